@@ -0,0 +1,115 @@
+//
+// Created by richard on 10/19/26.
+//
+// Shared cache lookups from 1 to 64 threads.
+//
+// All threads of a run share one table pre-filled with kNumKeys entries and
+// call GetOrInsert on random keys, so almost every call is a hit; one call in
+// kWriteEvery overwrites an entry. The baseline is a Map guarded by a single
+// std::shared_mutex, which every reader and writer goes through.
+#include "ffi/container/concurrent_map.h"
+#include "ffi/container/map.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+namespace {
+using namespace litetvm::ffi;
+
+constexpr int64_t kNumKeys = 1 << 14;
+constexpr int64_t kWriteEvery = 100;
+
+/*! \brief xorshift, cheap enough to not dominate the lookup. */
+inline uint64_t NextRandom(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+struct LockedMap {
+    std::shared_mutex mutex;
+    Map<int64_t, int64_t> map;
+
+    int64_t GetOrInsert(int64_t key) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto it = map.find(key);
+            if (it != map.end()) {
+                return (*it).second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        auto it = map.find(key);
+        if (it != map.end()) {
+            return (*it).second;
+        }
+        map.Set(key, key);
+        return key;
+    }
+
+    void Set(int64_t key, int64_t value) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        map.Set(key, value);
+    }
+};
+
+std::unique_ptr<LockedMap> locked_map;
+std::optional<ConcurrentMap<int64_t, int64_t>> concurrent_map;
+
+void BM_LockedMap(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        locked_map = std::make_unique<LockedMap>();
+        for (int64_t i = 0; i < kNumKeys; ++i) {
+            locked_map->map.Set(i, i);
+        }
+    }
+    uint64_t rng = 0x9e3779b97f4a7c15ULL + state.thread_index();
+    int64_t step = 0;
+    for (auto _: state) {
+        int64_t key = static_cast<int64_t>(NextRandom(rng) % kNumKeys);
+        if (++step % kWriteEvery == 0) {
+            locked_map->Set(key, step);
+        } else {
+            benchmark::DoNotOptimize(locked_map->GetOrInsert(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        locked_map.reset();
+    }
+}
+
+void BM_ConcurrentMap(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        concurrent_map.emplace();
+        for (int64_t i = 0; i < kNumKeys; ++i) {
+            concurrent_map->Set(i, i);
+        }
+    }
+    uint64_t rng = 0x9e3779b97f4a7c15ULL + state.thread_index();
+    int64_t step = 0;
+    for (auto _: state) {
+        int64_t key = static_cast<int64_t>(NextRandom(rng) % kNumKeys);
+        if (++step % kWriteEvery == 0) {
+            concurrent_map->Set(key, step);
+        } else {
+            benchmark::DoNotOptimize(concurrent_map->GetOrInsert(key, [](int64_t k) { return k; }));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        concurrent_map.reset();
+    }
+}
+
+BENCHMARK(BM_LockedMap)->Name("GetOrInsert/locked_map")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_ConcurrentMap)->Name("GetOrInsert/concurrent_map")->ThreadRange(1, 64)->UseRealTime();
+
+}// namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,106 @@
+//
+// Created by richard on 10/19/26.
+//
+// Allocate/free cycles of CPU tensor memory at typical activation sizes.
+//
+// Cycle/* allocates and frees one buffer, Layer/* keeps four live buffers and frees the
+// oldest one per iteration, as consecutive layers do with their activations. The second
+// argument writes one byte per page of each new buffer, which adds the page faults of
+// memory fresh from the system. malloc is posix_memalign with 64 byte alignment, caching is
+// CPUCachingAllocator. Tensor/* creates a float32 tensor through the environment allocator.
+#include "ffi/container/tensor.h"
+#include "ffi/extra/c_env_api.h"
+#include "ffi/extra/cpu_caching_allocator.h"
+#include "ffi/memory.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+namespace {
+using namespace litetvm::ffi;
+
+struct MallocAllocator {
+    void* Alloc(size_t nbytes) { return details::AlignedAlloc<64>(nbytes); }
+    void Free(void* ptr, size_t) { details::AlignedFree(ptr); }
+};
+
+struct CachingAllocator {
+    void* Alloc(size_t nbytes) { return CPUCachingAllocator::Global()->Alloc(nbytes); }
+    void Free(void* ptr, size_t nbytes) { CPUCachingAllocator::Global()->Free(ptr, nbytes); }
+};
+
+void Touch(void* ptr, size_t nbytes) {
+    char* data = static_cast<char*>(ptr);
+    for (size_t i = 0; i < nbytes; i += 4096) {
+        data[i] = 1;
+    }
+    benchmark::ClobberMemory();
+}
+
+template<typename TAllocator>
+void BM_Cycle(benchmark::State& state) {
+    TAllocator alloc;
+    size_t nbytes = static_cast<size_t>(state.range(0));
+    bool touch = state.range(1) != 0;
+    for (auto _: state) {
+        void* ptr = alloc.Alloc(nbytes);
+        if (touch) {
+            Touch(ptr, nbytes);
+        }
+        benchmark::DoNotOptimize(ptr);
+        alloc.Free(ptr, nbytes);
+    }
+}
+
+template<typename TAllocator>
+void BM_Layer(benchmark::State& state) {
+    constexpr size_t kLive = 4;
+    TAllocator alloc;
+    size_t nbytes = static_cast<size_t>(state.range(0));
+    bool touch = state.range(1) != 0;
+    void* live[kLive];
+    for (void*& ptr: live) {
+        ptr = alloc.Alloc(nbytes);
+    }
+    size_t oldest = 0;
+    for (auto _: state) {
+        alloc.Free(live[oldest], nbytes);
+        live[oldest] = alloc.Alloc(nbytes);
+        if (touch) {
+            Touch(live[oldest], nbytes);
+        }
+        benchmark::DoNotOptimize(live[oldest]);
+        oldest = (oldest + 1) % kLive;
+    }
+    for (void* ptr: live) {
+        alloc.Free(ptr, nbytes);
+    }
+}
+
+void BM_Tensor(benchmark::State& state) {
+    DLPackTensorAllocator env_alloc = TVMFFIEnvGetTensorAllocator();
+    int64_t numel = state.range(0) / 4;
+    for (auto _: state) {
+        Tensor tensor = Tensor::FromDLPackAlloc(env_alloc, {numel}, DLDataType{kDLFloat, 32, 1}, DLDevice{kDLCPU, 0});
+        benchmark::DoNotOptimize(tensor->data);
+    }
+}
+
+void Sizes(benchmark::internal::Benchmark* bench) {
+    for (int64_t touch: {0, 1}) {
+        for (int64_t nbytes: {4 << 10, 64 << 10, 1 << 20, 16 << 20}) {
+            bench->Args({nbytes, touch});
+        }
+    }
+}
+
+BENCHMARK(BM_Cycle<MallocAllocator>)->Name("Cycle/malloc")->Apply(Sizes);
+BENCHMARK(BM_Cycle<CachingAllocator>)->Name("Cycle/caching")->Apply(Sizes);
+BENCHMARK(BM_Layer<MallocAllocator>)->Name("Layer/malloc")->Apply(Sizes);
+BENCHMARK(BM_Layer<CachingAllocator>)->Name("Layer/caching")->Apply(Sizes);
+BENCHMARK(BM_Tensor)->Name("Tensor/caching")->Arg(4 << 10)->Arg(1 << 20)->Arg(16 << 20);
+
+}// namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+//
+// Created by richard on 10/19/26.
+//
+// DLPack export and import of CPU tensors, the C++ side of scripts/benchmark_dlpack.py.
+//
+// Export/* creates a managed tensor and runs its deleter, as __dlpack__ does.
+// RoundTrip/* imports our own export back, as from_dlpack on a tvm tensor does.
+// Import/foreign imports a managed tensor of another producer, as from_dlpack on a
+// torch or numpy tensor does. NopRoundTrip round trips three tensors and passes them
+// to testing.nop, the tvm.ffi.nop+from_dlpack(tvm) case of the script.
+#include "ffi/container/tensor.h"
+#include "ffi/extra/c_env_api.h"
+#include "ffi/function.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+using namespace litetvm::ffi;
+
+Tensor MakeTensor() {
+    return Tensor::FromDLPackAlloc(TVMFFIEnvGetTensorAllocator(), {1}, DLDataType{kDLInt, 64, 1},
+                                   DLDevice{kDLCPU, 0});
+}
+
+void BM_ExportLegacy(benchmark::State& state) {
+    Tensor x = MakeTensor();
+    for (auto _: state) {
+        DLManagedTensor* dlpack = x.ToDLPack();
+        benchmark::DoNotOptimize(dlpack);
+        dlpack->deleter(dlpack);
+    }
+}
+
+void BM_ExportVersioned(benchmark::State& state) {
+    Tensor x = MakeTensor();
+    for (auto _: state) {
+        DLManagedTensorVersioned* dlpack = x.ToDLPackVersioned();
+        benchmark::DoNotOptimize(dlpack);
+        dlpack->deleter(dlpack);
+    }
+}
+
+void BM_RoundTripLegacy(benchmark::State& state) {
+    Tensor x = MakeTensor();
+    for (auto _: state) {
+        Tensor y = Tensor::FromDLPack(x.ToDLPack());
+        benchmark::DoNotOptimize(y->data);
+    }
+}
+
+void BM_RoundTripVersioned(benchmark::State& state) {
+    Tensor x = MakeTensor();
+    for (auto _: state) {
+        Tensor y = Tensor::FromDLPackVersioned(x.ToDLPackVersioned());
+        benchmark::DoNotOptimize(y->data);
+    }
+}
+
+void BM_ImportForeign(benchmark::State& state) {
+    int64_t data = 0;
+    int64_t shape[1] = {1};
+    DLManagedTensorVersioned foreign{};
+    foreign.version = {DLPACK_MAJOR_VERSION, DLPACK_MINOR_VERSION};
+    foreign.dl_tensor.data = &data;
+    foreign.dl_tensor.device = DLDevice{kDLCPU, 0};
+    foreign.dl_tensor.ndim = 1;
+    foreign.dl_tensor.dtype = DLDataType{kDLInt, 64, 1};
+    foreign.dl_tensor.shape = shape;
+    foreign.deleter = [](DLManagedTensorVersioned*) {};
+    for (auto _: state) {
+        Tensor y = Tensor::FromDLPackVersioned(&foreign);
+        benchmark::DoNotOptimize(y->data);
+    }
+}
+
+void BM_NopRoundTrip(benchmark::State& state) {
+    Function nop = Function::GetGlobalRequired("testing.nop");
+    Tensor x = MakeTensor();
+    Tensor y = MakeTensor();
+    Tensor z = MakeTensor();
+    for (auto _: state) {
+        Tensor tx = Tensor::FromDLPackVersioned(x.ToDLPackVersioned());
+        Tensor ty = Tensor::FromDLPackVersioned(y.ToDLPackVersioned());
+        Tensor tz = Tensor::FromDLPackVersioned(z.ToDLPackVersioned());
+        nop(tx, ty, tz);
+    }
+}
+
+BENCHMARK(BM_ExportLegacy)->Name("Export/legacy");
+BENCHMARK(BM_ExportVersioned)->Name("Export/versioned");
+BENCHMARK(BM_RoundTripLegacy)->Name("RoundTrip/legacy");
+BENCHMARK(BM_RoundTripVersioned)->Name("RoundTrip/versioned");
+BENCHMARK(BM_ImportForeign)->Name("Import/foreign");
+BENCHMARK(BM_NopRoundTrip)->Name("NopRoundTrip");
+
+}// namespace
+
+BENCHMARK_MAIN();
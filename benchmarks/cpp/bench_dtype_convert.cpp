@@ -0,0 +1,125 @@
+//
+// Created by richard on 10/19/26.
+//
+// Throughput of dtype conversion and quantization of CPU tensors, in float32 elements per
+// second.
+//
+// To/<dtype> and From/<dtype> convert 4M elements between float32 and the dtype with AsType.
+// To/<dtype>/strided writes every other element of a wider tensor instead, which takes the
+// scalar kernels the contiguous rows of float16 and bfloat16 vectorize. Quantize/<dtype> and
+// Dequantize/<dtype> convert a 4096 x 1024 float32 matrix with a scale per row.
+#include "ffi/container/tensor.h"
+#include "ffi/memory.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+
+namespace {
+using namespace litetvm::ffi;
+
+constexpr int64_t kNumel = static_cast<int64_t>(4) << 20;
+constexpr int64_t kRows = 4096;
+constexpr DLDataType kFloat32{kDLFloat, 32, 1};
+
+struct CPUNDAlloc {
+    void AllocData(DLTensor* tensor) {
+        tensor->data = details::AlignedAlloc<64>(GetDataSize(*tensor));
+        std::memset(tensor->data, 0, GetDataSize(*tensor));
+    }
+
+    void FreeData(DLTensor* tensor) {
+        details::AlignedFree(tensor->data);
+    }
+};
+
+Tensor Empty(ShapeView shape, DLDataType dtype = kFloat32) {
+    return Tensor::FromNDAlloc(CPUNDAlloc(), shape, dtype, DLDevice{kDLCPU, 0});
+}
+
+// values spread over the range of the narrow dtypes
+Tensor Values(ShapeView shape) {
+    Tensor tensor = Empty(shape);
+    float* data = static_cast<float*>(tensor->data);
+    for (int64_t i = 0; i < tensor.numel(); ++i) {
+        data[i] = static_cast<float>(i % 1000 - 500) * 0.0625f;
+    }
+    return tensor;
+}
+
+template<DLDataTypeCode kCode, int kBits>
+void BM_To(benchmark::State& state) {
+    Tensor src = Values({kNumel});
+    for (auto _: state) {
+        benchmark::DoNotOptimize(src.AsType(DLDataType{kCode, kBits, 1}));
+    }
+    state.SetItemsProcessed(state.iterations() * kNumel);
+}
+
+template<DLDataTypeCode kCode, int kBits>
+void BM_ToStrided(benchmark::State& state) {
+    Tensor src = Values({kNumel, 1});
+    Tensor dst = Empty({kNumel, 2}, DLDataType{kCode, kBits, 1}).Slice(1, 0, 1);
+    for (auto _: state) {
+        src.CopyTo(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * kNumel);
+}
+
+template<DLDataTypeCode kCode, int kBits>
+void BM_From(benchmark::State& state) {
+    Tensor src = Values({kNumel}).AsType(DLDataType{kCode, kBits, 1});
+    for (auto _: state) {
+        benchmark::DoNotOptimize(src.AsType(kFloat32));
+    }
+    state.SetItemsProcessed(state.iterations() * kNumel);
+}
+
+Tensor RowScales() {
+    Tensor scale = Empty({kRows});
+    float* data = static_cast<float*>(scale->data);
+    for (int64_t i = 0; i < kRows; ++i) {
+        data[i] = 0.25f + static_cast<float>(i % 7);
+    }
+    return scale;
+}
+
+template<DLDataTypeCode kCode, int kBits>
+void BM_Quantize(benchmark::State& state) {
+    Tensor src = Values({kRows, kNumel / kRows});
+    Tensor scale = RowScales();
+    for (auto _: state) {
+        benchmark::DoNotOptimize(src.Quantize(DLDataType{kCode, kBits, 1}, scale));
+    }
+    state.SetItemsProcessed(state.iterations() * kNumel);
+}
+
+template<DLDataTypeCode kCode, int kBits>
+void BM_Dequantize(benchmark::State& state) {
+    Tensor scale = RowScales();
+    Tensor src = Values({kRows, kNumel / kRows}).Quantize(DLDataType{kCode, kBits, 1}, scale);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(src.Dequantize(kFloat32, scale));
+    }
+    state.SetItemsProcessed(state.iterations() * kNumel);
+}
+
+BENCHMARK(BM_To<kDLFloat, 16>)->Name("To/float16")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ToStrided<kDLFloat, 16>)->Name("To/float16/strided")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_To<kDLBfloat, 16>)->Name("To/bfloat16")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ToStrided<kDLBfloat, 16>)->Name("To/bfloat16/strided")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_To<kDLFloat8_e4m3fn, 8>)->Name("To/float8_e4m3fn")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_To<kDLFloat8_e5m2, 8>)->Name("To/float8_e5m2")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_To<kDLInt, 4>)->Name("To/int4")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_From<kDLFloat, 16>)->Name("From/float16")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_From<kDLBfloat, 16>)->Name("From/bfloat16")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_From<kDLFloat8_e4m3fn, 8>)->Name("From/float8_e4m3fn")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_From<kDLInt, 4>)->Name("From/int4")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Quantize<kDLInt, 4>)->Name("Quantize/int4")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Quantize<kDLFloat8_e4m3fn, 8>)->Name("Quantize/float8_e4m3fn")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Dequantize<kDLInt, 4>)->Name("Dequantize/int4")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Dequantize<kDLFloat8_e4m3fn, 8>)->Name("Dequantize/float8_e4m3fn")->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}// namespace
+
+BENCHMARK_MAIN();
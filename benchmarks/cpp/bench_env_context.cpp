@@ -0,0 +1,51 @@
+//
+// Created by richard on 10/19/26.
+//
+// Cost of the environment lookups on the tensor creation path.
+//
+// Get/* looks up the allocator, the default one or the one of the CPU device type, as
+// Tensor::FromDLPackAlloc callers do per tensor. Scope/* overrides the CPU allocator with
+// WithAllocator and restores it, and Stream/get looks up the stream of a device.
+#include "ffi/extra/cpu_caching_allocator.h"
+#include "ffi/extra/env_context.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+using namespace litetvm::ffi;
+
+void BM_GetAllocator(benchmark::State& state) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(TVMFFIEnvGetTensorAllocator());
+    }
+}
+
+void BM_GetDeviceAllocator(benchmark::State& state) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU));
+    }
+}
+
+void BM_Scope(benchmark::State& state) {
+    for (auto _: state) {
+        WithAllocator scope(kDLCPU, CPUCachingAllocator::DLPackAlloc);
+        benchmark::DoNotOptimize(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU));
+    }
+}
+
+void BM_GetStream(benchmark::State& state) {
+    int stream = 0;
+    WithStream scope(DLDevice{kDLCUDA, 0}, &stream);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(TVMFFIEnvGetStream(kDLCUDA, 0));
+    }
+}
+
+BENCHMARK(BM_GetAllocator)->Name("Get/default");
+BENCHMARK(BM_GetDeviceAllocator)->Name("Get/device");
+BENCHMARK(BM_Scope)->Name("Scope/allocator");
+BENCHMARK(BM_GetStream)->Name("Stream/get");
+
+}// namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,89 @@
+//
+// Created by richard on 10/18/26.
+//
+// Cost of throwing and catching an ffi::Error, and of returning it as Expected.
+//
+// Eager errors format the traceback at the throw site, lazy errors only
+// record program counters and symbolize them when the error is inspected.
+#include "ffi/error.h"
+#include "ffi/expected.h"
+#include "ffi/function.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace {
+using namespace litetvm::ffi;
+
+TVM_FFI_NO_INLINE void ThrowLazy(int value) {
+    TVM_FFI_THROW(ValueError) << "invalid value " << value;
+}
+
+TVM_FFI_NO_INLINE void ThrowEager(int value) {
+    details::ErrorBuilder("ValueError", TVM_FFI_TRACEBACK_HERE, false).stream() << "invalid value " << value;
+}
+
+template<void (*fthrow)(int)>
+void BM_ThrowCatch(benchmark::State& state) {
+    int value = 0;
+    for (auto _: state) {
+        try {
+            fthrow(value++);
+        } catch (const Error& error) {
+            benchmark::DoNotOptimize(&error);
+        }
+    }
+}
+
+template<void (*fthrow)(int)>
+void BM_ThrowCatchWhat(benchmark::State& state) {
+    int value = 0;
+    for (auto _: state) {
+        try {
+            fthrow(value++);
+        } catch (const Error& error) {
+            benchmark::DoNotOptimize(error.what());
+        }
+    }
+}
+
+// error returned through a function boundary: Expected vs. exception
+void BM_ReturnErrorExpected(benchmark::State& state) {
+    TypedFunction<Expected<int64_t>(int64_t)> fcheck = [](int64_t x) -> Expected<int64_t> {
+        if (x >= 0) return Error("ValueError", "invalid value", "");
+        return x;
+    };
+    int64_t value = 0;
+    for (auto _: state) {
+        Expected<int64_t> res = fcheck(value++);
+        benchmark::DoNotOptimize(res.is_err());
+    }
+}
+
+void BM_ReturnErrorThrow(benchmark::State& state) {
+    TypedFunction<int64_t(int64_t)> fcheck = [](int64_t x) -> int64_t {
+        if (x >= 0) TVM_FFI_THROW(ValueError) << "invalid value";
+        return x;
+    };
+    int64_t value = 0;
+    for (auto _: state) {
+        try {
+            benchmark::DoNotOptimize(fcheck(value++));
+        } catch (const Error& error) {
+            benchmark::DoNotOptimize(&error);
+        }
+    }
+}
+
+BENCHMARK(BM_ReturnErrorExpected)->Name("ReturnError/expected");
+BENCHMARK(BM_ReturnErrorThrow)->Name("ReturnError/throw");
+
+BENCHMARK(BM_ThrowCatch<ThrowLazy>)->Name("ThrowCatch/lazy")->ThreadRange(1, 8);
+BENCHMARK(BM_ThrowCatch<ThrowEager>)->Name("ThrowCatch/eager")->ThreadRange(1, 8);
+BENCHMARK(BM_ThrowCatchWhat<ThrowLazy>)->Name("ThrowCatchWhat/lazy");
+BENCHMARK(BM_ThrowCatchWhat<ThrowEager>)->Name("ThrowCatchWhat/eager");
+
+}// namespace
+
+BENCHMARK_MAIN();
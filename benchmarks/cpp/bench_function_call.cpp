@@ -0,0 +1,111 @@
+//
+// Created by richard on 10/18/26.
+//
+// Cost of calling a typed function with POD-only signatures.
+//
+// The generated assembly is kept in the build tree next to the object file
+// (bench_function_call.cpp.s), look for the InvokeTyped / InvokeGeneric symbols
+// to compare the code emitted for the specialized and the generic call path.
+#include "ffi/any.h"
+#include "ffi/dtype.h"
+#include "ffi/function.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <utility>
+
+namespace {
+using namespace litetvm::ffi;
+
+template<typename T, size_t>
+using Repeat = T;
+
+template<typename Seq>
+struct SumSignature;
+
+template<size_t... Is>
+struct SumSignature<std::index_sequence<Is...>> {
+    using FType = int64_t(Repeat<int64_t, Is>...);
+
+    static TypedFunction<FType> Make() {
+        return TypedFunction<FType>([](Repeat<int64_t, Is>... args) -> int64_t { return (int64_t{0} + ... + args); });
+    }
+
+    // specialized path selected by TypedFunction for POD-only signatures
+    TVM_FFI_NO_INLINE static int64_t InvokeTyped(const TypedFunction<FType>& f, Repeat<int64_t, Is>... args) {
+        return f(args...);
+    }
+
+    // generic path: owned Any result followed by a cast
+    TVM_FFI_NO_INLINE static int64_t InvokeGeneric(const TypedFunction<FType>& f, Repeat<int64_t, Is>... args) {
+        return f.packed()(args...).template cast<int64_t>();
+    }
+};
+
+template<size_t N, bool kTyped>
+void BM_CallInt64(benchmark::State& state) {
+    using Sig = SumSignature<std::make_index_sequence<N>>;
+    auto f = Sig::Make();
+    int64_t x = 1;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(x);
+        int64_t r = [&]<size_t... Is>(std::index_sequence<Is...>) {
+            if constexpr (kTyped) {
+                return Sig::InvokeTyped(f, Repeat<int64_t, Is>(x)...);
+            } else {
+                return Sig::InvokeGeneric(f, Repeat<int64_t, Is>(x)...);
+            }
+        }(std::make_index_sequence<N>());
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+#define BENCHMARK_INT64_CALL(N)                 \
+    BENCHMARK(BM_CallInt64<N, true>)->Name("Typed/int64/" #N); \
+    BENCHMARK(BM_CallInt64<N, false>)->Name("Generic/int64/" #N)
+
+BENCHMARK_INT64_CALL(0);
+BENCHMARK_INT64_CALL(1);
+BENCHMARK_INT64_CALL(2);
+BENCHMARK_INT64_CALL(3);
+BENCHMARK_INT64_CALL(4);
+BENCHMARK_INT64_CALL(5);
+BENCHMARK_INT64_CALL(6);
+BENCHMARK_INT64_CALL(7);
+BENCHMARK_INT64_CALL(8);
+
+using MixedFType = double(double, DLDataType, DLDevice, void*);
+
+TVM_FFI_NO_INLINE double InvokeMixedTyped(const TypedFunction<MixedFType>& f, double a, DLDataType dtype,
+                                           DLDevice device, void* ptr) {
+    return f(a, dtype, device, ptr);
+}
+
+TVM_FFI_NO_INLINE double InvokeMixedGeneric(const TypedFunction<MixedFType>& f, double a, DLDataType dtype,
+                                             DLDevice device, void* ptr) {
+    return f.packed()(a, dtype, device, ptr).cast<double>();
+}
+
+template<bool kTyped>
+void BM_CallMixed(benchmark::State& state) {
+    TypedFunction<MixedFType> f([](double a, DLDataType dtype, DLDevice device, void* ptr) {
+        return a + dtype.bits + device.device_id + (ptr != nullptr);
+    });
+    double a = 1.0;
+    DLDataType dtype{kDLFloat, 32, 1};
+    DLDevice device{kDLCPU, 0};
+    void* ptr = &a;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(a);
+        double r = kTyped ? InvokeMixedTyped(f, a, dtype, device, ptr) : InvokeMixedGeneric(f, a, dtype, device, ptr);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+BENCHMARK(BM_CallMixed<true>)->Name("Typed/mixed/4");
+BENCHMARK(BM_CallMixed<false>)->Name("Generic/mixed/4");
+
+}// namespace
+
+BENCHMARK_MAIN();
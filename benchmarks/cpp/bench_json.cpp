@@ -0,0 +1,75 @@
+//
+// Created by richard on 10/18/26.
+//
+// Heap allocations and time of parsing JSON documents with short keys.
+//
+// Keys and dtype strings of tensor metadata are mostly 8-23 bytes, longer than
+// the 7 bytes String stores inline. The allocs_per_parse counter counts every
+// malloc made during a parse.
+#include "ffi/extra/json.h"
+#include "ffi/string.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(size_t size);
+
+namespace {
+std::atomic<bool> count_allocs{false};
+std::atomic<int64_t> num_allocs{0};
+}// namespace
+
+// count the allocations of the whole process, including the ones made inside the library
+extern "C" void* malloc(size_t size) {
+    if (count_allocs.load(std::memory_order_relaxed)) {
+        num_allocs.fetch_add(1, std::memory_order_relaxed);
+    }
+    return __libc_malloc(size);
+}
+#endif
+
+namespace {
+using namespace litetvm::ffi;
+
+String MakeTensorMetadata(int64_t num_records) {
+    std::string json = "[";
+    for (int64_t i = 0; i < num_records; ++i) {
+        if (i != 0) json += ",";
+        json += R"({"name":"layer)" + std::to_string(i) + R"(.weight",)";
+        json += R"("dtype":"bfloat16","device_type":"cuda","device_id":0,)";
+        json += R"("shape":[4096,4096],"byte_offset":)" + std::to_string(i * 4096 * 4096 * 2) + ",";
+        json += R"("requires_grad":false,"storage_format":"row_major"})";
+    }
+    json += "]";
+    return String(std::move(json));
+}
+
+void BM_JSONParse(benchmark::State& state) {
+    String json = MakeTensorMetadata(state.range(0));
+    int64_t allocs = 0;
+    for (auto _: state) {
+#if defined(__GLIBC__)
+        num_allocs.store(0);
+        count_allocs.store(true);
+#endif
+        json::Value value = json::Parse(json);
+#if defined(__GLIBC__)
+        count_allocs.store(false);
+        allocs = num_allocs.load();
+#endif
+        benchmark::DoNotOptimize(value);
+    }
+    state.counters["allocs_per_parse"] = static_cast<double>(allocs);
+    state.counters["allocs_per_record"] = static_cast<double>(allocs) / static_cast<double>(state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(json.size()));
+}
+
+BENCHMARK(BM_JSONParse)->Name("JSONParse/tensor_metadata")->RangeMultiplier(10)->Range(10, 10000);
+
+}// namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,169 @@
+//
+// Created by richard on 10/19/26.
+//
+// Map lookups and inserts with the dense and swiss layouts of large maps.
+//
+// Keys are int64 scattered over the whole range, a lookup hit probes a key
+// that is in the map and a lookup miss one that is not, both in a random
+// order so that large maps do not stay in cache. Insert builds a map of n
+// entries from empty, rehashes included.
+//
+// StringLookup looks up registry-like names longer than the small string
+// buffer, either by constructing a String as the registries used to or by
+// std::string_view. GetGlobal and TypeKeyToIndex go through the C API.
+// Each reports allocs_per_lookup, counted by interposing malloc, which both
+// operator new and the object allocators go through (glibc only).
+#include "ffi/c_api.h"
+#include "ffi/container/map.h"
+#include "ffi/string.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+std::atomic<int64_t> num_allocs{0};
+}// namespace
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(size_t size);
+
+extern "C" void* malloc(size_t size) {
+    num_allocs.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+#endif
+
+namespace {
+using namespace litetvm::ffi;
+
+constexpr uint64_t kScatter = 0x9e3779b97f4a7c15ULL;
+
+inline int64_t KeyAt(int64_t i) { return static_cast<int64_t>(static_cast<uint64_t>(i) * kScatter); }
+
+/*! \brief xorshift, cheap enough to not dominate the lookup. */
+inline uint64_t NextRandom(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+Map<int64_t, int64_t> MakeMap(MapObj::Layout layout, int64_t n) {
+    Map<int64_t, int64_t> m(layout, 0);
+    for (int64_t i = 0; i < n; ++i) {
+        m.Set(KeyAt(i), i);
+    }
+    return m;
+}
+
+template<MapObj::Layout layout>
+void BM_LookupHit(benchmark::State& state) {
+    int64_t n = state.range(0);
+    Map<int64_t, int64_t> m = MakeMap(layout, n);
+    const MapObj* obj = static_cast<const MapObj*>(m.get());
+    uint64_t rng = 1;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(obj->count(KeyAt(static_cast<int64_t>(NextRandom(rng) % n))));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<MapObj::Layout layout>
+void BM_LookupMiss(benchmark::State& state) {
+    int64_t n = state.range(0);
+    Map<int64_t, int64_t> m = MakeMap(layout, n);
+    const MapObj* obj = static_cast<const MapObj*>(m.get());
+    uint64_t rng = 1;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(obj->count(KeyAt(n + static_cast<int64_t>(NextRandom(rng) % n))));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<MapObj::Layout layout>
+void BM_Insert(benchmark::State& state) {
+    int64_t n = state.range(0);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(MakeMap(layout, n));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+/*! \brief Run a lookup over the names in turn and report the allocations per lookup */
+template<typename FLookup>
+void RunNameLookup(benchmark::State& state, const std::vector<std::string>& names, FLookup flookup) {
+    size_t i = 0;
+    int64_t begin_allocs = num_allocs.load();
+    for (auto _: state) {
+        benchmark::DoNotOptimize(flookup(names[i]));
+        i = (i + 1 == names.size() ? 0 : i + 1);
+    }
+    state.counters["allocs_per_lookup"] =
+            static_cast<double>(num_allocs.load() - begin_allocs) / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations());
+}
+
+std::vector<std::string> MakeNames(Map<String, int64_t>* m) {
+    std::vector<std::string> names;
+    for (int64_t i = 0; i < 1000; ++i) {
+        names.push_back("testing.registered_global_" + std::to_string(i));
+        m->Set(names.back(), i);
+    }
+    return names;
+}
+
+void BM_StringLookupString(benchmark::State& state) {
+    Map<String, int64_t> m;
+    std::vector<std::string> names = MakeNames(&m);
+    RunNameLookup(state, names, [&](const std::string& name) { return m.count(String(name.data(), name.size())); });
+}
+
+void BM_StringLookupStringView(benchmark::State& state) {
+    Map<String, int64_t> m;
+    std::vector<std::string> names = MakeNames(&m);
+    RunNameLookup(state, names, [&](const std::string& name) { return m.count(std::string_view(name)); });
+}
+
+void BM_GetGlobal(benchmark::State& state) {
+    std::vector<std::string> names = {"ffi.ConcurrentMapGetOrInsert", "ffi.GetGlobalFuncMetadata",
+                                      "ffi.PersistentMapGetItem", "ffi.MapGetItem"};
+    RunNameLookup(state, names, [](const std::string& name) {
+        TVMFFIByteArray bytes{name.data(), name.size()};
+        TVMFFIObjectHandle handle = nullptr;
+        TVMFFIFunctionGetGlobal(&bytes, &handle);
+        TVMFFIObjectDecRef(handle);
+        return handle;
+    });
+}
+
+void BM_TypeKeyToIndex(benchmark::State& state) {
+    std::vector<std::string> names = {"ffi.ConcurrentMap", "ffi.PersistentArray", "ffi.Function", "ffi.Tensor"};
+    RunNameLookup(state, names, [](const std::string& name) {
+        TVMFFIByteArray bytes{name.data(), name.size()};
+        int32_t type_index = 0;
+        TVMFFITypeKeyToIndex(&bytes, &type_index);
+        return type_index;
+    });
+}
+
+#define TVM_FFI_BENCH_MAP_SIZES ->Arg(16)->Arg(256)->Arg(4096)->Arg(65536)->Arg(1 << 20)->Arg(10000000)
+
+BENCHMARK(BM_LookupHit<MapObj::Layout::kDense>)->Name("LookupHit/dense") TVM_FFI_BENCH_MAP_SIZES;
+BENCHMARK(BM_LookupHit<MapObj::Layout::kSwiss>)->Name("LookupHit/swiss") TVM_FFI_BENCH_MAP_SIZES;
+BENCHMARK(BM_LookupMiss<MapObj::Layout::kDense>)->Name("LookupMiss/dense") TVM_FFI_BENCH_MAP_SIZES;
+BENCHMARK(BM_LookupMiss<MapObj::Layout::kSwiss>)->Name("LookupMiss/swiss") TVM_FFI_BENCH_MAP_SIZES;
+BENCHMARK(BM_Insert<MapObj::Layout::kDense>)->Name("Insert/dense") TVM_FFI_BENCH_MAP_SIZES;
+BENCHMARK(BM_Insert<MapObj::Layout::kSwiss>)->Name("Insert/swiss") TVM_FFI_BENCH_MAP_SIZES;
+BENCHMARK(BM_StringLookupString)->Name("StringLookup/string");
+BENCHMARK(BM_StringLookupStringView)->Name("StringLookup/string_view");
+BENCHMARK(BM_GetGlobal)->Name("GetGlobal");
+BENCHMARK(BM_TypeKeyToIndex)->Name("TypeKeyToIndex");
+
+}// namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,102 @@
+//
+// Created by richard on 10/19/26.
+//
+// Time to get the data of a 64MB tensor file into usable tensors, page cache warm.
+//
+// Read/pread reads the file into freshly allocated memory, the copy that mapping saves.
+// Map/* loads the file with LoadTensorFile and reads one byte per page of each tensor,
+// with the default options, populate (read prefault) and the read-ahead thread. Bytes per second
+// count the file size.
+#include "ffi/container/mapped_file.h"
+#include "ffi/memory.h"
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+using namespace litetvm::ffi;
+
+constexpr int64_t kNumTensors = 16;
+constexpr int64_t kTensorElems = 1 << 20;
+
+struct CPUNDAlloc {
+    void AllocData(DLTensor* tensor) {
+        tensor->data = details::AlignedAlloc<64>(GetDataSize(*tensor));
+    }
+
+    void FreeData(DLTensor* tensor) {
+        details::AlignedFree(tensor->data);
+    }
+};
+
+const std::string& TensorFilePath() {
+    static const std::string path = []() {
+        std::string path = (std::filesystem::temp_directory_path() / "bench_mapped_file.bin").string();
+        Map<String, Tensor> tensors;
+        for (int64_t i = 0; i < kNumTensors; ++i) {
+            Tensor tensor = Tensor::FromNDAlloc(CPUNDAlloc(), {kTensorElems}, DLDataType{kDLFloat, 32, 1},
+                                                DLDevice{kDLCPU, 0});
+            std::fill_n(static_cast<float*>(tensor->data), kTensorElems, static_cast<float>(i));
+            tensors.Set("w" + std::to_string(i), tensor);
+        }
+        SaveTensorFile(path, tensors);
+        return path;
+    }();
+    return path;
+}
+
+int64_t FileBytes() {
+    return static_cast<int64_t>(std::filesystem::file_size(TensorFilePath()));
+}
+
+void BM_Read(benchmark::State& state) {
+    const std::string& path = TensorFilePath();
+    size_t nbytes = static_cast<size_t>(FileBytes());
+    for (auto _: state) {
+        char* buffer = static_cast<char*>(details::AlignedAlloc<4096>(nbytes));
+        int fd = open(path.c_str(), O_RDONLY);
+        for (size_t done = 0; done < nbytes;) {
+            ssize_t n = pread(fd, buffer + done, nbytes - done, static_cast<off_t>(done));
+            if (n <= 0) {
+                break;
+            }
+            done += static_cast<size_t>(n);
+        }
+        close(fd);
+        benchmark::DoNotOptimize(buffer[nbytes - 1]);
+        details::AlignedFree(buffer);
+    }
+    state.SetBytesProcessed(state.iterations() * FileBytes());
+}
+
+void BM_Map(benchmark::State& state) {
+    const std::string& path = TensorFilePath();
+    MapOptions options;
+    options.populate = state.range(0) == 1;
+    options.read_ahead = state.range(0) == 2;
+    for (auto _: state) {
+        Map<String, Tensor> tensors = LoadTensorFile(path, options);
+        char sum = 0;
+        for (const auto& [name, tensor]: tensors) {
+            const char* data = static_cast<const char*>(tensor->data);
+            for (size_t i = 0; i < GetDataSize(*tensor.get()); i += 4096) {
+                sum += data[i];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * FileBytes());
+}
+
+BENCHMARK(BM_Read)->Name("Read/pread")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Map)->Name("Map/default")->Arg(0)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Map)->Name("Map/populate")->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Map)->Name("Map/read_ahead")->Arg(2)->Unit(benchmark::kMillisecond);
+
+}// namespace
+
+BENCHMARK_MAIN();
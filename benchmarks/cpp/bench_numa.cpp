@@ -0,0 +1,76 @@
+//
+// Created by richard on 10/19/26.
+//
+// Memory bandwidth between the NUMA nodes of the machine.
+//
+// Read/<memory node>/<cpu node> sums a 128MB buffer allocated with NUMAAllocator on the
+// memory node, from one thread of NUMANodeThreadPool of the cpu node. Write/<memory node>/
+// <cpu node> fills it. Pairs of different nodes show the remote bandwidth, a machine without
+// NUMA only runs 0/0.
+#include "ffi/extra/numa.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <future>
+#include <numeric>
+
+namespace {
+using namespace litetvm::ffi;
+
+constexpr size_t kBufferBytes = static_cast<size_t>(128) << 20;
+
+// runs fn on a pinned thread of the node and waits for it
+template<typename F>
+void RunOnNode(int node, F fn) {
+    std::promise<void> done;
+    NUMANodeThreadPool(node)->Submit([&]() {
+        fn();
+        done.set_value();
+    });
+    done.get_future().wait();
+}
+
+void NodePairs(benchmark::internal::Benchmark* bench) {
+    for (int memory_node = 0; memory_node < NUMANumNodes(); ++memory_node) {
+        for (int cpu_node = 0; cpu_node < NUMANumNodes(); ++cpu_node) {
+            if (!NUMANodeCpus(cpu_node).empty()) {
+                bench->Args({memory_node, cpu_node});
+            }
+        }
+    }
+}
+
+void BM_Read(benchmark::State& state) {
+    int memory_node = static_cast<int>(state.range(0));
+    int cpu_node = static_cast<int>(state.range(1));
+    auto* buffer = static_cast<uint64_t*>(NUMAAllocator::Alloc(kBufferBytes, memory_node));
+    std::memset(buffer, 1, kBufferBytes);
+    for (auto _: state) {
+        uint64_t sum = 0;
+        RunOnNode(cpu_node, [&]() { sum = std::accumulate(buffer, buffer + kBufferBytes / 8, uint64_t{0}); });
+        benchmark::DoNotOptimize(sum);
+    }
+    NUMAAllocator::Free(buffer, kBufferBytes);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kBufferBytes));
+}
+
+void BM_Write(benchmark::State& state) {
+    int memory_node = static_cast<int>(state.range(0));
+    int cpu_node = static_cast<int>(state.range(1));
+    auto* buffer = static_cast<char*>(NUMAAllocator::Alloc(kBufferBytes, memory_node));
+    std::memset(buffer, 1, kBufferBytes);
+    for (auto _: state) {
+        RunOnNode(cpu_node, [&]() { std::memset(buffer, 2, kBufferBytes); });
+        benchmark::ClobberMemory();
+    }
+    NUMAAllocator::Free(buffer, kBufferBytes);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kBufferBytes));
+}
+
+BENCHMARK(BM_Read)->Name("Read")->Apply(NodePairs)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Write)->Name("Write")->Apply(NodePairs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}// namespace
+
+BENCHMARK_MAIN();
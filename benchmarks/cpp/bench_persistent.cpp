@@ -0,0 +1,108 @@
+//
+// Created by richard on 10/19/26.
+//
+// Version-heavy updates of copy-on-write and persistent containers.
+//
+// Each iteration derives a new version from the previous one with a single
+// Set while the last kVersions versions stay alive, like a pass that keeps
+// snapshots of a symbol table. Map and Array copy the whole container on
+// every Set of a shared handle, the persistent containers copy one path.
+#include "ffi/container/array.h"
+#include "ffi/container/map.h"
+#include "ffi/container/persistent_array.h"
+#include "ffi/container/persistent_map.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace {
+using namespace litetvm::ffi;
+
+constexpr size_t kVersions = 8;
+
+template<typename TMap>
+TMap MakeMap(int64_t n) {
+    TMap m;
+    for (int64_t i = 0; i < n; ++i) {
+        m.Set(i, i);
+    }
+    return m;
+}
+
+template<typename TArray>
+TArray MakeArray(int64_t n) {
+    TArray a;
+    for (int64_t i = 0; i < n; ++i) {
+        a.push_back(i);
+    }
+    return a;
+}
+
+template<typename TMap>
+void BM_MapVersions(benchmark::State& state) {
+    int64_t n = state.range(0);
+    std::vector<TMap> versions(kVersions, MakeMap<TMap>(n));
+    int64_t step = 0;
+    for (auto _: state) {
+        TMap next = versions[step % kVersions];
+        next.Set((step * 7919) % n, step);
+        versions[++step % kVersions] = std::move(next);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename TArray>
+void BM_ArrayVersions(benchmark::State& state) {
+    int64_t n = state.range(0);
+    std::vector<TArray> versions(kVersions, MakeArray<TArray>(n));
+    int64_t step = 0;
+    for (auto _: state) {
+        TArray next = versions[step % kVersions];
+        next.Set((step * 7919) % n, step);
+        versions[++step % kVersions] = std::move(next);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename TMap>
+void BM_MapLookup(benchmark::State& state) {
+    int64_t n = state.range(0);
+    TMap m = MakeMap<TMap>(n);
+    int64_t step = 0;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(m.at((step++ * 7919) % n));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename TArray>
+void BM_ArrayRead(benchmark::State& state) {
+    int64_t n = state.range(0);
+    TArray a = MakeArray<TArray>(n);
+    int64_t step = 0;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(a[(step++ * 7919) % n]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_MapVersions<Map<int64_t, int64_t>>)->Name("MapVersions/cow")->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK(BM_MapVersions<PersistentMap<int64_t, int64_t>>)
+        ->Name("MapVersions/persistent")
+        ->RangeMultiplier(10)
+        ->Range(100, 100000);
+BENCHMARK(BM_ArrayVersions<Array<int64_t>>)->Name("ArrayVersions/cow")->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK(BM_ArrayVersions<PersistentArray<int64_t>>)
+        ->Name("ArrayVersions/persistent")
+        ->RangeMultiplier(10)
+        ->Range(100, 100000);
+
+BENCHMARK(BM_MapLookup<Map<int64_t, int64_t>>)->Name("MapLookup/cow")->Arg(100000);
+BENCHMARK(BM_MapLookup<PersistentMap<int64_t, int64_t>>)->Name("MapLookup/persistent")->Arg(100000);
+BENCHMARK(BM_ArrayRead<Array<int64_t>>)->Name("ArrayRead/cow")->Arg(100000);
+BENCHMARK(BM_ArrayRead<PersistentArray<int64_t>>)->Name("ArrayRead/persistent")->Arg(100000);
+
+}// namespace
+
+BENCHMARK_MAIN();
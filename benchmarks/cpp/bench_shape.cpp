@@ -0,0 +1,103 @@
+//
+// Created by richard on 10/19/26.
+//
+// Create, compare and hash rank-2 to rank-4 shapes.
+//
+// Create/malloc builds the shape object with the plain object allocator, as
+// every shape used to be built; Create/pooled goes through Shape, which keeps
+// small shapes in a per-thread pool; Create/interned returns the cached shape
+// and Create/global calls the ffi.Shape global function. Compare and Hash run
+// StructuralEqual and StructuralHash on two equal shapes, created separately
+// or interned.
+#include "ffi/container/shape.h"
+#include "ffi/extra/structural_equal.h"
+#include "ffi/extra/structural_hash.h"
+#include "ffi/function.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace {
+using namespace litetvm::ffi;
+
+std::vector<int64_t> Dims(int64_t rank) {
+    std::vector<int64_t> dims;
+    for (int64_t i = 0; i < rank; ++i) {
+        dims.push_back(32 << i);
+    }
+    return dims;
+}
+
+void BM_CreateMalloc(benchmark::State& state) {
+    std::vector<int64_t> dims = Dims(state.range(0));
+    for (auto _: state) {
+        ObjectPtr<ShapeObj> p = make_inplace_array_object<ShapeObj, int64_t>(dims.size());
+        int64_t* data = reinterpret_cast<int64_t*>(reinterpret_cast<char*>(p.get()) + sizeof(ShapeObj));
+        std::copy(dims.begin(), dims.end(), data);
+        p->data = data;
+        p->size = dims.size();
+        benchmark::DoNotOptimize(p);
+    }
+}
+
+void BM_CreatePooled(benchmark::State& state) {
+    std::vector<int64_t> dims = Dims(state.range(0));
+    for (auto _: state) {
+        Shape shape(dims.begin(), dims.end());
+        benchmark::DoNotOptimize(shape);
+    }
+}
+
+void BM_CreateInterned(benchmark::State& state) {
+    std::vector<int64_t> dims = Dims(state.range(0));
+    for (auto _: state) {
+        Shape shape = Shape::Intern(ShapeView(dims.data(), dims.size()));
+        benchmark::DoNotOptimize(shape);
+    }
+}
+
+void BM_CreateGlobal(benchmark::State& state) {
+    Function fshape = Function::GetGlobalRequired("ffi.Shape");
+    for (auto _: state) {
+        benchmark::DoNotOptimize(fshape(32, 64, 128, 256));
+    }
+}
+
+void BM_CompareSeparate(benchmark::State& state) {
+    std::vector<int64_t> dims = Dims(state.range(0));
+    Shape lhs(dims.begin(), dims.end());
+    Shape rhs(dims.begin(), dims.end());
+    for (auto _: state) {
+        benchmark::DoNotOptimize(StructuralEqual::Equal(lhs, rhs));
+    }
+}
+
+void BM_CompareInterned(benchmark::State& state) {
+    std::vector<int64_t> dims = Dims(state.range(0));
+    Shape lhs = Shape::Intern(ShapeView(dims.data(), dims.size()));
+    Shape rhs = Shape::Intern(ShapeView(dims.data(), dims.size()));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(StructuralEqual::Equal(lhs, rhs));
+    }
+}
+
+void BM_Hash(benchmark::State& state) {
+    std::vector<int64_t> dims = Dims(state.range(0));
+    Shape shape(dims.begin(), dims.end());
+    for (auto _: state) {
+        benchmark::DoNotOptimize(StructuralHash::Hash(shape));
+    }
+}
+
+BENCHMARK(BM_CreateMalloc)->Name("Create/malloc")->DenseRange(2, 4);
+BENCHMARK(BM_CreatePooled)->Name("Create/pooled")->DenseRange(2, 4);
+BENCHMARK(BM_CreateInterned)->Name("Create/interned")->DenseRange(2, 4);
+BENCHMARK(BM_CreateGlobal)->Name("Create/global");
+BENCHMARK(BM_CompareSeparate)->Name("Compare/separate")->DenseRange(2, 4);
+BENCHMARK(BM_CompareInterned)->Name("Compare/interned")->DenseRange(2, 4);
+BENCHMARK(BM_Hash)->Name("Hash")->DenseRange(2, 4);
+
+}// namespace
+
+BENCHMARK_MAIN();
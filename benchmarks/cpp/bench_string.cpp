@@ -0,0 +1,75 @@
+//
+// Created by richard on 10/18/26.
+//
+// Assembling a string from many small pieces.
+//
+// String::operator+ copies the whole prefix on each append, std::ostringstream
+// copies once more when the result is turned into a String, StringBuilder
+// hands its buffer over to the String.
+#include "ffi/string.h"
+#include "ffi/string_builder.h"
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+
+namespace {
+using namespace litetvm::ffi;
+
+constexpr const char* kPiece = "0123456789abcdef";
+
+void BM_ConcatPlus(benchmark::State& state) {
+    for (auto _: state) {
+        String result;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            result = result + kPiece;
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 16);
+}
+
+void BM_ConcatOstringstream(benchmark::State& state) {
+    for (auto _: state) {
+        std::ostringstream os;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            os << kPiece;
+        }
+        String result(os.str());
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 16);
+}
+
+void BM_ConcatStringBuilder(benchmark::State& state) {
+    for (auto _: state) {
+        StringBuilder builder;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            builder << kPiece;
+        }
+        String result = builder.Build();
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 16);
+}
+
+void BM_ConcatBytesRope(benchmark::State& state) {
+    Bytes piece(std::string(4096, 'x'));
+    for (auto _: state) {
+        BytesRope rope;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            rope.Append(piece);
+        }
+        benchmark::DoNotOptimize(rope.size());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 4096);
+}
+
+BENCHMARK(BM_ConcatPlus)->Name("Concat/plus")->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_ConcatOstringstream)->Name("Concat/ostringstream")->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_ConcatStringBuilder)->Name("Concat/string_builder")->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_ConcatBytesRope)->Name("Concat/bytes_rope_4k")->RangeMultiplier(8)->Range(8, 4096);
+
+}// namespace
+
+BENCHMARK_MAIN();
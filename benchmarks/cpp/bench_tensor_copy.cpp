@@ -0,0 +1,117 @@
+//
+// Created by richard on 10/19/26.
+//
+// Bandwidth of CPU tensor copies, as bytes read plus bytes written per second.
+//
+// Memcpy is the bound. Contiguous copies a contiguous tensor, Transpose a float32 matrix
+// with the dims swapped, Broadcast a row to every row of a matrix, Gather every other
+// element of a row. Convert casts contiguous float32 to the given dtype. The argument is
+// the number of float32 elements, 4M elements run on ThreadPool::Global.
+#include "ffi/container/tensor.h"
+#include "ffi/memory.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+
+namespace {
+using namespace litetvm::ffi;
+
+struct CPUNDAlloc {
+    void AllocData(DLTensor* tensor) {
+        tensor->data = details::AlignedAlloc<64>(GetDataSize(*tensor));
+        std::memset(tensor->data, 0, GetDataSize(*tensor));
+    }
+
+    void FreeData(DLTensor* tensor) {
+        details::AlignedFree(tensor->data);
+    }
+};
+
+Tensor Empty(ShapeView shape, DLDataType dtype = DLDataType{kDLFloat, 32, 1}) {
+    return Tensor::FromNDAlloc(CPUNDAlloc(), shape, dtype, DLDevice{kDLCPU, 0});
+}
+
+int64_t Side(const benchmark::State& state) {
+    int64_t side = 1;
+    while (side * side < state.range(0)) {
+        side *= 2;
+    }
+    return side;
+}
+
+void BM_Memcpy(benchmark::State& state) {
+    Tensor src = Empty({state.range(0)});
+    Tensor dst = Empty({state.range(0)});
+    size_t nbytes = GetDataSize(*src.get());
+    for (auto _: state) {
+        std::memcpy(dst->data, src->data, nbytes);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * nbytes * 2);
+}
+
+void BM_Contiguous(benchmark::State& state) {
+    Tensor src = Empty({state.range(0)});
+    Tensor dst = Empty({state.range(0)});
+    for (auto _: state) {
+        src.CopyTo(dst);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 8);
+}
+
+void BM_Transpose(benchmark::State& state) {
+    int64_t side = Side(state);
+    Tensor src = Empty({side, side}).Permute({1, 0});
+    Tensor dst = Empty({side, side});
+    for (auto _: state) {
+        src.CopyTo(dst);
+    }
+    state.SetBytesProcessed(state.iterations() * side * side * 8);
+}
+
+void BM_Broadcast(benchmark::State& state) {
+    int64_t side = Side(state);
+    Tensor src = Empty({1, side});
+    Tensor dst = Empty({side, side});
+    for (auto _: state) {
+        src.CopyTo(dst);
+    }
+    state.SetBytesProcessed(state.iterations() * side * side * 4);
+}
+
+void BM_Gather(benchmark::State& state) {
+    Tensor src = Empty({state.range(0) * 2}).Slice(0, 0, state.range(0) * 2, 2);
+    Tensor dst = Empty({state.range(0)});
+    for (auto _: state) {
+        src.CopyTo(dst);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 8);
+}
+
+template<DLDataTypeCode kCode, int kBits>
+void BM_Convert(benchmark::State& state) {
+    Tensor src = Empty({state.range(0)});
+    Tensor dst = Empty({state.range(0)}, DLDataType{kCode, kBits, 1});
+    for (auto _: state) {
+        src.CopyTo(dst);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * (4 + kBits / 8));
+}
+
+void Sizes(benchmark::internal::Benchmark* bench) {
+    bench->Arg(64 << 10)->Arg(4 << 20);
+}
+
+BENCHMARK(BM_Memcpy)->Name("Memcpy")->Apply(Sizes);
+BENCHMARK(BM_Contiguous)->Name("Contiguous")->Apply(Sizes);
+BENCHMARK(BM_Transpose)->Name("Transpose")->Apply(Sizes);
+BENCHMARK(BM_Broadcast)->Name("Broadcast")->Apply(Sizes);
+BENCHMARK(BM_Gather)->Name("Gather")->Apply(Sizes);
+BENCHMARK(BM_Convert<kDLFloat, 16>)->Name("Convert/float16")->Apply(Sizes);
+BENCHMARK(BM_Convert<kDLBfloat, 16>)->Name("Convert/bfloat16")->Apply(Sizes);
+BENCHMARK(BM_Convert<kDLInt, 32>)->Name("Convert/int32")->Apply(Sizes);
+
+}// namespace
+
+BENCHMARK_MAIN();
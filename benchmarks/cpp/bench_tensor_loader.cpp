@@ -0,0 +1,112 @@
+//
+// Created by richard on 10/19/26.
+//
+// Time to load 16 tensors of 4MB from a raw file with TensorLoader, page cache warm.
+// Bytes per second count the file size over wall time, the reads run on other threads.
+//
+// Load/<io_depth> submits all the tensors and waits for them, the reads are spread over
+// io_depth threads, 0 reads on the calling thread. Pipeline/<io_depth> sums each tensor as
+// soon as it is loaded, overlapping the sums with the reads of the next tensors, and
+// Serial/pread reads and sums the tensors one after the other.
+#include "ffi/extra/tensor_loader.h"
+#include "ffi/memory.h"
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+using namespace litetvm::ffi;
+
+constexpr int64_t kNumTensors = 16;
+constexpr int64_t kTensorElems = 1 << 20;
+constexpr int64_t kTensorBytes = kTensorElems * static_cast<int64_t>(sizeof(float));
+
+const std::string& RawFilePath() {
+    static const std::string path = []() {
+        std::string path = (std::filesystem::temp_directory_path() / "bench_tensor_loader.bin").string();
+        std::vector<float> values(kTensorElems);
+        std::ofstream out(path, std::ios::binary);
+        for (int64_t i = 0; i < kNumTensors; ++i) {
+            std::fill(values.begin(), values.end(), static_cast<float>(i));
+            out.write(reinterpret_cast<const char*>(values.data()), kTensorBytes);
+        }
+        return path;
+    }();
+    return path;
+}
+
+std::vector<TensorLoadRequest> Requests() {
+    std::vector<TensorLoadRequest> requests;
+    for (int64_t i = 0; i < kNumTensors; ++i) {
+        requests.push_back({RawFilePath(), i * kTensorBytes, {kTensorElems}, DLDataType{kDLFloat, 32, 1}});
+    }
+    return requests;
+}
+
+float Sum(const float* data) {
+    return std::accumulate(data, data + kTensorElems, 0.0f);
+}
+
+void BM_Load(benchmark::State& state) {
+    TensorLoader loader(static_cast<int>(state.range(0)));
+    std::vector<TensorLoadRequest> requests = Requests();
+    for (auto _: state) {
+        for (const TensorFuture& future: loader.Submit(requests)) {
+            benchmark::DoNotOptimize(future.Wait()->data);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * kNumTensors * kTensorBytes);
+}
+
+void BM_Pipeline(benchmark::State& state) {
+    TensorLoader loader(static_cast<int>(state.range(0)));
+    std::vector<TensorLoadRequest> requests = Requests();
+    for (auto _: state) {
+        float sum = 0;
+        for (const TensorFuture& future: loader.Submit(requests)) {
+            sum += Sum(static_cast<const float*>(future.Wait()->data));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * kNumTensors * kTensorBytes);
+}
+
+void BM_Serial(benchmark::State& state) {
+    const std::string& path = RawFilePath();
+    float* buffer = static_cast<float*>(details::AlignedAlloc<4096>(kTensorBytes));
+    for (auto _: state) {
+        int fd = open(path.c_str(), O_RDONLY);
+        float sum = 0;
+        for (int64_t i = 0; i < kNumTensors; ++i) {
+            char* data = reinterpret_cast<char*>(buffer);
+            for (int64_t done = 0; done < kTensorBytes;) {
+                ssize_t n = pread(fd, data + done, kTensorBytes - done, i * kTensorBytes + done);
+                if (n <= 0) {
+                    break;
+                }
+                done += n;
+            }
+            sum += Sum(buffer);
+        }
+        close(fd);
+        benchmark::DoNotOptimize(sum);
+    }
+    details::AlignedFree(buffer);
+    state.SetBytesProcessed(state.iterations() * kNumTensors * kTensorBytes);
+}
+
+BENCHMARK(BM_Load)->Name("Load")->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+BENCHMARK(BM_Pipeline)->Name("Pipeline")->Arg(0)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Serial)->Name("Serial/pread")->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}// namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+//
+// Created by richard on 10/19/26.
+//
+// Fingerprinting and deduplicating model weights with TensorStore.
+//
+// Hash/* hashes a 64MB tensor, with TensorStore::Fingerprint or with StableHashBytes, the
+// byte hash of the structural hash. Ingest/* interns 4 variants of a model of 32 tensors of
+// 2MB into a new store, each variant fine-tunes 4 tensors of the base model, in memory or
+// with a backing file. Bytes per second count the tensors interned, dedup_ratio the bytes
+// interned per byte stored.
+#include "ffi/base_details.h"
+#include "ffi/extra/tensor_store.h"
+#include "ffi/memory.h"
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+namespace {
+using namespace litetvm::ffi;
+
+constexpr int64_t kNumTensors = 32;
+constexpr int64_t kTensorElems = 512 * 1024;
+constexpr int64_t kNumVariants = 4;
+constexpr int64_t kTunedPerVariant = 4;
+
+struct CPUNDAlloc {
+    void AllocData(DLTensor* tensor) {
+        tensor->data = details::AlignedAlloc<64>(GetDataSize(*tensor));
+    }
+
+    void FreeData(DLTensor* tensor) {
+        details::AlignedFree(tensor->data);
+    }
+};
+
+Tensor Filled(int64_t numel, float value) {
+    Tensor tensor = Tensor::FromNDAlloc(CPUNDAlloc(), {numel}, DLDataType{kDLFloat, 32, 1}, DLDevice{kDLCPU, 0});
+    std::fill_n(static_cast<float*>(tensor->data), numel, value);
+    return tensor;
+}
+
+// the variants share the tensors of the base model, but for their fine-tuned ones
+const std::vector<std::vector<Tensor>>& Variants() {
+    static const std::vector<std::vector<Tensor>> variants = []() {
+        std::vector<std::vector<Tensor>> variants;
+        for (int64_t v = 0; v < kNumVariants; ++v) {
+            std::vector<Tensor> tensors;
+            for (int64_t i = 0; i < kNumTensors; ++i) {
+                bool tuned = i >= v * kTunedPerVariant && i < (v + 1) * kTunedPerVariant;
+                // separate copies, as when each variant is loaded from its own file
+                tensors.push_back(Filled(kTensorElems, static_cast<float>(i) + (tuned ? 0.5f + v : 0.0f)));
+            }
+            variants.push_back(std::move(tensors));
+        }
+        return variants;
+    }();
+    return variants;
+}
+
+void BM_Fingerprint(benchmark::State& state) {
+    Tensor tensor = Filled(16 << 20, 1.0f);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(TensorStore::Fingerprint(tensor));
+    }
+    state.SetBytesProcessed(state.iterations() * (64 << 20));
+}
+
+void BM_StableHashBytes(benchmark::State& state) {
+    Tensor tensor = Filled(16 << 20, 1.0f);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(details::StableHashBytes(tensor->data, 64 << 20));
+    }
+    state.SetBytesProcessed(state.iterations() * (64 << 20));
+}
+
+void BM_Ingest(benchmark::State& state) {
+    std::string path = (std::filesystem::temp_directory_path() / "bench_tensor_store.bin").string();
+    bool backed = state.range(0) != 0;
+    double dedup_ratio = 0;
+    for (auto _: state) {
+        TensorStore store = backed ? TensorStore::Create(String(path)) : TensorStore::Create();
+        std::vector<Tensor> interned;
+        for (const std::vector<Tensor>& variant: Variants()) {
+            for (const Tensor& tensor: variant) {
+                interned.push_back(store.Intern(tensor));
+            }
+        }
+        dedup_ratio = store->GetStats().DedupRatio();
+    }
+    if (backed) {
+        std::filesystem::remove(path);
+    }
+    state.SetBytesProcessed(state.iterations() * kNumVariants * kNumTensors * kTensorElems * 4);
+    state.counters["dedup_ratio"] = dedup_ratio;
+}
+
+BENCHMARK(BM_Fingerprint)->Name("Hash/fingerprint")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_StableHashBytes)->Name("Hash/stable_hash_bytes")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Ingest)->Name("Ingest/memory")->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Ingest)->Name("Ingest/file")->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}// namespace
+
+BENCHMARK_MAIN();
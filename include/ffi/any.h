@@ -10,6 +10,8 @@
 #include "ffi/type_traits.h"
 
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
 namespace litetvm {
@@ -598,6 +600,16 @@ struct AnyHash {
         }
         return details::StableHashCombine(src.data_.type_index, src.data_.v_uint64);
     }
+    /*!
+   * \brief Calculate the hash code of a string without constructing a String
+   * \param src The string content
+   * \return Hash code of src, same as the hash code of String(src).
+   * \note Only participates for std::string_view so that String and const char* keep going through Any.
+   */
+    template<typename T, typename = std::enable_if_t<std::is_same_v<T, std::string_view>>>
+    uint64_t operator()(const T& src) const {
+        return details::StableHashCombine(kTVMFFIStr, details::StableHashBytes(src.data(), src.size()));
+    }
 };
 
 /*! \brief String-aware Any hash functor */
@@ -659,6 +671,28 @@ struct AnyEqual {
         }
         return false;
     }
+    /*!
+   * \brief Check if an Any holds a string equal to the given content
+   * \param lhs left operand.
+   * \param rhs right operand, the string content
+   * \return Whether lhs is a string with the same content as rhs.
+   */
+    template<typename T, typename = std::enable_if_t<std::is_same_v<T, std::string_view>>>
+    bool operator()(const Any& lhs, const T& rhs) const {
+        if (lhs.data_.type_index == kTVMFFISmallStr) {
+            return Bytes::memequal(lhs.data_.v_bytes, rhs.data(), lhs.data_.small_str_len, rhs.size());
+        }
+        if (lhs.data_.type_index == kTVMFFIStr) {
+            const details::BytesObjBase* lhs_str =
+                    details::AnyUnsafe::CopyFromAnyViewAfterCheck<const details::BytesObjBase*>(lhs);
+            return Bytes::memequal(lhs_str->data, rhs.data(), lhs_str->size, rhs.size());
+        }
+        return false;
+    }
+    template<typename T, typename = std::enable_if_t<std::is_same_v<T, std::string_view>>>
+    bool operator()(const T& lhs, const Any& rhs) const {
+        return (*this)(rhs, lhs);
+    }
 };
 
 }// namespace ffi
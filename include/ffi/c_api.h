@@ -151,6 +151,26 @@ typedef enum {
    * \sa TVMFFIObjectCreateOpaque
    */
     kTVMFFIOpaquePyObject = 74,
+    /*!
+   * \brief Array of unboxed POD elements,
+   *        layout = { TVMFFIObject, DLDataType, int64_t size, void* data, ... }
+   */
+    kTVMFFIPODArray = 75,
+    /*!
+   * \brief Persistent array, a 32-way trie with structural sharing between versions.
+   *        Nodes are internal objects and only accessible through the C++ API.
+   */
+    kTVMFFIPersistentArray = 76,
+    /*!
+   * \brief Persistent hash map, a hash array mapped trie with structural sharing
+   *        between versions. Nodes are internal objects and only accessible through the C++ API.
+   */
+    kTVMFFIPersistentMap = 77,
+    /*!
+   * \brief Hash map shared by all its handles and safe for concurrent reads and writes,
+   *        no copy-on-write.
+   */
+    kTVMFFIConcurrentMap = 78,
     kTVMFFIStaticObjectEnd,
     // [Section] Dynamic Boxed: [kTVMFFIDynObjectBegin, +oo)
     /*! \brief Start of type indices that are allocated at runtime. */
@@ -351,6 +371,11 @@ struct TVMFFIErrorCell {
    *
    * When printing out, we encourage reverse the order of lines to make it
    * align with python style.
+   *
+   * \note Errors thrown by TVM_FFI_THROW keep the raw program counters and symbolize
+   * them on first access, until then this field is empty. Readers of the cell must call
+   * update_backtrace with an empty backtrace in append mode to populate it before reading.
+   * The C++ accessors of Error do so.
    */
     TVMFFIByteArray backtrace;
 
@@ -364,6 +389,27 @@ struct TVMFFIErrorCell {
     void (*update_backtrace)(TVMFFIObjectHandle self, const TVMFFIByteArray* backtrace, int32_t update_mode);
 };
 
+/*!
+ * \brief Maximum number of program counters kept in a raw traceback.
+ */
+#define TVM_FFI_RAW_TRACEBACK_MAX_FRAMES 128
+
+/*!
+ * \brief Traceback captured at the throw site before symbolization.
+ */
+typedef struct {
+    /*! \brief The file name of the throw site. */
+    const char* filename;
+    /*! \brief The function of the throw site. */
+    const char* func;
+    /*! \brief The line number of the throw site. */
+    int32_t lineno;
+    /*! \brief Number of valid entries in pcs. */
+    int32_t num_frames;
+    /*! \brief Program counters in the order of recent call first. */
+    uintptr_t pcs[TVM_FFI_RAW_TRACEBACK_MAX_FRAMES];
+} TVMFFIRawTraceback;
+
 /*!
  * \brief Type that defines C-style safe call convention
  *
@@ -545,6 +591,12 @@ TVM_FFI_DLL void TVMFFIErrorSetRaised(TVMFFIObjectHandle error);
      */
 TVM_FFI_DLL void TVMFFIErrorSetRaisedFromCStr(const char* kind, const char* message);
 
+/*!
+ * \brief Set the preallocated MemoryError as the raised error in TLS.
+ * \note Unlike the other setters this function never allocates, it is meant for out-of-memory paths.
+ */
+TVM_FFI_DLL void TVMFFIErrorSetRaisedOutOfMemory();
+
 /*!
  * \brief Set a raised error in TLS, which can be fetched by TVMFFIErrorMoveFromRaised.
  *
@@ -577,12 +629,12 @@ TVM_FFI_DLL void TVMFFIErrorSetRaisedFromCStrParts(const char* kind, const char*
  * \param message The error message.
  * \param backtrace The backtrace of the error.
  * \param out The output error object handle.
- * \return 0 on success, nonzero on failure(likely MemoryError)
+ * \return 0 on success, -1 when memory runs out.
  *
  * \note This function is different from other functions as it is used in the error handling loop.
- *       So we do not follow normal error handling patterns. When error happens it will not set
- *       the error in TLS (since TLS error setting also involves creating an Error object).
- *       Instead, caller should simply report MemoryError to the logger.
+ *       So we do not follow normal error handling patterns. When memory runs out it does not set
+ *       the error in TLS, instead out is set to a new reference of the preallocated MemoryError
+ *       so the caller still has an error to report.
  */
 TVM_FFI_DLL int TVMFFIErrorCreate(const TVMFFIByteArray* kind, const TVMFFIByteArray* message,
                                   const TVMFFIByteArray* backtrace, TVMFFIObjectHandle* out);
@@ -678,6 +730,40 @@ The content of string can be accessed via TVMFFIObjectGetByteArrayPtr.
 */
 TVM_FFI_DLL int TVMFFIDataTypeToString(const DLDataType* dtype, TVMFFIAny* out);
 
+//---------------------------------------------------------------
+// Section: function profiler support APIs.
+// These APIs back the opt-in per-function call profiler.
+//---------------------------------------------------------------
+
+/*!
+ * \brief Mark that argument conversion of the innermost profiled call on this thread is done.
+ * \note Typed function wrappers call this between argument conversion and the function body,
+ *       it is a no-op when there is no profiled call in flight.
+ */
+TVM_FFI_DLL void TVMFFIProfilerMarkArgsConverted();
+
+/*!
+ * \brief Record the calls of a function under the given name while the profiler runs.
+ * \param name The name used to report the function.
+ * \param func The function to be tracked.
+ * \return 0 on success, nonzero on failure.
+ * \note The check sits in the call path of functions created from C++ callables, so
+ *       references fetched before the profiler starts are recorded as well. Functions
+ *       backed by a foreign safe_call are not recorded, use TVMFFIProfilerWrapFunction.
+ */
+TVM_FFI_DLL int TVMFFIProfilerTrackFunction(const TVMFFIByteArray* name, TVMFFIObjectHandle func);
+
+/*!
+ * \brief Wrap a function so that its calls are recorded under the given name.
+ * \param name The name used to report the function.
+ * \param func The function to be wrapped.
+ * \param out The wrapped function.
+ * \return 0 on success, nonzero on failure.
+ * \note The wrapper forwards directly to func when profiling is off.
+ */
+TVM_FFI_DLL int TVMFFIProfilerWrapFunction(const TVMFFIByteArray* name, TVMFFIObjectHandle func,
+                                           TVMFFIObjectHandle* out);
+
 //------------------------------------------------------------
 // Section: Type reflection support APIs
 //
@@ -1071,6 +1157,29 @@ TVM_FFI_DLL const TVMFFITypeAttrColumn* TVMFFIGetTypeAttrColumn(const TVMFFIByte
      */
 TVM_FFI_DLL const TVMFFIByteArray* TVMFFITraceback(const char* filename, int lineno, const char* func);
 
+/*!
+     * \brief Capture the raw program counters of the current stack without symbolizing them.
+     * \param filename The current file name, must have static storage duration.
+     * \param lineno The current line number
+     * \param func The current function, must have static storage duration.
+     * \param out The raw traceback, starting at the caller of this function, owned by the caller.
+     *
+     * \note This function only unwinds the stack, use TVMFFITracebackSymbolize
+     * to turn the result into the same string returned by TVMFFITraceback.
+     */
+TVM_FFI_DLL void TVMFFITracebackCaptureRaw(const char* filename, int lineno, const char* func,
+                                           TVMFFIRawTraceback* out);
+
+/*!
+     * \brief Symbolize a raw traceback captured by TVMFFITracebackCaptureRaw.
+     * \param raw The raw traceback.
+     * \return The traceback string, valid until the next call on the same thread.
+     *
+     * \note Symbols are cached by program counter, so symbolizing the same
+     * throw site again only formats the cached frames.
+     */
+TVM_FFI_DLL const TVMFFIByteArray* TVMFFITracebackSymbolize(const TVMFFIRawTraceback* raw);
+
 /*!
      * \brief Initialize the type info during runtime.
      * When the function is first called for a type,
@@ -12,6 +12,8 @@
 #include "ffi/optional.h"
 
 #include <algorithm>
+#include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -298,6 +300,9 @@ private:
     template<typename, typename>
     friend class Array;
 
+    template<typename, typename>
+    friend class ArrayBuilder;
+
     template<typename... Types>
     friend class Tuple;
 
@@ -308,6 +313,91 @@ private:
     friend ObjectPtr<ArrayObj> make_object<>();
 };
 
+/*!
+ * \brief Array object that stores POD elements unboxed.
+ *
+ * The elements follow the object in the same allocation, see PODArray for the typed reference.
+ */
+class PODArrayObj : public Object {
+public:
+    /*! \brief The element type, one of int64, float64 and bool. */
+    DLDataType dtype;
+    /*! \brief The number of elements. */
+    int64_t size;
+    /*! \brief Pointer to the first element. */
+    void* data;
+
+    /*!
+   * \brief Visit the elements as a typed span.
+   * \param fvisit The visitor, called with std::span<const T> of the element type.
+   * \return The result of the visitor.
+   */
+    template<typename FVisit>
+    decltype(auto) VisitSpan(FVisit fvisit) const {
+        switch (dtype.code) {
+            case kDLInt:
+                return fvisit(std::span<const int64_t>(static_cast<const int64_t*>(data), size));
+            case kDLFloat:
+                return fvisit(std::span<const double>(static_cast<const double*>(data), size));
+            default:
+                return fvisit(std::span<const bool>(static_cast<const bool*>(data), size));
+        }
+    }
+
+    /*!
+   * \brief Read i-th element as Any.
+   * \param i The index
+   * \return the i-th element.
+   */
+    NODISCARD Any at(int64_t i) const {
+        if (i < 0 || i >= size) {
+            TVM_FFI_THROW(IndexError) << "Index " << i << " out of bounds " << size;
+        }
+        return VisitSpan([i](auto elems) { return Any(elems[i]); });
+    }
+
+    static constexpr int32_t _type_index = kTVMFFIPODArray;
+    static constexpr bool _type_final = true;
+    TVM_FFI_DECLARE_OBJECT_INFO_STATIC(StaticTypeKey::kTVMFFIPODArray, PODArrayObj, Object);
+};
+
+namespace details {
+/*!
+ * \brief Element types supported by PODArrayObj.
+ */
+template<typename T>
+struct PODArrayElemTraits {
+    static constexpr bool enabled = false;
+};
+
+template<>
+struct PODArrayElemTraits<int64_t> {
+    static constexpr bool enabled = true;
+    static constexpr DLDataType dtype = {kDLInt, 64, 1};
+    static bool Match(DLDataType other) {
+        return other.code == dtype.code && other.bits == dtype.bits && other.lanes == 1;
+    }
+};
+
+template<>
+struct PODArrayElemTraits<double> {
+    static constexpr bool enabled = true;
+    static constexpr DLDataType dtype = {kDLFloat, 64, 1};
+    static bool Match(DLDataType other) {
+        return other.code == dtype.code && other.bits == dtype.bits && other.lanes == 1;
+    }
+};
+
+template<>
+struct PODArrayElemTraits<bool> {
+    static constexpr bool enabled = true;
+    static constexpr DLDataType dtype = {kDLBool, 8, 1};
+    static bool Match(DLDataType other) {
+        return other.code == dtype.code && other.bits == dtype.bits && other.lanes == 1;
+    }
+};
+}// namespace details
+
 /*! \brief Helper struct for type-checking
  *
  * is_valid_iterator<T, IterType>::value will be true if IterType can
@@ -587,6 +677,93 @@ public:
                 ->InitRange(idx, first, last);
     }
 
+    /*!
+   * \brief Append a range of elements to the back of the array.
+   * \param first The begin iterator of the range
+   * \param last The end iterator of the range
+   * \note For forward iterators the container grows at most once, to exactly
+   *  the required capacity. The range must not point into this array.
+   */
+    template<typename Iter>
+    void Extend(Iter first, Iter last) {
+        static_assert(is_valid_iterator_v<T, Iter>, "Iter cannot be inserted into a Array<T>");
+        using category = typename std::iterator_traits<Iter>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+            int64_t numel = std::distance(first, last);
+            if (numel <= 0) {
+                return;
+            }
+            ArrayObj* p = CopyOnWriteExact(numel);
+            Any* itr = p->MutableEnd();
+            // To ensure exception safety, size is only incremented after the initialization succeeds
+            for (; first != last; ++first, ++itr) {
+                new (itr) Any(*first);
+                ++p->size_;
+            }
+        } else {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+    }
+
+    /*!
+   * \brief Append all elements of a range to the back of the array.
+   * \param range The range to be appended.
+   */
+    template<typename Range, typename = std::enable_if_t<!std::is_base_of_v<ObjectRef, Range>>>
+    void Extend(const Range& range) {
+        Extend(std::begin(range), std::end(range));
+    }
+
+    /*!
+   * \brief Append all elements of another array to the back of the array.
+   * \param other The array to be appended, can be this array itself.
+   */
+    template<typename U, typename = std::enable_if_t<details::type_contains_v<T, U>>>
+    void Extend(Array<U> other) {
+        // other holds a reference, so appending an array to itself copies instead of moving
+        Extend(other.begin(), other.end());
+    }
+
+    /*!
+   * \brief Remove all elements that satisfy the predicate.
+   * \param fpred The predicate T -> bool.
+   * \return The number of removed elements.
+   * \note Elements are compacted in place when the array is uniquely owned,
+   *  otherwise only the remaining elements are copied. The predicate runs on
+   *  every element before any is moved, so the array is unchanged if it throws.
+   */
+    template<typename F>
+    int64_t EraseIf(F fpred) {
+        ArrayObj* p = GetArrayObj();
+        if (p == nullptr || p->size_ == 0) {
+            return 0;
+        }
+        int64_t size = p->size_;
+        if (!data_.unique()) {
+            data_ = FilterHelper(data_, [&fpred](const T& value) { return !fpred(value); });
+            return size - GetArrayObj()->size_;
+        }
+        Any* begin = p->MutableBegin();
+        std::vector<bool> keep(size);
+        int64_t num_kept = 0;
+        for (int64_t i = 0; i < size; ++i) {
+            keep[i] = !fpred(details::AnyUnsafe::CopyFromAnyViewAfterCheck<T>(begin[i]));
+            num_kept += keep[i];
+        }
+        for (int64_t i = 0, j = 0; i < size; ++i) {
+            if (keep[i]) {
+                if (j != i) {
+                    begin[j] = std::move(begin[i]);
+                }
+                ++j;
+            }
+        }
+        p->ShrinkBy(size - num_kept);
+        return size - num_kept;
+    }
+
     /*! \brief Remove the last item of the list */
     void pop_back() {
         if (data_ == nullptr) {
@@ -773,6 +950,20 @@ public:
         data_ = MapHelper(std::move(data_), fmutate);
     }
 
+    /*!
+   * \brief Select the elements that satisfy the predicate.
+   * \param fpred The predicate T -> bool.
+   * \return The filtered array. If every element is kept, the result shares
+   *  the container of this array.
+   */
+    template<typename F, typename = std::enable_if_t<std::is_convertible_v<std::invoke_result_t<F, T>, bool>>>
+    Array<T> Filter(F fpred) const {
+        if (data_ == nullptr) {
+            return *this;
+        }
+        return Array<T>(FilterHelper(data_, fpred));
+    }
+
     /*!
    * \brief reset the array to content from iterator.
    * \param first begin of iterator
@@ -857,6 +1048,22 @@ private:
         return SwitchContainer(cap);
     }
 
+    /*!
+   * \brief Copy on write with exactly enough capacity for the extra elements.
+   * \param reserve_extra Number of extra slots needed
+   * \return ArrayObj pointer to the unique copy
+   */
+    ArrayObj* CopyOnWriteExact(int64_t reserve_extra) {
+        ArrayObj* p = GetArrayObj();
+        if (p == nullptr) {
+            return SwitchContainer(reserve_extra);
+        }
+        if (p->capacity_ >= p->size_ + reserve_extra) {
+            return CopyOnWrite();
+        }
+        return SwitchContainer(p->size_ + reserve_extra);
+    }
+
     /*!
    * \brief Move or copy the ArrayObj to new address with the given capacity
    * \param capacity The capacity requirement of the new address
@@ -872,6 +1079,43 @@ private:
         return static_cast<ArrayObj*>(data_.get());
     }
 
+    /*!
+   * \brief Helper method for Filter/EraseIf.
+   * \param data The input container, kept unchanged.
+   * \param fpred The predicate, elements that satisfy it are kept.
+   * \return data itself if all elements are kept, otherwise a new container.
+   */
+    template<typename F>
+    static ObjectPtr<Object> FilterHelper(const ObjectPtr<Object>& data, F fpred) {
+        auto* arr = static_cast<ArrayObj*>(data.get());
+        const Any* begin = arr->begin();
+        int64_t size = arr->size_;
+        int64_t first_removed = 0;
+        while (first_removed < size &&
+               fpred(details::AnyUnsafe::CopyFromAnyViewAfterCheck<T>(begin[first_removed]))) {
+            ++first_removed;
+        }
+        if (first_removed == size) {
+            return data;
+        }
+        // decide the rest first so the output is allocated at its final size
+        std::vector<bool> keep(size - first_removed);
+        int64_t num_kept = first_removed;
+        for (int64_t i = first_removed + 1; i < size; ++i) {
+            keep[i - first_removed] = fpred(details::AnyUnsafe::CopyFromAnyViewAfterCheck<T>(begin[i]));
+            num_kept += keep[i - first_removed];
+        }
+        ObjectPtr<ArrayObj> output = ArrayObj::Empty(num_kept);
+        Any* itr = output->MutableBegin();
+        for (int64_t i = 0; i < size; ++i) {
+            if (i < first_removed || (i > first_removed && keep[i - first_removed])) {
+                new (itr++) Any(begin[i]);
+                ++output->size_;
+            }
+        }
+        return output;
+    }
+
     /*! \brief Helper method for mutate/map
    *
    * A helper function used internally by both `Array::Map` and
@@ -1008,12 +1252,118 @@ private:
 template<typename T,
          typename = std::enable_if_t<std::is_same_v<T, Any> || TypeTraits<T>::convert_enabled>>
 Array<T> Concat(Array<T> lhs, const Array<T>& rhs) {
-    for (const auto& x: rhs) {
-        lhs.push_back(x);
-    }
-    return std::move(lhs);
+    lhs.Extend(rhs);
+    return lhs;
 }
 
+/*!
+ * \brief Move-only builder that fills an ArrayObj in place.
+ *
+ * The builder is the sole owner of the container while it is being filled, so
+ * appending skips the copy-on-write checks of Array::push_back. Build() hands
+ * the container over to an Array without copying it.
+ *
+ * \code
+ *   ArrayBuilder<int64_t> builder(n);
+ *   for (int64_t i = 0; i < n; ++i) {
+ *       builder.push_back(i * i);
+ *   }
+ *   Array<int64_t> squares = std::move(builder).Build();
+ * \endcode
+ *
+ * \tparam T The element type of the resulting Array.
+ */
+template<typename T, typename = std::enable_if_t<details::storage_enabled_v<T>>>
+class ArrayBuilder {
+public:
+    /*!
+   * \brief Create a builder.
+   * \param capacity The initial capacity.
+   */
+    explicit ArrayBuilder(int64_t capacity = ArrayObj::kInitSize) : data_(ArrayObj::Empty(capacity)) {}
+
+    ArrayBuilder(ArrayBuilder&&) noexcept = default;
+    ArrayBuilder& operator=(ArrayBuilder&&) noexcept = default;
+    ArrayBuilder(const ArrayBuilder&) = delete;
+    ArrayBuilder& operator=(const ArrayBuilder&) = delete;
+
+    /*! \return The number of elements appended so far. */
+    NODISCARD int64_t size() const {
+        return data_ == nullptr ? 0 : data_->size_;
+    }
+
+    /*! \return The capacity of the container being built. */
+    NODISCARD int64_t capacity() const {
+        return data_ == nullptr ? 0 : data_->capacity_;
+    }
+
+    /*! \return Whether no element has been appended. */
+    NODISCARD bool empty() const {
+        return size() == 0;
+    }
+
+    /*!
+   * \brief Make sure the container has the capacity of at least n.
+   * \param n lower bound of the capacity
+   */
+    void reserve(int64_t n) {
+        if (n > capacity()) {
+            Grow(n);
+        }
+    }
+
+    /*!
+   * \brief Append an element.
+   * \param item The element.
+   */
+    void push_back(const T& item) {
+        EnsureSpace()->EmplaceInit(data_->size_, item);
+        ++data_->size_;
+    }
+
+    void push_back(T&& item) {
+        EnsureSpace()->EmplaceInit(data_->size_, std::move(item));
+        ++data_->size_;
+    }
+
+    /*!
+   * \brief Construct an element in place at the back.
+   * \param args The arguments to construct T.
+   */
+    template<typename... Args>
+    void emplace_back(Args&&... args) {
+        EnsureSpace()->EmplaceInit(data_->size_, T(std::forward<Args>(args)...));
+        ++data_->size_;
+    }
+
+    /*!
+   * \brief Finish building and return the array.
+   * \return The array that owns the built container.
+   * \note The builder is empty afterwards and can be reused.
+   */
+    Array<T> Build() && {
+        if (data_ == nullptr) {
+            return Array<T>();
+        }
+        return Array<T>(ObjectPtr<Object>(std::move(data_)));
+    }
+
+private:
+    ArrayObj* EnsureSpace() {
+        if (data_ == nullptr || data_->size_ == data_->capacity_) {
+            Grow(std::max(ArrayObj::kInitSize, capacity() * ArrayObj::kIncFactor));
+        }
+        return data_.get();
+    }
+
+    void Grow(int64_t capacity) {
+        data_ = data_ == nullptr ? ArrayObj::Empty(capacity) : ArrayObj::MoveFrom(capacity, data_.get());
+    }
+
+    /*! \brief The container being built, always uniquely owned. */
+    ObjectPtr<ArrayObj> data_;
+};
+
 // Specialize make_object<ArrayObj> to make sure it is correct.
 template<>
 inline ObjectPtr<ArrayObj> make_object() {
@@ -1021,6 +1371,32 @@ inline ObjectPtr<ArrayObj> make_object() {
 }
 
 // Traits for Array
+namespace details {
+/*!
+ * \brief Box the elements of a PODArrayObj into an Array<T>.
+ * \param n The unboxed array.
+ * \return The boxed array, std::nullopt if an element cannot be converted to T.
+ */
+template<typename T>
+std::optional<Array<T>> ArrayFromPODArray(const PODArrayObj* n) {
+    return n->VisitSpan([](auto elems) -> std::optional<Array<T>> {
+        using ElemType = typename decltype(elems)::value_type;
+        Array<T> result;
+        result.reserve(static_cast<int64_t>(elems.size()));
+        for (ElemType v: elems) {
+            if constexpr (std::is_same_v<T, Any> || std::is_same_v<T, ElemType>) {
+                result.push_back(v);
+            } else if (auto opt_v = AnyView(v).try_cast<T>()) {
+                result.push_back(*std::move(opt_v));
+            } else {
+                return std::nullopt;
+            }
+        }
+        return result;
+    });
+}
+}// namespace details
+
 template<typename T>
 inline constexpr bool use_default_type_traits_v<Array<T>> = false;
 
@@ -1064,6 +1440,10 @@ struct TypeTraits<Array<T>> : ObjectRefTypeTraitsBase<Array<T>> {
     }
 
     TVM_FFI_INLINE static std::optional<Array<T>> TryCastFromAnyView(const TVMFFIAny* src) {
+        // unboxed arrays are boxed element by element
+        if (src->type_index == kTVMFFIPODArray) {
+            return details::ArrayFromPODArray<T>(reinterpret_cast<const PODArrayObj*>(src->v_obj));
+        }
         // try to run conversion.
         if (src->type_index != kTVMFFIArray) {
             return std::nullopt;
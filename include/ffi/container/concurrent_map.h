@@ -0,0 +1,375 @@
+//
+// Created by richard on 10/19/26.
+//
+
+#ifndef LITETVM_FFI_CONTAINER_CONCURRENT_MAP_H
+#define LITETVM_FFI_CONTAINER_CONCURRENT_MAP_H
+
+#include "ffi/any.h"
+#include "ffi/container/container_details.h"
+#include "ffi/container/map.h"
+#include "ffi/error.h"
+#include "ffi/function.h"
+#include "ffi/memory.h"
+#include "ffi/object.h"
+#include "ffi/type_traits.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace litetvm {
+namespace ffi {
+
+/*!
+ * \brief Hash map content that can be read and written from multiple threads.
+ *
+ * Entries are spread over kNumShards shards by key hash, each a MapObj guarded
+ * by its own reader-writer lock, so readers of different shards never contend
+ * and readers of the same shard only share the lock. Keys are hashed and
+ * compared with AnyHash and AnyEqual, like MapObj.
+ *
+ * Unlike Map there is no copy-on-write: all handles share the same content.
+ */
+class ConcurrentMapObj : public Object {
+public:
+    /*! \brief Number of shards, a power of two. */
+    static constexpr size_t kNumShards = 64;
+
+    /*!
+   * \brief Get the value of a key.
+   * \param key The key.
+   * \return The value, std::nullopt if the key is absent or still being computed.
+   */
+    std::optional<Any> Get(const Any& key) const {
+        const Shard& shard = ShardOf(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return Lookup(shard, key);
+    }
+
+    /*!
+   * \brief Insert or overwrite an entry.
+   * \param key The key.
+   * \param value The value.
+   */
+    void Set(const Any& key, const Any& value) {
+        Shard& shard = ShardOf(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.entries.Set(key, value);
+    }
+
+    /*!
+   * \brief Get the value of a key, computing and inserting it when absent.
+   *
+   * The factory runs without holding any shard lock and at most once per key:
+   * concurrent callers of the same key wait for the first one. If the factory
+   * throws, the error propagates and the next caller retries. An entry Set while
+   * the factory runs takes precedence over the computed value.
+   *
+   * The factory must not call GetOrInsert with the same key, the call would wait
+   * for itself. Such a reentrant call throws RuntimeError instead.
+   *
+   * \param key The key.
+   * \param factory Function that takes the key and returns the value.
+   * \return The value associated with the key.
+   */
+    template<typename FCreate>
+    Any GetOrInsert(const Any& key, FCreate factory) {
+        Shard& shard = ShardOf(key);
+        std::shared_ptr<Pending> pending;
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            if (std::optional<Any> value = Lookup(shard, key)) {
+                return *std::move(value);
+            }
+            if (auto it = shard.pending.find(key); it != shard.pending.end()) {
+                pending = it->second;
+            }
+        }
+        if (pending == nullptr) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            if (std::optional<Any> value = Lookup(shard, key)) {
+                return *std::move(value);
+            }
+            auto [it, inserted] = shard.pending.try_emplace(key, nullptr);
+            if (inserted) {
+                it->second = std::make_shared<Pending>();
+            }
+            pending = it->second;
+        }
+        if (pending->owner.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+            TVM_FFI_THROW(RuntimeError) << "ConcurrentMap: GetOrInsert called from the factory of the same key";
+        }
+        std::call_once(pending->once, [&] {
+            pending->owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+            Any value;
+            try {
+                value = factory(key);
+            } catch (...) {
+                // the key must not stay pending, the next caller starts over
+                pending->owner.store(std::thread::id(), std::memory_order_relaxed);
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                ErasePending(shard, key, pending);
+                throw;
+            }
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            if (std::optional<Any> existing = Lookup(shard, key)) {
+                value = *std::move(existing);
+            } else {
+                shard.entries.Set(key, value);
+            }
+            ErasePending(shard, key, pending);
+            pending->value = std::move(value);
+            pending->owner.store(std::thread::id(), std::memory_order_relaxed);
+        });
+        return pending->value;
+    }
+
+    /*!
+   * \brief Erase an entry.
+   * \param key The key.
+   * \return Whether the key was present.
+   */
+    bool Erase(const Any& key) {
+        Shard& shard = ShardOf(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        size_t size = shard.entries.size();
+        shard.entries.erase(key);
+        return shard.entries.size() != size;
+    }
+
+    /*! \brief Remove all entries. */
+    void clear() {
+        for (Shard& shard: shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.entries.clear();
+        }
+    }
+
+    /*!
+   * \return The number of entries, the ones still being computed are not counted.
+   * \note The result is a snapshot when other threads are writing.
+   */
+    NODISCARD size_t size() const {
+        size_t size = 0;
+        for (const Shard& shard: shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            size += shard.entries.size();
+        }
+        return size;
+    }
+
+    /*!
+   * \brief Visit all entries, one shard at a time.
+   * \param fvisit Callback that takes the key and the value.
+   * \note fvisit runs under the shard's read lock and must not modify the map.
+   */
+    template<typename FVisit>
+    void ForEach(FVisit fvisit) const {
+        for (const Shard& shard: shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (const auto& [key, value]: shard.entries) {
+                fvisit(key, value);
+            }
+        }
+    }
+
+    static constexpr int32_t _type_index = kTVMFFIConcurrentMap;
+    static constexpr bool _type_final = true;
+    TVM_FFI_DECLARE_OBJECT_INFO_STATIC(StaticTypeKey::kTVMFFIConcurrentMap, ConcurrentMapObj, Object);
+
+private:
+    /*! \brief A GetOrInsert whose factory has not returned yet. */
+    struct Pending {
+        std::once_flag once;
+        Any value;
+        // thread running the factory, to detect reentrant calls
+        std::atomic<std::thread::id> owner{std::thread::id()};
+    };
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        Map<Any, Any> entries;
+        std::unordered_map<Any, std::shared_ptr<Pending>, AnyHash, AnyEqual> pending;
+    };
+
+    /*! \brief Find a key in a shard, the caller holds the shard lock. */
+    static std::optional<Any> Lookup(const Shard& shard, const Any& key) {
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return std::nullopt;
+        }
+        return (*it).second;
+    }
+
+    /*! \brief Remove the pending entry of a key if it is still this one, the caller holds the shard lock. */
+    static void ErasePending(Shard& shard, const Any& key, const std::shared_ptr<Pending>& pending) {
+        auto it = shard.pending.find(key);
+        if (it != shard.pending.end() && it->second == pending) {
+            shard.pending.erase(it);
+        }
+    }
+
+    Shard& ShardOf(const Any& key) {
+        return shards_[Mix(AnyHash()(key)) & (kNumShards - 1)];
+    }
+
+    const Shard& ShardOf(const Any& key) const {
+        return shards_[Mix(AnyHash()(key)) & (kNumShards - 1)];
+    }
+
+    /*! \brief Spread the hash bits, AnyHash of pointers leaves the low bits mostly unused. */
+    static uint64_t Mix(uint64_t hash) {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    Shard shards_[kNumShards];
+};
+
+/*!
+ * \brief Thread-safe hash map shared by all its handles.
+ *
+ * Keys and values are checked when they are read back, the map itself is not
+ * scanned when it is converted from Any.
+ *
+ * \tparam K The key type.
+ * \tparam V The value type.
+ */
+template<typename K, typename V,
+         typename = std::enable_if_t<details::storage_enabled_v<K> && details::storage_enabled_v<V>>>
+class ConcurrentMap : public ObjectRef {
+public:
+    using key_type = K;
+    using mapped_type = V;
+
+    /*! \brief Create an empty map. */
+    ConcurrentMap() : ObjectRef(make_object<ConcurrentMapObj>()) {}
+
+    /*! \return The value associated with the key, std::nullopt if not found */
+    std::optional<V> Get(const K& key) const {
+        std::optional<Any> value = get()->Get(key);
+        if (!value.has_value()) {
+            return std::nullopt;
+        }
+        return CastValue(*std::move(value));
+    }
+
+    /*!
+   * \brief Insert or overwrite an entry.
+   * \param key The key.
+   * \param value The value.
+   */
+    void Set(const K& key, const V& value) const {
+        GetMapObj()->Set(Any(key), Any(value));
+    }
+
+    /*!
+   * \brief Get the value of a key, computing and inserting it when absent.
+   * \param key The key.
+   * \param factory Callable K -> V, runs at most once per key.
+   * \return The value associated with the key.
+   */
+    template<typename FCreate, typename = std::enable_if_t<std::is_invocable_v<FCreate, K>>>
+    V GetOrInsert(const K& key, FCreate factory) const {
+        return CastValue(GetMapObj()->GetOrInsert(Any(key), [&factory](const Any& k) -> Any {
+            return Any(factory(details::AnyUnsafe::CopyFromAnyViewAfterCheck<K>(k)));
+        }));
+    }
+
+    /*!
+   * \brief Get the value of a key, computing and inserting it when absent.
+   * \param key The key.
+   * \param factory FFI function that takes the key and returns the value.
+   * \return The value associated with the key.
+   */
+    V GetOrInsert(const K& key, const Function& factory) const {
+        return CastValue(GetMapObj()->GetOrInsert(Any(key), [&factory](const Any& k) -> Any { return factory(k); }));
+    }
+
+    /*!
+   * \brief Erase the entry of a key.
+   * \param key The key.
+   * \return Whether the key was present.
+   */
+    bool erase(const K& key) const {
+        return GetMapObj()->Erase(Any(key));
+    }
+
+    /*! \return The number of entries */
+    NODISCARD size_t size() const {
+        return get()->size();
+    }
+
+    /*! \return whether the map is empty */
+    NODISCARD bool empty() const {
+        return size() == 0;
+    }
+
+    /*! \brief Remove all entries. */
+    void clear() const {
+        GetMapObj()->clear();
+    }
+
+    TVM_FFI_DEFINE_OBJECT_REF_METHODS_NOTNULLABLE(ConcurrentMap, ObjectRef, ConcurrentMapObj);
+
+private:
+    static V CastValue(Any value) {
+        if constexpr (std::is_same_v<V, Any>) {
+            return value;
+        } else {
+            return std::move(value).template cast<V>();
+        }
+    }
+
+    ConcurrentMapObj* GetMapObj() const {
+        return static_cast<ConcurrentMapObj*>(data_.get());
+    }
+};
+
+template<typename K, typename V>
+inline constexpr bool use_default_type_traits_v<ConcurrentMap<K, V>> = false;
+
+// the content is only checked when it is read, scanning it would need to lock every shard
+template<typename K, typename V>
+struct TypeTraits<ConcurrentMap<K, V>> : public ObjectRefTypeTraitsBase<ConcurrentMap<K, V>> {
+    static constexpr int32_t field_static_type_index = TypeIndex::kTVMFFIConcurrentMap;
+    using ObjectRefTypeTraitsBase<ConcurrentMap<K, V>>::CopyFromAnyViewAfterCheck;
+
+    TVM_FFI_INLINE static bool CheckAnyStrict(const TVMFFIAny* src) {
+        return src->type_index == TypeIndex::kTVMFFIConcurrentMap;
+    }
+
+    TVM_FFI_INLINE static std::optional<ConcurrentMap<K, V>> TryCastFromAnyView(const TVMFFIAny* src) {
+        if (!CheckAnyStrict(src)) return std::nullopt;
+        return CopyFromAnyViewAfterCheck(src);
+    }
+
+    TVM_FFI_INLINE static std::string TypeStr() {
+        return "ConcurrentMap<" + details::Type2Str<K>::v() + ", " + details::Type2Str<V>::v() + ">";
+    }
+
+    TVM_FFI_INLINE static std::string TypeSchema() {
+        std::ostringstream oss;
+        oss << R"({"type":")" << StaticTypeKey::kTVMFFIConcurrentMap << R"(","args":[)";
+        oss << details::TypeSchema<K>::v() << ",";
+        oss << details::TypeSchema<V>::v();
+        oss << "]}";
+        return oss.str();
+    }
+};
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_CONTAINER_CONCURRENT_MAP_H
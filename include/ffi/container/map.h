@@ -11,12 +11,35 @@
 #include "ffi/object.h"
 
 #include <algorithm>
+#include <bit>
 #include <limits>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*! \brief Maximum load factor of DenseMapObj. */
+#ifndef TVM_FFI_DENSE_MAP_MAX_LOAD_FACTOR
+#define TVM_FFI_DENSE_MAP_MAX_LOAD_FACTOR 0.99
+#endif
+
+/*! \brief Maximum load factor of SwissMapObj, must be below 1. */
+#ifndef TVM_FFI_SWISS_MAP_MAX_LOAD_FACTOR
+#define TVM_FFI_SWISS_MAP_MAX_LOAD_FACTOR 0.875
+#endif
+
+/*! \brief Whether maps that outgrow SmallMapObj use SwissMapObj rather than DenseMapObj. */
+#ifndef TVM_FFI_MAP_USE_SWISS_LAYOUT
+#define TVM_FFI_MAP_USE_SWISS_LAYOUT 0
+#endif
+
 namespace litetvm {
 
 namespace ffi {
@@ -86,6 +109,20 @@ public:
    */
     iterator find(const key_type& key) const;
     /*!
+   * \brief Index value associated with a string key, without constructing a String
+   * \param key The content of the string key
+   * \return The iterator of the entry associated with the key, end iterator if not exists
+   */
+    template<typename T, typename = std::enable_if_t<std::is_same_v<T, std::string_view>>>
+    iterator find(const T& key) const;
+    /*!
+   * \brief Count the number of times a string key exists, without constructing a String
+   * \param key The content of the string key
+   * \return The result, 0 or 1
+   */
+    template<typename T, typename = std::enable_if_t<std::is_same_v<T, std::string_view>>>
+    size_t count(const T& key) const { return find(key) != end(); }
+    /*!
    * \brief Erase the entry associated with the iterator
    * \param position The iterator
    */
@@ -159,12 +196,27 @@ public:
 
         friend class DenseMapObj;
         friend class SmallMapObj;
+        friend class SwissMapObj;
+    };
+    /*! \brief Layout of the maps that outgrow SmallMapObj */
+    enum class Layout : uint8_t {
+        /*! \brief DenseMapObj, chained through 1-byte jump distances */
+        kDense,
+        /*! \brief SwissMapObj, 16 slots probed at a time with SIMD */
+        kSwiss,
     };
     /*!
    * \brief Create an empty container
    * \return The object created
    */
     static inline ObjectPtr<MapObj> Empty();
+    /*!
+   * \brief Create an empty container with a given layout
+   * \param layout The layout, a dense layout map starts small when capacity allows
+   * \param capacity The number of entries to reserve
+   * \return The object created
+   */
+    static inline ObjectPtr<MapObj> Empty(Layout layout, uint64_t capacity);
 
 protected:
 #if TVM_FFI_DEBUG_WITH_ABI_CHANGE
@@ -212,6 +264,16 @@ protected:
      * \return True if the map is a small map
      */
     bool IsSmallMap() const { return (slots_ & kSmallTagMask) != 0ull; }
+    /*!
+   * \brief Swiss layout tag mask
+   * \note The second most significant bit is used to indicate the swiss map layout.
+   */
+    static constexpr uint64_t kSwissTagMask = static_cast<uint64_t>(1) << 62;
+    /*!
+     * \brief Check if the map is a swiss map
+     * \return True if the map is a swiss map
+     */
+    bool IsSwissMap() const { return (slots_ & kSwissTagMask) != 0ull; }
 
     /*!
    * \brief Optional data deleter when data is allocated separately
@@ -292,8 +354,10 @@ public:
    * \brief Index value associated with a key
    * \param key The indexing key
    * \return The iterator of the entry associated with the key, end iterator if not exists
+   * \tparam KeyType key_type, or std::string_view to look up a string key by its content
    */
-    iterator find(const key_type& key) const {
+    template<typename KeyType>
+    iterator find(const KeyType& key) const {
         KVType* ptr = static_cast<KVType*>(data_);
         for (uint64_t i = 0; i < size_; ++i, ++ptr) {
             if (AnyEqual()(ptr->first, key)) {
@@ -494,7 +558,7 @@ private:
     /*! \brief The number of elements in a memory block */
     static constexpr int kBlockCap = 16;
     /*! \brief Maximum load factor of the hash map */
-    static constexpr double kMaxLoadFactor = 0.99;
+    static constexpr double kMaxLoadFactor = TVM_FFI_DENSE_MAP_MAX_LOAD_FACTOR;
     /*! \brief Binary representation of the metadata of an empty slot */
     static constexpr uint8_t kEmptySlot = 0b11111111;
     /*! \brief Binary representation of the metadata of a protected slot */
@@ -559,8 +623,10 @@ public:
    * \brief Index value associated with a key
    * \param key The indexing key
    * \return The iterator of the entry associated with the key, end iterator if not exists
+   * \tparam KeyType key_type, or std::string_view to look up a string key by its content
    */
-    iterator find(const key_type& key) const {
+    template<typename KeyType>
+    iterator find(const KeyType& key) const {
         ListNode node = Search(key);
         return node.IsNone() ? end() : iterator(node.index, this);
     }
@@ -648,8 +714,10 @@ private:
    * \brief Search for the given key
    * \param key The key
    * \return ListNode that associated with the key
+   * \tparam KeyType key_type or std::string_view
    */
-    ListNode Search(const key_type& key) const {
+    template<typename KeyType>
+    ListNode Search(const KeyType& key) const {
         if (this->size_ == 0) {
             return ListNode();
         }
@@ -1188,18 +1256,485 @@ private:
      * \param n The number of slots
      */
     void SetSlotsAndDenseLayoutTag(uint64_t n) {
-        TVM_FFI_ICHECK(((n & kSmallTagMask) == 0ull)) << "DenseMap expects MSB clear";
+        TVM_FFI_ICHECK(((n & (kSmallTagMask | kSwissTagMask)) == 0ull)) << "DenseMap expects tag bits clear";
         slots_ = n;
     }
 };
 
+/*! \brief A specialization of hash map that probes 16 slots at a time, after the idea of [1].
+ *
+ * A. Overview
+ *
+ * SwissMapObj separates the index of the hash table from the entries, like the compact dict of
+ * CPython. The entries are stored in insertion order in a dense array, so iteration order matches
+ * DenseMapObj; the hash table only maps slots to entry indices.
+ *
+ * A1. Group metadata. Every slot has one metadata byte: (0b10000000)_2 for an empty slot,
+ * (0b11111110)_2 for a deleted slot, and otherwise the lower 7 bits (H2) of the mixed hash code.
+ * Slots form groups of 16 and a lookup compares the H2 of the key against the 16 metadata bytes
+ * of a group at once with SSE2 or NEON, only the slots that match are compared with AnyEqual.
+ *
+ * A2. Probing. The rest of the hash bits (H1) select the first group, the following groups are
+ * visited with triangle numbers, which cover the whole power-of-2-sized table [2]. A lookup stops
+ * at the first group that holds an empty slot.
+ *
+ * A3. Deletion. An erased entry stays in the entry array as a hole until the next rehash. Its
+ * slot becomes empty if its group still holds an empty slot, because no probe sequence has ever
+ * gone past such a group, and deleted otherwise.
+ *
+ * [1] https://abseil.io/about/design/swisstables
+ * [2] https://fgiesen.wordpress.com/2015/02/22/triangular-numbers-mod-2n/
+ */
+class SwissMapObj : public MapObj {
+private:
+    /*! \brief The number of slots probed together */
+    static constexpr int kGroupSize = 16;
+    /*! \brief Maximum load factor of the hash map */
+    static constexpr double kMaxLoadFactor = TVM_FFI_SWISS_MAP_MAX_LOAD_FACTOR;
+    /*! \brief Binary representation of the metadata of an empty slot */
+    static constexpr uint8_t kEmptySlot = 0b10000000;
+    /*! \brief Binary representation of the metadata of a deleted slot */
+    static constexpr uint8_t kDeletedSlot = 0b11111110;
+    /*! \brief Index indicator to indicate an invalid index */
+    static constexpr uint64_t kInvalidIndex = std::numeric_limits<uint64_t>::max();
+    /*! \brief Entry of the map, the slot is kInvalidIndex once the entry is erased */
+    struct Entry {
+        KVType data;
+        uint64_t hash;
+        uint64_t slot;
+
+        Entry(KVType&& data, uint64_t hash, uint64_t slot) : data(std::move(data)), hash(hash), slot(slot) {}
+    };
+
+    static_assert(kMaxLoadFactor > 0 && kMaxLoadFactor < 1, "TVM_FFI_SWISS_MAP_MAX_LOAD_FACTOR must be in (0, 1)");
+
+#if defined(__SSE2__) || defined(_M_X64)
+    /*! \brief Number of mask bits per slot */
+    static constexpr int kMaskShift = 0;
+#elif defined(__ARM_NEON)
+    static constexpr int kMaskShift = 2;
+#else
+    static constexpr int kMaskShift = 0;
+#endif
+
+    /*! \brief Bit mask of the matching slots of a group */
+    struct GroupMask {
+        uint64_t bits;
+        /*! \return Whether any slot matches */
+        explicit operator bool() const { return bits != 0; }
+        /*! \return The lowest matching slot in the group */
+        int Lowest() const { return std::countr_zero(bits) >> kMaskShift; }
+        /*! \brief Drop the lowest matching slot */
+        void ClearLowest() { bits &= bits - 1; }
+    };
+
+    /*! \brief Match the metadata bytes of a group that equal to the given byte */
+    static GroupMask Match(const uint8_t* ctrl, uint8_t meta) {
+#if defined(__SSE2__) || defined(_M_X64)
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return {static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(meta)))))};
+#elif defined(__ARM_NEON)
+        uint8x16_t eq = vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(meta));
+        return {NarrowMask(eq)};
+#else
+        uint64_t bits = 0;
+        for (int i = 0; i < kGroupSize; ++i) {
+            bits |= static_cast<uint64_t>(ctrl[i] == meta) << i;
+        }
+        return {bits};
+#endif
+    }
+
+    /*! \brief Match the empty and deleted slots of a group, i.e. the metadata bytes with MSB set */
+    static GroupMask MatchEmptyOrDeleted(const uint8_t* ctrl) {
+#if defined(__SSE2__) || defined(_M_X64)
+        return {static_cast<uint64_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))))};
+#elif defined(__ARM_NEON)
+        uint8x16_t msb = vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(ctrl)), vdupq_n_s8(0));
+        return {NarrowMask(msb)};
+#else
+        uint64_t bits = 0;
+        for (int i = 0; i < kGroupSize; ++i) {
+            bits |= static_cast<uint64_t>(ctrl[i] >> 7) << i;
+        }
+        return {bits};
+#endif
+    }
+
+#if !(defined(__SSE2__) || defined(_M_X64)) && defined(__ARM_NEON)
+    /*! \brief Compress a 0x00/0xFF byte vector to 4 bits per slot and keep one bit of each */
+    static uint64_t NarrowMask(uint8x16_t mask) {
+        uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(mask), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ULL;
+    }
+#endif
+
+    /*!
+   * \brief Deleter for the table
+   * \param data The pointer to the table
+   */
+    static void TableDeleter(void* data) { ::operator delete(data); }
+
+public:
+    using MapObj::iterator;
+
+    /*!
+   * \brief Return the number of slots for Swiss layout (mask off tag).
+   * \return The number of slots
+   */
+    uint64_t NumSlots() const { return slots_ & ~kSwissTagMask; }
+
+    /*!
+   * \brief Destroy the SwissMapObj
+   */
+    ~SwissMapObj() { this->Reset(); }
+    /*! \return The number of elements of the key */
+    size_t count(const key_type& key) const { return Search(key) != kInvalidIndex; }
+    /*!
+   * \brief Index value associated with a key, throw exception if the key does not exist
+   * \param key The indexing key
+   * \return The const reference to the value
+   */
+    const mapped_type& at(const key_type& key) const { return At(key); }
+    /*!
+   * \brief Index value associated with a key, throw exception if the key does not exist
+   * \param key The indexing key
+   * \return The mutable reference to the value
+   */
+    mapped_type& at(const key_type& key) { return At(key); }
+    /*!
+   * \brief Index value associated with a key
+   * \param key The indexing key
+   * \return The iterator of the entry associated with the key, end iterator if not exists
+   * \tparam KeyType key_type, or std::string_view to look up a string key by its content
+   */
+    template<typename KeyType>
+    iterator find(const KeyType& key) const { return iterator(Search(key), this); }
+    /*!
+   * \brief Erase the entry associated with the iterator
+   * \param position The iterator
+   */
+    void erase(const iterator& position) {
+        if (position.self != nullptr && position.index < n_used_) {
+            Erase(position.index);
+        }
+    }
+    /*! \return begin iterator */
+    iterator begin() const { return iterator(IncItr(kInvalidIndex), this); }
+    /*! \return end iterator */
+    iterator end() const { return iterator(kInvalidIndex, this); }
+
+private:
+    /*! \brief Metadata bytes of all slots */
+    uint8_t* Ctrl() const { return static_cast<uint8_t*>(data_); }
+    /*! \brief Entry index of all slots */
+    uint32_t* SlotIndex() const { return reinterpret_cast<uint32_t*>(Ctrl() + NumSlots()); }
+    /*! \brief Entries in insertion order */
+    Entry* Entries() const {
+        return reinterpret_cast<Entry*>(Ctrl() + NumSlots() * (1 + sizeof(uint32_t)));
+    }
+    /*!
+   * \brief Spread the hash code over all bits, AnyHash of integers and pointers is close to identity.
+   * \param hash_value The raw hash value
+   * \return The mixed hash value
+   */
+    static uint64_t MixHash(uint64_t hash_value) {
+        hash_value ^= hash_value >> 33;
+        hash_value *= 0xff51afd7ed558ccdULL;
+        hash_value ^= hash_value >> 33;
+        hash_value *= 0xc4ceb9fe1a85ec53ULL;
+        hash_value ^= hash_value >> 33;
+        return hash_value;
+    }
+    /*! \brief H2, the part of the hash code stored in the metadata */
+    static uint8_t H2(uint64_t hash) { return static_cast<uint8_t>(hash & 0b01111111); }
+    /*! \brief The first group on the probe sequence of a hash code */
+    uint64_t FirstGroup(uint64_t hash) const { return (hash >> 7) & (NumSlots() / kGroupSize - 1); }
+    /*!
+   * \brief Search for the given key
+   * \param key The key
+   * \return The entry index associated with the key, kInvalidIndex if not exists
+   * \tparam KeyType key_type or std::string_view
+   */
+    template<typename KeyType>
+    uint64_t Search(const KeyType& key) const {
+        if (this->size_ == 0) {
+            return kInvalidIndex;
+        }
+        return Search(key, MixHash(AnyHash()(key)));
+    }
+    /*!
+   * \brief Search for the given key with its mixed hash code
+   * \param key The key
+   * \param hash The mixed hash code of the key
+   * \return The entry index associated with the key, kInvalidIndex if not exists
+   * \tparam KeyType key_type or std::string_view
+   */
+    template<typename KeyType>
+    uint64_t Search(const KeyType& key, uint64_t hash) const {
+        uint64_t group_mask = NumSlots() / kGroupSize - 1;
+        uint64_t group = FirstGroup(hash);
+        for (uint64_t step = 1;; ++step) {
+            const uint8_t* ctrl = Ctrl() + group * kGroupSize;
+#if defined(__GNUC__) || defined(__clang__)
+            // the entry indices of a group share a cache line, fetch it together with the metadata
+            __builtin_prefetch(SlotIndex() + group * kGroupSize);
+#endif
+            for (GroupMask match = Match(ctrl, H2(hash)); match; match.ClearLowest()) {
+                uint32_t index = SlotIndex()[group * kGroupSize + match.Lowest()];
+                const Entry& entry = Entries()[index];
+                if (entry.hash == hash && AnyEqual()(entry.data.first, key)) {
+                    return index;
+                }
+            }
+            if (Match(ctrl, kEmptySlot)) {
+                return kInvalidIndex;
+            }
+            group = (group + step) & group_mask;
+        }
+    }
+    /*!
+   * \brief Search for the given key, throw exception if not exists
+   * \param key The key
+   * \return The value associated with the key
+   */
+    mapped_type& At(const key_type& key) const {
+        uint64_t index = Search(key);
+        if (index == kInvalidIndex) {
+            TVM_FFI_THROW(KeyError) << "key is not in Map";
+        }
+        return Entries()[index].data.second;
+    }
+    /*!
+   * \brief Find the first empty or deleted slot on the probe sequence of a hash code
+   * \param hash The mixed hash code
+   * \return The slot index
+   */
+    uint64_t FindInsertSlot(uint64_t hash) const {
+        uint64_t group_mask = NumSlots() / kGroupSize - 1;
+        uint64_t group = FirstGroup(hash);
+        for (uint64_t step = 1;; ++step) {
+            GroupMask match = MatchEmptyOrDeleted(Ctrl() + group * kGroupSize);
+            if (match) {
+                return group * kGroupSize + match.Lowest();
+            }
+            group = (group + step) & group_mask;
+        }
+    }
+    /*!
+   * \brief Append an entry whose key is known to be absent, the capacity must be enough
+   * \param kv The entry
+   * \param hash The mixed hash code of the key
+   */
+    void InsertNew(KVType&& kv, uint64_t hash) {
+        uint64_t slot = FindInsertSlot(hash);
+        Ctrl()[slot] = H2(hash);
+        SlotIndex()[slot] = static_cast<uint32_t>(n_used_);
+        new (Entries() + n_used_) Entry(std::move(kv), hash, slot);
+        ++n_used_;
+        ++size_;
+    }
+    /*!
+   * \brief Remove an entry
+   * \param index The entry index
+   */
+    void Erase(uint64_t index) {
+        Entry& entry = Entries()[index];
+        uint8_t* group_ctrl = Ctrl() + (entry.slot & ~static_cast<uint64_t>(kGroupSize - 1));
+        Ctrl()[entry.slot] = Match(group_ctrl, kEmptySlot) ? kEmptySlot : kDeletedSlot;
+        // Favor this over ~KVType as MSVC may not support ~KVType (need the original name)
+        entry.data.first.Any::~Any();
+        entry.data.second.Any::~Any();
+        entry.slot = kInvalidIndex;
+        size_ -= 1;
+        // trailing holes can be reused right away
+        while (n_used_ != 0 && Entries()[n_used_ - 1].slot == kInvalidIndex) {
+            --n_used_;
+        }
+    }
+    /*! \brief Clear the container to empty, release all entries and memory acquired */
+    void Reset() {
+        Entry* entries = Entries();
+        for (uint64_t i = 0; i < n_used_; ++i) {
+            if (entries[i].slot != kInvalidIndex) {
+                entries[i].data.first.Any::~Any();
+                entries[i].data.second.Any::~Any();
+            }
+        }
+        ReleaseMemory();
+    }
+    /*! \brief Release the memory acquired by the container without deleting its entries stored inside
+   */
+    void ReleaseMemory() {
+        if (data_ != nullptr) {
+            TVM_FFI_ICHECK(data_deleter_ != nullptr);
+            data_deleter_(data_);
+        }
+        data_ = nullptr;
+        data_deleter_ = nullptr;
+        slots_ = kSwissTagMask;
+        size_ = 0;
+        n_used_ = 0;
+        capacity_ = 0;
+    }
+    /*!
+   * \brief Create an empty container
+   * \param capacity The number of entries the container can hold without rehashing
+   * \return The object created
+   */
+    static ObjectPtr<SwissMapObj> Empty(uint64_t capacity) {
+        uint64_t n_slots = kGroupSize;
+        while (MaxEntries(n_slots) < capacity) {
+            n_slots <<= 1;
+        }
+        capacity = MaxEntries(n_slots);
+        TVM_FFI_ICHECK_LE(capacity, std::numeric_limits<uint32_t>::max()) << "Map is too large";
+        ObjectPtr<SwissMapObj> p = make_object<SwissMapObj>();
+        uint8_t* table =
+                static_cast<uint8_t*>(::operator new(n_slots * (1 + sizeof(uint32_t)) + capacity * sizeof(Entry)));
+        std::fill(table, table + n_slots, kEmptySlot);
+        p->data_ = table;
+        // assign table deleter so even if we take re-alloc data
+        // in another shared-lib that may have different malloc/free behavior
+        // it will still be safe.
+        p->data_deleter_ = TableDeleter;
+        p->SetSlotsAndSwissLayoutTag(n_slots);
+        p->size_ = 0;
+        p->n_used_ = 0;
+        p->capacity_ = capacity;
+        return p;
+    }
+    /*!
+   * \brief Create an empty container with elements copying from another SwissMapObj
+   * \param from The source container
+   * \return The object created
+   * \note The holes of erased entries are not copied.
+   */
+    static ObjectPtr<SwissMapObj> CopyFrom(SwissMapObj* from) {
+        ObjectPtr<SwissMapObj> p = Empty(from->capacity_);
+        Entry* entries = from->Entries();
+        for (uint64_t i = 0; i < from->n_used_; ++i) {
+            if (entries[i].slot != kInvalidIndex) {
+                p->InsertNew(KVType(entries[i].data), entries[i].hash);
+            }
+        }
+        return p;
+    }
+    /*!
+   * \brief Move the entries into a new container with the given capacity
+   * \param from The source container, left empty
+   * \param capacity The capacity of the new container
+   * \return The object created
+   */
+    static ObjectPtr<SwissMapObj> Rehash(SwissMapObj* from, uint64_t capacity) {
+        ObjectPtr<SwissMapObj> p = Empty(capacity);
+        Entry* entries = from->Entries();
+        for (uint64_t i = 0; i < from->n_used_; ++i) {
+            if (entries[i].slot != kInvalidIndex) {
+                // the stored hash avoids calling AnyHash again
+                p->InsertNew(std::move(entries[i].data), entries[i].hash);
+                entries[i].data.first.Any::~Any();
+                entries[i].data.second.Any::~Any();
+            }
+        }
+        from->ReleaseMemory();
+        return p;
+    }
+    /*!
+   * \brief InsertMaybeReHash an entry into the given hash map
+   * \param kv The entry to be inserted
+   * \param map The pointer to the map, can be changed if re-hashing happens
+   */
+    static void InsertMaybeReHash(KVType&& kv, ObjectPtr<Object>* map) {
+        SwissMapObj* map_node = static_cast<SwissMapObj*>(map->get());
+        uint64_t hash = MixHash(AnyHash()(kv.first));
+        uint64_t index = map_node->size_ == 0 ? kInvalidIndex : map_node->Search(kv.first, hash);
+        if (index != kInvalidIndex) {
+            map_node->Entries()[index].data.second = std::move(kv.second);
+            return;
+        }
+        if (map_node->n_used_ == map_node->capacity_) {
+            // grow when at least half of the entries are alive, otherwise only drop the holes
+            uint64_t capacity = map_node->size_ * 2 >= map_node->capacity_ ? map_node->capacity_ * 2
+                                                                            : map_node->capacity_;
+            ObjectPtr<SwissMapObj> p = Rehash(map_node, capacity);
+            p->InsertNew(std::move(kv), hash);
+            *map = std::move(p);
+            return;
+        }
+        map_node->InsertNew(std::move(kv), hash);
+    }
+    /*!
+   * \brief The number of entries a table of the given size can hold, one slot is always left
+   *        empty so that probing terminates.
+   */
+    static uint64_t MaxEntries(uint64_t n_slots) {
+        // NOLINTNEXTLINE(bugprone-narrowing-conversions)
+        uint64_t n = static_cast<uint64_t>(static_cast<double>(n_slots) * kMaxLoadFactor);
+        return std::min(n, n_slots - 1);
+    }
+    /*!
+   * \brief Increment the pointer
+   * \param index The pointer to be incremented
+   * \return The increased pointer
+   */
+    uint64_t IncItr(uint64_t index) const {
+        // kInvalidIndex + 1 wraps to the first entry
+        for (++index; index < n_used_; ++index) {
+            if (Entries()[index].slot != kInvalidIndex) {
+                return index;
+            }
+        }
+        return kInvalidIndex;
+    }
+    /*!
+   * \brief Decrement the pointer
+   * \param index The pointer to be decremented
+   * \return The decreased pointer
+   */
+    uint64_t DecItr(uint64_t index) const {
+        // this is the end iterator, we need to return tail.
+        if (index == kInvalidIndex) {
+            index = n_used_;
+        }
+        while (index-- > 0) {
+            if (Entries()[index].slot != kInvalidIndex) {
+                return index;
+            }
+        }
+        return kInvalidIndex;
+    }
+    /*!
+   * \brief De-reference the pointer
+   * \param index The pointer to be dereferenced
+   * \return The result
+   */
+    KVType* DeRefItr(uint64_t index) const { return &Entries()[index].data; }
+    /*!
+     * \brief Set the number of slots and attach tags bit.
+     * \param n The number of slots
+     */
+    void SetSlotsAndSwissLayoutTag(uint64_t n) { slots_ = (n & ~kSwissTagMask) | kSwissTagMask; }
+
+    /*! \brief The number of entries used, including the holes of erased entries */
+    uint64_t n_used_ = 0;
+    /*! \brief The number of entries that fit in the table */
+    uint64_t capacity_ = 0;
+
+    friend class MapObj;
+};
+
 #define TVM_FFI_DISPATCH_MAP(base, var, body)         \
     {                                                 \
         using TSmall = SmallMapObj*;                  \
         using TDense = DenseMapObj*;                  \
+        using TSwiss = SwissMapObj*;                  \
         if ((base)->IsSmallMap()) {                   \
             TSmall var = static_cast<TSmall>((base)); \
             body;                                     \
+        } else if ((base)->IsSwissMap()) {            \
+            TSwiss var = static_cast<TSwiss>((base)); \
+            body;                                     \
         } else {                                      \
             TDense var = static_cast<TDense>((base)); \
             body;                                     \
@@ -1210,9 +1745,13 @@ private:
     {                                                 \
         using TSmall = const SmallMapObj*;            \
         using TDense = const DenseMapObj*;            \
+        using TSwiss = const SwissMapObj*;            \
         if ((base)->IsSmallMap()) {                   \
             TSmall var = static_cast<TSmall>((base)); \
             body;                                     \
+        } else if ((base)->IsSwissMap()) {            \
+            TSwiss var = static_cast<TSwiss>((base)); \
+            body;                                     \
         } else {                                      \
             TDense var = static_cast<TDense>((base)); \
             body;                                     \
@@ -1264,6 +1803,11 @@ inline MapObj::iterator MapObj::find(const MapObj::key_type& key) const {
     TVM_FFI_DISPATCH_MAP_CONST(this, p, { return p->find(key); });
 }
 
+template<typename T, typename>
+inline MapObj::iterator MapObj::find(const T& key) const {
+    TVM_FFI_DISPATCH_MAP_CONST(this, p, { return p->find(key); });
+}
+
 inline void MapObj::erase(const MapObj::iterator& position) {
     TVM_FFI_DISPATCH_MAP(this, p, { return p->erase(position); });
 }
@@ -1273,10 +1817,26 @@ inline void MapObj::erase(const MapObj::iterator& position) {
 
 inline ObjectPtr<MapObj> MapObj::Empty() { return SmallMapObj::Empty(); }
 
+inline ObjectPtr<MapObj> MapObj::Empty(Layout layout, uint64_t capacity) {
+    if (layout == Layout::kSwiss) {
+        return SwissMapObj::Empty(capacity);
+    }
+    if (capacity <= SmallMapObj::kMaxSize) {
+        return SmallMapObj::Empty(std::max(capacity, SmallMapObj::kInitSize));
+    }
+    uint32_t fib_shift;
+    uint64_t n_slots;
+    DenseMapObj::CalcTableSize(capacity, &fib_shift, &n_slots);
+    return DenseMapObj::Empty(fib_shift, n_slots);
+}
+
 inline ObjectPtr<MapObj> MapObj::CopyFrom(MapObj* from) {
     if (from->IsSmallMap()) {
         return SmallMapObj::CopyFrom(static_cast<SmallMapObj*>(from));
     }
+    if (from->IsSwissMap()) {
+        return SwissMapObj::CopyFrom(static_cast<SwissMapObj*>(from));
+    }
     return DenseMapObj::CopyFrom(static_cast<DenseMapObj*>(from));
 }
 
@@ -1299,6 +1859,13 @@ inline ObjectPtr<Object> MapObj::CreateFromRange(IterType first, IterType last)
         }
         return obj;
     }
+#if TVM_FFI_MAP_USE_SWISS_LAYOUT
+    ObjectPtr<Object> obj = SwissMapObj::Empty(cap);
+    for (; first != last; ++first) {
+        KVType kv(*first);
+        SwissMapObj::InsertMaybeReHash(std::move(kv), &obj);
+    }
+#else
     uint32_t fib_shift;
     uint64_t n_slots;
     DenseMapObj::CalcTableSize(cap, &fib_shift, &n_slots);
@@ -1307,6 +1874,7 @@ inline ObjectPtr<Object> MapObj::CreateFromRange(IterType first, IterType last)
         KVType kv(*first);
         DenseMapObj::InsertMaybeReHash(std::move(kv), &obj);
     }
+#endif// TVM_FFI_MAP_USE_SWISS_LAYOUT
     return obj;
 }
 
@@ -1324,10 +1892,12 @@ inline void MapObj::InsertMaybeReHash(KVType&& kv, ObjectPtr<Object>* map) {
                 SmallMapObj::InsertMaybeReHash(std::move(kv), map);
             } else {
                 ObjectPtr<Object> new_map = MapObj::CreateFromRange(base->begin(), base->end());
-                DenseMapObj::InsertMaybeReHash(std::move(kv), &new_map);
+                MapObj::InsertMaybeReHash(std::move(kv), &new_map);
                 *map = std::move(new_map);
             }
         }
+    } else if (base->IsSwissMap()) {
+        SwissMapObj::InsertMaybeReHash(std::move(kv), map);
     } else {
         DenseMapObj::InsertMaybeReHash(std::move(kv), map);
     }
@@ -1336,6 +1906,17 @@ inline void MapObj::InsertMaybeReHash(KVType&& kv, ObjectPtr<Object>* map) {
 template<>
 ObjectPtr<MapObj> make_object<>() = delete;
 
+namespace details {
+/*! \brief Whether a Map<K, V> can look up T by string content, K must be able to hold a String */
+template<typename K, typename T>
+inline constexpr bool is_map_string_view_v =
+        (std::is_same_v<T, std::string_view> || std::is_same_v<T, TVMFFIByteArray>) &&
+        (std::is_same_v<K, String> || std::is_same_v<K, Any>);
+
+TVM_FFI_INLINE std::string_view AsMapStringView(std::string_view key) { return key; }
+TVM_FFI_INLINE std::string_view AsMapStringView(const TVMFFIByteArray& key) { return ToStringView(key); }
+}// namespace details
+
 /*!
  * \brief Map container of NodeRef->NodeRef in DSL graph.
  *  Map implements copy on write semantics, which means map is mutable
@@ -1411,6 +1992,13 @@ public:
    */
     explicit Map(ObjectPtr<Object> n) : ObjectRef(n) {}
     /*!
+   * \brief Construct an empty map with a given layout
+   * \param layout The layout used once the map outgrows the small layout
+   * \param capacity The number of entries to reserve
+   * \note Copies keep the layout, a map built from a range or cleared uses the default layout.
+   */
+    Map(MapObj::Layout layout, size_t capacity) { data_ = MapObj::Empty(layout, capacity); }
+    /*!
    * \brief constructor from iterator
    * \param begin begin of iterator
    * \param end end of iterator
@@ -1444,11 +2032,28 @@ public:
         return details::AnyUnsafe::CopyFromAnyViewAfterCheck<V>(GetMapObj()->at(key));
     }
     /*!
+   * \brief Read element from map by the content of a string key, without constructing a String.
+   * \param key The key, std::string_view or TVMFFIByteArray
+   * \return the corresonding element.
+   */
+    template<typename T, typename = std::enable_if_t<details::is_map_string_view_v<K, T>>>
+    const V at(const T& key) const {
+        MapObj::iterator iter = GetMapObj()->find(details::AsMapStringView(key));
+        if (iter == GetMapObj()->end()) {
+            TVM_FFI_THROW(KeyError) << "key is not in Map";
+        }
+        return details::AnyUnsafe::CopyFromAnyViewAfterCheck<V>(iter->second);
+    }
+    /*!
    * \brief Read element from map.
    * \param key The key
    * \return the corresonding element.
    */
     const V operator[](const K& key) const { return this->at(key); }
+    template<typename T, typename = std::enable_if_t<details::is_map_string_view_v<K, T>>>
+    const V operator[](const T& key) const {
+        return this->at(key);
+    }
     /*! \return The size of the array */
     size_t size() const {
         MapObj* n = GetMapObj();
@@ -1459,6 +2064,12 @@ public:
         MapObj* n = GetMapObj();
         return n == nullptr ? 0 : GetMapObj()->count(key);
     }
+    /*! \return The number of elements of a string key, std::string_view or TVMFFIByteArray */
+    template<typename T, typename = std::enable_if_t<details::is_map_string_view_v<K, T>>>
+    size_t count(const T& key) const {
+        MapObj* n = GetMapObj();
+        return n == nullptr ? 0 : n->count(details::AsMapStringView(key));
+    }
     /*! \return whether array is empty */
     bool empty() const { return size() == 0; }
     /*! \brief Release reference to all the elements */
@@ -1483,6 +2094,11 @@ public:
     iterator end() const { return iterator(GetMapObj()->end()); }
     /*! \return find the key and returns the associated iterator */
     iterator find(const K& key) const { return iterator(GetMapObj()->find(key)); }
+    /*! \return find a string key, std::string_view or TVMFFIByteArray, and returns the associated iterator */
+    template<typename T, typename = std::enable_if_t<details::is_map_string_view_v<K, T>>>
+    iterator find(const T& key) const {
+        return iterator(GetMapObj()->find(details::AsMapStringView(key)));
+    }
     /*! \return The value associated with the key, std::nullopt if not found */
     std::optional<V> Get(const K& key) const {
         MapObj::iterator iter = GetMapObj()->find(key);
@@ -1491,6 +2107,15 @@ public:
         }
         return details::AnyUnsafe::CopyFromAnyViewAfterCheck<V>(iter->second);
     }
+    /*! \return The value associated with a string key, std::nullopt if not found */
+    template<typename T, typename = std::enable_if_t<details::is_map_string_view_v<K, T>>>
+    std::optional<V> Get(const T& key) const {
+        MapObj::iterator iter = GetMapObj()->find(details::AsMapStringView(key));
+        if (iter == GetMapObj()->end()) {
+            return std::nullopt;
+        }
+        return details::AnyUnsafe::CopyFromAnyViewAfterCheck<V>(iter->second);
+    }
     void erase(const K& key) { CopyOnWrite()->erase(key); }
 
     /*!
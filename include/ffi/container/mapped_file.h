@@ -0,0 +1,132 @@
+//
+// Created by richard on 10/19/26.
+//
+
+#ifndef LITETVM_FFI_CONTAINER_MAPPED_FILE_H
+#define LITETVM_FFI_CONTAINER_MAPPED_FILE_H
+
+#include "ffi/container/map.h"
+#include "ffi/container/tensor.h"
+#include "ffi/string.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace litetvm {
+namespace ffi {
+
+/*! \brief How a file is mapped into memory. */
+struct MapOptions {
+    /*! \brief Access pattern advice for the mapped pages, see madvise. */
+    enum class Advice : int {
+        kNormal = 0,
+        kSequential = 1,
+        kRandom = 2,
+        kWillNeed = 3,
+    };
+
+    /*! \brief Read-fault the whole range into the page cache before returning, sharing its pages. */
+    bool populate = false;
+    /*! \brief Advice for the mapped range. */
+    Advice advice = Advice::kNormal;
+    /*!
+     * \brief Touch the pages on a background thread, in file order, until the mapping is released.
+     *
+     * The caller can use the first tensors while the rest of the file is faulted in.
+     */
+    bool read_ahead = false;
+};
+
+/*!
+ * \brief A range of a file mapped copy-on-write into memory.
+ *
+ * Writes to the mapped memory are private to the process and never reach the file. The
+ * range stays mapped while the object or a tensor created from it is alive.
+ */
+class MappedFileObj : public Object {
+public:
+    MappedFileObj(char* base, size_t mapped_size, size_t data_offset, size_t size)
+        : base_(base), mapped_size_(mapped_size), data_offset_(data_offset), size_(size) {}
+
+    TVM_FFI_DLL ~MappedFileObj();
+
+    /*! \return The first byte of the requested range. */
+    NODISCARD char* data() const {
+        return base_ + data_offset_;
+    }
+
+    /*! \return The size of the requested range. */
+    NODISCARD size_t size() const {
+        return size_;
+    }
+
+    TVM_FFI_DECLARE_OBJECT_INFO_FINAL("ffi.MappedFile", MappedFileObj, Object);
+
+private:
+    // page aligned start and length of the mapping
+    char* base_;
+    size_t mapped_size_;
+    // offset of the requested range from base_
+    size_t data_offset_;
+    size_t size_;
+    // read-ahead thread, stopped and joined before unmapping
+    std::thread read_ahead_;
+    std::atomic<bool> stop_read_ahead_{false};
+
+    friend class MappedFile;
+};
+
+/*! \brief Reference to MappedFileObj. */
+class MappedFile : public ObjectRef {
+public:
+    /*!
+     * \brief Map a range of a file.
+     * \param path The file path.
+     * \param options The mapping options.
+     * \param offset The start of the range, need not be page aligned.
+     * \param length The length of the range, -1 maps up to the end of the file.
+     * \return The mapped file.
+     * \note Throws RuntimeError if the file cannot be opened or mapped, ValueError if the range
+     *  is not in the file.
+     */
+    TVM_FFI_DLL static MappedFile Open(const String& path, const MapOptions& options = MapOptions(),
+                                       int64_t offset = 0, int64_t length = -1);
+
+    /*!
+     * \brief Create a contiguous tensor on the mapped memory, without copying.
+     * \param offset The offset of the tensor data in the mapped range.
+     * \param shape The shape.
+     * \param dtype The dtype.
+     * \return The tensor, it keeps the mapping alive.
+     */
+    TVM_FFI_DLL Tensor ToTensor(int64_t offset, ShapeView shape, DLDataType dtype) const;
+
+    TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(MappedFile, ObjectRef, MappedFileObj);
+};
+
+/*!
+ * \brief Save CPU tensors to a tensor file.
+ *
+ * A tensor file starts with a header naming each tensor with its dtype, shape and the offset
+ * of its data, followed by the data of each tensor in C order, starting on a 4096 byte
+ * boundary. All integers are little endian.
+ *
+ * \param path The file path.
+ * \param tensors The tensors by name.
+ */
+TVM_FFI_DLL void SaveTensorFile(const String& path, const Map<String, Tensor>& tensors);
+
+/*!
+ * \brief Load the tensors of a tensor file, mapping the file into memory.
+ * \param path The file path.
+ * \param options The mapping options.
+ * \return The tensors by name, they share the mapping of the file.
+ * \note Throws ValueError if the file is not a valid tensor file.
+ */
+TVM_FFI_DLL Map<String, Tensor> LoadTensorFile(const String& path, const MapOptions& options = MapOptions());
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_CONTAINER_MAPPED_FILE_H
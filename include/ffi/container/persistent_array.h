@@ -0,0 +1,664 @@
+//
+// Created by richard on 10/19/26.
+//
+
+#ifndef LITETVM_FFI_CONTAINER_PERSISTENT_ARRAY_H
+#define LITETVM_FFI_CONTAINER_PERSISTENT_ARRAY_H
+
+#include "ffi/any.h"
+#include "ffi/cast.h"
+#include "ffi/container/array.h"
+#include "ffi/container/container_details.h"
+#include "ffi/error.h"
+#include "ffi/memory.h"
+#include "ffi/object.h"
+#include "ffi/type_traits.h"
+
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace litetvm {
+namespace ffi {
+
+namespace details {
+/*!
+ * \brief Trie node of PersistentArrayObj.
+ *
+ * Leaf nodes hold elements, inner nodes hold their children. Nodes are shared
+ * between versions and are only modified in place when uniquely referenced.
+ */
+class PersistentArrayNodeObj : public Object, public InplaceArrayBase<PersistentArrayNodeObj, TVMFFIAny> {
+public:
+    /*! \brief Number of index bits consumed by each level. */
+    static constexpr int32_t kBits = 5;
+    /*! \brief Branching factor of the trie. */
+    static constexpr int64_t kWidth = int64_t{1} << kBits;
+    /*! \brief Mask of the index bits of one level. */
+    static constexpr int64_t kMask = kWidth - 1;
+
+    ~PersistentArrayNodeObj() {
+        Any* begin = slots();
+        for (int64_t i = 0; i < size_; ++i) {
+            (begin + i)->Any::~Any();
+        }
+    }
+
+    /*! \return Pointer to the first slot. */
+    NODISCARD Any* slots() const {
+        return static_cast<Any*>(AddressOf(0));
+    }
+
+    /*! \return The number of initialized slots. */
+    NODISCARD int64_t size() const {
+        return size_;
+    }
+
+    /*!
+   * \brief Get the i-th child of an inner node.
+   * \param i The slot index.
+   * \return The child node.
+   */
+    NODISCARD PersistentArrayNodeObj* child(int64_t i) const {
+        return static_cast<PersistentArrayNodeObj*>(AnyUnsafe::ObjectPtrFromAnyAfterCheck(slots()[i]));
+    }
+
+    /*! \brief Append a slot, the node must not be full. */
+    void Push(Any value) {
+        new (slots() + size_) Any(std::move(value));
+        ++size_;
+    }
+
+    /*! \brief Append a child node, the node must not be full. */
+    void PushChild(ObjectPtr<PersistentArrayNodeObj> node) {
+        Push(ObjectRef(ObjectPtr<Object>(std::move(node))));
+    }
+
+    /*! \brief Remove the last slot. */
+    void Pop() {
+        (slots() + size_ - 1)->Any::~Any();
+        --size_;
+    }
+
+    /*! \return An empty node. */
+    static ObjectPtr<PersistentArrayNodeObj> Empty() {
+        ObjectPtr<PersistentArrayNodeObj> p = make_inplace_array_object<PersistentArrayNodeObj, TVMFFIAny>(kWidth);
+        p->size_ = 0;
+        return p;
+    }
+
+    /*!
+   * \brief Copy the first n slots of a node.
+   * \param from The source node.
+   * \param n The number of slots to copy.
+   * \return The copy.
+   */
+    static ObjectPtr<PersistentArrayNodeObj> CopyFrom(const PersistentArrayNodeObj* from, int64_t n) {
+        ObjectPtr<PersistentArrayNodeObj> p = Empty();
+        const Any* read = from->slots();
+        for (int64_t i = 0; i < n; ++i) {
+            p->Push(read[i]);
+        }
+        return p;
+    }
+
+    TVM_FFI_DECLARE_OBJECT_INFO_FINAL("ffi.PersistentArrayNode", PersistentArrayNodeObj, Object);
+
+private:
+    /*! \return Size of initialized memory, used by InplaceArrayBase. */
+    NODISCARD size_t GetSize() const {
+        return static_cast<size_t>(size_);
+    }
+
+    /*! \brief Number of initialized slots. */
+    int64_t size_{0};
+
+    friend InplaceArrayBase;
+};
+}// namespace details
+
+/*!
+ * \brief Persistent vector content.
+ *
+ * Elements live in a 32-way radix-balanced trie plus a tail leaf for fast
+ * appends. Updates copy only the path from the root to the changed leaf, so
+ * every older version stays valid and shares all other nodes.
+ */
+class PersistentArrayObj : public Object {
+public:
+    using Node = details::PersistentArrayNodeObj;
+
+    /*! \return The size of the array */
+    NODISCARD size_t size() const {
+        return static_cast<size_t>(size_);
+    }
+
+    /*!
+   * \brief Read i-th element from array.
+   * \param i The index
+   * \return the i-th element.
+   */
+    NODISCARD const Any& at(int64_t i) const {
+        if (i < 0 || i >= size_) {
+            TVM_FFI_THROW(IndexError) << "Index " << i << " out of bounds " << size_;
+        }
+        return LeafFor(i)->slots()[i & Node::kMask];
+    }
+
+    /*!
+   * \brief Read i-th element from array.
+   * \param i The index
+   * \return the i-th element.
+   */
+    const Any& operator[](int64_t i) const {
+        return at(i);
+    }
+
+    /*! \return An empty array. */
+    static ObjectPtr<PersistentArrayObj> Empty() {
+        ObjectPtr<PersistentArrayObj> p = make_object<PersistentArrayObj>();
+        p->tail_ = Node::Empty();
+        return p;
+    }
+
+    /*!
+   * \brief Create a new version that shares all nodes with from.
+   * \param from The source array.
+   * \return The new version.
+   */
+    static ObjectPtr<PersistentArrayObj> CopyFrom(const PersistentArrayObj* from) {
+        ObjectPtr<PersistentArrayObj> p = make_object<PersistentArrayObj>();
+        p->size_ = from->size_;
+        p->shift_ = from->shift_;
+        p->root_ = from->root_;
+        p->tail_ = from->tail_;
+        return p;
+    }
+
+    static constexpr int32_t _type_index = kTVMFFIPersistentArray;
+    static constexpr bool _type_final = true;
+    TVM_FFI_DECLARE_OBJECT_INFO_STATIC(StaticTypeKey::kTVMFFIPersistentArray, PersistentArrayObj, Object);
+
+private:
+    /*! \return The number of elements stored in the trie, the rest is in the tail. */
+    NODISCARD int64_t TailOffset() const {
+        return size_ < Node::kWidth ? 0 : ((size_ - 1) >> Node::kBits) << Node::kBits;
+    }
+
+    /*! \return The leaf that contains the i-th element. */
+    NODISCARD const Node* LeafFor(int64_t i) const {
+        if (i >= TailOffset()) {
+            return tail_.get();
+        }
+        const Node* node = root_.get();
+        for (int32_t level = shift_; level > 0; level -= Node::kBits) {
+            node = node->child((i >> level) & Node::kMask);
+        }
+        return node;
+    }
+
+    /*!
+   * \brief Append an element.
+   * \param value The element.
+   * \note The container must be uniquely owned.
+   */
+    void PushBack(Any value) {
+        if (size_ - TailOffset() < Node::kWidth) {
+            EditableTail()->Push(std::move(value));
+            ++size_;
+            return;
+        }
+        // the tail is full, move it into the trie
+        int64_t tree_size = TailOffset();
+        if (root_ == nullptr) {
+            root_ = std::move(tail_);
+            shift_ = 0;
+        } else if (tree_size == (Node::kWidth << shift_)) {
+            // the trie is full, grow one level
+            ObjectPtr<Node> new_root = Node::Empty();
+            new_root->PushChild(std::move(root_));
+            new_root->PushChild(NewPath(shift_, std::move(tail_)));
+            root_ = std::move(new_root);
+            shift_ += Node::kBits;
+        } else {
+            if (ObjectPtr<Node> rep = PushTail(root_.get(), root_.unique(), shift_, tree_size, std::move(tail_))) {
+                root_ = std::move(rep);
+            }
+        }
+        tail_ = Node::Empty();
+        tail_->Push(std::move(value));
+        ++size_;
+    }
+
+    /*!
+   * \brief Remove the last element.
+   * \note The container must be uniquely owned and not empty.
+   */
+    void PopBack() {
+        if (size_ - TailOffset() > 1 || size_ == 1) {
+            EditableTail()->Pop();
+            --size_;
+            return;
+        }
+        // the tail becomes empty, take the last leaf of the trie as the new tail
+        int64_t new_size = size_ - 1;
+        tail_ = GetObjectPtr<Node>(const_cast<Node*>(LeafFor(new_size - 1)));
+        if (shift_ == 0) {
+            root_ = nullptr;
+        } else {
+            root_ = PopTail(root_.get(), root_.unique(), shift_, new_size - 1);
+            if (shift_ > 0 && root_->size() == 1) {
+                // drop a level that only has one child
+                root_ = GetObjectPtr<Node>(root_->child(0));
+                shift_ -= Node::kBits;
+            }
+        }
+        size_ = new_size;
+    }
+
+    /*!
+   * \brief Set the i-th element.
+   * \note The container must be uniquely owned.
+   */
+    void SetItem(int64_t i, Any value) {
+        if (i < 0 || i >= size_) {
+            TVM_FFI_THROW(IndexError) << "indexing " << i << " on an array of size " << size_;
+        }
+        if (i >= TailOffset()) {
+            EditableTail()->slots()[i & Node::kMask] = std::move(value);
+            return;
+        }
+        if (ObjectPtr<Node> rep = SetInTrie(root_.get(), root_.unique(), shift_, i, std::move(value))) {
+            root_ = std::move(rep);
+        }
+    }
+
+    Node* EditableTail() {
+        if (!tail_.unique()) {
+            tail_ = Node::CopyFrom(tail_.get(), tail_->size());
+        }
+        return tail_.get();
+    }
+
+    /*! \brief Wrap a leaf into single-child inner nodes up to the given level. */
+    static ObjectPtr<Node> NewPath(int32_t level, ObjectPtr<Node> leaf) {
+        if (level == 0) {
+            return leaf;
+        }
+        ObjectPtr<Node> node = Node::Empty();
+        node->PushChild(NewPath(level - Node::kBits, std::move(leaf)));
+        return node;
+    }
+
+    /*!
+   * \brief Get a node that can be modified.
+   * \return nullptr if node is editable, otherwise its copy.
+   */
+    static ObjectPtr<Node> CopyIfShared(const Node* node, bool editable) {
+        return editable ? nullptr : Node::CopyFrom(node, node->size());
+    }
+
+    /*!
+   * \brief Replace the i-th slot with a child node.
+   * \return The replacement of node, nullptr when node is modified in place.
+   */
+    static ObjectPtr<Node> ReplaceChild(const Node* node, bool editable, int64_t i, ObjectPtr<Node> child) {
+        ObjectPtr<Node> copy = CopyIfShared(node, editable);
+        Node* target = copy != nullptr ? copy.get() : const_cast<Node*>(node);
+        target->slots()[i] = ObjectRef(ObjectPtr<Object>(std::move(child)));
+        return copy;
+    }
+
+    /*!
+   * \brief Insert a full leaf at index into the trie below node.
+   * \return The replacement of node, nullptr when node is modified in place.
+   */
+    static ObjectPtr<Node> PushTail(const Node* node, bool editable, int32_t level, int64_t index, ObjectPtr<Node> leaf) {
+        int64_t sub = (index >> level) & Node::kMask;
+        if (level == Node::kBits || sub == node->size()) {
+            ObjectPtr<Node> copy = CopyIfShared(node, editable);
+            Node* target = copy != nullptr ? copy.get() : const_cast<Node*>(node);
+            target->PushChild(NewPath(level - Node::kBits, std::move(leaf)));
+            return copy;
+        }
+        Node* child = node->child(sub);
+        ObjectPtr<Node> rep = PushTail(child, editable && child->unique(), level - Node::kBits, index, std::move(leaf));
+        return rep != nullptr ? ReplaceChild(node, editable, sub, std::move(rep)) : nullptr;
+    }
+
+    /*!
+   * \brief Remove the leaf that contains index from the trie below node.
+   * \return The new node, nullptr if it becomes empty.
+   */
+    static ObjectPtr<Node> PopTail(Node* node, bool editable, int32_t level, int64_t index) {
+        int64_t sub = (index >> level) & Node::kMask;
+        ObjectPtr<Node> result = editable ? GetObjectPtr<Node>(node) : Node::CopyFrom(node, node->size());
+        if (level > Node::kBits) {
+            Node* child = node->child(sub);
+            ObjectPtr<Node> new_child = PopTail(child, editable && child->unique(), level - Node::kBits, index);
+            if (new_child != nullptr) {
+                result->slots()[sub] = ObjectRef(ObjectPtr<Object>(std::move(new_child)));
+                return result;
+            }
+        }
+        if (sub == 0) {
+            return nullptr;
+        }
+        result->Pop();
+        return result;
+    }
+
+    /*!
+   * \brief Set the element at index in the trie below node.
+   * \return The replacement of node, nullptr when node is modified in place.
+   */
+    static ObjectPtr<Node> SetInTrie(const Node* node, bool editable, int32_t level, int64_t index, Any value) {
+        if (level == 0) {
+            ObjectPtr<Node> copy = CopyIfShared(node, editable);
+            Node* target = copy != nullptr ? copy.get() : const_cast<Node*>(node);
+            target->slots()[index & Node::kMask] = std::move(value);
+            return copy;
+        }
+        int64_t sub = (index >> level) & Node::kMask;
+        Node* child = node->child(sub);
+        ObjectPtr<Node> rep = SetInTrie(child, editable && child->unique(), level - Node::kBits, index, std::move(value));
+        return rep != nullptr ? ReplaceChild(node, editable, sub, std::move(rep)) : nullptr;
+    }
+
+    /*! \brief Number of elements. */
+    int64_t size_{0};
+    /*! \brief Level of the root node, 0 when the root is a leaf. */
+    int32_t shift_{0};
+    /*! \brief Root of the trie, nullptr when all elements fit in the tail. */
+    ObjectPtr<Node> root_;
+    /*! \brief The last, possibly partial, leaf. */
+    ObjectPtr<Node> tail_;
+
+    template<typename, typename>
+    friend class PersistentArray;
+};
+
+/*!
+ * \brief Array with structural sharing between versions.
+ *
+ * Copying a PersistentArray is O(1). Set, push_back and pop_back copy
+ * O(log32 n) nodes when the array is shared with another version and
+ * update in place when it is not, instead of copying the whole array like
+ * Array does.
+ *
+ * \tparam T The content Value type, must be compatible with tvm::ffi::Any
+ */
+template<typename T, typename = std::enable_if_t<details::storage_enabled_v<T>>>
+class PersistentArray : public ObjectRef {
+public:
+    using value_type = T;
+
+    /*! \brief Iterator of the persistent array. */
+    class iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = int64_t;
+        using value_type = T;
+        using pointer = value_type*;
+        using reference = value_type;
+
+        iterator() = default;
+
+        bool operator==(const iterator& other) const {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return index_ != other.index_;
+        }
+
+        reference operator*() const {
+            return details::AnyUnsafe::CopyFromAnyViewAfterCheck<T>(leaf_->slots()[index_ & Node::kMask]);
+        }
+
+        iterator& operator++() {
+            ++index_;
+            if ((index_ & Node::kMask) == 0 && index_ < static_cast<int64_t>(arr_->size())) {
+                leaf_ = arr_->LeafFor(index_);
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        iterator& operator--() {
+            --index_;
+            leaf_ = arr_->LeafFor(index_);
+            return *this;
+        }
+
+        iterator operator--(int) {
+            iterator copy = *this;
+            --(*this);
+            return copy;
+        }
+
+        difference_type operator-(const iterator& other) const {
+            return index_ - other.index_;
+        }
+
+    private:
+        using Node = details::PersistentArrayNodeObj;
+
+        iterator(const PersistentArrayObj* arr, int64_t index) : arr_(arr), index_(index) {
+            if (index < static_cast<int64_t>(arr->size())) {
+                leaf_ = arr->LeafFor(index);
+            }
+        }
+
+        const PersistentArrayObj* arr_{nullptr};
+        const Node* leaf_{nullptr};
+        int64_t index_{0};
+
+        friend class PersistentArray;
+    };
+
+    /*! \brief default constructor */
+    PersistentArray() : ObjectRef(PersistentArrayObj::Empty()) {}
+
+    /*!
+   * \brief Constructor from iterator
+   * \param first begin of iterator
+   * \param last end of iterator
+   * \tparam Iter The type of iterator
+   */
+    template<typename Iter>
+    PersistentArray(Iter first, Iter last) : PersistentArray() {
+        static_assert(is_valid_iterator_v<T, Iter>, "IterType cannot be inserted into a PersistentArray<T>");
+        PersistentArrayObj* p = GetArrayObj();
+        for (; first != last; ++first) {
+            p->PushBack(Any(*first));
+        }
+    }
+
+    /*!
+   * \brief constructor from initializer list
+   * \param init The initializer list
+   */
+    PersistentArray(std::initializer_list<T> init) : PersistentArray(init.begin(), init.end()) {}// NOLINT(*)
+
+    /*!
+   * \brief constructor from Array
+   * \param arr The array
+   */
+    explicit PersistentArray(const Array<T>& arr) : PersistentArray(arr.begin(), arr.end()) {}
+
+    /*! \return The size of the array */
+    NODISCARD size_t size() const {
+        return GetArrayObj()->size();
+    }
+
+    /*! \return whether the array is empty */
+    NODISCARD bool empty() const {
+        return size() == 0;
+    }
+
+    /*!
+   * \brief Read i-th element from array.
+   * \param i The index
+   * \return the i-th element.
+   */
+    const T operator[](int64_t i) const {
+        return details::AnyUnsafe::CopyFromAnyViewAfterCheck<T>(GetArrayObj()->at(i));
+    }
+
+    /*! \return The last element of the array */
+    const T back() const {
+        if (empty()) {
+            TVM_FFI_THROW(IndexError) << "cannot index a empty array";
+        }
+        return (*this)[static_cast<int64_t>(size()) - 1];
+    }
+
+    /*! \return begin iterator */
+    iterator begin() const {
+        return iterator(GetArrayObj(), 0);
+    }
+
+    /*! \return end iterator */
+    iterator end() const {
+        return iterator(GetArrayObj(), static_cast<int64_t>(size()));
+    }
+
+    /*!
+   * \brief set i-th element of the array.
+   * \param i The index
+   * \param value The value to be setted.
+   */
+    void Set(int64_t i, T value) {
+        CopyOnWrite()->SetItem(i, Any(std::move(value)));
+    }
+
+    /*!
+   * \brief push a new item to the back of the list
+   * \param item The item to be pushed.
+   */
+    void push_back(const T& item) {
+        CopyOnWrite()->PushBack(Any(item));
+    }
+
+    /*! \brief Remove the last item of the list */
+    void pop_back() {
+        if (empty()) {
+            TVM_FFI_THROW(RuntimeError) << "cannot pop_back an empty array";
+        }
+        CopyOnWrite()->PopBack();
+    }
+
+    /*! \return A regular Array with the same elements. */
+    NODISCARD Array<T> ToArray() const {
+        ArrayBuilder<T> builder(static_cast<int64_t>(size()));
+        for (T value: *this) {
+            builder.push_back(std::move(value));
+        }
+        return std::move(builder).Build();
+    }
+
+    /*! \return The underlying PersistentArrayObj */
+    NODISCARD PersistentArrayObj* GetArrayObj() const {
+        return static_cast<PersistentArrayObj*>(data_.get());
+    }
+
+    TVM_FFI_DEFINE_OBJECT_REF_METHODS_NOTNULLABLE(PersistentArray, ObjectRef, PersistentArrayObj);
+
+private:
+    /*!
+   * \brief Make the container uniquely owned, sharing the nodes with the other versions.
+   * \return The container.
+   */
+    PersistentArrayObj* CopyOnWrite() {
+        if (!data_.unique()) {
+            data_ = PersistentArrayObj::CopyFrom(GetArrayObj());
+        }
+        return GetArrayObj();
+    }
+};
+
+template<typename T>
+inline constexpr bool use_default_type_traits_v<PersistentArray<T>> = false;
+
+template<typename T>
+struct TypeTraits<PersistentArray<T>> : public ObjectRefTypeTraitsBase<PersistentArray<T>> {
+    static constexpr int32_t field_static_type_index = TypeIndex::kTVMFFIPersistentArray;
+    using ObjectRefTypeTraitsBase<PersistentArray<T>>::CopyFromAnyViewAfterCheck;
+
+    TVM_FFI_INLINE static std::string GetMismatchTypeInfo(const TVMFFIAny* src) {
+        if (src->type_index != TypeIndex::kTVMFFIPersistentArray) {
+            return TypeTraitsBase::GetMismatchTypeInfo(src);
+        }
+        if constexpr (!std::is_same_v<T, Any>) {
+            const auto* n = reinterpret_cast<const PersistentArrayObj*>(src->v_obj);
+            for (int64_t i = 0; i < static_cast<int64_t>(n->size()); ++i) {
+                const Any& elem = n->at(i);
+                if (!details::AnyUnsafe::CheckAnyStrict<T>(elem) && !elem.try_cast<T>().has_value()) {
+                    return "PersistentArray[index " + std::to_string(i) + ": " +
+                           details::AnyUnsafe::GetMismatchTypeInfo<T>(elem) + "]";
+                }
+            }
+        }
+        TVM_FFI_THROW(InternalError) << "Cannot reach here";
+        TVM_FFI_UNREACHABLE();
+    }
+
+    TVM_FFI_INLINE static bool CheckAnyStrict(const TVMFFIAny* src) {
+        if (src->type_index != TypeIndex::kTVMFFIPersistentArray) return false;
+        if constexpr (std::is_same_v<T, Any>) {
+            return true;
+        } else {
+            const auto* n = reinterpret_cast<const PersistentArrayObj*>(src->v_obj);
+            for (int64_t i = 0; i < static_cast<int64_t>(n->size()); ++i) {
+                if (!details::AnyUnsafe::CheckAnyStrict<T>(n->at(i))) return false;
+            }
+            return true;
+        }
+    }
+
+    TVM_FFI_INLINE static std::optional<PersistentArray<T>> TryCastFromAnyView(const TVMFFIAny* src) {
+        if (src->type_index != TypeIndex::kTVMFFIPersistentArray) return std::nullopt;
+        if (CheckAnyStrict(src)) return CopyFromAnyViewAfterCheck(src);
+        // slow path, convert each element
+        const auto* n = reinterpret_cast<const PersistentArrayObj*>(src->v_obj);
+        PersistentArray<T> ret;
+        for (int64_t i = 0; i < static_cast<int64_t>(n->size()); ++i) {
+            std::optional<T> elem = n->at(i).try_cast<T>();
+            if (!elem.has_value()) return std::nullopt;
+            ret.push_back(*std::move(elem));
+        }
+        return ret;
+    }
+
+    TVM_FFI_INLINE static std::string TypeStr() {
+        return "PersistentArray<" + details::Type2Str<T>::v() + ">";
+    }
+
+    TVM_FFI_INLINE static std::string TypeSchema() {
+        std::ostringstream oss;
+        oss << R"({"type":")" << StaticTypeKey::kTVMFFIPersistentArray << R"(","args":[)";
+        oss << details::TypeSchema<T>::v();
+        oss << "]}";
+        return oss.str();
+    }
+};
+
+namespace details {
+template<typename T, typename U>
+inline constexpr bool type_contains_v<PersistentArray<T>, PersistentArray<U>> = type_contains_v<T, U>;
+}// namespace details
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_CONTAINER_PERSISTENT_ARRAY_H
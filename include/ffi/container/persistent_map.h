@@ -0,0 +1,859 @@
+//
+// Created by richard on 10/19/26.
+//
+
+#ifndef LITETVM_FFI_CONTAINER_PERSISTENT_MAP_H
+#define LITETVM_FFI_CONTAINER_PERSISTENT_MAP_H
+
+#include "ffi/any.h"
+#include "ffi/container/container_details.h"
+#include "ffi/container/map.h"
+#include "ffi/error.h"
+#include "ffi/memory.h"
+#include "ffi/object.h"
+#include "ffi/type_traits.h"
+
+#include <bit>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace litetvm {
+namespace ffi {
+
+namespace details {
+/*!
+ * \brief Node of the hash array mapped trie behind PersistentMapObj.
+ *
+ * Each node consumes 5 bits of the key hash. The datamap marks the hash
+ * fragments stored as inline key/value entries, the nodemap marks the ones
+ * that continue in a child node. Slots hold all entries first, as key and
+ * value pairs, followed by the children. Once the hash bits run out, nodes
+ * only hold entries with colliding hashes and are searched linearly.
+ */
+class PersistentMapNodeObj : public Object, public InplaceArrayBase<PersistentMapNodeObj, TVMFFIAny> {
+public:
+    /*! \brief Number of hash bits consumed by each level. */
+    static constexpr int32_t kBits = 5;
+    /*! \brief Mask of the hash bits of one level. */
+    static constexpr uint64_t kMask = (1 << kBits) - 1;
+    /*! \brief Levels at or beyond this shift only hold colliding entries. */
+    static constexpr int32_t kMaxShift = 64;
+    /*! \brief Maximum depth of the trie. */
+    static constexpr int32_t kMaxDepth = kMaxShift / kBits + 2;
+
+    ~PersistentMapNodeObj() {
+        Any* begin = slots();
+        for (int32_t i = 0; i < size_; ++i) {
+            (begin + i)->Any::~Any();
+        }
+    }
+
+    /*! \return Pointer to the first slot. */
+    NODISCARD Any* slots() const {
+        return static_cast<Any*>(AddressOf(0));
+    }
+
+    /*! \return The number of inline entries. */
+    NODISCARD int32_t num_entries() const {
+        return num_entries_;
+    }
+
+    /*! \return The number of children. */
+    NODISCARD int32_t num_children() const {
+        return size_ - 2 * num_entries_;
+    }
+
+    NODISCARD const Any& key(int32_t i) const {
+        return slots()[2 * i];
+    }
+
+    NODISCARD const Any& value(int32_t i) const {
+        return slots()[2 * i + 1];
+    }
+
+    NODISCARD PersistentMapNodeObj* child(int32_t i) const {
+        return static_cast<PersistentMapNodeObj*>(
+                AnyUnsafe::ObjectPtrFromAnyAfterCheck(slots()[2 * num_entries_ + i]));
+    }
+
+    /*! \return The hash of a key, with the bits mixed for use as trie path. */
+    static uint64_t Hash(const Any& key) {
+        uint64_t h = AnyHash()(key);
+        // splitmix64 finalizer, AnyHash of pointers leaves the low bits mostly unused
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return h;
+    }
+
+    /*! \return The bit of the hash fragment at the given shift. */
+    static uint32_t BitOf(uint64_t hash, int32_t shift) {
+        return uint32_t{1} << ((hash >> shift) & kMask);
+    }
+
+    /*!
+   * \brief Find the value of a key.
+   * \param root The root node.
+   * \param key The key.
+   * \param hash The hash of the key.
+   * \return Pointer to the value, nullptr if not found.
+   */
+    static const Any* Find(const PersistentMapNodeObj* node, const Any& key, uint64_t hash) {
+        for (int32_t shift = 0;; shift += kBits) {
+            if (shift >= kMaxShift) {
+                for (int32_t i = 0; i < node->num_entries_; ++i) {
+                    if (AnyEqual()(node->key(i), key)) return &node->value(i);
+                }
+                return nullptr;
+            }
+            uint32_t bit = BitOf(hash, shift);
+            if (node->datamap_ & bit) {
+                int32_t i = std::popcount(node->datamap_ & (bit - 1));
+                return AnyEqual()(node->key(i), key) ? &node->value(i) : nullptr;
+            }
+            if (!(node->nodemap_ & bit)) {
+                return nullptr;
+            }
+            node = node->child(std::popcount(node->nodemap_ & (bit - 1)));
+        }
+    }
+
+    /*!
+   * \brief Insert or update a key below node.
+   * \param node The node, only modified when editable.
+   * \param editable Whether node is uniquely owned by the caller.
+   * \param shift The hash shift of the node.
+   * \param hash The hash of the key.
+   * \param key The key.
+   * \param value The value.
+   * \param added Set to true when a new entry is added.
+   * \return The replacement of node, nullptr when node is modified in place.
+   */
+    static ObjectPtr<PersistentMapNodeObj> Insert(const PersistentMapNodeObj* node, bool editable, int32_t shift,
+                                                  uint64_t hash, Any key, Any value, bool* added) {
+        if (shift >= kMaxShift) {
+            for (int32_t i = 0; i < node->num_entries_; ++i) {
+                if (AnyEqual()(node->key(i), key)) {
+                    return ReplaceSlot(node, editable, 2 * i + 1, std::move(value));
+                }
+            }
+            *added = true;
+            return CopyInsertEntry(node, 0, node->num_entries_, std::move(key), std::move(value));
+        }
+        uint32_t bit = BitOf(hash, shift);
+        if (node->datamap_ & bit) {
+            int32_t i = std::popcount(node->datamap_ & (bit - 1));
+            if (AnyEqual()(node->key(i), key)) {
+                return ReplaceSlot(node, editable, 2 * i + 1, std::move(value));
+            }
+            // two different keys share the fragment, push both one level down
+            *added = true;
+            ObjectPtr<PersistentMapNodeObj> sub =
+                    MergeTwo(shift + kBits, node->key(i), node->value(i), Hash(node->key(i)),
+                             std::move(key), std::move(value), hash);
+            return CopyEntryToChild(node, bit, i, std::move(sub));
+        }
+        if (node->nodemap_ & bit) {
+            int32_t c = std::popcount(node->nodemap_ & (bit - 1));
+            PersistentMapNodeObj* sub = node->child(c);
+            ObjectPtr<PersistentMapNodeObj> rep =
+                    Insert(sub, editable && sub->unique(), shift + kBits, hash, std::move(key), std::move(value), added);
+            if (rep == nullptr) {
+                return nullptr;
+            }
+            return ReplaceSlot(node, editable, 2 * node->num_entries_ + c, ObjectRef(ObjectPtr<Object>(std::move(rep))));
+        }
+        *added = true;
+        int32_t i = std::popcount(node->datamap_ & (bit - 1));
+        return CopyInsertEntry(node, bit, i, std::move(key), std::move(value));
+    }
+
+    /*!
+   * \brief Erase a key below node.
+   * \param node The node, only modified when editable.
+   * \param editable Whether node is uniquely owned by the caller.
+   * \param shift The hash shift of the node.
+   * \param hash The hash of the key.
+   * \param key The key.
+   * \param removed Set to true when the key is found.
+   * \return The replacement of node, nullptr when node is modified in place or key is not found.
+   */
+    static ObjectPtr<PersistentMapNodeObj> Erase(const PersistentMapNodeObj* node, bool editable, int32_t shift,
+                                                 uint64_t hash, const Any& key, bool* removed) {
+        if (shift >= kMaxShift) {
+            for (int32_t i = 0; i < node->num_entries_; ++i) {
+                if (AnyEqual()(node->key(i), key)) {
+                    *removed = true;
+                    return CopyRemoveEntry(node, 0, i);
+                }
+            }
+            return nullptr;
+        }
+        uint32_t bit = BitOf(hash, shift);
+        if (node->datamap_ & bit) {
+            int32_t i = std::popcount(node->datamap_ & (bit - 1));
+            if (!AnyEqual()(node->key(i), key)) {
+                return nullptr;
+            }
+            *removed = true;
+            return CopyRemoveEntry(node, bit, i);
+        }
+        if (!(node->nodemap_ & bit)) {
+            return nullptr;
+        }
+        int32_t c = std::popcount(node->nodemap_ & (bit - 1));
+        PersistentMapNodeObj* sub = node->child(c);
+        ObjectPtr<PersistentMapNodeObj> rep = Erase(sub, editable && sub->unique(), shift + kBits, hash, key, removed);
+        if (!*removed) {
+            return nullptr;
+        }
+        const PersistentMapNodeObj* new_sub = rep != nullptr ? rep.get() : sub;
+        if (new_sub->num_entries_ == 1 && new_sub->num_children() == 0) {
+            // keep the trie compact, a child with a single entry is inlined
+            return CopyChildToEntry(node, bit, c, new_sub->key(0), new_sub->value(0));
+        }
+        if (rep == nullptr) {
+            return nullptr;
+        }
+        return ReplaceSlot(node, editable, 2 * node->num_entries_ + c, ObjectRef(ObjectPtr<Object>(std::move(rep))));
+    }
+
+    /*! \return An empty node. */
+    static ObjectPtr<PersistentMapNodeObj> Empty() {
+        return Alloc(0, 0, 0);
+    }
+
+    TVM_FFI_DECLARE_OBJECT_INFO_FINAL("ffi.PersistentMapNode", PersistentMapNodeObj, Object);
+
+private:
+    /*! \return Size of initialized memory, used by InplaceArrayBase. */
+    NODISCARD size_t GetSize() const {
+        return static_cast<size_t>(size_);
+    }
+
+    /*! \brief Allocate a node with room for the given number of slots. */
+    static ObjectPtr<PersistentMapNodeObj> Alloc(uint32_t datamap, uint32_t nodemap, int32_t num_slots) {
+        ObjectPtr<PersistentMapNodeObj> p = make_inplace_array_object<PersistentMapNodeObj, TVMFFIAny>(num_slots);
+        p->datamap_ = datamap;
+        p->nodemap_ = nodemap;
+        p->size_ = 0;
+        p->num_entries_ = 0;
+        return p;
+    }
+
+    void Push(Any value) {
+        new (slots() + size_) Any(std::move(value));
+        ++size_;
+    }
+
+    /*! \brief Build a node that holds two entries whose hashes agree below shift. */
+    static ObjectPtr<PersistentMapNodeObj> MergeTwo(int32_t shift, Any k0, Any v0, uint64_t h0, Any k1, Any v1,
+                                                    uint64_t h1) {
+        if (shift >= kMaxShift) {
+            ObjectPtr<PersistentMapNodeObj> p = Alloc(0, 0, 4);
+            p->Push(std::move(k0));
+            p->Push(std::move(v0));
+            p->Push(std::move(k1));
+            p->Push(std::move(v1));
+            p->num_entries_ = 2;
+            return p;
+        }
+        uint32_t b0 = BitOf(h0, shift);
+        uint32_t b1 = BitOf(h1, shift);
+        if (b0 == b1) {
+            ObjectPtr<PersistentMapNodeObj> p = Alloc(0, b0, 1);
+            p->Push(ObjectRef(ObjectPtr<Object>(MergeTwo(shift + kBits, std::move(k0), std::move(v0), h0,
+                                                          std::move(k1), std::move(v1), h1))));
+            return p;
+        }
+        ObjectPtr<PersistentMapNodeObj> p = Alloc(b0 | b1, 0, 4);
+        if (b0 > b1) {
+            std::swap(k0, k1);
+            std::swap(v0, v1);
+        }
+        p->Push(std::move(k0));
+        p->Push(std::move(v0));
+        p->Push(std::move(k1));
+        p->Push(std::move(v1));
+        p->num_entries_ = 2;
+        return p;
+    }
+
+    /*! \brief Replace one slot, copying node unless it is editable. */
+    static ObjectPtr<PersistentMapNodeObj> ReplaceSlot(const PersistentMapNodeObj* node, bool editable, int32_t slot,
+                                                       Any value) {
+        if (editable) {
+            node->slots()[slot] = std::move(value);
+            return nullptr;
+        }
+        ObjectPtr<PersistentMapNodeObj> p = Alloc(node->datamap_, node->nodemap_, node->size_);
+        for (int32_t i = 0; i < node->size_; ++i) {
+            p->Push(i == slot ? std::move(value) : node->slots()[i]);
+        }
+        p->num_entries_ = node->num_entries_;
+        return p;
+    }
+
+    /*! \brief Copy node with a new entry inserted at entry index i. */
+    static ObjectPtr<PersistentMapNodeObj> CopyInsertEntry(const PersistentMapNodeObj* node, uint32_t bit, int32_t i,
+                                                           Any key, Any value) {
+        ObjectPtr<PersistentMapNodeObj> p = Alloc(node->datamap_ | bit, node->nodemap_, node->size_ + 2);
+        const Any* read = node->slots();
+        for (int32_t j = 0; j < 2 * i; ++j) p->Push(read[j]);
+        p->Push(std::move(key));
+        p->Push(std::move(value));
+        for (int32_t j = 2 * i; j < node->size_; ++j) p->Push(read[j]);
+        p->num_entries_ = node->num_entries_ + 1;
+        return p;
+    }
+
+    /*! \brief Copy node without the entry at index i. */
+    static ObjectPtr<PersistentMapNodeObj> CopyRemoveEntry(const PersistentMapNodeObj* node, uint32_t bit, int32_t i) {
+        ObjectPtr<PersistentMapNodeObj> p = Alloc(node->datamap_ & ~bit, node->nodemap_, node->size_ - 2);
+        const Any* read = node->slots();
+        for (int32_t j = 0; j < node->size_; ++j) {
+            if (j != 2 * i && j != 2 * i + 1) p->Push(read[j]);
+        }
+        p->num_entries_ = node->num_entries_ - 1;
+        return p;
+    }
+
+    /*! \brief Copy node with the entry at index i moved into a new child. */
+    static ObjectPtr<PersistentMapNodeObj> CopyEntryToChild(const PersistentMapNodeObj* node, uint32_t bit, int32_t i,
+                                                            ObjectPtr<PersistentMapNodeObj> sub) {
+        ObjectPtr<PersistentMapNodeObj> p = Alloc(node->datamap_ & ~bit, node->nodemap_ | bit, node->size_ - 1);
+        const Any* read = node->slots();
+        int32_t child_pos = std::popcount(node->nodemap_ & (bit - 1));
+        int32_t num_entries = node->num_entries_;
+        for (int32_t j = 0; j < 2 * num_entries; ++j) {
+            if (j != 2 * i && j != 2 * i + 1) p->Push(read[j]);
+        }
+        for (int32_t c = 0; c < node->num_children(); ++c) {
+            if (c == child_pos) p->Push(ObjectRef(ObjectPtr<Object>(std::move(sub))));
+            p->Push(read[2 * num_entries + c]);
+        }
+        if (child_pos == node->num_children()) {
+            p->Push(ObjectRef(ObjectPtr<Object>(std::move(sub))));
+        }
+        p->num_entries_ = num_entries - 1;
+        return p;
+    }
+
+    /*! \brief Copy node with the child at index c replaced by an inline entry. */
+    static ObjectPtr<PersistentMapNodeObj> CopyChildToEntry(const PersistentMapNodeObj* node, uint32_t bit, int32_t c,
+                                                            const Any& key, const Any& value) {
+        ObjectPtr<PersistentMapNodeObj> p = Alloc(node->datamap_ | bit, node->nodemap_ & ~bit, node->size_ + 1);
+        const Any* read = node->slots();
+        int32_t entry_pos = std::popcount(node->datamap_ & (bit - 1));
+        int32_t num_entries = node->num_entries_;
+        for (int32_t j = 0; j < num_entries; ++j) {
+            if (j == entry_pos) {
+                p->Push(key);
+                p->Push(value);
+            }
+            p->Push(read[2 * j]);
+            p->Push(read[2 * j + 1]);
+        }
+        if (entry_pos == num_entries) {
+            p->Push(key);
+            p->Push(value);
+        }
+        for (int32_t j = 0; j < node->num_children(); ++j) {
+            if (j != c) p->Push(read[2 * num_entries + j]);
+        }
+        p->num_entries_ = num_entries + 1;
+        return p;
+    }
+
+    /*! \brief Hash fragments stored as inline entries. */
+    uint32_t datamap_{0};
+    /*! \brief Hash fragments stored in children. */
+    uint32_t nodemap_{0};
+    /*! \brief Number of initialized slots. */
+    int32_t size_{0};
+    /*! \brief Number of inline entries. */
+    int32_t num_entries_{0};
+
+    friend InplaceArrayBase;
+};
+}// namespace details
+
+/*!
+ * \brief Persistent hash map content.
+ *
+ * Entries live in a hash array mapped trie. Updates copy only the nodes on
+ * the path to the changed entry, so every older version stays valid and
+ * shares all other nodes. Keys are hashed and compared with AnyHash and
+ * AnyEqual, like MapObj.
+ */
+class PersistentMapObj : public Object {
+public:
+    using Node = details::PersistentMapNodeObj;
+    /*! \brief Type of value stored in the hash map */
+    using KVType = std::pair<Any, Any>;
+
+    /*! \brief Iterator over the entries, visits each node's entries before its children. */
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = int64_t;
+        using value_type = KVType;
+        using pointer = value_type*;
+        using reference = value_type;
+
+        iterator() = default;
+
+        bool operator==(const iterator& other) const {
+            return node_ == other.node_ && index_ == other.index_;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+        /*! \return The current key */
+        NODISCARD const Any& key() const {
+            return node_->key(index_);
+        }
+
+        /*! \return The current value */
+        NODISCARD const Any& value() const {
+            return node_->value(index_);
+        }
+
+        reference operator*() const {
+            return {key(), value()};
+        }
+
+        iterator& operator++() {
+            Advance();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator copy = *this;
+            Advance();
+            return copy;
+        }
+
+    private:
+        explicit iterator(const Node* root) {
+            stack_[0] = {root, 0};
+            depth_ = 1;
+            Advance();
+        }
+
+        void Advance() {
+            while (depth_ > 0) {
+                Frame& frame = stack_[depth_ - 1];
+                if (frame.pos < frame.node->num_entries()) {
+                    node_ = frame.node;
+                    index_ = frame.pos++;
+                    return;
+                }
+                int32_t c = frame.pos - frame.node->num_entries();
+                if (c < frame.node->num_children()) {
+                    ++frame.pos;
+                    stack_[depth_++] = {frame.node->child(c), 0};
+                } else {
+                    --depth_;
+                }
+            }
+            node_ = nullptr;
+            index_ = 0;
+        }
+
+        struct Frame {
+            const Node* node;
+            int32_t pos;
+        };
+
+        Frame stack_[Node::kMaxDepth]{};
+        int32_t depth_{0};
+        const Node* node_{nullptr};
+        int32_t index_{0};
+
+        friend class PersistentMapObj;
+    };
+
+    /*! \return The number of entries */
+    NODISCARD size_t size() const {
+        return static_cast<size_t>(size_);
+    }
+
+    /*! \return The number of entries with the key, 0 or 1 */
+    NODISCARD size_t count(const Any& key) const {
+        return Find(key) != nullptr ? 1 : 0;
+    }
+
+    /*!
+   * \brief Find the value of a key.
+   * \param key The key.
+   * \return Pointer to the value, nullptr if not found.
+   */
+    NODISCARD const Any* Find(const Any& key) const {
+        return Node::Find(root_.get(), key, Node::Hash(key));
+    }
+
+    /*!
+   * \brief Read element from map.
+   * \param key The key
+   * \return the corresonding element.
+   */
+    NODISCARD const Any& at(const Any& key) const {
+        const Any* value = Find(key);
+        if (value == nullptr) {
+            TVM_FFI_THROW(KeyError) << "key is not in Map";
+        }
+        return *value;
+    }
+
+    NODISCARD iterator begin() const {
+        return iterator(root_.get());
+    }
+
+    NODISCARD iterator end() const {
+        return iterator();
+    }
+
+    /*! \return An empty map. */
+    static ObjectPtr<PersistentMapObj> Empty() {
+        ObjectPtr<PersistentMapObj> p = make_object<PersistentMapObj>();
+        p->root_ = Node::Empty();
+        return p;
+    }
+
+    /*!
+   * \brief Create a new version that shares all nodes with from.
+   * \param from The source map.
+   * \return The new version.
+   */
+    static ObjectPtr<PersistentMapObj> CopyFrom(const PersistentMapObj* from) {
+        ObjectPtr<PersistentMapObj> p = make_object<PersistentMapObj>();
+        p->size_ = from->size_;
+        p->root_ = from->root_;
+        return p;
+    }
+
+    static constexpr int32_t _type_index = kTVMFFIPersistentMap;
+    static constexpr bool _type_final = true;
+    TVM_FFI_DECLARE_OBJECT_INFO_STATIC(StaticTypeKey::kTVMFFIPersistentMap, PersistentMapObj, Object);
+
+private:
+    /*!
+   * \brief Insert or update an entry.
+   * \note The container must be uniquely owned.
+   */
+    void Set(Any key, Any value) {
+        bool added = false;
+        uint64_t hash = Node::Hash(key);
+        if (ObjectPtr<Node> rep = Node::Insert(root_.get(), root_.unique(), 0, hash, std::move(key), std::move(value), &added)) {
+            root_ = std::move(rep);
+        }
+        size_ += added;
+    }
+
+    /*!
+   * \brief Erase an entry if it exists.
+   * \note The container must be uniquely owned.
+   */
+    void Erase(const Any& key) {
+        bool removed = false;
+        if (ObjectPtr<Node> rep = Node::Erase(root_.get(), root_.unique(), 0, Node::Hash(key), key, &removed)) {
+            root_ = std::move(rep);
+        }
+        size_ -= removed;
+    }
+
+    /*! \brief Number of entries. */
+    int64_t size_{0};
+    /*! \brief Root of the trie. */
+    ObjectPtr<Node> root_;
+
+    template<typename, typename, typename>
+    friend class PersistentMap;
+};
+
+/*!
+ * \brief Hash map with structural sharing between versions.
+ *
+ * Copying a PersistentMap is O(1). Set and erase copy O(log32 n) nodes when
+ * the map is shared with another version and update in place when it is not,
+ * instead of copying the whole table like Map does. Iteration order is
+ * determined by the key hashes.
+ *
+ * \tparam K The key type.
+ * \tparam V The value type.
+ */
+template<typename K, typename V,
+         typename = std::enable_if_t<details::storage_enabled_v<K> && details::storage_enabled_v<V>>>
+class PersistentMap : public ObjectRef {
+public:
+    using key_type = K;
+    using mapped_type = V;
+
+    /*! \brief Iterator of the persistent map */
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = int64_t;
+        using value_type = const std::pair<K, V>;
+        using pointer = value_type*;
+        using reference = value_type;
+
+        iterator() = default;
+
+        bool operator==(const iterator& other) const {
+            return itr_ == other.itr_;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return itr_ != other.itr_;
+        }
+
+        pointer operator->() const = delete;
+
+        reference operator*() const {
+            return std::make_pair(details::AnyUnsafe::CopyFromAnyViewAfterCheck<K>(itr_.key()),
+                                  details::AnyUnsafe::CopyFromAnyViewAfterCheck<V>(itr_.value()));
+        }
+
+        iterator& operator++() {
+            ++itr_;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator copy = *this;
+            ++itr_;
+            return copy;
+        }
+
+    private:
+        explicit iterator(PersistentMapObj::iterator itr) : itr_(itr) {}
+
+        PersistentMapObj::iterator itr_;
+
+        friend class PersistentMap;
+    };
+
+    /*! \brief default constructor */
+    PersistentMap() : ObjectRef(PersistentMapObj::Empty()) {}
+
+    /*!
+   * \brief constructor from iterator
+   * \param first begin of iterator
+   * \param last end of iterator
+   * \tparam IterType The type of iterator
+   */
+    template<typename IterType>
+    PersistentMap(IterType first, IterType last) : PersistentMap() {
+        PersistentMapObj* p = GetMapObj();
+        for (; first != last; ++first) {
+            p->Set(Any((*first).first), Any((*first).second));
+        }
+    }
+
+    /*!
+   * \brief constructor from initializer list
+   * \param init The initalizer list
+   */
+    PersistentMap(std::initializer_list<std::pair<K, V>> init) : PersistentMap(init.begin(), init.end()) {}
+
+    /*!
+   * \brief constructor from Map
+   * \param map The map
+   */
+    explicit PersistentMap(const Map<K, V>& map) : PersistentMap(map.begin(), map.end()) {}
+
+    /*!
+   * \brief Read element from map.
+   * \param key The key
+   * \return the corresonding element.
+   */
+    const V at(const K& key) const {
+        return details::AnyUnsafe::CopyFromAnyViewAfterCheck<V>(GetMapObj()->at(key));
+    }
+
+    const V operator[](const K& key) const {
+        return this->at(key);
+    }
+
+    /*! \return The size of the map */
+    NODISCARD size_t size() const {
+        return GetMapObj()->size();
+    }
+
+    /*! \return The number of elements of the key */
+    NODISCARD size_t count(const K& key) const {
+        return GetMapObj()->count(key);
+    }
+
+    /*! \return whether the map is empty */
+    NODISCARD bool empty() const {
+        return size() == 0;
+    }
+
+    /*! \return The value associated with the key, std::nullopt if not found */
+    std::optional<V> Get(const K& key) const {
+        const Any* value = GetMapObj()->Find(key);
+        if (value == nullptr) {
+            return std::nullopt;
+        }
+        return details::AnyUnsafe::CopyFromAnyViewAfterCheck<V>(*value);
+    }
+
+    /*!
+   * \brief set the Map.
+   * \param key The index key.
+   * \param value The value to be setted.
+   */
+    void Set(const K& key, const V& value) {
+        CopyOnWrite()->Set(Any(key), Any(value));
+    }
+
+    /*!
+   * \brief Erase the entry of a key.
+   * \param key The key.
+   */
+    void erase(const K& key) {
+        CopyOnWrite()->Erase(Any(key));
+    }
+
+    /*! \brief Release reference to all the elements */
+    void clear() {
+        data_ = PersistentMapObj::Empty();
+    }
+
+    /*! \return begin iterator */
+    iterator begin() const {
+        return iterator(GetMapObj()->begin());
+    }
+
+    /*! \return end iterator */
+    iterator end() const {
+        return iterator(GetMapObj()->end());
+    }
+
+    /*! \return A regular Map with the same entries. */
+    NODISCARD Map<K, V> ToMap() const {
+        return Map<K, V>(begin(), end());
+    }
+
+    /*! \return The underlying PersistentMapObj */
+    NODISCARD PersistentMapObj* GetMapObj() const {
+        return static_cast<PersistentMapObj*>(data_.get());
+    }
+
+    TVM_FFI_DEFINE_OBJECT_REF_METHODS_NOTNULLABLE(PersistentMap, ObjectRef, PersistentMapObj);
+
+private:
+    /*!
+   * \brief Make the container uniquely owned, sharing the nodes with the other versions.
+   * \return The container.
+   */
+    PersistentMapObj* CopyOnWrite() {
+        if (!data_.unique()) {
+            data_ = PersistentMapObj::CopyFrom(GetMapObj());
+        }
+        return GetMapObj();
+    }
+};
+
+template<typename K, typename V>
+inline constexpr bool use_default_type_traits_v<PersistentMap<K, V>> = false;
+
+template<typename K, typename V>
+struct TypeTraits<PersistentMap<K, V>> : public ObjectRefTypeTraitsBase<PersistentMap<K, V>> {
+    static constexpr int32_t field_static_type_index = TypeIndex::kTVMFFIPersistentMap;
+    using ObjectRefTypeTraitsBase<PersistentMap<K, V>>::CopyFromAnyViewAfterCheck;
+
+    TVM_FFI_INLINE static std::string GetMismatchTypeInfo(const TVMFFIAny* src) {
+        if (src->type_index != TypeIndex::kTVMFFIPersistentMap) {
+            return TypeTraitsBase::GetMismatchTypeInfo(src);
+        }
+        if constexpr (!std::is_same_v<K, Any> || !std::is_same_v<V, Any>) {
+            const auto* n = reinterpret_cast<const PersistentMapObj*>(src->v_obj);
+            for (auto it = n->begin(); it != n->end(); ++it) {
+                if constexpr (!std::is_same_v<K, Any>) {
+                    if (!details::AnyUnsafe::CheckAnyStrict<K>(it.key()) && !it.key().try_cast<K>().has_value()) {
+                        return "PersistentMap[some key is " + details::AnyUnsafe::GetMismatchTypeInfo<K>(it.key()) +
+                               ", V]";
+                    }
+                }
+                if constexpr (!std::is_same_v<V, Any>) {
+                    if (!details::AnyUnsafe::CheckAnyStrict<V>(it.value()) && !it.value().try_cast<V>().has_value()) {
+                        return "PersistentMap[K, some value is " +
+                               details::AnyUnsafe::GetMismatchTypeInfo<V>(it.value()) + "]";
+                    }
+                }
+            }
+        }
+        TVM_FFI_THROW(InternalError) << "Cannot reach here";
+        TVM_FFI_UNREACHABLE();
+    }
+
+    TVM_FFI_INLINE static bool CheckAnyStrict(const TVMFFIAny* src) {
+        if (src->type_index != TypeIndex::kTVMFFIPersistentMap) return false;
+        if constexpr (std::is_same_v<K, Any> && std::is_same_v<V, Any>) {
+            return true;
+        } else {
+            const auto* n = reinterpret_cast<const PersistentMapObj*>(src->v_obj);
+            for (auto it = n->begin(); it != n->end(); ++it) {
+                if constexpr (!std::is_same_v<K, Any>) {
+                    if (!details::AnyUnsafe::CheckAnyStrict<K>(it.key())) return false;
+                }
+                if constexpr (!std::is_same_v<V, Any>) {
+                    if (!details::AnyUnsafe::CheckAnyStrict<V>(it.value())) return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    TVM_FFI_INLINE static std::optional<PersistentMap<K, V>> TryCastFromAnyView(const TVMFFIAny* src) {
+        if (src->type_index != TypeIndex::kTVMFFIPersistentMap) return std::nullopt;
+        if (CheckAnyStrict(src)) return CopyFromAnyViewAfterCheck(src);
+        // slow path, convert each entry
+        const auto* n = reinterpret_cast<const PersistentMapObj*>(src->v_obj);
+        PersistentMap<K, V> ret;
+        for (auto it = n->begin(); it != n->end(); ++it) {
+            auto k = it.key().try_cast<K>();
+            auto v = it.value().try_cast<V>();
+            if (!k.has_value() || !v.has_value()) return std::nullopt;
+            ret.Set(*std::move(k), *std::move(v));
+        }
+        return ret;
+    }
+
+    TVM_FFI_INLINE static std::string TypeStr() {
+        return "PersistentMap<" + details::Type2Str<K>::v() + ", " + details::Type2Str<V>::v() + ">";
+    }
+
+    TVM_FFI_INLINE static std::string TypeSchema() {
+        std::ostringstream oss;
+        oss << R"({"type":")" << StaticTypeKey::kTVMFFIPersistentMap << R"(","args":[)";
+        oss << details::TypeSchema<K>::v() << ",";
+        oss << details::TypeSchema<V>::v();
+        oss << "]}";
+        return oss.str();
+    }
+};
+
+namespace details {
+template<typename K, typename V, typename KU, typename VU>
+inline constexpr bool type_contains_v<PersistentMap<K, V>, PersistentMap<KU, VU>> =
+        type_contains_v<K, KU> && type_contains_v<V, VU>;
+}// namespace details
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_CONTAINER_PERSISTENT_MAP_H
@@ -0,0 +1,281 @@
+//
+// Created by richard on 10/18/26.
+//
+
+#ifndef LITETVM_FFI_CONTAINER_POD_ARRAY_H
+#define LITETVM_FFI_CONTAINER_POD_ARRAY_H
+
+#include "ffi/any.h"
+#include "ffi/container/array.h"
+#include "ffi/error.h"
+#include "ffi/memory.h"
+#include "ffi/type_traits.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace litetvm {
+namespace ffi {
+
+namespace details {
+/*!
+ * \brief Allocate a PODArrayObj with n uninitialized elements.
+ * \param n The number of elements.
+ * \param mutable_data Output pointer to the elements, can be nullptr.
+ * \return The array object.
+ */
+template<typename T>
+TVM_FFI_INLINE ObjectPtr<PODArrayObj> MakeEmptyPODArray(size_t n, T** mutable_data) {
+    static_assert(sizeof(PODArrayObj) % alignof(T) == 0);
+    ObjectPtr<PODArrayObj> p = make_inplace_array_object<PODArrayObj, T>(n);
+    T* data = reinterpret_cast<T*>(reinterpret_cast<char*>(p.get()) + sizeof(PODArrayObj));
+    if (mutable_data) {
+        *mutable_data = data;
+    }
+    p->dtype = PODArrayElemTraits<T>::dtype;
+    p->size = static_cast<int64_t>(n);
+    p->data = data;
+    return p;
+}
+}// namespace details
+
+/*!
+ * \brief Array of POD elements stored unboxed in contiguous memory.
+ *
+ * Array<int64_t> stores each element as a 16-byte Any, PODArray<int64_t> stores
+ * the raw values, so the elements can be accessed as a std::span and processed
+ * with vectorized loops. Array<T> arguments accept PODArray transparently.
+ *
+ * \code
+ *
+ * PODArray<int64_t> indices = {1, 2, 3};
+ * std::span<const int64_t> view = indices.span();
+ * Array<Any> boxed = indices.ToArray();
+ *
+ * \endcode
+ *
+ * \tparam T The element type, one of int64_t, double and bool.
+ * \note The array is copy-on-write, MutableSpan makes a unique copy when the storage is shared.
+ */
+template<typename T>
+class PODArray : public ObjectRef {
+public:
+    static_assert(details::PODArrayElemTraits<T>::enabled, "PODArray only supports int64_t, double and bool");
+
+    using value_type = T;
+    using iterator = const T*;
+
+    /*! \brief Construct an empty array. */
+    PODArray() : ObjectRef(details::MakeEmptyPODArray<T>(0, nullptr)) {}
+
+    /*!
+   * \brief Constructs an array with n elements. Each element is a copy of val
+   * \param n The size of the array
+   * \param val The init value
+   */
+    explicit PODArray(size_t n, T val = T()) {
+        T* data;
+        data_ = details::MakeEmptyPODArray<T>(n, &data);
+        std::fill_n(data, n, val);
+    }
+
+    /*!
+   * \brief Constructor from iterator
+   * \param first begin of iterator
+   * \param last end of iterator
+   * \tparam IterType The type of iterator
+   */
+    template<typename IterType,
+             typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag,
+                                                           typename std::iterator_traits<IterType>::iterator_category>>>
+    PODArray(IterType first, IterType last) {
+        T* data;
+        data_ = details::MakeEmptyPODArray<T>(std::distance(first, last), &data);
+        std::copy(first, last, data);
+    }
+
+    /*!
+   * \brief constructor from initializer list
+   * \param init The initializer list
+   */
+    PODArray(std::initializer_list<T> init) : PODArray(init.begin(), init.end()) {}// NOLINT(*)
+
+    /*!
+   * \brief constructor from a span, the elements are copied
+   * \param elems The elements
+   */
+    explicit PODArray(std::span<const T> elems) : PODArray(elems.begin(), elems.end()) {}
+
+    /*! \return The number of elements */
+    NODISCARD size_t size() const {
+        return static_cast<size_t>(get()->size);
+    }
+
+    /*! \return Whether the array is empty */
+    NODISCARD bool empty() const {
+        return size() == 0;
+    }
+
+    /*! \return The pointer to the first element */
+    NODISCARD const T* data() const {
+        return static_cast<const T*>(get()->data);
+    }
+
+    /*! \return begin iterator */
+    NODISCARD const T* begin() const {
+        return data();
+    }
+
+    /*! \return end iterator */
+    NODISCARD const T* end() const {
+        return data() + size();
+    }
+
+    /*!
+   * \brief Read i-th element without bound check.
+   * \param i The index
+   * \return the i-th element.
+   */
+    T operator[](size_t i) const {
+        return data()[i];
+    }
+
+    /*!
+   * \brief Read i-th element.
+   * \param i The index
+   * \return the i-th element.
+   */
+    T at(size_t i) const {
+        if (i >= size()) {
+            TVM_FFI_THROW(IndexError) << "Index " << i << " out of bounds " << size();
+        }
+        return data()[i];
+    }
+
+    /*! \return The elements as a span */
+    NODISCARD std::span<const T> span() const {
+        return {data(), size()};
+    }
+
+    /*!
+   * \brief Get the elements as a mutable span.
+   * \return The span.
+   * \note Makes a unique copy first when the storage is shared.
+   */
+    std::span<T> MutableSpan() {
+        if (!data_.unique()) {
+            data_ = PODArray(begin(), end()).data_;
+        }
+        return {static_cast<T*>(get()->data), size()};
+    }
+
+    /*!
+   * \brief Set i-th element.
+   * \param i The index
+   * \param value The value
+   */
+    void Set(size_t i, T value) {
+        if (i >= size()) {
+            TVM_FFI_THROW(IndexError) << "Index " << i << " out of bounds " << size();
+        }
+        MutableSpan()[i] = value;
+    }
+
+    /*!
+   * \brief Box the elements into an Array<Any>.
+   * \return The boxed array.
+   */
+    NODISCARD Array<Any> ToArray() const {
+        return Array<Any>(begin(), end());
+    }
+
+    /*!
+   * \brief Unbox the elements of an array.
+   * \param arr The array, each element must be convertible to T.
+   * \return The unboxed array, std::nullopt if an element cannot be converted.
+   */
+    static std::optional<PODArray> TryFromArray(const Array<Any>& arr) {
+        T* data;
+        PODArray result(details::MakeEmptyPODArray<T>(arr.size(), &data));
+        for (const Any& item: arr) {
+            if (auto opt = item.try_cast<T>()) {
+                *data++ = *opt;
+            } else {
+                return std::nullopt;
+            }
+        }
+        return result;
+    }
+
+    /*!
+   * \brief Unbox the elements of an array.
+   * \param arr The array, each element must be convertible to T.
+   * \return The unboxed array.
+   */
+    static PODArray FromArray(const Array<Any>& arr) {
+        if (auto opt = TryFromArray(arr)) {
+            return *std::move(opt);
+        }
+        TVM_FFI_THROW(TypeError) << "Cannot convert " << TypeTraits<Array<Any>>::TypeStr() << " to "
+                                 << details::Type2Str<PODArray>::v() << ", element mismatch";
+        TVM_FFI_UNREACHABLE();
+    }
+
+    TVM_FFI_DEFINE_OBJECT_REF_METHODS_NOTNULLABLE(PODArray, ObjectRef, PODArrayObj);
+
+private:
+    explicit PODArray(ObjectPtr<PODArrayObj> ptr) : ObjectRef(std::move(ptr)) {}
+};
+
+template<typename T>
+inline constexpr bool use_default_type_traits_v<PODArray<T>> = false;
+
+// PODArray accepts itself without copy, and unboxes an Array of convertible elements
+template<typename T>
+struct TypeTraits<PODArray<T>> : ObjectRefTypeTraitsBase<PODArray<T>> {
+    static constexpr int32_t field_static_type_index = kTVMFFIPODArray;
+    using ObjectRefTypeTraitsBase<PODArray<T>>::CopyFromAnyViewAfterCheck;
+
+    TVM_FFI_INLINE static bool CheckAnyStrict(const TVMFFIAny* src) {
+        return src->type_index == kTVMFFIPODArray &&
+               details::PODArrayElemTraits<T>::Match(reinterpret_cast<const PODArrayObj*>(src->v_obj)->dtype);
+    }
+
+    TVM_FFI_INLINE static std::optional<PODArray<T>> TryCastFromAnyView(const TVMFFIAny* src) {
+        if (CheckAnyStrict(src)) {
+            return CopyFromAnyViewAfterCheck(src);
+        }
+        if (src->type_index == kTVMFFIPODArray) {
+            // other element type, go through the boxed conversion
+            auto opt_arr = details::ArrayFromPODArray<Any>(reinterpret_cast<const PODArrayObj*>(src->v_obj));
+            return PODArray<T>::TryFromArray(*opt_arr);
+        }
+        if (src->type_index == kTVMFFIArray) {
+            return PODArray<T>::TryFromArray(TypeTraits<Array<Any>>::CopyFromAnyViewAfterCheck(src));
+        }
+        return std::nullopt;
+    }
+
+    TVM_FFI_INLINE static std::string TypeStr() {
+        return "PODArray<" + details::Type2Str<T>::v() + ">";
+    }
+
+    TVM_FFI_INLINE static std::string TypeSchema() {
+        std::ostringstream oss;
+        oss << R"({"type":")" << StaticTypeKey::kTVMFFIPODArray << R"(","args":[)";
+        oss << details::TypeSchema<T>::v();
+        oss << "]}";
+        return oss.str();
+    }
+};
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_CONTAINER_POD_ARRAY_H
@@ -6,6 +6,7 @@
 #define LITETVM_CONTAINER_SHAPE_H
 
 #include "ffi/container/array.h"
+#include "ffi/container/shape_ops.h"
 #include "ffi/error.h"
 #include "ffi/type_traits.h"
 
@@ -42,11 +43,7 @@ public:
 
     /*! \brief Get the product of the shape. */
     int64_t Product() const {
-        int64_t product = 1;
-        for (size_t i = 0; i < cell_.size; ++i) {
-            product *= cell_.data[i];
-        }
-        return product;
+        return ShapeOps::Numel(cell_.data, static_cast<int32_t>(cell_.size));
     }
 
     /*! \brief Get the i-th element of the shape. */
@@ -86,11 +83,7 @@ public:
 
     /*! \brief Get "numel", meaning the number of elements of an array if the array has this shape */
     NODISCARD int64_t Product() const {
-        int64_t product = 1;
-        for (size_t i = 0; i < this->size; ++i) {
-            product *= this->data[i];
-        }
-        return product;
+        return ShapeOps::Numel(this->data, static_cast<int32_t>(this->size));
     }
 
     static constexpr uint32_t _type_index = kTVMFFIShape;
@@ -110,8 +103,65 @@ private:
     std::vector<int64_t> data_;
 };
 
+/*!
+ * \brief Allocator of shape objects of small rank.
+ *
+ * Shapes of rank up to kMaxPooledRank are laid out in fixed size blocks that are recycled
+ * through a bounded thread-local pool, tensor code creates and drops such shapes at a high rate.
+ */
+class SmallShapeObjAllocator : public ObjAllocatorBase<SmallShapeObjAllocator> {
+public:
+    /*! \brief Maximum rank of the shapes kept in the pool. */
+    static constexpr size_t kMaxPooledRank = 4;
+    /*! \brief Maximum number of free blocks kept by each thread. */
+    static constexpr size_t kMaxPooledBlocks = 256;
+
+    template<typename ArrayType, typename ElemType>
+    class ArrayHandler {
+    public:
+        static ArrayType* New(SmallShapeObjAllocator*, size_t num_elems) {
+            static_assert(sizeof(ArrayType) + sizeof(ElemType) * kMaxPooledRank <= kBlockSize,
+                          "shape object does not fit the block");
+            TVM_FFI_ICHECK_LE(num_elems, kMaxPooledRank);
+            void* data = AcquireBlock();
+            new (data) ArrayType();
+            return reinterpret_cast<ArrayType*>(data);
+        }
+
+        static FObjectDeleter Deleter() {
+            return Deleter_;
+        }
+
+    private:
+        static void Deleter_(void* objptr, int flags) {
+            ArrayType* tptr = ObjectUnsafe::RawObjectPtrFromUnowned<ArrayType>(static_cast<TVMFFIObject*>(objptr));
+            if (flags & kTVMFFIObjectDeleterFlagBitMaskStrong) {
+                tptr->ArrayType::~ArrayType();
+            }
+            if (flags & kTVMFFIObjectDeleterFlagBitMaskWeak) {
+                ReleaseBlock(tptr);
+            }
+        }
+    };
+
+private:
+    static constexpr size_t kBlockSize = sizeof(ShapeObj) + sizeof(int64_t) * kMaxPooledRank;
+
+    using BlockPool = ThreadLocalBlockPool<kBlockSize, alignof(ShapeObj), kMaxPooledBlocks>;
+
+    static void* AcquireBlock() {
+        return BlockPool::Acquire();
+    }
+
+    static void ReleaseBlock(void* block) {
+        BlockPool::Release(block);
+    }
+};
+
 TVM_FFI_INLINE ObjectPtr<ShapeObj> MakeEmptyShape(size_t length, int64_t** mutable_data) {
-    ObjectPtr<ShapeObj> p = make_inplace_array_object<ShapeObj, int64_t>(length);
+    ObjectPtr<ShapeObj> p = length <= SmallShapeObjAllocator::kMaxPooledRank
+                                    ? SmallShapeObjAllocator().make_inplace_array<ShapeObj, int64_t>(length)
+                                    : make_inplace_array_object<ShapeObj, int64_t>(length);
     static_assert(alignof(ShapeObj) % alignof(int64_t) == 0);
     static_assert(sizeof(ShapeObj) % alignof(int64_t) == 0);
     auto* data = reinterpret_cast<int64_t*>(reinterpret_cast<char*>(p.get()) + sizeof(ShapeObj));
@@ -133,6 +183,40 @@ TVM_FFI_INLINE ObjectPtr<ShapeObj> MakeInplaceShape(Iter begin, Iter end) {
     return p;
 }
 
+/*!
+ * \brief Create a shape from a vector, small shapes are copied into a pooled object.
+ * \param other The vector.
+ * \return The shape.
+ */
+TVM_FFI_INLINE ObjectPtr<ShapeObj> MakeShapeFromVector(std::vector<int64_t> other) {
+    if (other.size() <= SmallShapeObjAllocator::kMaxPooledRank) {
+        return MakeInplaceShape(other.begin(), other.end());
+    }
+    return make_object<ShapeObjStdImpl>(std::move(other));
+}
+
+/*!
+ * \brief Direct mapped per-thread cache of interned shapes.
+ *
+ * A shape that collides with a cached one of different content replaces it, so the cache
+ * never grows beyond kNumSlots shapes per thread.
+ */
+class ShapeInternCache {
+public:
+    /*! \brief Number of hash bits that select the slot. */
+    static constexpr int kSlotBits = 8;
+    /*! \brief Number of slots of the cache. */
+    static constexpr size_t kNumSlots = static_cast<size_t>(1) << kSlotBits;
+
+    /*!
+     * \brief Get the cached shape of the given content, defined in the library so that the
+     *  cache is shared by every module of the process.
+     * \param shape The shape content.
+     * \return The interned shape object.
+     */
+    TVM_FFI_DLL static ObjectPtr<ShapeObj> Intern(ShapeView shape);
+};
+
 /*!
  * \brief Get the product of a shape.
  * \param shape The input shape.
@@ -140,11 +224,7 @@ TVM_FFI_INLINE ObjectPtr<ShapeObj> MakeInplaceShape(Iter begin, Iter end) {
  * \return The product of the shape.
  */
 TVM_FFI_INLINE void FillStridesFromShape(ShapeView shape, int64_t* out_strides) {
-    int64_t stride = 1;
-    for (int64_t i = static_cast<int64_t>(shape.size()) - 1; i >= 0; --i) {
-        out_strides[i] = stride;
-        stride *= shape[i];
-    }
+    ShapeOps::FillContiguousStrides(shape.data(), static_cast<int32_t>(shape.size()), out_strides);
 }
 
 /*!
@@ -206,7 +286,7 @@ public:
    * \param other a int64_t array.
    */
     Shape(std::vector<int64_t> other)// NOLINT(*)
-        : ObjectRef(make_object<details::ShapeObjStdImpl>(std::move(other))) {}
+        : ObjectRef(details::MakeShapeFromVector(std::move(other))) {}
 
     /*!
    * \brief constructor from shape view.
@@ -223,6 +303,17 @@ public:
         return Shape(details::MakeStridesFromShape(shape));
     }
 
+    /*!
+   * \brief Get a shared shape with the given content from the interning cache of this thread.
+   * \param shape The shape content.
+   * \return The shape, repeated calls with the same content return the same object while it stays cached.
+   * \note Shapes are immutable, so sharing them is safe, and comparing two interned shapes
+   *       usually ends at the same_as check.
+   */
+    static Shape Intern(ShapeView shape) {
+        return Shape(details::ShapeInternCache::Intern(shape));
+    }
+
     /*!
    * \brief Convert to shape view.
    * \return The shape view.
@@ -303,7 +394,7 @@ private:
     explicit Shape(ObjectPtr<ShapeObj> ptr) : ObjectRef(std::move(ptr)) {}
 };
 
-inline std::ostream& operator<<(std::ostream& os, const Shape& shape) {
+inline std::ostream& operator<<(std::ostream& os, ShapeView shape) {
     os << '[';
     for (size_t i = 0; i < shape.size(); ++i) {
         if (i != 0) {
@@ -315,6 +406,10 @@ inline std::ostream& operator<<(std::ostream& os, const Shape& shape) {
     return os;
 }
 
+inline std::ostream& operator<<(std::ostream& os, const Shape& shape) {
+    return os << ShapeView(shape);
+}
+
 // Shape
 template<>
 inline constexpr bool use_default_type_traits_v<Shape> = false;
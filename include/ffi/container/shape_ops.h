@@ -0,0 +1,413 @@
+//
+// Created by richard on 10/19/26.
+//
+
+#ifndef LITETVM_FFI_CONTAINER_SHAPE_OPS_H
+#define LITETVM_FFI_CONTAINER_SHAPE_OPS_H
+
+#include "ffi/base_details.h"
+#include "ffi/error.h"
+
+#include <dlpack/dlpack.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace litetvm {
+namespace ffi {
+
+/*!
+ * \brief Arithmetic on shapes and strides given as (data, ndim).
+ *
+ * Ranks 0 to kMaxFixedRank dispatch to kernels with the rank as a template argument, so the
+ * loops over the dims are unrolled; larger ranks use the same kernels with a runtime rank.
+ * Functions prefixed with Checked validate the dims and throw ValueError on negative dims
+ * or int64/size_t overflow.
+ */
+class ShapeOps {
+public:
+    /*! \brief Maximum rank with a dedicated kernel. */
+    static constexpr int32_t kMaxFixedRank = 8;
+    /*! \brief Rank template argument of the runtime rank kernels. */
+    static constexpr int32_t kDynamicRank = -1;
+
+    /*!
+   * \brief Number of elements of a shape.
+   * \param shape The shape.
+   * \param ndim The rank.
+   * \return The product of the dims.
+   */
+    static int64_t Numel(const int64_t* shape, int32_t ndim) {
+        return DispatchRank(ndim, [&](auto rank) { return NumelImpl<decltype(rank)::value>(shape, ndim); });
+    }
+    /*!
+   * \brief Number of elements of a shape, checked.
+   * \param shape The shape.
+   * \param ndim The rank.
+   * \return The product of the dims.
+   */
+    static int64_t CheckedNumel(const int64_t* shape, int32_t ndim) {
+        return DispatchRank(ndim, [&](auto rank) { return CheckedNumelImpl<decltype(rank)::value>(shape, ndim); });
+    }
+    /*!
+   * \brief Number of bytes to store a tensor of a shape and dtype densely, checked.
+   * \param shape The shape.
+   * \param ndim The rank.
+   * \param dtype The data type, sub-byte types other than uint1 are packed.
+   * \return The number of bytes.
+   */
+    static size_t CheckedDataSize(const int64_t* shape, int32_t ndim, DLDataType dtype) {
+        uint64_t numel = static_cast<uint64_t>(CheckedNumel(shape, ndim));
+        // compatible handling sub-byte uint1(bool), which usually stored as uint8_t
+        if (dtype.code == kDLUInt && dtype.bits == 1 && dtype.lanes == 1) {
+            return CheckedCast(numel);
+        }
+        uint64_t bits;
+        if (MulOverflow(numel, static_cast<uint64_t>(dtype.bits) * dtype.lanes, &bits) ||
+            bits > std::numeric_limits<uint64_t>::max() - 7) {
+            TVM_FFI_THROW(ValueError) << "Data size of shape " << ShapeStr(shape, ndim) << " overflows";
+        }
+        return CheckedCast((bits + 7) / 8);
+    }
+    /*!
+   * \brief Check that a tensor of a shape and dtype can be stored densely, for callers that size the data themselves.
+   * \param shape The shape.
+   * \param ndim The rank.
+   * \param dtype The data type.
+   * \throws ValueError if a dim is negative or the data size overflows.
+   */
+    static void CheckDataSize(const int64_t* shape, int32_t ndim, DLDataType dtype) {
+        static_cast<void>(CheckedDataSize(shape, ndim, dtype));
+    }
+    /*!
+   * \brief Fill the strides of a contiguous tensor.
+   * \param shape The shape.
+   * \param ndim The rank.
+   * \param out_strides The output strides, ndim elements.
+   * \return The number of elements, computed in the same pass.
+   */
+    static int64_t FillContiguousStrides(const int64_t* shape, int32_t ndim, int64_t* out_strides) {
+        return DispatchRank(ndim, [&](auto rank) {
+            return FillContiguousStridesImpl<decltype(rank)::value>(shape, ndim, out_strides);
+        });
+    }
+    /*!
+   * \brief Check if strides describe a contiguous layout of a shape.
+   * \param shape The shape.
+   * \param strides The strides, nullptr means contiguous.
+   * \param ndim The rank.
+   * \return The check result, the strides of dims of extent 1 are not checked.
+   */
+    static bool IsContiguous(const int64_t* shape, const int64_t* strides, int32_t ndim) {
+        if (strides == nullptr) {
+            return true;
+        }
+        return DispatchRank(ndim, [&](auto rank) {
+            return IsContiguousImpl<decltype(rank)::value>(shape, strides, ndim);
+        });
+    }
+    /*!
+   * \brief Numpy broadcast of two shapes, aligned at the last dim.
+   * \param lhs The left shape.
+   * \param lhs_ndim The rank of lhs.
+   * \param rhs The right shape.
+   * \param rhs_ndim The rank of rhs.
+   * \param out The output shape, max(lhs_ndim, rhs_ndim) elements.
+   * \return The rank of the output.
+   */
+    static int32_t BroadcastShape(const int64_t* lhs, int32_t lhs_ndim, const int64_t* rhs, int32_t rhs_ndim,
+                                  int64_t* out) {
+        int32_t ndim = lhs_ndim > rhs_ndim ? lhs_ndim : rhs_ndim;
+        DispatchRank(ndim, [&](auto rank) {
+            BroadcastShapeImpl<decltype(rank)::value>(lhs, lhs_ndim, rhs, rhs_ndim, out, ndim);
+            return 0;
+        });
+        return ndim;
+    }
+    /*!
+   * \brief Resolve the target shape of a reshape, at most one dim can be -1.
+   * \param numel The number of elements of the source.
+   * \param shape The target shape.
+   * \param ndim The target rank.
+   * \param out The resolved shape, ndim elements.
+   * \note Throws ValueError if the number of elements does not match.
+   */
+    static void InferReshape(int64_t numel, const int64_t* shape, int32_t ndim, int64_t* out) {
+        int32_t infer_dim = -1;
+        int64_t known = 1;
+        for (int32_t i = 0; i < ndim; ++i) {
+            out[i] = shape[i];
+            if (shape[i] == -1) {
+                if (infer_dim != -1) {
+                    TVM_FFI_THROW(ValueError) << "Reshape to " << ShapeStr(shape, ndim)
+                                              << " can infer at most one dim";
+                }
+                infer_dim = i;
+            } else if (shape[i] < 0 || MulOverflow(known, shape[i], &known)) {
+                TVM_FFI_THROW(ValueError) << "Invalid reshape target " << ShapeStr(shape, ndim);
+            }
+        }
+        if (infer_dim != -1) {
+            if (known == 0 || numel % known != 0) {
+                TVM_FFI_THROW(ValueError) << "Cannot reshape " << numel << " elements to " << ShapeStr(shape, ndim);
+            }
+            out[infer_dim] = numel / known;
+        } else if (known != numel) {
+            TVM_FFI_THROW(ValueError) << "Cannot reshape " << numel << " elements to " << ShapeStr(shape, ndim);
+        }
+    }
+    /*!
+   * \brief Compute the strides of a view of a strided tensor with another shape of the same numel.
+   * \param shape The source shape.
+   * \param strides The source strides, not nullptr.
+   * \param ndim The source rank.
+   * \param new_shape The target shape, resolved.
+   * \param new_ndim The target rank.
+   * \param out_strides The target strides, new_ndim elements.
+   * \return Whether the target shape can view the source memory without a copy.
+   *
+   * Source dims are grouped into chunks that are contiguous with each other, a target dim
+   * must not span two chunks.
+   */
+    static bool ComputeViewStrides(const int64_t* shape, const int64_t* strides, int32_t ndim,
+                                   const int64_t* new_shape, int32_t new_ndim, int64_t* out_strides) {
+        int64_t numel = Numel(shape, ndim);
+        if (numel == 0 || ndim == 0) {
+            // any strides work for an empty tensor or a scalar
+            if (Numel(new_shape, new_ndim) != numel) {
+                return false;
+            }
+            FillContiguousStrides(new_shape, new_ndim, out_strides);
+            return true;
+        }
+        int32_t view_d = new_ndim - 1;
+        int64_t chunk_base_stride = strides[ndim - 1];
+        int64_t tensor_numel = 1;
+        int64_t view_numel = 1;
+        for (int32_t tensor_d = ndim - 1; tensor_d >= 0; --tensor_d) {
+            tensor_numel *= shape[tensor_d];
+            // a chunk ends where the next outer dim is not contiguous with it
+            if (tensor_d == 0 ||
+                (shape[tensor_d - 1] != 1 && strides[tensor_d - 1] != tensor_numel * chunk_base_stride)) {
+                while (view_d >= 0 && (view_numel < tensor_numel || new_shape[view_d] == 1)) {
+                    out_strides[view_d] = view_numel * chunk_base_stride;
+                    view_numel *= new_shape[view_d];
+                    --view_d;
+                }
+                if (view_numel != tensor_numel) {
+                    return false;
+                }
+                if (tensor_d > 0) {
+                    chunk_base_stride = strides[tensor_d - 1];
+                    tensor_numel = 1;
+                    view_numel = 1;
+                }
+            }
+        }
+        return view_d == -1;
+    }
+
+    /*!
+   * \brief Range of element offsets reached by a strided tensor, relative to its first element.
+   * \param shape The shape.
+   * \param strides The strides, not nullptr unless ndim is 0.
+   * \param ndim The rank.
+   * \param min_offset The smallest offset, non-positive.
+   * \param max_offset The largest offset, non-negative.
+   * \return False if the tensor has no elements, the offsets are not set then.
+   * \note Throws ValueError if an offset overflows int64.
+   */
+    static bool ElementSpan(const int64_t* shape, const int64_t* strides, int32_t ndim, int64_t* min_offset,
+                            int64_t* max_offset) {
+        *min_offset = 0;
+        *max_offset = 0;
+        for (int32_t i = 0; i < ndim; ++i) {
+            if (shape[i] == 0) {
+                return false;
+            }
+        }
+        for (int32_t i = 0; i < ndim; ++i) {
+            int64_t extent;
+            int64_t* bound = strides[i] < 0 ? min_offset : max_offset;
+            if (MulOverflow(shape[i] - 1, strides[i], &extent) || AddOverflow(*bound, extent, bound)) {
+                TVM_FFI_THROW(ValueError) << "Offsets of shape " << ShapeStr(shape, ndim) << " with strides "
+                                          << ShapeStr(strides, ndim) << " overflow";
+            }
+        }
+        return true;
+    }
+
+    /*!
+   * \brief Multiply two int64, checked.
+   * \param a The lhs.
+   * \param b The rhs.
+   * \param out The product, set only without overflow.
+   * \return Whether the product overflows.
+   */
+    TVM_FFI_INLINE static bool MulOverflow(int64_t a, int64_t b, int64_t* out) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_mul_overflow(a, b, out);
+#else
+        constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+        constexpr int64_t kMin = std::numeric_limits<int64_t>::min();
+        if (a > 0 ? (b > 0 ? a > kMax / b : b < kMin / a)
+                  : (b > 0 ? a < kMin / b : (a != 0 && b < kMax / a))) {
+            return true;
+        }
+        *out = a * b;
+        return false;
+#endif
+    }
+
+    /*!
+   * \brief Add two int64, checked.
+   * \param a The lhs.
+   * \param b The rhs.
+   * \param out The sum, set only without overflow.
+   * \return Whether the sum overflows.
+   */
+    TVM_FFI_INLINE static bool AddOverflow(int64_t a, int64_t b, int64_t* out) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_add_overflow(a, b, out);
+#else
+        if ((b > 0 && a > std::numeric_limits<int64_t>::max() - b) ||
+            (b < 0 && a < std::numeric_limits<int64_t>::min() - b)) {
+            return true;
+        }
+        *out = a + b;
+        return false;
+#endif
+    }
+
+private:
+    template<typename F>
+    TVM_FFI_INLINE static std::invoke_result_t<F, std::integral_constant<int32_t, kDynamicRank>> DispatchRank(
+            int32_t ndim, F&& f) {
+        switch (ndim) {
+            case 0: return f(std::integral_constant<int32_t, 0>());
+            case 1: return f(std::integral_constant<int32_t, 1>());
+            case 2: return f(std::integral_constant<int32_t, 2>());
+            case 3: return f(std::integral_constant<int32_t, 3>());
+            case 4: return f(std::integral_constant<int32_t, 4>());
+            case 5: return f(std::integral_constant<int32_t, 5>());
+            case 6: return f(std::integral_constant<int32_t, 6>());
+            case 7: return f(std::integral_constant<int32_t, 7>());
+            case 8: return f(std::integral_constant<int32_t, 8>());
+            default: return f(std::integral_constant<int32_t, kDynamicRank>());
+        }
+    }
+    static_assert(kMaxFixedRank == 8, "DispatchRank lists the fixed ranks");
+
+    template<int32_t kRank>
+    TVM_FFI_INLINE static int32_t Rank(int32_t ndim) {
+        if constexpr (kRank == kDynamicRank) {
+            return ndim;
+        } else {
+            return kRank;
+        }
+    }
+
+    template<int32_t kRank>
+    static int64_t NumelImpl(const int64_t* shape, int32_t ndim) {
+        int64_t numel = 1;
+        for (int32_t i = 0; i < Rank<kRank>(ndim); ++i) {
+            numel *= shape[i];
+        }
+        return numel;
+    }
+
+    template<int32_t kRank>
+    static int64_t CheckedNumelImpl(const int64_t* shape, int32_t ndim) {
+        int64_t numel = 1;
+        bool invalid = false;
+        for (int32_t i = 0; i < Rank<kRank>(ndim); ++i) {
+            invalid |= shape[i] < 0;
+            invalid |= MulOverflow(numel, shape[i], &numel);
+        }
+        if (invalid) {
+            TVM_FFI_THROW(ValueError) << "Invalid shape " << ShapeStr(shape, ndim)
+                                      << ", dims must be non-negative and the product must fit in int64";
+        }
+        return numel;
+    }
+
+    template<int32_t kRank>
+    static int64_t FillContiguousStridesImpl(const int64_t* shape, int32_t ndim, int64_t* out_strides) {
+        int64_t stride = 1;
+        for (int32_t i = Rank<kRank>(ndim) - 1; i >= 0; --i) {
+            out_strides[i] = stride;
+            stride *= shape[i];
+        }
+        return stride;
+    }
+
+    template<int32_t kRank>
+    static bool IsContiguousImpl(const int64_t* shape, const int64_t* strides, int32_t ndim) {
+        int64_t expected_stride = 1;
+        bool contiguous = true;
+        for (int32_t i = Rank<kRank>(ndim) - 1; i >= 0; --i) {
+            // Skip stride check if shape[i] is 1, where the dimension is contiguous
+            // regardless of the value of stride, PyTorch normalizes such strides to 1.
+            // More context: https://github.com/pytorch/pytorch/pull/83158
+            contiguous &= shape[i] == 1 || strides[i] == expected_stride;
+            expected_stride *= shape[i];
+        }
+        return contiguous;
+    }
+
+    template<int32_t kRank>
+    static void BroadcastShapeImpl(const int64_t* lhs, int32_t lhs_ndim, const int64_t* rhs, int32_t rhs_ndim,
+                                   int64_t* out, int32_t ndim) {
+        bool compatible = true;
+        for (int32_t i = 0; i < Rank<kRank>(ndim); ++i) {
+            int32_t lhs_i = i - (Rank<kRank>(ndim) - lhs_ndim);
+            int32_t rhs_i = i - (Rank<kRank>(ndim) - rhs_ndim);
+            int64_t l = lhs_i >= 0 ? lhs[lhs_i] : 1;
+            int64_t r = rhs_i >= 0 ? rhs[rhs_i] : 1;
+            compatible &= l == r || l == 1 || r == 1;
+            out[i] = l == 1 ? r : l;
+        }
+        if (!compatible) {
+            TVM_FFI_THROW(ValueError) << "Cannot broadcast " << ShapeStr(lhs, lhs_ndim) << " with "
+                                      << ShapeStr(rhs, rhs_ndim);
+        }
+    }
+
+    TVM_FFI_INLINE static bool MulOverflow(uint64_t a, uint64_t b, uint64_t* out) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_mul_overflow(a, b, out);
+#else
+        if (a != 0 && b > std::numeric_limits<uint64_t>::max() / a) {
+            return true;
+        }
+        *out = a * b;
+        return false;
+#endif
+    }
+
+    static size_t CheckedCast(uint64_t value) {
+        if (value > std::numeric_limits<size_t>::max()) {
+            TVM_FFI_THROW(ValueError) << "Data size " << value << " does not fit in size_t";
+        }
+        return static_cast<size_t>(value);
+    }
+
+    static std::string ShapeStr(const int64_t* shape, int32_t ndim) {
+        std::ostringstream os;
+        os << '[';
+        for (int32_t i = 0; i < ndim; ++i) {
+            os << (i != 0 ? ", " : "") << shape[i];
+        }
+        os << ']';
+        return os.str();
+    }
+};
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_CONTAINER_SHAPE_OPS_H
@@ -6,10 +6,13 @@
 #define LITETVM_FFI_CONTAINER_NDARRAY_H
 
 #include <ffi/container/shape.h>
+#include <ffi/container/shape_ops.h>
 #include <ffi/dtype.h>
 #include <ffi/error.h>
 
+#include <algorithm>
 #include <atomic>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -33,29 +36,7 @@ inline bool IsDirectAddressDevice(const DLDevice& device) {
  * \return The check result.
  */
 inline bool IsContiguous(const DLTensor& arr) {
-    if (arr.strides == nullptr) {
-        return true;
-    }
-
-    int64_t expected_stride = 1;
-    for (int32_t i = arr.ndim; i != 0; --i) {
-        int32_t k = i - 1;
-        if (arr.shape[k] == 1) {
-            // Skip stride check if shape[k] is 1, where the dimension is contiguous
-            // regardless of the value of stride.
-            //
-            // For example, PyTorch will normalize stride to 1 if shape is 1 when exporting
-            // to DLPack.
-            // More context: https://github.com/pytorch/pytorch/pull/83158
-            continue;
-        }
-
-        if (arr.strides[k] != expected_stride) {
-            return false;
-        }
-        expected_stride *= arr.shape[k];
-    }
-    return true;
+    return ShapeOps::IsContiguous(arr.shape, arr.strides, arr.ndim);
 }
 
 /**
@@ -96,11 +77,7 @@ inline size_t GetDataSize(size_t numel, DLDataType dtype) {
  *  \return number of  bytes of data in the DLTensor.
  */
 inline size_t GetDataSize(const DLTensor& arr) {
-    size_t size = 1;
-    for (int i = 0; i < arr.ndim; ++i) {
-        size *= static_cast<size_t>(arr.shape[i]);
-    }
-    return GetDataSize(size, arr.dtype);
+    return GetDataSize(static_cast<size_t>(ShapeOps::Numel(arr.shape, arr.ndim)), arr.dtype);
 }
 
 /*! \brief An object representing an NDArray. */
@@ -112,10 +89,11 @@ public:
     /*!
    * \brief Move NDArray to a DLPack managed tensor.
    * \return The converted DLPack managed tensor.
+   * \note The managed tensor is recycled through a thread-local pool once its deleter runs.
    */
     NODISCARD DLManagedTensor* ToDLPack() const {
         TensorObj* self = const_cast<TensorObj*>(this);
-        DLManagedTensor* ret = new DLManagedTensor();
+        DLManagedTensor* ret = new (ManagedTensorPool::Acquire()) DLManagedTensor();
         ret->dl_tensor = *static_cast<DLTensor*>(self);
         ret->manager_ctx = self;
         ret->deleter = DLManagedTensorDeleter<DLManagedTensor>;
@@ -126,10 +104,11 @@ public:
     /*!
    * \brief Move  NDArray to a DLPack managed tensor.
    * \return The converted DLPack managed tensor.
+   * \note The managed tensor is recycled through a thread-local pool once its deleter runs.
    */
     NODISCARD DLManagedTensorVersioned* ToDLPackVersioned() const {
         TensorObj* self = const_cast<TensorObj*>(this);
-        DLManagedTensorVersioned* ret = new DLManagedTensorVersioned();
+        DLManagedTensorVersioned* ret = new (ManagedTensorPool::Acquire()) DLManagedTensorVersioned();
         ret->version.major = DLPACK_MAJOR_VERSION;
         ret->version.minor = DLPACK_MINOR_VERSION;
         ret->dl_tensor = *static_cast<DLTensor*>(self);
@@ -140,11 +119,49 @@ public:
     }
 
 protected:
+    /*! \brief Maximum number of free managed tensors kept by each thread. */
+    static constexpr size_t kMaxPooledManagedTensors = 64;
+
+    using ManagedTensorPool = details::ThreadLocalBlockPool<
+            std::max(sizeof(DLManagedTensor), sizeof(DLManagedTensorVersioned)),
+            std::max(alignof(DLManagedTensor), alignof(DLManagedTensorVersioned)), kMaxPooledManagedTensors>;
+
     template<typename TDLManagedTensor>
     static void DLManagedTensorDeleter(TDLManagedTensor* tensor) {
         TensorObj* obj = static_cast<TensorObj*>(tensor->manager_ctx);
         details::ObjectUnsafe::DecRefObjectHandle(obj);
-        delete tensor;
+        static_assert(std::is_trivially_destructible_v<TDLManagedTensor>);
+        ManagedTensorPool::Release(tensor);
+    }
+
+    /*!
+   * \brief Take back a tensor exported by ToDLPack or ToDLPackVersioned.
+   * \param tensor The managed tensor.
+   * \return The exported tensor, or nullptr if the managed tensor is not ours or was modified.
+   * \note On success the managed tensor is released and its reference moved to the result.
+   */
+    template<typename TDLManagedTensor>
+    static ObjectPtr<TensorObj> UnwrapDLPack(TDLManagedTensor* tensor) {
+        if (tensor->deleter != DLManagedTensorDeleter<TDLManagedTensor>) {
+            return nullptr;
+        }
+        TensorObj* obj = static_cast<TensorObj*>(tensor->manager_ctx);
+        const DLTensor& dl_tensor = tensor->dl_tensor;
+        if (dl_tensor.data != obj->data || dl_tensor.shape != obj->shape || dl_tensor.strides != obj->strides ||
+            dl_tensor.ndim != obj->ndim || dl_tensor.byte_offset != obj->byte_offset ||
+            dl_tensor.dtype.code != obj->dtype.code || dl_tensor.dtype.bits != obj->dtype.bits ||
+            dl_tensor.dtype.lanes != obj->dtype.lanes || dl_tensor.device.device_type != obj->device.device_type ||
+            dl_tensor.device.device_id != obj->device.device_id) {
+            return nullptr;
+        }
+        if constexpr (std::is_same_v<TDLManagedTensor, DLManagedTensorVersioned>) {
+            // exports carry no flags
+            if (tensor->flags != 0) {
+                return nullptr;
+            }
+        }
+        ManagedTensorPool::Release(tensor);
+        return details::ObjectUnsafe::ObjectPtrFromOwned<TensorObj>(obj);
     }
 
     friend class Tensor;
@@ -171,7 +188,7 @@ public:
         this->shape = reinterpret_cast<int64_t*>(reinterpret_cast<char*>(this) + sizeof(Self));
         this->strides = this->shape + shape.size();
         std::copy(shape.begin(), shape.end(), this->shape);
-        details::FillStridesFromShape(shape, this->strides);
+        ShapeOps::FillContiguousStrides(this->shape, this->ndim, this->strides);
         // call allocator to alloc data
         alloc_.AllocData(static_cast<DLTensor*>(this), std::forward<ExtraArgs>(extra_args)...);
     }
@@ -195,8 +212,7 @@ public:
         *static_cast<DLTensor*>(this) = tensor_->dl_tensor;
         if (extra_strides_at_tail) {
             this->strides = reinterpret_cast<int64_t*>(reinterpret_cast<char*>(this) + sizeof(Self));
-            details::FillStridesFromShape(ShapeView(tensor_->dl_tensor.shape, tensor_->dl_tensor.ndim),
-                                          this->strides);
+            ShapeOps::FillContiguousStrides(this->shape, this->ndim, this->strides);
         }
     }
 
@@ -210,8 +226,37 @@ public:
 private:
     TDLPackManagedTensor* tensor_;
 };
+
+/*!
+ * \brief Tensor that shares the data of a base tensor, created by the view functions of Tensor.
+ *
+ * Shape and strides are allocated inplace after the object and filled by the creator.
+ */
+class TensorObjView : public TensorObj {
+public:
+    using Self = TensorObjView;
+
+    TensorObjView(ObjectPtr<Object> base, int32_t ndim, DLDataType dtype, uint64_t byte_offset)
+        : base_(std::move(base)) {
+        const TensorObj* base_tensor = static_cast<const TensorObj*>(base_.get());
+        this->data = base_tensor->data;
+        this->device = base_tensor->device;
+        this->ndim = ndim;
+        this->dtype = dtype;
+        this->byte_offset = byte_offset;
+        this->shape = reinterpret_cast<int64_t*>(reinterpret_cast<char*>(this) + sizeof(Self));
+        this->strides = this->shape + ndim;
+    }
+
+private:
+    // keeps the data of the base alive
+    ObjectPtr<Object> base_;
+};
 }// namespace details
 
+// defined in ffi/container/mapped_file.h
+struct MapOptions;
+
 /*!
  * \brief Managed NDArray.
  *  The array is backed by reference counted blocks.
@@ -291,6 +336,8 @@ public:
     template<typename TNDAlloc, typename... ExtraArgs>
     static Tensor FromNDAlloc(TNDAlloc alloc, ShapeView shape, DLDataType dtype, DLDevice device,
                               ExtraArgs&&... extra_args) {
+        // the allocator sizes the data itself, reject negative dims and sizes that overflow before it does
+        ShapeOps::CheckDataSize(shape.data(), static_cast<int32_t>(shape.size()), dtype);
         // inplace alloc shape and strides after data structure (as a result why multiply 2)
         size_t num_extra_i64_at_tail = shape.size() * 2;
         return Tensor(make_inplace_array_object<details::TensorObjFromNDAlloc<TNDAlloc>, int64_t>(
@@ -325,6 +372,7 @@ public:
                     << "FromDLPackAlloc: allocator is nullptr, "
                     << "likely because TVMFFIEnvSetTensorAllocator has not been called.";
         }
+        ShapeOps::CheckDataSize(shape.data(), static_cast<int32_t>(shape.size()), dtype);
         DLTensor prototype;
         prototype.device = device;
         prototype.dtype = dtype;
@@ -370,6 +418,7 @@ public:
    */
     static Tensor FromDLPack(DLManagedTensor* tensor, size_t require_alignment = 0,
                              bool require_contiguous = false) {
+        ShapeOps::CheckedNumel(tensor->dl_tensor.shape, tensor->dl_tensor.ndim);
         if (require_alignment != 0 && !ffi::IsAligned(tensor->dl_tensor, require_alignment)) {
             TVM_FFI_THROW(RuntimeError) << "FromDLPack: Data is not aligned to " << require_alignment
                                         << " bytes.";
@@ -377,6 +426,9 @@ public:
         if (require_contiguous && !ffi::IsContiguous(tensor->dl_tensor)) {
             TVM_FFI_THROW(RuntimeError) << "FromDLPack: Tensor is not contiguous.";
         }
+        if (ObjectPtr<TensorObj> obj = TensorObj::UnwrapDLPack(tensor)) {
+            return Tensor(std::move(obj));
+        }
         if (tensor->dl_tensor.strides != nullptr || tensor->dl_tensor.ndim == 0) {
             return Tensor(make_object<details::TensorObjFromDLPack<DLManagedTensor>>(
                     tensor, /*extra_strides_at_tail=*/false));
@@ -395,6 +447,7 @@ public:
    */
     static Tensor FromDLPackVersioned(DLManagedTensorVersioned* tensor, size_t require_alignment = 0,
                                       bool require_contiguous = false) {
+        ShapeOps::CheckedNumel(tensor->dl_tensor.shape, tensor->dl_tensor.ndim);
         if (require_alignment != 0 && !ffi::IsAligned(tensor->dl_tensor, require_alignment)) {
             TVM_FFI_THROW(RuntimeError) << "FromDLPack: Data is not aligned to " << require_alignment
                                         << " bytes.";
@@ -405,6 +458,9 @@ public:
         if (tensor->flags & DLPACK_FLAG_BITMASK_IS_SUBBYTE_TYPE_PADDED) {
             TVM_FFI_THROW(RuntimeError) << "Subbyte type padded is not yet supported";
         }
+        if (ObjectPtr<TensorObj> obj = TensorObj::UnwrapDLPack(tensor)) {
+            return Tensor(std::move(obj));
+        }
         if (tensor->dl_tensor.strides != nullptr || tensor->dl_tensor.ndim == 0) {
             return Tensor(make_object<details::TensorObjFromDLPack<DLManagedTensorVersioned>>(
                     tensor, /*extra_strides_at_tail=*/false));
@@ -415,6 +471,223 @@ public:
                                                    /*extra_strides_at_tail=*/true));
     }
 
+    /*!
+   * \brief Create a contiguous view of the tensor data with another shape and dtype.
+   * \param shape The shape of the view.
+   * \param dtype The data type of the view.
+   * \param relative_byte_offset The offset of the view from the start of the tensor, in bytes.
+   * \return The view, it keeps the tensor alive.
+   * \note The tensor must be contiguous and the view must fit in its data.
+   */
+    NODISCARD Tensor CreateView(ShapeView shape, DLDataType dtype, int64_t relative_byte_offset = 0) const {
+        const TensorObj* self = get();
+        if (!ffi::IsContiguous(*self)) {
+            TVM_FFI_THROW(ValueError) << "CreateView: the tensor is not contiguous";
+        }
+        size_t view_size = ShapeOps::CheckedDataSize(shape.data(), static_cast<int32_t>(shape.size()), dtype);
+        size_t self_size = GetDataSize(*self);
+        if (relative_byte_offset < 0 || static_cast<size_t>(relative_byte_offset) > self_size ||
+            view_size > self_size - static_cast<size_t>(relative_byte_offset)) {
+            TVM_FFI_THROW(ValueError) << "CreateView: a view of " << view_size << " bytes at offset "
+                                      << relative_byte_offset << " does not fit in " << self_size << " bytes";
+        }
+        auto view = MakeView(static_cast<int32_t>(shape.size()), dtype, self->byte_offset + relative_byte_offset);
+        std::copy(shape.begin(), shape.end(), view->shape);
+        ShapeOps::FillContiguousStrides(view->shape, view->ndim, view->strides);
+        return Tensor(std::move(view));
+    }
+
+    /*!
+   * \brief Slice a dim of the tensor without copying, with the semantics of python slices.
+   * \param dim The dim to slice, negative values count from the last dim.
+   * \param begin The first index, negative values count from the end, clamped to the extent.
+   * \param end The index past the last, negative values count from the end, clamped to the extent.
+   * \param step The step between indices, positive.
+   * \return The view, it keeps the tensor alive.
+   */
+    NODISCARD Tensor Slice(int64_t dim, int64_t begin, int64_t end, int64_t step = 1) const {
+        const TensorObj* self = get();
+        int64_t elem_bytes = ElementBytes(self->dtype, "Slice");
+        int32_t d = NormalizeDim(dim, self->ndim, "Slice");
+        if (step <= 0) {
+            TVM_FFI_THROW(ValueError) << "Slice: step must be positive, got " << step;
+        }
+        int64_t extent = self->shape[d];
+        begin = begin < 0 ? std::max<int64_t>(begin + extent, 0) : std::min(begin, extent);
+        end = end < 0 ? std::max<int64_t>(end + extent, 0) : std::min(end, extent);
+        int64_t length = end > begin ? (end - begin - 1) / step + 1 : 0;
+        int64_t stride;
+        if (ShapeOps::MulOverflow(self->strides[d], step, &stride)) {
+            TVM_FFI_THROW(ValueError) << "Slice: stride " << self->strides[d] << " with step " << step
+                                      << " overflows";
+        }
+        uint64_t byte_offset = ViewByteOffset(length != 0 ? begin : 0, self->strides[d], elem_bytes, "Slice");
+        auto view = MakeView(self->ndim, self->dtype, byte_offset);
+        std::copy(self->shape, self->shape + self->ndim, view->shape);
+        std::copy(self->strides, self->strides + self->ndim, view->strides);
+        view->shape[d] = length;
+        view->strides[d] = stride;
+        return Tensor(std::move(view));
+    }
+
+    /*!
+   * \brief Reshape the tensor without copying.
+   * \param shape The new shape, one dim can be -1 to be inferred.
+   * \return The view, it keeps the tensor alive.
+   * \note Throws ValueError if the strides of the tensor do not allow the new shape as a view.
+   */
+    NODISCARD Tensor Reshape(ShapeView shape) const {
+        const TensorObj* self = get();
+        int32_t ndim = static_cast<int32_t>(shape.size());
+        auto view = MakeView(ndim, self->dtype, self->byte_offset);
+        ShapeOps::InferReshape(ShapeOps::Numel(self->shape, self->ndim), shape.data(), ndim, view->shape);
+        if (!ShapeOps::ComputeViewStrides(self->shape, self->strides, self->ndim, view->shape, ndim,
+                                          view->strides)) {
+            TVM_FFI_THROW(ValueError) << "Reshape: the strides of the tensor do not allow shape "
+                                      << ShapeView(view->shape, ndim) << " without a copy";
+        }
+        return Tensor(std::move(view));
+    }
+
+    /*!
+   * \brief Permute the dims of the tensor without copying.
+   * \param dims The dim of the tensor at each dim of the view, negative values count from the last dim.
+   * \return The view, it keeps the tensor alive.
+   */
+    NODISCARD Tensor Permute(ShapeView dims) const {
+        const TensorObj* self = get();
+        if (static_cast<int32_t>(dims.size()) != self->ndim) {
+            TVM_FFI_THROW(ValueError) << "Permute: expect " << self->ndim << " dims, got " << dims.size();
+        }
+        auto view = MakeView(self->ndim, self->dtype, self->byte_offset);
+        for (int32_t i = 0; i < self->ndim; ++i) {
+            int32_t d = NormalizeDim(dims[i], self->ndim, "Permute");
+            for (int32_t j = 0; j < i; ++j) {
+                if (NormalizeDim(dims[j], self->ndim, "Permute") == d) {
+                    TVM_FFI_THROW(ValueError) << "Permute: dim " << d << " is repeated in " << dims;
+                }
+            }
+            view->shape[i] = self->shape[d];
+            view->strides[i] = self->strides[d];
+        }
+        return Tensor(std::move(view));
+    }
+
+    /*!
+   * \brief Create a view with arbitrary shape and strides.
+   * \param shape The shape of the view.
+   * \param strides The strides of the view, in elements.
+   * \param storage_offset The offset of the first element of the view from the first element
+   *  of the tensor, in elements.
+   * \return The view, it keeps the tensor alive.
+   * \note The elements of the view must lie in the memory spanned by the tensor.
+   */
+    NODISCARD Tensor AsStrided(ShapeView shape, ShapeView strides, int64_t storage_offset = 0) const {
+        const TensorObj* self = get();
+        int64_t elem_bytes = ElementBytes(self->dtype, "AsStrided");
+        int32_t ndim = static_cast<int32_t>(shape.size());
+        if (strides.size() != shape.size()) {
+            TVM_FFI_THROW(ValueError) << "AsStrided: shape " << shape << " and strides " << strides
+                                      << " differ in rank";
+        }
+        ShapeOps::CheckedNumel(shape.data(), ndim);
+        int64_t view_min, view_max, self_min, self_max;
+        if (ShapeOps::ElementSpan(shape.data(), strides.data(), ndim, &view_min, &view_max)) {
+            bool self_nonempty = ShapeOps::ElementSpan(self->shape, self->strides, self->ndim, &self_min, &self_max);
+            if (!self_nonempty || storage_offset < self_min || storage_offset > self_max ||
+                view_min < self_min - storage_offset || view_max > self_max - storage_offset) {
+                TVM_FFI_THROW(ValueError) << "AsStrided: shape " << shape << " with strides " << strides
+                                          << " at offset " << storage_offset
+                                          << " reaches outside the memory of the tensor";
+            }
+        }
+        auto view = MakeView(ndim, self->dtype, ViewByteOffset(storage_offset, 1, elem_bytes, "AsStrided"));
+        std::copy(shape.begin(), shape.end(), view->shape);
+        std::copy(strides.begin(), strides.end(), view->strides);
+        return Tensor(std::move(view));
+    }
+
+    /*!
+   * \brief Copy the elements of a CPU tensor into another CPU tensor.
+   *
+   * The strides of both tensors are collapsed into the fewest loops, contiguous, broadcast
+   * and transposed layouts take dedicated kernels and large copies run on ThreadPool::Global.
+   *
+   * \param dst The destination, its shape must be the shape of this tensor or one this
+   *  tensor broadcasts to. Its elements must not overlap with the elements of this tensor.
+   * \note The elements are converted when the dtypes differ, supported are bool, int, uint,
+   *  float and bfloat of 8 to 64 bits and the float8 dtypes.
+   */
+    TVM_FFI_DLL void CopyTo(const Tensor& dst) const;
+
+    /*!
+   * \brief Get a contiguous tensor with the elements of this tensor.
+   * \return This tensor if it is contiguous, otherwise a contiguous copy on kDLCPU, also for
+   *  pinned host tensors.
+   */
+    TVM_FFI_DLL Tensor Contiguous() const;
+
+    /*!
+   * \brief Get a contiguous CPU tensor with the elements of this tensor converted to a dtype.
+   *
+   * Besides the dtypes of CopyTo, int4, uint4 and float4_e2m1fn are supported, packed two
+   * elements per byte with the first in the low nibble. Floats round to nearest even, and to
+   * int4 and uint4 saturate as in Quantize, other integers convert as static_cast.
+   *
+   * \param dtype The dtype of the result.
+   * \return This tensor if it is contiguous and of the dtype, otherwise the converted copy.
+   */
+    TVM_FFI_DLL Tensor AsType(DLDataType dtype) const;
+
+    /*!
+   * \brief Quantize the elements of this CPU tensor, divided by a scale.
+   *
+   * The elements are converted to float32, divided by the scale of their channel and rounded
+   * to nearest even. Integer results saturate, NaN quantizes to integer 0.
+   *
+   * \param dtype The dtype of the result: int4, uint4, int8, uint8, a float8 dtype or
+   *  float4_e2m1fn.
+   * \param scale The float scales, one element for a per-tensor scale or one per channel.
+   * \param axis The dim of the channels, negative counts from the last dim. Unused with a
+   *  per-tensor scale.
+   * \return The contiguous quantized tensor.
+   */
+    TVM_FFI_DLL Tensor Quantize(DLDataType dtype, const Tensor& scale, int64_t axis = 0) const;
+
+    /*!
+   * \brief Dequantize the elements of this CPU tensor, multiplied by a scale.
+   *
+   * \param dtype The float dtype of the result.
+   * \param scale The float scales, one element for a per-tensor scale or one per channel.
+   * \param axis The dim of the channels, negative counts from the last dim.
+   * \return The contiguous dequantized tensor.
+   * \note This tensor must have one of the dtypes of Quantize.
+   */
+    TVM_FFI_DLL Tensor Dequantize(DLDataType dtype, const Tensor& scale, int64_t axis = 0) const;
+
+    /*!
+   * \brief Map a tensor stored in C order in a file, without copying.
+   * \param path The file path.
+   * \param offset The offset of the tensor data in the file.
+   * \param shape The shape.
+   * \param dtype The dtype.
+   * \return The CPU tensor, it keeps the file mapped. Writes to it do not reach the file.
+   * \sa MappedFile, LoadTensorFile
+   */
+    TVM_FFI_DLL static Tensor LoadMapped(const String& path, int64_t offset, ShapeView shape, DLDataType dtype);
+
+    /*!
+   * \brief Map a tensor stored in C order in a file, without copying.
+   * \param path The file path.
+   * \param offset The offset of the tensor data in the file.
+   * \param shape The shape.
+   * \param dtype The dtype.
+   * \param options The mapping options.
+   * \return The CPU tensor, it keeps the file mapped. Writes to it do not reach the file.
+   */
+    TVM_FFI_DLL static Tensor LoadMapped(const String& path, int64_t offset, ShapeView shape, DLDataType dtype,
+                                         const MapOptions& options);
+
     /*!
    * \brief Convert the NDArray to a DLPack managed tensor.
    * \return The converted DLPack managed tensor.
@@ -441,6 +714,48 @@ protected:
     NODISCARD TensorObj* get_mutable() const {
         return const_cast<TensorObj*>(get());
     }
+
+private:
+    ObjectPtr<details::TensorObjView> MakeView(int32_t ndim, DLDataType dtype, uint64_t byte_offset) const {
+        return make_inplace_array_object<details::TensorObjView, int64_t>(
+                static_cast<size_t>(ndim) * 2, details::ObjectUnsafe::ObjectPtrFromObjectRef<Object>(*this), ndim,
+                dtype, byte_offset);
+    }
+
+    static int64_t ElementBytes(DLDataType dtype, const char* op) {
+        int64_t bits = static_cast<int64_t>(dtype.bits) * dtype.lanes;
+        if (bits % 8 != 0) {
+            TVM_FFI_THROW(ValueError) << op << ": byte offsets of sub-byte dtype " << dtype << " are not supported";
+        }
+        return bits / 8;
+    }
+
+    /*!
+   * \brief Byte offset of a view whose first element is index * stride elements past the first element.
+   * \note Throws ValueError if the offset overflows or is before the start of the data, which
+   *  the unsigned byte_offset cannot express.
+   */
+    uint64_t ViewByteOffset(int64_t index, int64_t stride, int64_t elem_bytes, const char* op) const {
+        const TensorObj* self = get();
+        int64_t offset;
+        if (ShapeOps::MulOverflow(index, stride, &offset) || ShapeOps::MulOverflow(offset, elem_bytes, &offset) ||
+            self->byte_offset > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) ||
+            ShapeOps::AddOverflow(static_cast<int64_t>(self->byte_offset), offset, &offset)) {
+            TVM_FFI_THROW(ValueError) << op << ": the byte offset of the view overflows";
+        }
+        if (offset < 0) {
+            TVM_FFI_THROW(ValueError) << op << ": the view starts " << -offset
+                                      << " bytes before the data pointer, byte_offset cannot be negative";
+        }
+        return static_cast<uint64_t>(offset);
+    }
+
+    static int32_t NormalizeDim(int64_t dim, int32_t ndim, const char* op) {
+        if (dim < -static_cast<int64_t>(ndim) || dim >= ndim) {
+            TVM_FFI_THROW(IndexError) << op << ": dim " << dim << " is out of range for rank " << ndim;
+        }
+        return static_cast<int32_t>(dim < 0 ? dim + ndim : dim);
+    }
 };
 
 /*!
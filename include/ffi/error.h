@@ -10,11 +10,14 @@
 #include "ffi/memory.h"
 #include "ffi/object.h"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -72,32 +75,188 @@ public:
 };
 
 namespace details {
+/*!
+ * \brief Allocator of error objects.
+ *
+ * Error objects are laid out in one block together with their strings. Blocks up to
+ * kBlockSize bytes are recycled through bounded thread-local pools, one per size class
+ * from kMinBlockSize up by powers of two, so a hot throw path does not go back to the
+ * system allocator for every error and a small error does not hold a large block.
+ */
+class ErrorObjAllocator : public ObjAllocatorBase<ErrorObjAllocator> {
+public:
+    /*! \brief Size of the smallest pooled blocks. */
+    static constexpr size_t kMinBlockSize = 256;
+    /*! \brief Size of the largest pooled blocks. */
+    static constexpr size_t kBlockSize = 2048;
+    /*! \brief Maximum number of free blocks of each size kept by each thread. */
+    static constexpr size_t kMaxPooledBlocks = 8;
+
+    template<typename ArrayType, typename ElemType>
+    class ArrayHandler {
+    public:
+        template<typename... Args>
+        static ArrayType* New(ErrorObjAllocator*, size_t num_elems, Args&&... args) {
+            static_assert(alignof(ArrayType) <= kBlockHeaderSize, "error object alignment constraint");
+            // the block header records the requested size so the deleter knows where the block goes
+            size_t size = kBlockHeaderSize + sizeof(ArrayType) + sizeof(ElemType) * num_elems;
+            void* block = AcquireBlock<kMinBlockSize>(size);
+            *static_cast<size_t*>(block) = size;
+            void* data = static_cast<char*>(block) + kBlockHeaderSize;
+            new (data) ArrayType(std::forward<Args>(args)...);
+            return reinterpret_cast<ArrayType*>(data);
+        }
+
+        static FObjectDeleter Deleter() {
+            return Deleter_;
+        }
+
+    private:
+        static void Deleter_(void* objptr, int flags) {
+            ArrayType* tptr = ObjectUnsafe::RawObjectPtrFromUnowned<ArrayType>(static_cast<TVMFFIObject*>(objptr));
+            if (flags & kTVMFFIObjectDeleterFlagBitMaskStrong) {
+                tptr->ArrayType::~ArrayType();
+            }
+            if (flags & kTVMFFIObjectDeleterFlagBitMaskWeak) {
+                void* block = reinterpret_cast<char*>(tptr) - kBlockHeaderSize;
+                ReleaseBlock<kMinBlockSize>(block, *static_cast<size_t*>(block));
+            }
+        }
+    };
+
+private:
+    static constexpr size_t kBlockHeaderSize = 16;
+
+    template<size_t kSize>
+    using BlockPool = ThreadLocalBlockPool<kSize, kBlockHeaderSize, kMaxPooledBlocks>;
+
+    // take a block of the smallest size class from kSize up that fits
+    template<size_t kSize>
+    static void* AcquireBlock(size_t size) {
+        if constexpr (kSize <= kBlockSize) {
+            return size <= kSize ? BlockPool<kSize>::Acquire() : AcquireBlock<kSize * 2>(size);
+        } else {
+            return AlignedAlloc<kBlockHeaderSize>(size);
+        }
+    }
+
+    template<size_t kSize>
+    static void ReleaseBlock(void* block, size_t size) {
+        if constexpr (kSize <= kBlockSize) {
+            if (size <= kSize) {
+                BlockPool<kSize>::Release(block);
+            } else {
+                ReleaseBlock<kSize * 2>(block, size);
+            }
+        } else {
+            AlignedFree(block);
+        }
+    }
+};
+
+/*!
+ * \brief Error object created from the C++ side.
+ *
+ * The object is a single allocation laid out as
+ * [ErrorObjFromStd][raw program counters][kind\0][message\0][backtrace\0].
+ * A backtrace that is symbolized or updated later moves into backtrace_data_.
+ */
 class ErrorObjFromStd : public ErrorObj {
 public:
-    ErrorObjFromStd(std::string kind, std::string message, std::string backtrace)
-        : kind_data_(std::move(kind)), message_data_(std::move(message)), backtrace_data_(std::move(backtrace)) {
-        this->kind = TVMFFIByteArray{kind_data_.data(), kind_data_.length()};
-        this->message = TVMFFIByteArray{message_data_.data(), message_data_.length()};
-        this->backtrace = TVMFFIByteArray{backtrace_data_.data(), backtrace_data_.length()};
-        this->update_backtrace = UpdateBacktrace;
+    ErrorObjFromStd() = default;
+
+    /*!
+     * \brief Create an error with a formatted backtrace.
+     */
+    static ObjectPtr<ErrorObjFromStd> Create(std::string_view kind, std::string_view message,
+                                             std::string_view backtrace) {
+        ObjectPtr<ErrorObjFromStd> obj = Allocate(0, kind, message, backtrace);
+        std::call_once(obj->symbolized_, [] {});
+        return obj;
+    }
+
+    /*!
+     * \brief Create an error from a raw traceback, the backtrace is symbolized on first access.
+     */
+    static ObjectPtr<ErrorObjFromStd> Create(std::string_view kind, std::string_view message,
+                                             const TVMFFIRawTraceback& raw) {
+        ObjectPtr<ErrorObjFromStd> obj = Allocate(raw.num_frames, kind, message, std::string_view());
+        std::copy(raw.pcs, raw.pcs + raw.num_frames, obj->RawPcs());
+        obj->raw_filename_ = raw.filename;
+        obj->raw_func_ = raw.func;
+        obj->raw_lineno_ = raw.lineno;
+        return obj;
     }
 
 private:
+    static ObjectPtr<ErrorObjFromStd> Allocate(int32_t num_raw_pcs, std::string_view kind,
+                                               std::string_view message, std::string_view backtrace) {
+        size_t num_bytes = sizeof(uintptr_t) * num_raw_pcs + kind.size() + message.size() + backtrace.size() + 3;
+        ObjectPtr<ErrorObjFromStd> obj =
+                ErrorObjAllocator().make_inplace_array<ErrorObjFromStd, char>(num_bytes);
+        obj->num_raw_pcs_ = num_raw_pcs;
+        char* cursor = reinterpret_cast<char*>(obj->RawPcs() + num_raw_pcs);
+        obj->kind = CopyString(kind, &cursor);
+        obj->message = CopyString(message, &cursor);
+        obj->backtrace = CopyString(backtrace, &cursor);
+        obj->update_backtrace = UpdateBacktrace;
+        return obj;
+    }
+
+    static TVMFFIByteArray CopyString(std::string_view str, char** cursor) {
+        char* data = *cursor;
+        std::memcpy(data, str.data(), str.size());
+        data[str.size()] = '\0';
+        *cursor += str.size() + 1;
+        return TVMFFIByteArray{data, str.size()};
+    }
+
+    uintptr_t* RawPcs() {
+        static_assert(sizeof(ErrorObjFromStd) % alignof(uintptr_t) == 0);
+        return reinterpret_cast<uintptr_t*>(this + 1);
+    }
+
+    void EnsureSymbolized() {
+        std::call_once(symbolized_, [this] {
+            TVMFFIRawTraceback raw;
+            raw.filename = raw_filename_;
+            raw.func = raw_func_;
+            raw.lineno = raw_lineno_;
+            raw.num_frames = num_raw_pcs_;
+            std::copy(RawPcs(), RawPcs() + num_raw_pcs_, raw.pcs);
+            const TVMFFIByteArray* symbolized = TVMFFITracebackSymbolize(&raw);
+            backtrace_data_.assign(symbolized->data, symbolized->size);
+            this->backtrace = TVMFFIByteArray{backtrace_data_.data(), backtrace_data_.length()};
+        });
+    }
+
     static void UpdateBacktrace(TVMFFIObjectHandle self, const TVMFFIByteArray* backtrace_str, int32_t update_mode) {
         ErrorObjFromStd* obj = static_cast<ErrorObjFromStd*>(self);
         if (update_mode == kTVMFFIBacktraceUpdateModeReplace) {
-            obj->backtrace_data_.resize(backtrace_str->size);
-            std::memcpy(obj->backtrace_data_.data(), backtrace_str->data, backtrace_str->size);
-            obj->backtrace = TVMFFIByteArray{obj->backtrace_data_.data(), obj->backtrace_data_.length()};
+            // the pending traceback is discarded
+            std::call_once(obj->symbolized_, [] {});
+            obj->backtrace_data_.assign(backtrace_str->data, backtrace_str->size);
         } else {
+            obj->EnsureSymbolized();
+            // the accessors of Error append nothing to force symbolization
+            if (backtrace_str->size == 0) return;
+            if (obj->backtrace.data != obj->backtrace_data_.data()) {
+                // the backtrace still lives in the inline storage
+                obj->backtrace_data_.assign(obj->backtrace.data, obj->backtrace.size);
+            }
             obj->backtrace_data_.append(backtrace_str->data, backtrace_str->size);
-            obj->backtrace = TVMFFIByteArray{obj->backtrace_data_.data(), obj->backtrace_data_.length()};
         }
+        obj->backtrace = TVMFFIByteArray{obj->backtrace_data_.data(), obj->backtrace_data_.length()};
     }
 
-    std::string kind_data_;
-    std::string message_data_;
+    // backtrace that no longer fits the inline storage
     std::string backtrace_data_;
+    // raw traceback waiting for symbolization, the program counters are stored inline
+    const char* raw_filename_{nullptr};
+    const char* raw_func_{nullptr};
+    int32_t raw_lineno_{0};
+    int32_t num_raw_pcs_{0};
+    std::once_flag symbolized_;
 };
 }// namespace details
 
@@ -108,11 +267,19 @@ private:
 class Error : public ObjectRef, public std::exception {
 public:
     Error(const std::string& kind, const std::string& message, const std::string& backtrace) {
-        data_ = make_object<details::ErrorObjFromStd>(kind, message, backtrace);
+        data_ = details::ErrorObjFromStd::Create(kind, message, backtrace);
+    }
+
+    Error(const std::string& kind, const std::string& message, const TVMFFIByteArray* backtrace) {
+        data_ = details::ErrorObjFromStd::Create(kind, message, std::string_view(backtrace->data, backtrace->size));
     }
 
-    Error(const std::string& kind, const std::string& message, const TVMFFIByteArray* backtrace)
-        : Error(kind, message, std::string(backtrace->data, backtrace->size)) {}
+    /*!
+   * \brief Construct from a raw traceback that is symbolized when the backtrace is first read.
+   */
+    Error(const std::string& kind, const std::string& message, const TVMFFIRawTraceback& raw) {
+        data_ = details::ErrorObjFromStd::Create(kind, message, raw);
+    }
 
     NODISCARD std::string kind() const {
         auto* obj = static_cast<ErrorObj*>(data_.get());
@@ -132,7 +299,7 @@ public:
   * \sa TracebackMostRecentCallLast
   */
     NODISCARD std::string backtrace() const {
-        ErrorObj* obj = static_cast<ErrorObj*>(data_.get());
+        ErrorObj* obj = SymbolizedErrorObj();
         return std::string(obj->backtrace.data, obj->backtrace.size);
     }
 
@@ -144,7 +311,7 @@ public:
     std::string TracebackMostRecentCallLast() const {
         // add placeholder for the first line
         std::vector<int64_t> line_breakers = {-1};
-        ErrorObj* obj = static_cast<ErrorObj*>(data_.get());
+        ErrorObj* obj = SymbolizedErrorObj();
         for (size_t i = 0; i < obj->backtrace.size; i++) {
             if (obj->backtrace.data[i] == '\n') {
                 line_breakers.push_back(i);
@@ -174,19 +341,49 @@ public:
     }
 
     NODISCARD const char* what() const noexcept override {
+        // the buffer is reused across calls, so only a longer message grows it
         thread_local std::string what_data;
         auto* obj = static_cast<ErrorObj*>(data_.get());
-        what_data = std::string("Traceback (most recent call last):\n") +
-                    TracebackMostRecentCallLast() + std::string(obj->kind.data, obj->kind.size) +
-                    std::string(": ") + std::string(obj->message.data, obj->message.size) + '\n';
+        what_data.clear();
+        what_data.append("Traceback (most recent call last):\n");
+        what_data.append(TracebackMostRecentCallLast());
+        what_data.append(obj->kind.data, obj->kind.size);
+        what_data.append(": ");
+        what_data.append(obj->message.data, obj->message.size);
+        what_data.push_back('\n');
         return what_data.c_str();
     }
 
     TVM_FFI_DEFINE_OBJECT_REF_METHODS_NOTNULLABLE(Error, ObjectRef, ErrorObj);
+
+private:
+    /*!
+   * \brief Get the error object with its backtrace populated.
+   * \note Appending an empty backtrace forces a lazily captured traceback to be symbolized.
+   */
+    ErrorObj* SymbolizedErrorObj() const {
+        ErrorObj* obj = static_cast<ErrorObj*>(data_.get());
+        // errors created outside this library may not provide the callback
+        if (obj->update_backtrace != nullptr) {
+            TVMFFIByteArray empty{nullptr, 0};
+            obj->update_backtrace(obj, &empty, kTVMFFIBacktraceUpdateModeAppend);
+        }
+        return obj;
+    }
 };
 
 namespace details {
 
+/*!
+ * \brief Throw site whose raw traceback is captured by ErrorBuilder.
+ * \note Only the program counters are recorded, symbolization happens when the error is inspected.
+ */
+struct RawTracebackHere {
+    const char* filename;
+    int lineno;
+    const char* func;
+};
+
 class ErrorBuilder {
 public:
     explicit ErrorBuilder(std::string kind, std::string backtrace, bool log_before_throw)
@@ -195,6 +392,16 @@ public:
     explicit ErrorBuilder(std::string kind, const TVMFFIByteArray* backtrace, bool log_before_throw)
         : ErrorBuilder(std::move(kind), std::string(backtrace->data, backtrace->size), log_before_throw) {}
 
+    /*!
+     * \brief Construct with the raw traceback of the throw site, symbolization is deferred
+     *  until the error is inspected.
+     * \note Inlined, so the traceback starts at the throw site rather than in this constructor.
+     */
+    TVM_FFI_INLINE explicit ErrorBuilder(std::string kind, RawTracebackHere site, bool log_before_throw)
+        : kind_(std::move(kind)), has_raw_(true), log_before_throw_(log_before_throw) {
+        TVMFFITracebackCaptureRaw(site.filename, site.lineno, site.func, &raw_);
+    }
+
 // MSVC disable warning in error builder as it is exepected
 #ifdef _MSC_VER
 #pragma disagnostic push
@@ -202,7 +409,7 @@ public:
 #endif
     // avoid inline to reduce binary size, error throw path do not need to be fast
     [[noreturn]] ~ErrorBuilder() noexcept(false) {
-        Error error(kind_, stream_.str(), backtrace_);
+        Error error = has_raw_ ? Error(kind_, stream_.str(), raw_) : Error(kind_, stream_.str(), backtrace_);
         if (log_before_throw_) {
             std::cerr << error.what();
         }
@@ -220,11 +427,17 @@ protected:
     std::string kind_;
     std::ostringstream stream_;
     std::string backtrace_;
+    // copied by value, the error is built from it after the message is formatted
+    TVMFFIRawTraceback raw_;
+    bool has_raw_{false};
     bool log_before_throw_;
 };
 
 // define traceback here as call into traceback function
 #define TVM_FFI_TRACEBACK_HERE TVMFFITraceback(__FILE__, __LINE__, TVM_FFI_FUNC_SIG)
+// raw traceback of the current stack, symbolized lazily
+#define TVM_FFI_RAW_TRACEBACK_HERE \
+    ::litetvm::ffi::details::RawTracebackHere{__FILE__, __LINE__, TVM_FFI_FUNC_SIG}
 }// namespace details
 
 /*!
@@ -238,9 +451,9 @@ protected:
  *
  * \endcode
  */
-#define TVM_FFI_THROW(ErrorKind)                                              \
-    ::litetvm::ffi::details::ErrorBuilder(#ErrorKind, TVM_FFI_TRACEBACK_HERE, \
-                                          TVM_FFI_ALWAYS_LOG_BEFORE_THROW)    \
+#define TVM_FFI_THROW(ErrorKind)                                                  \
+    ::litetvm::ffi::details::ErrorBuilder(#ErrorKind, TVM_FFI_RAW_TRACEBACK_HERE, \
+                                          TVM_FFI_ALWAYS_LOG_BEFORE_THROW)        \
             .stream()
 
 /*!
@@ -251,7 +464,7 @@ protected:
  *  In most cases, we should use use TVM_FFI_THROW.
  */
 #define TVM_FFI_LOG_AND_THROW(ErrorKind) \
-    ::litetvm::ffi::details::ErrorBuilder(#ErrorKind, TVM_FFI_TRACEBACK_HERE, true).stream()
+    ::litetvm::ffi::details::ErrorBuilder(#ErrorKind, TVM_FFI_RAW_TRACEBACK_HERE, true).stream()
 
 // Glog style checks with TVM_FFI prefix
 // NOTE: we explicitly avoid glog style generic macros (LOG/CHECK) in tvm ffi
@@ -0,0 +1,130 @@
+//
+// Created by richard on 10/18/26.
+//
+
+#ifndef LITETVM_FFI_EXPECTED_H
+#define LITETVM_FFI_EXPECTED_H
+
+#include "ffi/any.h"
+#include "ffi/base_details.h"
+#include "ffi/error.h"
+
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace litetvm {
+namespace ffi {
+
+/*!
+ * \brief Result of a function that holds either a value or an Error.
+ *
+ * A function returning Expected reports its error through the -1 return code
+ * of the C ABI instead of throwing, and TypedFunction returning Expected
+ * receives it without an unwind. Validation paths only pay for the error object.
+ *
+ * \code
+ *
+ * Expected<int64_t> CheckPositive(int64_t x) {
+ *   if (x <= 0) return Error("ValueError", "expect a positive value", "");
+ *   return x;
+ * }
+ *
+ * TypedFunction<Expected<int64_t>(int64_t)> fcheck = CheckPositive;
+ * Expected<int64_t> res = fcheck(-1);
+ * if (res.is_err()) {
+ *   std::cout << res.error().message();
+ * }
+ *
+ * \endcode
+ *
+ * \tparam T The value type.
+ */
+template<typename T>
+class Expected {
+public:
+    static_assert(!std::is_void_v<T>, "Expected<void> is not supported");
+    static_assert(!std::is_same_v<T, Error>, "Expected<Error> is ambiguous");
+
+    using value_type = T;
+
+    Expected(T value) : data_(std::in_place_index<0>, std::move(value)) {}// NOLINT(*)
+
+    Expected(Error error) : data_(std::in_place_index<1>, std::move(error)) {}// NOLINT(*)
+
+    NODISCARD bool is_ok() const {
+        return data_.index() == 0;
+    }
+
+    NODISCARD bool is_err() const {
+        return data_.index() == 1;
+    }
+
+    explicit operator bool() const {
+        return is_ok();
+    }
+
+    /*!
+   * \brief Get the value.
+   * \return The value.
+   * \note Throws the stored error if there is no value.
+   */
+    const T& value() const& {
+        if (is_err()) {
+            throw std::get<1>(data_);
+        }
+        return std::get<0>(data_);
+    }
+
+    T value() && {
+        if (is_err()) {
+            throw std::get<1>(data_);
+        }
+        return std::move(std::get<0>(data_));
+    }
+
+    T value_or(T default_value) const& {
+        return is_ok() ? std::get<0>(data_) : std::move(default_value);
+    }
+
+    /*!
+   * \brief Get the error.
+   * \return The error.
+   */
+    const Error& error() const& {
+        if (!is_err()) {
+            TVM_FFI_THROW(RuntimeError) << "Expected holds a value instead of an error";
+        }
+        return std::get<1>(data_);
+    }
+
+    Error error() && {
+        if (!is_err()) {
+            TVM_FFI_THROW(RuntimeError) << "Expected holds a value instead of an error";
+        }
+        return std::move(std::get<1>(data_));
+    }
+
+private:
+    std::variant<T, Error> data_;
+};
+
+namespace details {
+template<typename T>
+inline constexpr bool is_expected_v = false;
+
+template<typename T>
+inline constexpr bool is_expected_v<Expected<T>> = true;
+
+template<typename T>
+struct Type2Str<Expected<T>> {
+    static std::string v() {
+        return Type2Str<T>::v();
+    }
+};
+}// namespace details
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_EXPECTED_H
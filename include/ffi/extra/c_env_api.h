@@ -56,13 +56,39 @@ TVM_FFI_DLL int TVMFFIEnvSetTensorAllocator(DLPackTensorAllocator allocator,
 /*!
      * \brief FFI function get the current DLPack allocator stored in context.
      *
-     * This function first queries the global context, and if not found,
-     * queries the thread-local context.
+     * This function first queries the thread-local context, and if not set,
+     * queries the global context.
      *
-     * \return The current DLPack allocator.
+     * \return The current DLPack allocator, the global context defaults to the
+     *         CPU caching allocator in extra/cpu_caching_allocator.h.
      */
 TVM_FFI_DLL DLPackTensorAllocator TVMFFIEnvGetTensorAllocator();
 
+/*!
+ * \brief FFI function to set the DLPack allocator of a device type in thread-local(TLS) context
+ *
+ * The allocator of a device type takes precedence over the one set by TVMFFIEnvSetTensorAllocator
+ * in the same context. Allocators are looked up from the TLS allocator of the device type,
+ * the TLS default, the global allocator of the device type, then the global default.
+ *
+ * \param device_type The device type, in [0, 32).
+ * \param allocator The allocator to set, nullptr to fall back to the less specific allocators.
+ * \param write_to_global_context Whether to also set the allocator to the global context.
+ * \param opt_out_original_allocator Output original TLS allocator of the device type if the
+ *        address is not nullptr.
+ * \return 0 when success, nonzero when failure happens
+ */
+TVM_FFI_DLL int TVMFFIEnvSetDeviceTensorAllocator(int32_t device_type, DLPackTensorAllocator allocator,
+                                                  int write_to_global_context,
+                                                  DLPackTensorAllocator* opt_out_original_allocator);
+
+/*!
+ * \brief FFI function to get the DLPack allocator of a device type.
+ * \param device_type The device type.
+ * \return The allocator to use for tensors of the device type.
+ */
+TVM_FFI_DLL DLPackTensorAllocator TVMFFIEnvGetDeviceTensorAllocator(int32_t device_type);
+
 /*!
  * \brief Check if there are any signals raised in the surrounding env.
  * \return 0 when success, nonzero when failure happens
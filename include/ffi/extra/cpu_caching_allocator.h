@@ -0,0 +1,119 @@
+//
+// Created by richard on 10/19/26.
+//
+
+#ifndef LITETVM_FFI_EXTRA_CPU_CACHING_ALLOCATOR_H
+#define LITETVM_FFI_EXTRA_CPU_CACHING_ALLOCATOR_H
+
+#include "ffi/c_api.h"
+#include "ffi/extra/base.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace litetvm {
+namespace ffi {
+
+/*!
+ * \brief Caching allocator of CPU tensor memory.
+ *
+ * Requests are rounded up to size classes, four per power of two starting at 64 bytes, and
+ * freed blocks are kept in free lists keyed by size class and alignment. Blocks up to
+ * kMaxThreadCachedSize are first cached per thread without locking, the rest and the
+ * overflow of the thread caches go to a shared cache. The shared cache is bounded by the
+ * cache limit and is released when an allocation fails.
+ *
+ * The allocator is the default DLPack tensor allocator of the environment, see
+ * TVMFFIEnvGetTensorAllocator.
+ */
+class CPUCachingAllocator {
+public:
+    /*! \brief Default alignment, matches the cache line and AVX-512 vectors. */
+    static constexpr size_t kDefaultAlignment = 64;
+    /*! \brief Alignment of large tensors, so they start on a page. */
+    static constexpr size_t kPageAlignment = 4096;
+    /*! \brief Size from which DLPackAlloc aligns to pages. */
+    static constexpr size_t kPageAlignedSize = static_cast<size_t>(1) << 20;
+    /*! \brief Largest block size kept in the per-thread caches. */
+    static constexpr size_t kMaxThreadCachedSize = static_cast<size_t>(1) << 18;
+    /*! \brief Largest block size kept in any cache, larger requests go to the system. */
+    static constexpr size_t kMaxCachedSize = static_cast<size_t>(1) << 28;
+    /*! \brief Default limit of the bytes kept in the caches. */
+    static constexpr size_t kDefaultCacheLimit = static_cast<size_t>(1) << 30;
+
+    /*!
+     * \brief Memory statistics of the allocator.
+     *
+     * Threads publish the statistics of their cached blocks in batches of up to 1MB or 1024
+     * allocations, so the values may lag behind other threads, but not the calling thread.
+     */
+    struct Stats {
+        /*! \brief Bytes of the blocks handed out and not freed, rounded to size classes. */
+        size_t bytes_in_use;
+        /*! \brief Bytes of the free blocks kept in the caches. */
+        size_t bytes_cached;
+        /*! \brief High water mark of bytes_in_use. */
+        size_t peak_bytes_in_use;
+        /*! \brief Number of allocations. */
+        uint64_t num_allocs;
+        /*! \brief Number of allocations served from a cache. */
+        uint64_t num_cache_hits;
+    };
+
+    /*!
+     * \brief Get the process wide allocator.
+     * \return The allocator, never destroyed.
+     */
+    TVM_FFI_EXTRA_CXX_API static CPUCachingAllocator* Global();
+
+    /*!
+     * \brief Allocate memory.
+     * \param nbytes The number of bytes.
+     * \param alignment The alignment, a power of 2 no larger than kPageAlignment.
+     * \return The allocated memory.
+     * \note Throws ValueError on an invalid alignment, std::bad_alloc if the system is out of memory.
+     */
+    TVM_FFI_EXTRA_CXX_API void* Alloc(size_t nbytes, size_t alignment = kDefaultAlignment);
+
+    /*!
+     * \brief Free memory returned by Alloc.
+     * \param ptr The memory.
+     * \param nbytes The number of bytes passed to Alloc.
+     * \param alignment The alignment passed to Alloc.
+     */
+    TVM_FFI_EXTRA_CXX_API void Free(void* ptr, size_t nbytes, size_t alignment = kDefaultAlignment);
+
+    /*!
+     * \brief Release the blocks of the shared cache and of the calling thread's cache to the system.
+     * \note The caches of other threads are released when they free blocks past their bound or exit.
+     */
+    TVM_FFI_EXTRA_CXX_API void Trim();
+
+    /*!
+     * \brief Set the limit of the bytes kept in the caches, trims the shared cache down to it.
+     * \param bytes The limit, 0 disables caching in the shared cache.
+     */
+    TVM_FFI_EXTRA_CXX_API void SetCacheLimit(size_t bytes);
+
+    /*! \return The memory statistics. */
+    TVM_FFI_EXTRA_CXX_API Stats GetStats() const;
+
+    /*!
+     * \brief DLPackTensorAllocator of CPU tensors backed by the global allocator.
+     *
+     * Tensors of at least kPageAlignedSize bytes are page aligned, others are aligned to
+     * kDefaultAlignment. The shape is copied into the managed tensor and strides are nullptr.
+     */
+    TVM_FFI_EXTRA_CXX_API static int DLPackAlloc(DLTensor* prototype, DLManagedTensorVersioned** out,
+                                                 void* error_ctx,
+                                                 void (*SetError)(void* error_ctx, const char* kind,
+                                                                  const char* message));
+
+private:
+    CPUCachingAllocator() = default;
+};
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_EXTRA_CPU_CACHING_ALLOCATOR_H
@@ -0,0 +1,96 @@
+//
+// Created by richard on 10/19/26.
+//
+
+#ifndef LITETVM_FFI_EXTRA_ENV_CONTEXT_H
+#define LITETVM_FFI_EXTRA_ENV_CONTEXT_H
+
+#include "ffi/extra/c_env_api.h"
+#include "ffi/function.h"
+
+namespace litetvm {
+namespace ffi {
+
+/*!
+ * \brief Scoped override of the thread-local tensor allocator.
+ *
+ * Restores the previous thread-local allocator on destruction, so overrides nest.
+ *
+ * \code
+ *
+ * {
+ *   ffi::WithAllocator scope(kDLCPU, MyAllocator);
+ *   // allocates with MyAllocator
+ *   ffi::Tensor tensor = ffi::Tensor::FromDLPackAlloc(
+ *     TVMFFIEnvGetDeviceTensorAllocator(kDLCPU), shape, dtype, device
+ *   );
+ * }
+ * \endcode
+ */
+class WithAllocator {
+public:
+    /*!
+     * \brief Override the allocator of all device types.
+     * \param allocator The allocator.
+     */
+    explicit WithAllocator(DLPackTensorAllocator allocator) {
+        TVM_FFI_CHECK_SAFE_CALL(TVMFFIEnvSetTensorAllocator(allocator, 0, &original_));
+    }
+
+    /*!
+     * \brief Override the allocator of a device type.
+     * \param device_type The device type.
+     * \param allocator The allocator.
+     */
+    WithAllocator(int32_t device_type, DLPackTensorAllocator allocator) : device_type_(device_type) {
+        TVM_FFI_CHECK_SAFE_CALL(TVMFFIEnvSetDeviceTensorAllocator(device_type, allocator, 0, &original_));
+    }
+
+    ~WithAllocator() {
+        if (device_type_ < 0) {
+            TVMFFIEnvSetTensorAllocator(original_, 0, nullptr);
+        } else {
+            TVMFFIEnvSetDeviceTensorAllocator(device_type_, original_, 0, nullptr);
+        }
+    }
+
+    WithAllocator(const WithAllocator&) = delete;
+    WithAllocator& operator=(const WithAllocator&) = delete;
+
+private:
+    int32_t device_type_{-1};
+    DLPackTensorAllocator original_{nullptr};
+};
+
+/*!
+ * \brief Scoped override of the thread-local stream of a device.
+ *
+ * Restores the previous stream on destruction, so overrides nest.
+ */
+class WithStream {
+public:
+    /*!
+     * \brief Override the stream of a device.
+     * \param device The device.
+     * \param stream The stream.
+     */
+    WithStream(DLDevice device, TVMFFIStreamHandle stream) : device_(device) {
+        TVM_FFI_CHECK_SAFE_CALL(TVMFFIEnvSetStream(device.device_type, device.device_id, stream, &original_));
+    }
+
+    ~WithStream() {
+        TVMFFIEnvSetStream(device_.device_type, device_.device_id, original_, nullptr);
+    }
+
+    WithStream(const WithStream&) = delete;
+    WithStream& operator=(const WithStream&) = delete;
+
+private:
+    DLDevice device_;
+    TVMFFIStreamHandle original_{nullptr};
+};
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_EXTRA_ENV_CONTEXT_H
@@ -0,0 +1,106 @@
+//
+// Created by richard on 10/19/26.
+//
+
+#ifndef LITETVM_FFI_EXTRA_NUMA_H
+#define LITETVM_FFI_EXTRA_NUMA_H
+
+#include "ffi/c_api.h"
+#include "ffi/extra/base.h"
+#include "ffi/thread_pool.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace litetvm {
+namespace ffi {
+
+/*!
+ * \brief Get the number of NUMA nodes.
+ *
+ * Read from /sys/devices/system/node on Linux, machines without NUMA information have one node.
+ * \return The largest online node id plus one.
+ */
+TVM_FFI_EXTRA_CXX_API int NUMANumNodes();
+
+/*!
+ * \brief Get the CPUs of a NUMA node.
+ * \param node The node.
+ * \return The CPU ids, empty for memory only nodes, all CPUs without NUMA information.
+ */
+TVM_FFI_EXTRA_CXX_API std::vector<int> NUMANodeCpus(int node);
+
+/*!
+ * \brief Bind memory pages to a NUMA node with mbind.
+ * \param ptr The page aligned memory.
+ * \param nbytes The number of bytes.
+ * \param node The node.
+ * \return Whether the pages are bound, false if the system does not support it.
+ */
+TVM_FFI_EXTRA_CXX_API bool NUMABindMemory(void* ptr, size_t nbytes, int node);
+
+/*!
+ * \brief Pin the calling thread to the CPUs of a NUMA node and allocate its memory there.
+ *
+ * Sets the thread affinity and, with set_mempolicy, makes the node the preferred node of the
+ * pages the thread touches first.
+ * \param node The node.
+ * \return Whether the thread is pinned, false if the system does not support it.
+ */
+TVM_FFI_EXTRA_CXX_API bool NUMAPinThread(int node);
+
+/*!
+ * \brief Get the thread pool of a NUMA node.
+ *
+ * The pool has one worker less than the node has CPUs, and at least one, since the calling
+ * thread runs a share of each loop as with ThreadPool::Global. The workers are pinned with
+ * NUMAPinThread.
+ * \param node The node.
+ * \return The pool, never destroyed.
+ */
+TVM_FFI_EXTRA_CXX_API ThreadPool* NUMANodeThreadPool(int node);
+
+/*!
+ * \brief Allocator of CPU memory bound to NUMA nodes.
+ *
+ * Memory is mapped from the system in whole pages and bound to the node before it is
+ * touched, so it lands on the node whichever thread first writes it. Where binding is not
+ * supported the memory is allocated as usual. Meant for long lived tensors such as weights,
+ * CPUCachingAllocator serves short lived ones faster.
+ *
+ * Use DLPackAlloc as the CPU tensor allocator of the environment to place tensors by
+ * device_id, e.g. TVMFFIEnvSetDeviceTensorAllocator(kDLCPU, NUMAAllocator::DLPackAlloc, ...).
+ */
+class NUMAAllocator {
+public:
+    /*!
+     * \brief Allocate memory on a NUMA node.
+     * \param nbytes The number of bytes.
+     * \param node The node.
+     * \return The page aligned memory.
+     * \note Throws ValueError if the node does not exist, std::bad_alloc if the system is out of memory.
+     */
+    TVM_FFI_EXTRA_CXX_API static void* Alloc(size_t nbytes, int node);
+
+    /*!
+     * \brief Free memory returned by Alloc.
+     * \param ptr The memory.
+     * \param nbytes The number of bytes passed to Alloc.
+     */
+    TVM_FFI_EXTRA_CXX_API static void Free(void* ptr, size_t nbytes);
+
+    /*!
+     * \brief DLPackTensorAllocator of CPU tensors on the NUMA node given by the device id.
+     *
+     * Tensors are page aligned. The shape is copied into the managed tensor and strides are nullptr.
+     */
+    TVM_FFI_EXTRA_CXX_API static int DLPackAlloc(DLTensor* prototype, DLManagedTensorVersioned** out,
+                                                 void* error_ctx,
+                                                 void (*SetError)(void* error_ctx, const char* kind,
+                                                                  const char* message));
+};
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_EXTRA_NUMA_H
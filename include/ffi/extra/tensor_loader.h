@@ -0,0 +1,151 @@
+//
+// Created by richard on 10/19/26.
+//
+
+#ifndef LITETVM_FFI_EXTRA_TENSOR_LOADER_H
+#define LITETVM_FFI_EXTRA_TENSOR_LOADER_H
+
+#include "ffi/container/tensor.h"
+#include "ffi/extra/base.h"
+#include "ffi/function.h"
+#include "ffi/optional.h"
+#include "ffi/string.h"
+#include "ffi/thread_pool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace litetvm {
+namespace ffi {
+
+/*! \brief A tensor stored in C order in a file. */
+struct TensorLoadRequest {
+    /*! \brief The file path. */
+    String path;
+    /*! \brief The offset of the tensor data in the file. */
+    int64_t offset;
+    /*! \brief The shape. */
+    Shape shape;
+    /*! \brief The dtype. */
+    DLDataType dtype;
+};
+
+/*! \brief A tensor being loaded by a TensorLoader. */
+class TensorFutureObj : public Object {
+public:
+    /*! \return Whether the tensor is loaded or failed to load. */
+    TVM_FFI_EXTRA_CXX_API bool IsReady() const;
+
+    /*!
+     * \brief Wait for the tensor.
+     * \return The loaded tensor.
+     * \note Throws RuntimeError if it failed to load.
+     */
+    TVM_FFI_EXTRA_CXX_API Tensor Wait() const;
+
+    TVM_FFI_DECLARE_OBJECT_INFO_FINAL("ffi.TensorFuture", TensorFutureObj, Object);
+
+private:
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cv_;
+    bool ready_{false};
+    // the destination, reset if loading failed
+    Tensor tensor_;
+    // the first error of the chunks
+    std::string error_;
+    // called with the tensor or the Error once ready
+    Optional<Function> callback_;
+    // chunks not read yet
+    std::atomic<int64_t> pending_chunks_{0};
+
+    friend class TensorLoader;
+};
+
+/*! \brief Reference to TensorFutureObj. */
+class TensorFuture : public ObjectRef {
+public:
+    /*! \return Whether the tensor is loaded or failed to load. */
+    NODISCARD bool IsReady() const {
+        return get()->IsReady();
+    }
+
+    /*!
+     * \brief Wait for the tensor.
+     * \return The loaded tensor.
+     */
+    NODISCARD Tensor Wait() const {
+        return get()->Wait();
+    }
+
+    TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(TensorFuture, ObjectRef, TensorFutureObj);
+};
+
+/*!
+ * \brief Loads tensors from files on a pool of I/O threads.
+ *
+ * Destination tensors are allocated on the submitting thread with its environment CPU
+ * allocator, see TVMFFIEnvGetDeviceTensorAllocator, then read with pread in chunks spread
+ * over the I/O threads, so one large tensor uses all of them. Consumers can compute on the first
+ * tensors while the next ones are read.
+ */
+class TensorLoader {
+public:
+    /*! \brief Default number of I/O threads. */
+    static constexpr int kDefaultIODepth = 4;
+    /*! \brief Default size of the reads. */
+    static constexpr int64_t kDefaultChunkBytes = static_cast<int64_t>(4) << 20;
+
+    /*!
+     * \brief Create a loader.
+     * \param io_depth The number of I/O threads, the reads in flight at any time. With 0 the
+     *  reads run on the submitting thread.
+     * \param chunk_bytes The size of the reads.
+     */
+    TVM_FFI_EXTRA_CXX_API explicit TensorLoader(int io_depth = kDefaultIODepth,
+                                                int64_t chunk_bytes = kDefaultChunkBytes);
+
+    /*! \brief Finish the submitted loads. */
+    TVM_FFI_EXTRA_CXX_API ~TensorLoader();
+
+    /*!
+     * \brief Start loading a tensor.
+     * \param request The tensor to load.
+     * \param callback Called on an I/O thread with the tensor, or the Error if it failed to load.
+     *  Exceptions thrown by the callback are ignored.
+     * \return The future of the tensor.
+     * \note Throws synchronously if the file cannot be opened or the tensor cannot be allocated.
+     */
+    TVM_FFI_EXTRA_CXX_API TensorFuture Submit(const TensorLoadRequest& request,
+                                              Optional<Function> callback = std::nullopt);
+
+    /*!
+     * \brief Start loading tensors, each file is opened once.
+     * \param requests The tensors to load.
+     * \return The futures of the tensors, in request order.
+     */
+    TVM_FFI_EXTRA_CXX_API std::vector<TensorFuture> Submit(const std::vector<TensorLoadRequest>& requests);
+
+    /*! \return The number of I/O threads. */
+    NODISCARD int io_depth() const {
+        return pool_.NumThreads() - 1;
+    }
+
+private:
+    struct FileHandle;
+
+    TensorFuture Submit(const TensorLoadRequest& request, std::shared_ptr<FileHandle> file,
+                        Optional<Function> callback);
+
+    int64_t chunk_bytes_;
+    // declared last, its destructor runs the pending reads first
+    ThreadPool pool_;
+};
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_EXTRA_TENSOR_LOADER_H
@@ -0,0 +1,129 @@
+//
+// Created by richard on 10/19/26.
+//
+
+#ifndef LITETVM_FFI_EXTRA_TENSOR_STORE_H
+#define LITETVM_FFI_EXTRA_TENSOR_STORE_H
+
+#include "ffi/container/tensor.h"
+#include "ffi/extra/base.h"
+#include "ffi/optional.h"
+#include "ffi/string.h"
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace litetvm {
+namespace ffi {
+
+/*!
+ * \brief Content addressed store of CPU tensors.
+ *
+ * Intern returns the tensor already in the store with the same shape, dtype and bytes, if
+ * any, so models sharing weights keep one copy of them. Tensors are found by a fingerprint
+ * of their bytes and compared byte by byte before being shared. The store only references
+ * its tensors weakly, a tensor leaves the store when the last user drops it.
+ *
+ * With a backing file, the bytes of new tensors are appended to the file and the store
+ * returns tensors mapping the file, so the kernel can drop their pages under memory pressure
+ * and read them back on demand. The file only grows: the range of a tensor that left the
+ * store is not reused, nor is the range written by a thread that lost a race to intern the
+ * same bytes. Use a new store to compact it.
+ */
+class TensorStoreObj : public Object {
+public:
+    /*! \brief Counters of the interned tensors. */
+    struct Stats {
+        /*! \brief Number of Intern calls. */
+        int64_t num_interned;
+        /*! \brief Number of Intern calls that returned a tensor already in the store. */
+        int64_t num_deduplicated;
+        /*! \brief Bytes of the tensors passed to Intern. */
+        int64_t bytes_interned;
+        /*! \brief Bytes of the tensors that were already in the store. */
+        int64_t bytes_deduplicated;
+
+        /*! \return The bytes interned per byte stored, 1 without duplicates. */
+        NODISCARD double DedupRatio() const {
+            int64_t bytes_stored = bytes_interned - bytes_deduplicated;
+            return bytes_stored > 0 ? static_cast<double>(bytes_interned) / static_cast<double>(bytes_stored) : 1.0;
+        }
+    };
+
+    /*!
+     * \brief Create a store, see TensorStore::Create.
+     * \param backing_file The backing file path.
+     * \param backing_fd The backing file opened for writing, -1 without backing file.
+     */
+    TensorStoreObj(Optional<String> backing_file, int backing_fd);
+
+    TVM_FFI_EXTRA_CXX_API ~TensorStoreObj();
+
+    /*!
+     * \brief Get the canonical tensor with the content of a tensor.
+     * \param tensor The CPU tensor, may be strided.
+     * \return The tensor of the store with the same shape, dtype and bytes, else the tensor
+     *  itself, made contiguous or mapped from the backing file, which becomes canonical.
+     * \note Throws ValueError if the tensor is not on the CPU.
+     */
+    TVM_FFI_EXTRA_CXX_API Tensor Intern(const Tensor& tensor);
+
+    /*! \return The counters of the interned tensors. */
+    TVM_FFI_EXTRA_CXX_API Stats GetStats() const;
+
+    static constexpr bool _type_mutable = true;
+    TVM_FFI_DECLARE_OBJECT_INFO_FINAL("ffi.TensorStore", TensorStoreObj, Object);
+
+private:
+    // copy of the contiguous tensor in the range of the backing file at offset, mapped
+    Tensor WriteBackingFile(const Tensor& tensor, int64_t offset);
+
+    mutable std::mutex mutex_;
+    // tensors by fingerprint, a bucket is erased once all its tensors are gone
+    std::unordered_map<uint64_t, std::vector<WeakObjectPtr<TensorObj>>> entries_;
+    Stats stats_{};
+    Optional<String> backing_file_;
+    int backing_fd_{-1};
+    // end of the reserved ranges of the backing file
+    int64_t backing_size_{0};
+};
+
+/*! \brief Reference to TensorStoreObj. */
+class TensorStore : public ObjectRef {
+public:
+    /*!
+     * \brief Create a store.
+     * \param backing_file The file holding the bytes of the tensors, created or truncated.
+     *  Without it the store keeps the interned tensors themselves.
+     * \return The store.
+     */
+    TVM_FFI_EXTRA_CXX_API static TensorStore Create(Optional<String> backing_file = std::nullopt);
+
+    /*!
+     * \brief Get the canonical tensor with the content of a tensor.
+     * \param tensor The CPU tensor.
+     * \return The canonical tensor.
+     */
+    NODISCARD Tensor Intern(const Tensor& tensor) const {
+        return get()->Intern(tensor);
+    }
+
+    /*!
+     * \brief Fingerprint the shape, dtype and bytes of a tensor.
+     *
+     * The bytes are hashed in 1MB chunks in parallel, with 64 bit lanes vectorized on SSE2.
+     * The fingerprint does not depend on the number of threads or the platform.
+     * \param tensor The CPU tensor, may be strided.
+     * \return The fingerprint.
+     */
+    TVM_FFI_EXTRA_CXX_API static uint64_t Fingerprint(const Tensor& tensor);
+
+    TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(TensorStore, ObjectRef, TensorStoreObj);
+};
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_EXTRA_TENSOR_STORE_H
@@ -11,7 +11,10 @@
 #include "ffi/error.h"
 #include "ffi/function_details.h"
 
+#include <atomic>
 #include <functional>
+#include <new>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -43,6 +46,10 @@ namespace ffi {
     catch (const ::litetvm::ffi::EnvErrorAlreadySet&) {                                                    \
         return -2;                                                                                         \
     }                                                                                                      \
+    catch (const std::bad_alloc&) {                                                                        \
+        TVMFFIErrorSetRaisedOutOfMemory();                                                                 \
+        return -1;                                                                                         \
+    }                                                                                                      \
     catch (const std::exception& ex) {                                                                     \
         ::litetvm::ffi::details::SetSafeCallRaised(::litetvm::ffi::Error("InternalError", ex.what(), "")); \
         return -1;                                                                                         \
@@ -78,6 +85,12 @@ public:
         (*call_ptr)(this, args, num_args, result);
     }
 
+    /*! \return Whether this call should be recorded by the profiler. */
+    TVM_FFI_INLINE bool IsProfiling() const {
+        // functions that are never tracked only pay the load and a predictable branch
+        return profile_site_.load(std::memory_order_relaxed) >= 0 && details::ProfilerEnabled();
+    }
+
     static constexpr uint32_t _type_index = kTVMFFIFunction;
     TVM_FFI_DECLARE_OBJECT_INFO_STATIC(StaticTypeKey::kTVMFFIFunction, FunctionObj, Object);
 
@@ -93,10 +106,33 @@ private:
                                                 num_args, reinterpret_cast<TVMFFIAny*>(rv)));
     }
 
+    /*!
+     * \brief Profiler call site of the function, -1 when its calls are not recorded.
+     * \note Assigned when the function is registered, see Profiler::Track.
+     */
+    std::atomic<int32_t> profile_site_{-1};
+
     friend class Function;
+    friend class FunctionProfiler;
 };
 
 namespace details {
+/*!
+ * \brief Call a function through its cpp_call and record the call, defined in profiler.cpp.
+ * \param call The call to be recorded.
+ * \param func The function, whose call site is used.
+ */
+TVM_FFI_DLL void ProfiledCppCall(FunctionObj::FCall call, const FunctionObj* func, const AnyView* args,
+                                 int32_t num_args, Any* result);
+
+/*!
+ * \brief Call a function through its safe_call and record the call, defined in profiler.cpp.
+ * \param call The call to be recorded.
+ * \param func The function, whose call site is used.
+ */
+TVM_FFI_DLL int ProfiledSafeCall(TVMFFISafeCallType call, void* func, const TVMFFIAny* args, int32_t num_args,
+                                 TVMFFIAny* result);
+
 /*!
  * \brief Derived object class for constructing FunctionObj backed by a TCallable
  *
@@ -120,6 +156,14 @@ public:
 private:
     // implementation of call
     static void CppCall(const FunctionObj* func, const AnyView* args, int32_t num_args, Any* result) {
+        if (func->IsProfiling()) {
+            ProfiledCppCall(Invoke, func, args, num_args, result);
+            return;
+        }
+        Invoke(func, args, num_args, result);
+    }
+
+    static void Invoke(const FunctionObj* func, const AnyView* args, int32_t num_args, Any* result) {
         static_cast<const TSelf*>(func)->callable_(args, num_args, result);
     }
 
@@ -139,6 +183,63 @@ private:
     mutable TStorage callable_;
 };
 
+/*!
+ * \brief Store the value held by an Expected into the safe call result, or raise its error.
+ * \param ret The returned Expected.
+ * \param result The safe call result.
+ * \return 0 when a value is stored, -1 when the error is raised.
+ */
+template<typename R>
+TVM_FFI_INLINE int SetSafeCallExpectedResult(R&& ret, TVMFFIAny* result) {
+    if (ret.is_err()) {
+        SetSafeCallRaised(ret.error());
+        return -1;
+    }
+    *reinterpret_cast<Any*>(result) = std::move(ret).value();
+    return 0;
+}
+
+/*!
+ * \brief Derived object class for functions returning Expected.
+ *
+ * The function is only reachable through safe_call, errors held by the
+ * returned Expected are set as the raised error and reported with -1
+ * instead of being thrown.
+ */
+template<typename R, typename TCallable>
+class ExpectedFunctionObjImpl : public FunctionObj {
+public:
+    using TStorage = std::remove_cv_t<std::remove_reference_t<TCallable>>;
+    using TSelf = ExpectedFunctionObjImpl;
+
+    explicit ExpectedFunctionObjImpl(TCallable callable) : callable_(std::move(callable)) {
+        this->safe_call = SafeCall;
+        // C++ callers are redirected to safe_call, which turns the -1 into an exception
+        this->cpp_call = nullptr;
+    }
+
+private:
+    static int SafeCall(void* func, const TVMFFIAny* args, int32_t num_args, TVMFFIAny* result) {
+        if (static_cast<const FunctionObj*>(func)->IsProfiling()) {
+            return ProfiledSafeCall(Invoke, func, args, num_args, result);
+        }
+        return Invoke(func, args, num_args, result);
+    }
+
+    static int Invoke(void* func, const TVMFFIAny* args, int32_t num_args, TVMFFIAny* result) {
+        TVM_FFI_SAFE_CALL_BEGIN();
+        TVM_FFI_ICHECK_LT(result->type_index, TypeIndex::kTVMFFIStaticObjectBegin);
+        const TSelf* self = static_cast<const TSelf*>(static_cast<FunctionObj*>(func));
+        std::optional<R> ret;
+        self->callable_(reinterpret_cast<const AnyView*>(args), num_args, &ret);
+        return SetSafeCallExpectedResult(std::move(*ret), result);
+        TVM_FFI_SAFE_CALL_END();
+    }
+
+    /*! \brief Type-erased filed for storing callable object*/
+    mutable TStorage callable_;
+};
+
 /*!
  * \brief FunctionObj specialization for raw C style callback where handle and deleter are null.
  */
@@ -419,11 +520,21 @@ public:
     template<typename TCallable>
     static Function FromTyped(TCallable callable) {
         using FuncInfo = details::FunctionInfo<TCallable>;
-        auto packed_call = [callable = std::move(callable)](const AnyView* args, int32_t num_args, Any* rv) mutable -> void {
-            details::unpack_call<typename FuncInfo::RetType>(std::make_index_sequence<FuncInfo::num_args>{},
-                                                             nullptr, callable, args, num_args, rv);
-        };
-        return FromPackedInternal(std::move(packed_call));
+        using R = typename FuncInfo::RetType;
+        if constexpr (details::is_expected_v<R>) {
+            auto packed_call = [callable = std::move(callable)](const AnyView* args, int32_t num_args,
+                                                                std::optional<R>* rv) mutable -> void {
+                details::unpack_call<R>(std::make_index_sequence<FuncInfo::num_args>{}, nullptr, callable, args,
+                                        num_args, rv);
+            };
+            return FromExpectedInternal<R>(std::move(packed_call));
+        } else {
+            auto packed_call = [callable = std::move(callable)](const AnyView* args, int32_t num_args, Any* rv) mutable -> void {
+                details::unpack_call<R>(std::make_index_sequence<FuncInfo::num_args>{}, nullptr, callable, args,
+                                        num_args, rv);
+            };
+            return FromPackedInternal(std::move(packed_call));
+        }
     }
 
     /*!
@@ -435,11 +546,21 @@ public:
     template<typename TCallable>
     static Function FromTyped(TCallable callable, std::string name) {
         using FuncInfo = details::FunctionInfo<TCallable>;
-        auto packed_call = [callable = std::move(callable), name = std::move(name)](const AnyView* args, int32_t num_args, Any* rv) mutable -> void {
-            details::unpack_call<typename FuncInfo::RetType>(
-                    std::make_index_sequence<FuncInfo::num_args>{}, &name, callable, args, num_args, rv);
-        };
-        return FromPackedInternal(std::move(packed_call));
+        using R = typename FuncInfo::RetType;
+        if constexpr (details::is_expected_v<R>) {
+            auto packed_call = [callable = std::move(callable), name = std::move(name)](
+                                       const AnyView* args, int32_t num_args, std::optional<R>* rv) mutable -> void {
+                details::unpack_call<R>(std::make_index_sequence<FuncInfo::num_args>{}, &name, callable, args,
+                                        num_args, rv);
+            };
+            return FromExpectedInternal<R>(std::move(packed_call));
+        } else {
+            auto packed_call = [callable = std::move(callable), name = std::move(name)](const AnyView* args, int32_t num_args, Any* rv) mutable -> void {
+                details::unpack_call<R>(std::make_index_sequence<FuncInfo::num_args>{}, &name, callable, args,
+                                        num_args, rv);
+            };
+            return FromPackedInternal(std::move(packed_call));
+        }
     }
 
     /*!
@@ -512,8 +633,107 @@ private:
         func.data_ = make_object<ObjType>(std::forward<TCallable>(packed_call));
         return func;
     }
+
+    /*!
+   * \brief Constructing a function that returns Expected from a callable
+   *        that stores the result into std::optional<R>.
+   * \param packed_call The packed call.
+   */
+    template<typename R, typename TCallable>
+    static Function FromExpectedInternal(TCallable packed_call) {
+        using ObjType = details::ExpectedFunctionObjImpl<R, TCallable>;
+        Function func;
+        func.data_ = make_object<ObjType>(std::forward<TCallable>(packed_call));
+        return func;
+    }
 };
 
+namespace details {
+/*!
+ * \brief Whether T is a POD value that is stored inline in TVMFFIAny.
+ */
+template<typename T>
+inline constexpr bool is_pod_value_v = std::is_arithmetic_v<T> || std::is_same_v<T, DLDataType> ||
+                                       std::is_same_v<T, DLDevice> || std::is_same_v<T, void*>;
+
+/*!
+ * \brief Whether the signature R(Args...) only contains POD values.
+ */
+template<typename R, typename... Args>
+inline constexpr bool is_pod_signature_v =
+        (std::is_void_v<R> || is_pod_value_v<R>) && (is_pod_value_v<Args> && ...);
+
+/*!
+ * \brief Call a function whose arguments and return value are all POD values.
+ *
+ * Arguments are written directly into raw TVMFFIAny cells and the result is
+ * read back without materializing an owned Any, so no destructor check runs
+ * when the callee returns the expected type.
+ *
+ * \param func The function to be called.
+ * \param args The arguments.
+ * \return The return value.
+ */
+template<typename R, typename... Args>
+TVM_FFI_INLINE R CallPODFunction(const FunctionObj* func, Args... args) {
+    constexpr int kNumArgs = sizeof...(Args);
+    constexpr int kArraySize = kNumArgs > 0 ? kNumArgs : 1;
+    TVMFFIAny args_pack[kArraySize];
+    [[maybe_unused]] int index = 0;
+    (TypeTraits<Args>::CopyToAnyView(args, &args_pack[index++]), ...);
+
+    TVMFFIAny result;
+    result.type_index = kTVMFFINone;
+    result.zero_padding = 0;
+    result.v_int64 = 0;
+    func->CallPacked(reinterpret_cast<const AnyView*>(args_pack), kNumArgs,
+                     reinterpret_cast<Any*>(&result));
+
+    if constexpr (std::is_void_v<R>) {
+        if (result.type_index >= kTVMFFIStaticObjectBegin) {
+            // release the object returned by a callee that does not match the signature
+            AnyUnsafe::MoveTVMFFIAnyToAny(&result);
+        }
+    } else {
+        if (TypeTraits<R>::CheckAnyStrict(&result)) {
+            return TypeTraits<R>::CopyFromAnyViewAfterCheck(&result);
+        }
+        // slow path: implicit conversions (e.g. int to float) and type errors,
+        // the result may hold an object and must go through Any
+        return AnyUnsafe::MoveTVMFFIAnyToAny(&result).cast<R>();
+    }
+}
+
+/*!
+ * \brief Call a function and return its error as Expected without throwing.
+ *
+ * The call goes through safe_call, so both functions returning Expected and
+ * functions that throw report errors through the return code.
+ *
+ * \param func The function to be called.
+ * \param args The arguments.
+ * \return The value or the error raised by the callee.
+ */
+template<typename R, typename... Args>
+TVM_FFI_INLINE R CallExpectedFunction(const FunctionObj* func, Args&&... args) {
+    constexpr int kNumArgs = sizeof...(Args);
+    constexpr int kArraySize = kNumArgs > 0 ? kNumArgs : 1;
+    AnyView args_pack[kArraySize];
+    PackedArgs::Fill(args_pack, std::forward<Args>(args)...);
+    Any result;
+    FunctionObj* self = const_cast<FunctionObj*>(func);
+    int ret_code = self->safe_call(self, reinterpret_cast<const TVMFFIAny*>(args_pack), kNumArgs,
+                                   reinterpret_cast<TVMFFIAny*>(&result));
+    if (ret_code == 0) {
+        return std::move(result).cast<typename R::value_type>();
+    }
+    if (ret_code == -2) {
+        throw EnvErrorAlreadySet();
+    }
+    return MoveFromSafeCallRaised();
+}
+}// namespace details
+
 /*!
  * \brief Please refer to \ref TypedFunctionAnchor "TypedFunction<R(Args..)>"
  */
@@ -648,7 +868,12 @@ public:
    * \returns The return value.
    */
     TVM_FFI_INLINE R operator()(Args... args) const {
-        if constexpr (std::is_same_v<R, void>) {
+        if constexpr (details::is_pod_signature_v<R, Args...>) {
+            return details::CallPODFunction<R, Args...>(static_cast<const FunctionObj*>(packed_.get()), args...);
+        } else if constexpr (details::is_expected_v<R>) {
+            return details::CallExpectedFunction<R>(static_cast<const FunctionObj*>(packed_.get()),
+                                                    std::forward<Args>(args)...);
+        } else if constexpr (std::is_same_v<R, void>) {
             packed_(std::forward<Args>(args)...);
         } else {
             Any res = packed_(std::forward<Args>(args)...);
@@ -788,11 +1013,22 @@ inline int32_t TypeKeyToIndex(std::string_view type_key) {
                                                   int32_t num_args, TVMFFIAny* result) { \
         TVM_FFI_SAFE_CALL_BEGIN();                                                       \
         using FuncInfo = ::litetvm::ffi::details::FunctionInfo<decltype(Function)>;      \
+        using RetType = typename FuncInfo::RetType;                                      \
         static std::string name = #ExportName;                                           \
-        ::litetvm::ffi::details::unpack_call<typename FuncInfo::RetType>(                \
-                std::make_index_sequence<FuncInfo::num_args>{}, &name, Function,         \
-                reinterpret_cast<const ::litetvm::ffi::AnyView*>(args), num_args,        \
-                reinterpret_cast<::litetvm::ffi::Any*>(result));                         \
+        if constexpr (::litetvm::ffi::details::is_expected_v<RetType>) {                 \
+            std::optional<RetType> ret;                                                  \
+            ::litetvm::ffi::details::unpack_call<RetType>(                               \
+                    std::make_index_sequence<FuncInfo::num_args>{}, &name, Function,     \
+                    reinterpret_cast<const ::litetvm::ffi::AnyView*>(args), num_args,    \
+                    &ret);                                                               \
+            return ::litetvm::ffi::details::SetSafeCallExpectedResult(std::move(*ret),   \
+                                                                      result);           \
+        } else {                                                                         \
+            ::litetvm::ffi::details::unpack_call<RetType>(                               \
+                    std::make_index_sequence<FuncInfo::num_args>{}, &name, Function,     \
+                    reinterpret_cast<const ::litetvm::ffi::AnyView*>(args), num_args,    \
+                    reinterpret_cast<::litetvm::ffi::Any*>(result));                     \
+        }                                                                                \
         TVM_FFI_SAFE_CALL_END();                                                         \
     }                                                                                    \
     }
@@ -9,6 +9,7 @@
 #include "ffi/base_details.h"
 #include "ffi/c_api.h"
 #include "ffi/error.h"
+#include "ffi/expected.h"
 
 #include <string>
 #include <tuple>
@@ -45,6 +46,9 @@ static constexpr bool ArgSupported = std::is_same_v<std::remove_const_t<std::rem
 template<typename T>
 static constexpr bool RetSupported = std::is_same_v<T, Any> || std::is_void_v<T> || TypeTraits<T>::convert_enabled;
 
+template<typename T>
+static constexpr bool RetSupported<Expected<T>> = RetSupported<T>;
+
 template<typename R, typename... Args>
 struct FuncFunctorImpl {
     using FType = R(Args...);
@@ -112,11 +116,11 @@ struct FunctionInfo<R (Class::*)(Args...) const, std::enable_if_t<std::is_base_o
 
 template<typename Class, typename R, typename... Args>
 struct FunctionInfo<R (Class::*)(Args...), std::enable_if_t<std::is_base_of_v<ObjectRef, Class>>>
-    : FuncFunctorImpl<R, Class*, Args...> {};
+    : FuncFunctorImpl<R, Class, Args...> {};
 
 template<typename Class, typename R, typename... Args>
 struct FunctionInfo<R (Class::*)(Args...) const, std::enable_if_t<std::is_base_of_v<ObjectRef, Class>>>
-    : FuncFunctorImpl<R, const Class*, Args...> {};
+    : FuncFunctorImpl<R, const Class, Args...> {};
 
 
 /*! \brief Using static function to output typed function signature */
@@ -170,9 +174,33 @@ private:
     FGetFuncSignature f_sig_;
 };
 
-template<typename R, std::size_t... Is, typename F>
+/*! \brief Whether the function profiler is recording calls, defined in profiler.cpp. */
+TVM_FFI_DLL bool ProfilerEnabled();
+
+/*!
+ * \brief Invoke a typed function with arguments that are already converted.
+ *
+ * The arguments are converted when binding to the parameters of Run,
+ * so the profiler can be told where argument conversion ends and the body starts.
+ */
+template<typename R, typename... Args>
+struct ProfiledInvoke {
+    template<typename F>
+    TVM_FFI_INLINE static R Run(const F& f, Args... args) {
+        TVMFFIProfilerMarkArgsConverted();
+        return f(std::forward<Args>(args)...);
+    }
+};
+
+/*!
+ * \brief Unpack the arguments, call the function and store the return value.
+ *
+ * \note rv is an Any in general, functions returning Expected store the result
+ * into std::optional<Expected<T>> so the error never becomes a return value.
+ */
+template<typename R, std::size_t... Is, typename F, typename TRet>
 TVM_FFI_INLINE void unpack_call(std::index_sequence<Is...>, const std::string* optional_name, const F& f,
-                                MAYBE_UNUSED const AnyView* args, MAYBE_UNUSED int32_t num_args, MAYBE_UNUSED Any* rv) {
+                                MAYBE_UNUSED const AnyView* args, MAYBE_UNUSED int32_t num_args, MAYBE_UNUSED TRet* rv) {
     using FuncInfo = FunctionInfo<F>;
     FGetFuncSignature f_sig = FuncInfo::Sig;
 
@@ -188,6 +216,16 @@ TVM_FFI_INLINE void unpack_call(std::index_sequence<Is...>, const std::string* o
                                  << " but got " << num_args << " arguments";
     }
 
+    if (ProfilerEnabled()) {
+        using Invoker = ProfiledInvoke<R, std::tuple_element_t<Is, typename FuncInfo::ArgType>...>;
+        if constexpr (std::is_same_v<R, void>) {
+            Invoker::Run(f, ArgValueWithContext(args, Is, optional_name, f_sig)...);
+        } else {
+            *rv = R(Invoker::Run(f, ArgValueWithContext(args, Is, optional_name, f_sig)...));
+        }
+        return;
+    }
+
     // use index sequence to do recursive-less unpacking
     if constexpr (std::is_same_v<R, void>) {
         f(ArgValueWithContext(args, Is, optional_name, f_sig)...);
@@ -224,6 +262,13 @@ struct TypeSchemaImpl {
     }
 };
 
+template<typename T>
+struct TypeSchemaImpl<Expected<T>> {
+    static std::string v() {
+        return TypeSchemaImpl<T>::v();
+    }
+};
+
 template<>
 struct TypeSchemaImpl<void> {
     static std::string v() {
@@ -75,6 +75,68 @@ TVM_FFI_INLINE void AlignedFree(void* data) {
 #endif
 }
 
+/*!
+ * \brief Bounded thread-local pool of fixed size memory blocks.
+ *
+ * Blocks released by a thread are kept for its next acquisitions, up to kMaxBlocks, and
+ * freed on thread exit. Blocks may be released on another thread than the acquiring one.
+ *
+ * \tparam kBlockSize The size of the blocks.
+ * \tparam kAlign The alignment of the blocks.
+ * \tparam kMaxBlocks The maximum number of free blocks kept by each thread.
+ */
+template<size_t kBlockSize, size_t kAlign, size_t kMaxBlocks>
+class ThreadLocalBlockPool {
+public:
+    /*! \return A block of kBlockSize bytes. */
+    static void* Acquire() {
+        Pool* pool = ThreadLocalPool();
+        if (pool->size != 0) {
+            return pool->blocks[--pool->size];
+        }
+        return AlignedAlloc<kAlign>(kBlockSize);
+    }
+
+    /*!
+     * \brief Return a block to the pool of the calling thread.
+     * \param block The block returned by Acquire.
+     */
+    static void Release(void* block) {
+        Pool* pool = ThreadLocalPool();
+        if (!pool->closed && pool->size < kMaxBlocks) {
+            pool->blocks[pool->size++] = block;
+            return;
+        }
+        AlignedFree(block);
+    }
+
+private:
+    struct Pool {
+        void* blocks[kMaxBlocks];
+        size_t size{0};
+        bool closed{false};
+    };
+
+    // frees the pooled blocks on thread exit
+    struct PoolCloser {
+        Pool* pool;
+        ~PoolCloser() {
+            for (size_t i = 0; i < pool->size; ++i) {
+                AlignedFree(pool->blocks[i]);
+            }
+            pool->size = 0;
+            pool->closed = true;
+        }
+    };
+
+    static Pool* ThreadLocalPool() {
+        // the pool itself is trivially destructible so blocks released during thread exit can still check it
+        static thread_local Pool pool;
+        static thread_local PoolCloser closer{&pool};
+        return &pool;
+    }
+};
+
 
 /*!
  * \brief Base class of object allocators that implements make.
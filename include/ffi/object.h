@@ -63,7 +63,11 @@ struct StaticTypeKey {
     static constexpr const char* kTVMFFIObject = "ffi.Object";
     static constexpr const char* kTVMFFIFunction = "ffi.Function";
     static constexpr const char* kTVMFFIArray = "ffi.Array";
+    static constexpr const char* kTVMFFIPODArray = "ffi.PODArray";
     static constexpr const char* kTVMFFIMap = "ffi.Map";
+    static constexpr const char* kTVMFFIPersistentArray = "ffi.PersistentArray";
+    static constexpr const char* kTVMFFIPersistentMap = "ffi.PersistentMap";
+    static constexpr const char* kTVMFFIConcurrentMap = "ffi.ConcurrentMap";
     static constexpr const char* kTVMFFIModule = "ffi.Module";
     /*! \brief The type key for OpaquePyObject */
     static constexpr const char* kTVMFFIOpaquePyObject = "ffi.OpaquePyObject";
@@ -0,0 +1,112 @@
+//
+// Created by richard on 10/18/26.
+//
+
+#ifndef LITETVM_FFI_PROFILER_H
+#define LITETVM_FFI_PROFILER_H
+
+#include "ffi/any.h"
+#include "ffi/c_api.h"
+#include "ffi/container/map.h"
+#include "ffi/function.h"
+#include "ffi/string.h"
+
+#include <string_view>
+
+namespace litetvm {
+namespace ffi {
+
+/*!
+ * \brief Opt-in profiler that records per-function call statistics.
+ *
+ * Functions registered in the global function table and functions returned by
+ * library modules are tracked: their call path records the call while the
+ * profiler is running. Lookups always return the registered function itself,
+ * and references fetched before Start are recorded too. Functions backed by a
+ * foreign safe_call can be recorded through Wrap instead.
+ *
+ * Counters are kept per thread and merged when a report is requested.
+ *
+ * \code
+ *
+ * Profiler::Start();
+ * RunWorkload();
+ * Profiler::Stop();
+ * Map<String, Any> report = Profiler::Report();
+ *
+ * \endcode
+ */
+class Profiler {
+public:
+    /*! \brief Reset the collected statistics and start recording. */
+    static void Start() {
+        static Function fstart = Function::GetGlobalRequired("ffi.Profiler.Start");
+        fstart();
+    }
+
+    /*! \brief Stop recording, the collected statistics are kept. */
+    static void Stop() {
+        static Function fstop = Function::GetGlobalRequired("ffi.Profiler.Stop");
+        fstop();
+    }
+
+    /*! \return Whether the profiler is recording calls. */
+    static bool Enabled() {
+        return details::ProfilerEnabled();
+    }
+
+    /*!
+     * \brief Get the statistics collected since the last Start.
+     * \return Map from function name to a map of statistics.
+     */
+    static Map<String, Any> Report() {
+        static Function freport = Function::GetGlobalRequired("ffi.Profiler.Report");
+        return freport().cast<Map<String, Any>>();
+    }
+
+    /*!
+     * \brief Record the calls of a function under the given name while the profiler runs.
+     * \param name The name used to report the function.
+     * \param func The function to be tracked, it is not copied or wrapped.
+     */
+    static void Track(std::string_view name, const Function& func) {
+        TVMFFIByteArray name_arr{name.data(), name.size()};
+        TVM_FFI_CHECK_SAFE_CALL(TVMFFIProfilerTrackFunction(&name_arr, details::ObjectUnsafe::GetHeader(func.get())));
+    }
+
+    static void Track(const String& name, const Function& func) {
+        Track(std::string_view(name.data(), name.length()), func);
+    }
+
+    static void Track(const char* name, const Function& func) {
+        Track(std::string_view(name), func);
+    }
+
+    /*!
+     * \brief Wrap a function so that its calls are recorded under the given name.
+     * \param name The name used to report the function.
+     * \param func The function to be wrapped.
+     * \return The wrapped function.
+     */
+    static Function Wrap(std::string_view name, const Function& func) {
+        TVMFFIByteArray name_arr{name.data(), name.size()};
+        TVMFFIObjectHandle handle;
+        TVM_FFI_CHECK_SAFE_CALL(
+                TVMFFIProfilerWrapFunction(&name_arr, details::ObjectUnsafe::GetHeader(func.get()), &handle));
+        return details::ObjectUnsafe::ObjectRefFromObjectPtr<Function>(
+                details::ObjectUnsafe::ObjectPtrFromOwned<Object>(static_cast<TVMFFIObject*>(handle)));
+    }
+
+    static Function Wrap(const String& name, const Function& func) {
+        return Wrap(std::string_view(name.data(), name.length()), func);
+    }
+
+    static Function Wrap(const char* name, const Function& func) {
+        return Wrap(std::string_view(name), func);
+    }
+};
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_PROFILER_H
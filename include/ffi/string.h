@@ -165,6 +165,20 @@ public:
         data_.type_index = large_type_index;
     }
 
+    /*!
+     * \brief Take over a heap allocated bytes object
+     * \param ptr The object, its data and size must be set up
+     * \param large_type_index The type index of the object
+     */
+    template<typename LargeObj>
+    void InitFromObjectPtr(ObjectPtr<LargeObj> ptr, int32_t large_type_index) {
+        data_.type_index = TypeIndex::kTVMFFINone;
+        data_.zero_padding = 0;
+        TVM_FFI_CLEAR_PTR_PADDING_IN_FFI_ANY(&data_);
+        data_.v_obj = ObjectUnsafe::MoveObjectPtrToTVMFFIObjectPtr(std::move(ptr));
+        data_.type_index = large_type_index;
+    }
+
     /*!
      * \brief Create a new empty space for a string
      * \param size The size of the string
@@ -230,6 +244,9 @@ private:
 };
 }// namespace details
 
+class BytesRope;
+class StringBuilder;
+
 /*!
  * \brief Managed reference of byte array.
  */
@@ -346,6 +363,7 @@ private:
     friend struct TypeTraits;
     template<typename, typename>
     friend class Optional;
+    friend class BytesRope;
     // internal backing cell
     details::BytesBaseCell data_;
     // create a new String from TVMFFIAny, must keep private
@@ -566,6 +584,7 @@ private:
     friend struct TypeTraits;
     template<typename, typename>
     friend class Optional;
+    friend class StringBuilder;
     // internal backing cell
     details::BytesBaseCell data_;
     // create a new String from TVMFFIAny, must keep private
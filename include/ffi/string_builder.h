@@ -0,0 +1,354 @@
+//
+// Created by richard on 10/18/26.
+//
+
+#ifndef LITETVM_FFI_STRING_BUILDER_H
+#define LITETVM_FFI_STRING_BUILDER_H
+
+#include "ffi/base_details.h"
+#include "ffi/memory.h"
+#include "ffi/string.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace litetvm {
+namespace ffi {
+
+/*!
+ * \brief Builder that assembles a String piece by piece.
+ *
+ * The content is appended to chunks that grow geometrically, so appends never
+ * move what was already written. Build() hands the first chunk over to the
+ * resulting String without a copy when it holds the whole content, otherwise
+ * the chunks are copied once into a single allocation.
+ *
+ * \code
+ *
+ * StringBuilder builder;
+ * builder << "float" << 32 << 'x' << 4;
+ * String dtype = builder.Build();
+ *
+ * \endcode
+ */
+class StringBuilder {
+public:
+    /*! \brief default constructor */
+    StringBuilder() = default;
+
+    /*!
+   * \brief Constructor with an initial capacity.
+   * \param capacity The number of bytes expected to be appended.
+   */
+    explicit StringBuilder(size_t capacity) {
+        Reserve(capacity);
+    }
+
+    StringBuilder(const StringBuilder&) = delete;
+    StringBuilder& operator=(const StringBuilder&) = delete;
+    StringBuilder(StringBuilder&&) noexcept = default;
+    StringBuilder& operator=(StringBuilder&&) noexcept = default;
+
+    /*! \return The number of bytes appended so far */
+    NODISCARD size_t size() const {
+        return size_;
+    }
+
+    /*! \return Whether nothing has been appended */
+    NODISCARD bool empty() const {
+        return size_ == 0;
+    }
+
+    /*!
+   * \brief Make sure the content can grow to capacity bytes without allocation.
+   * \param capacity The total number of bytes.
+   */
+    void Reserve(size_t capacity) {
+        if (capacity > size_ && static_cast<size_t>(end_ - cursor_) < capacity - size_) {
+            Grow(capacity - size_);
+        }
+    }
+
+    /*!
+   * \brief Append a char sequence.
+   * \param data The data pointer.
+   * \param size The number of bytes.
+   * \return Self
+   */
+    StringBuilder& Append(const char* data, size_t size) {
+        while (size != 0) {
+            if (cursor_ == end_) {
+                Grow(size);
+            }
+            size_t n = std::min(size, static_cast<size_t>(end_ - cursor_));
+            std::memcpy(cursor_, data, n);
+            cursor_ += n;
+            data += n;
+            size -= n;
+            size_ += n;
+        }
+        return *this;
+    }
+
+    StringBuilder& Append(std::string_view str) {
+        return Append(str.data(), str.size());
+    }
+
+    StringBuilder& Append(char c) {
+        if (cursor_ == end_) {
+            Grow(1);
+        }
+        *cursor_++ = c;
+        ++size_;
+        return *this;
+    }
+
+    /*!
+   * \brief Append the decimal representation of a number.
+   * \param value The number.
+   * \return Self
+   */
+    template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    StringBuilder& AppendNumber(T value) {
+        // enough for any integer and the shortest round-trip form of a double
+        char buffer[32];
+        std::to_chars_result res = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return Append(buffer, static_cast<size_t>(res.ptr - buffer));
+    }
+
+    StringBuilder& operator<<(std::string_view str) {
+        return Append(str);
+    }
+
+    StringBuilder& operator<<(const char* str) {
+        return Append(std::string_view(str));
+    }
+
+    StringBuilder& operator<<(const std::string& str) {
+        return Append(str.data(), str.size());
+    }
+
+    StringBuilder& operator<<(const String& str) {
+        return Append(str.data(), str.size());
+    }
+
+    StringBuilder& operator<<(char c) {
+        return Append(c);
+    }
+
+    template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, char> &&
+                                                     !std::is_same_v<T, bool>>>
+    StringBuilder& operator<<(T value) {
+        return AppendNumber(value);
+    }
+
+    /*!
+   * \brief Build the string and reset the builder.
+   * \return The string.
+   * \note The first chunk is moved into the String when it holds all the content and
+   *       at least half of it is used, so the result does not keep a large slack around.
+   */
+    String Build() {
+        String result;
+        if (size_ > kMaxSmallStrLen && chunks_.empty() && size_ * 2 >= head_capacity_) {
+            // move the buffer into the string
+            head_->data = head_data_;
+            head_->size = size_;
+            head_data_[size_] = '\0';
+            result.data_.InitFromObjectPtr(std::move(head_), TypeIndex::kTVMFFIStr);
+        } else {
+            char* dest = result.InitSpaceForSize(size_);
+            CopyTo(dest);
+            dest[size_] = '\0';
+        }
+        Clear();
+        return result;
+    }
+
+    /*! \brief Discard the content. */
+    void Clear() {
+        head_.reset();
+        head_data_ = nullptr;
+        head_capacity_ = 0;
+        head_size_ = 0;
+        chunks_.clear();
+        cursor_ = nullptr;
+        end_ = nullptr;
+        size_ = 0;
+    }
+
+private:
+    /*! \brief Buffer allocated after the first chunk is full. */
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        size_t capacity;
+        size_t size;
+    };
+
+    void Grow(size_t min_size) {
+        if (head_ == nullptr) {
+            size_t capacity = std::max(min_size, kInitCapacity);
+            // one extra byte for the terminating \0
+            head_ = make_inplace_array_object<details::StringObj, char>(capacity + 1);
+            head_data_ = reinterpret_cast<char*>(head_.get()) + sizeof(details::StringObj);
+            head_capacity_ = capacity;
+            cursor_ = head_data_;
+            end_ = head_data_ + capacity;
+            return;
+        }
+        // seal the current chunk
+        if (chunks_.empty()) {
+            head_size_ = static_cast<size_t>(cursor_ - head_data_);
+        } else {
+            chunks_.back().size = static_cast<size_t>(cursor_ - chunks_.back().data.get());
+        }
+        // the total capacity at least doubles
+        size_t capacity = std::max(min_size, size_);
+        chunks_.push_back(Chunk{std::make_unique<char[]>(capacity), capacity, 0});
+        cursor_ = chunks_.back().data.get();
+        end_ = cursor_ + capacity;
+    }
+
+    void CopyTo(char* dest) const {
+        if (head_ == nullptr) return;
+        size_t head_size = chunks_.empty() ? static_cast<size_t>(cursor_ - head_data_) : head_size_;
+        std::memcpy(dest, head_data_, head_size);
+        dest += head_size;
+        for (size_t i = 0; i < chunks_.size(); ++i) {
+            size_t chunk_size =
+                    i + 1 == chunks_.size() ? static_cast<size_t>(cursor_ - chunks_[i].data.get()) : chunks_[i].size;
+            std::memcpy(dest, chunks_[i].data.get(), chunk_size);
+            dest += chunk_size;
+        }
+    }
+
+    /*! \brief Initial capacity of the first chunk. */
+    static constexpr size_t kInitCapacity = 64;
+    /*! \brief Strings up to this length are stored inline in String. */
+    static constexpr size_t kMaxSmallStrLen = sizeof(int64_t) - 1;
+
+    // the first chunk, allocated as a StringObj so that Build can hand it over
+    ObjectPtr<details::StringObj> head_;
+    char* head_data_{nullptr};
+    size_t head_capacity_{0};
+    size_t head_size_{0};
+    std::vector<Chunk> chunks_;
+    // write position in the current chunk
+    char* cursor_{nullptr};
+    char* end_{nullptr};
+    size_t size_{0};
+};
+
+/*!
+ * \brief Rope of Bytes for concatenating large payloads without copying.
+ *
+ * The pieces are shared by reference, Flatten copies them once into a
+ * contiguous Bytes when a consumer needs the whole payload.
+ */
+class BytesRope {
+public:
+    /*! \brief default constructor */
+    BytesRope() = default;
+
+    /*!
+   * \brief Construct from a single piece.
+   * \param piece The piece.
+   */
+    BytesRope(Bytes piece) {// NOLINT(*)
+        Append(std::move(piece));
+    }
+
+    /*!
+   * \brief Append a piece.
+   * \param piece The piece.
+   * \return Self
+   */
+    BytesRope& Append(Bytes piece) {
+        if (piece.size() != 0) {
+            size_ += piece.size();
+            pieces_.push_back(std::move(piece));
+        }
+        return *this;
+    }
+
+    /*!
+   * \brief Append the pieces of another rope.
+   * \param other The other rope.
+   * \return Self
+   */
+    BytesRope& Append(const BytesRope& other) {
+        pieces_.insert(pieces_.end(), other.pieces_.begin(), other.pieces_.end());
+        size_ += other.size_;
+        return *this;
+    }
+
+    /*! \return The total number of bytes */
+    NODISCARD size_t size() const {
+        return size_;
+    }
+
+    /*! \return Whether the rope is empty */
+    NODISCARD bool empty() const {
+        return size_ == 0;
+    }
+
+    /*! \return The pieces of the rope */
+    NODISCARD const std::vector<Bytes>& pieces() const {
+        return pieces_;
+    }
+
+    /*!
+   * \brief Read a byte.
+   * \param pos The position.
+   * \return The byte at position.
+   */
+    char at(size_t pos) const {
+        if (pos >= size_) {
+            TVM_FFI_THROW(IndexError) << "Index " << pos << " out of bounds " << size_;
+        }
+        for (const Bytes& piece: pieces_) {
+            if (pos < piece.size()) return piece.data()[pos];
+            pos -= piece.size();
+        }
+        TVM_FFI_UNREACHABLE();
+    }
+
+    /*!
+   * \brief Concatenate the pieces into contiguous Bytes.
+   * \return The bytes, a rope of a single piece returns it without a copy.
+   */
+    NODISCARD Bytes Flatten() const {
+        if (pieces_.size() == 1) {
+            return pieces_[0];
+        }
+        Bytes result;
+        char* dest = result.InitSpaceForSize(size_);
+        for (const Bytes& piece: pieces_) {
+            std::memcpy(dest, piece.data(), piece.size());
+            dest += piece.size();
+        }
+        *dest = '\0';
+        return result;
+    }
+
+    friend BytesRope operator+(BytesRope lhs, const BytesRope& rhs) {
+        lhs.Append(rhs);
+        return lhs;
+    }
+
+private:
+    std::vector<Bytes> pieces_;
+    size_t size_{0};
+};
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_STRING_BUILDER_H
@@ -0,0 +1,92 @@
+//
+// Created by richard on 10/19/26.
+//
+
+#ifndef LITETVM_FFI_THREAD_POOL_H
+#define LITETVM_FFI_THREAD_POOL_H
+
+#include "ffi/c_api.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace litetvm {
+namespace ffi {
+
+/*!
+ * \brief Fixed size pool of worker threads.
+ *
+ * The caller of ParallelFor runs a share of the work itself, so a pool of n workers runs
+ * loops on n + 1 threads and a pool without workers runs them inline. Loops started from
+ * a worker thread run inline as well, nested loops never wait for busy workers.
+ */
+class ThreadPool {
+public:
+    /*!
+     * \brief Create a pool.
+     * \param num_workers The number of worker threads.
+     */
+    TVM_FFI_DLL explicit ThreadPool(int num_workers);
+
+    /*!
+     * \brief Create a pool whose workers run an init function first, e.g. to pin them to CPUs.
+     * \param num_workers The number of worker threads.
+     * \param init_worker Called on each worker with its index before it runs tasks, must not throw.
+     */
+    TVM_FFI_DLL ThreadPool(int num_workers, std::function<void(int)> init_worker);
+
+    /*! \brief Wait for the submitted tasks and join the workers. */
+    TVM_FFI_DLL ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /*!
+     * \brief Get the process wide pool.
+     *
+     * Its loops run on TVM_FFI_NUM_THREADS threads, default to the hardware concurrency.
+     * \return The pool, never destroyed.
+     */
+    TVM_FFI_DLL static ThreadPool* Global();
+
+    /*! \return The number of threads that run a loop, the workers and the caller. */
+    NODISCARD int NumThreads() const {
+        return static_cast<int>(workers_.size()) + 1;
+    }
+
+    /*!
+     * \brief Run a task on a worker, or inline if the pool has no workers.
+     * \param task The task, must not throw.
+     */
+    TVM_FFI_DLL void Submit(std::function<void()> task);
+
+    /*!
+     * \brief Run fn over [begin, end) split into contiguous chunks, one per thread.
+     * \param begin The start of the range.
+     * \param end The end of the range.
+     * \param min_chunk The smallest chunk worth running on another thread.
+     * \param fn The body, called as fn(chunk_begin, chunk_end).
+     * \note Returns when all chunks are done, the first exception thrown by fn is rethrown.
+     */
+    TVM_FFI_DLL void ParallelFor(int64_t begin, int64_t end, int64_t min_chunk,
+                                 const std::function<void(int64_t, int64_t)>& fn);
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+    bool stop_{false};
+};
+
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_THREAD_POOL_H
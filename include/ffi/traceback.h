@@ -37,16 +37,16 @@ inline int32_t GetTracebackLimit() {
 inline bool ShouldExcludeFrame(const char* filename, const char* symbol) {
     if (filename) {
         // Stack frames for TVM FFI
-        if (strstr(filename, "include/tvm/ffi/error.h")) {
+        if (strstr(filename, "include/ffi/error.h")) {
             return true;
         }
-        if (strstr(filename, "include/tvm/ffi/function_details.h")) {
+        if (strstr(filename, "include/ffi/function_details.h")) {
             return true;
         }
-        if (strstr(filename, "include/tvm/ffi/function.h")) {
+        if (strstr(filename, "include/ffi/function.h")) {
             return true;
         }
-        if (strstr(filename, "include/tvm/ffi/any.h")) {
+        if (strstr(filename, "include/ffi/any.h")) {
             return true;
         }
         if (strstr(filename, "include/tvm/runtime/logging.h")) {
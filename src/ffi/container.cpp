@@ -2,8 +2,13 @@
 // Created by richard on 5/15/25.
 //
 #include "ffi/container/array.h"
+#include "ffi/container/concurrent_map.h"
 #include "ffi/container/map.h"
+#include "ffi/container/persistent_array.h"
+#include "ffi/container/persistent_map.h"
+#include "ffi/container/pod_array.h"
 #include "ffi/container/shape.h"
+#include "ffi/dtype.h"
 #include "ffi/function.h"
 #include "ffi/reflection/registry.h"
 
@@ -49,6 +54,26 @@ TVM_FFI_STATIC_INIT_BLOCK() {
             .def("ffi.ArrayGetItem", [](const ArrayObj* n, int64_t i) -> Any { return n->at(i); })
             .def("ffi.ArraySize",
                  [](const ArrayObj* n) -> int64_t { return static_cast<int64_t>(n->size()); })
+            .def("ffi.PODArrayFromArray",
+                 [](const Array<Any>& arr, DLDataType dtype) -> ObjectRef {
+                     // the elements keep the declared width, e.g. int32 is not widened to int64
+                     if (details::PODArrayElemTraits<int64_t>::Match(dtype)) {
+                         return PODArray<int64_t>::FromArray(arr);
+                     }
+                     if (details::PODArrayElemTraits<double>::Match(dtype)) {
+                         return PODArray<double>::FromArray(arr);
+                     }
+                     if (details::PODArrayElemTraits<bool>::Match(dtype)) {
+                         return PODArray<bool>::FromArray(arr);
+                     }
+                     TVM_FFI_THROW(ValueError) << "PODArray only supports int64, float64 and bool elements, got "
+                                               << dtype;
+                     TVM_FFI_UNREACHABLE();
+                 })
+            .def("ffi.PODArrayToArray",
+                 [](const PODArrayObj* n) -> Array<Any> { return *details::ArrayFromPODArray<Any>(n); })
+            .def("ffi.PODArrayGetItem", [](const PODArrayObj* n, int64_t i) -> Any { return n->at(i); })
+            .def("ffi.PODArraySize", [](const PODArrayObj* n) -> int64_t { return n->size; })
             .def_packed("ffi.Map",
                         [](PackedArgs args, Any* ret) {
                             TVM_FFI_ICHECK_EQ(args.size() % 2, 0);
@@ -65,9 +90,73 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                  [](const MapObj* n, const Any& k) -> int64_t {
                      return static_cast<int64_t>(n->count(k));
                  })
-            .def("ffi.MapForwardIterFunctor", [](const MapObj* n) -> Function {
-                return ffi::Function::FromTyped(MapForwardIterFunctor(n->begin(), n->end()));
-            });
+            .def("ffi.MapForwardIterFunctor",
+                 [](const MapObj* n) -> Function {
+                     return ffi::Function::FromTyped(MapForwardIterFunctor(n->begin(), n->end()));
+                 })
+            .def_packed("ffi.PersistentArray",
+                        [](PackedArgs args, Any* ret) {
+                            *ret = PersistentArray<Any>(args.data(), args.data() + args.size());
+                        })
+            .def("ffi.PersistentArrayGetItem",
+                 [](const PersistentArrayObj* n, int64_t i) -> Any { return n->at(i); })
+            .def("ffi.PersistentArraySize",
+                 [](const PersistentArrayObj* n) -> int64_t { return static_cast<int64_t>(n->size()); })
+            // updates return a new version and keep the argument unchanged
+            .def("ffi.PersistentArraySetItem",
+                 [](PersistentArray<Any> arr, int64_t i, Any value) -> PersistentArray<Any> {
+                     arr.Set(i, std::move(value));
+                     return arr;
+                 })
+            .def("ffi.PersistentArrayPushBack",
+                 [](PersistentArray<Any> arr, Any value) -> PersistentArray<Any> {
+                     arr.push_back(value);
+                     return arr;
+                 })
+            .def_packed("ffi.PersistentMap",
+                        [](PackedArgs args, Any* ret) {
+                            TVM_FFI_ICHECK_EQ(args.size() % 2, 0);
+                            PersistentMap<Any, Any> data;
+                            for (int i = 0; i < args.size(); i += 2) {
+                                data.Set(args[i], args[i + 1]);
+                            }
+                            *ret = data;
+                        })
+            .def("ffi.PersistentMapSize",
+                 [](const PersistentMapObj* n) -> int64_t { return static_cast<int64_t>(n->size()); })
+            .def("ffi.PersistentMapGetItem", [](const PersistentMapObj* n, const Any& k) -> Any { return n->at(k); })
+            .def("ffi.PersistentMapCount",
+                 [](const PersistentMapObj* n, const Any& k) -> int64_t {
+                     return static_cast<int64_t>(n->count(k));
+                 })
+            .def("ffi.PersistentMapSet",
+                 [](PersistentMap<Any, Any> map, Any key, Any value) -> PersistentMap<Any, Any> {
+                     map.Set(key, value);
+                     return map;
+                 })
+            .def("ffi.PersistentMapErase", [](PersistentMap<Any, Any> map, Any key) -> PersistentMap<Any, Any> {
+                map.erase(key);
+                return map;
+            })
+            .def("ffi.ConcurrentMap", []() { return ConcurrentMap<Any, Any>(); })
+            .def("ffi.ConcurrentMapSize",
+                 [](const ConcurrentMapObj* n) -> int64_t { return static_cast<int64_t>(n->size()); })
+            .def("ffi.ConcurrentMapGetItem",
+                 [](const ConcurrentMapObj* n, const Any& k) -> Any {
+                     std::optional<Any> value = n->Get(k);
+                     if (!value.has_value()) {
+                         TVM_FFI_THROW(KeyError) << "key is not in ConcurrentMap";
+                     }
+                     return *std::move(value);
+                 })
+            .def("ffi.ConcurrentMapSet",
+                 [](ConcurrentMap<Any, Any> map, Any key, Any value) { map.Set(key, value); })
+            .def("ffi.ConcurrentMapGetOrInsert",
+                 [](ConcurrentMap<Any, Any> map, Any key, Function factory) -> Any {
+                     return map.GetOrInsert(key, factory);
+                 })
+            .def("ffi.ConcurrentMapErase",
+                 [](ConcurrentMap<Any, Any> map, Any key) -> bool { return map.erase(key); });
 }
 
 }// namespace ffi
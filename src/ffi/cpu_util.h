@@ -0,0 +1,36 @@
+//
+// Created by richard on 10/19/26.
+//
+// Helpers of the CPU tensor kernels, shared by the tensor copy and dtype conversion kernels.
+#ifndef LITETVM_FFI_CPU_UTIL_H
+#define LITETVM_FFI_CPU_UTIL_H
+
+#include "ffi/c_api.h"
+#include "ffi/container/tensor.h"
+#include "ffi/memory.h"
+
+namespace litetvm {
+namespace ffi {
+namespace details {
+
+/*! \brief Allocator of CPU tensors with 64 byte aligned data. */
+struct AlignedCPUAlloc {
+    void AllocData(DLTensor* tensor) {
+        tensor->data = AlignedAlloc<64>(GetDataSize(*tensor));
+    }
+
+    void FreeData(DLTensor* tensor) {
+        AlignedFree(tensor->data);
+    }
+};
+
+/*! \return Whether the data of the device can be accessed from the host. */
+inline bool IsCPUAccessible(DLDevice device) {
+    return device.device_type == kDLCPU || device.device_type == kDLCUDAHost || device.device_type == kDLROCMHost;
+}
+
+}// namespace details
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_CPU_UTIL_H
@@ -3,6 +3,7 @@
 //
 
 #include "ffi/dtype.h"
+#include "ffi/string_builder.h"
 
 #include <string_view>
 
@@ -144,7 +145,7 @@ inline void PrintDLDataTypeCodeAsStr(std::ostream& os, DLDataTypeCode type_code)
  *  \param dtype The DLDataType to print.
  *  \return The output stream.
  */
-inline std::string DLDataTypeToString_(DLDataType dtype) {// NOLINT(*)
+inline String DLDataTypeToString_(DLDataType dtype) {// NOLINT(*)
     if (dtype.bits == 1 && dtype.lanes == 1 && dtype.code == kDLUInt) {
         return "bool";
     }
@@ -153,7 +154,7 @@ inline std::string DLDataTypeToString_(DLDataType dtype) {// NOLINT(*)
         return "";
     }
 
-    std::ostringstream os;
+    StringBuilder os;
     if (dtype.code >= kDLExtCustomBegin) {
         os << "custom["
            << details::DLDataTypeCodeGetCustomTypeName(static_cast<DLDataTypeCode>(dtype.code)) << "]";
@@ -162,7 +163,7 @@ inline std::string DLDataTypeToString_(DLDataType dtype) {// NOLINT(*)
     }
 
     if (dtype.code == kDLOpaqueHandle) {
-        return os.str();
+        return os.Build();
     }
 
     auto lanes = static_cast<int16_t>(dtype.lanes);
@@ -174,7 +175,7 @@ inline std::string DLDataTypeToString_(DLDataType dtype) {// NOLINT(*)
     } else if (lanes < -1) {
         os << "xvscalex" << -lanes;
     }
-    return os.str();
+    return os.Build();
 }
 
 /*!
@@ -321,7 +322,7 @@ int TVMFFIDataTypeFromString(const TVMFFIByteArray* str, DLDataType* out) {
 
 int TVMFFIDataTypeToString(const DLDataType* dtype, TVMFFIAny* out) {
     TVM_FFI_SAFE_CALL_BEGIN();
-    litetvm::ffi::String out_str(litetvm::ffi::DLDataTypeToString_(*dtype));
+    litetvm::ffi::String out_str = litetvm::ffi::DLDataTypeToString_(*dtype);
     litetvm::ffi::TypeTraits<litetvm::ffi::String>::MoveToAny(std::move(out_str), out);
     TVM_FFI_SAFE_CALL_END();
 }
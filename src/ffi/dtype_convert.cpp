@@ -0,0 +1,515 @@
+//
+// Created by richard on 10/19/26.
+//
+// Conversion of CPU tensors between dtypes, and quantization to 8 and 4 bit dtypes.
+//
+// Rows between float32 and float16 or bfloat16 run 8 elements at a time on AVX2 and F16C
+// when the CPU has them. AsType converts with the copy kernels of tensor_copy.cpp, which
+// read float8 through a table of the 256 values and round to float8 with integer
+// arithmetic. The packed dtypes, int4, uint4 and float4_e2m1fn, hold two elements per byte
+// with the first in the low nibble and convert through the quantization kernels with a scale
+// of 1. Quantize divides by the scale of the channel of each element and rounds, Dequantize
+// looks the codes up in a table of their values and multiplies by the scale. Both run on
+// blocks of kBlock elements, split over ThreadPool::Global for large tensors.
+#include "ffi/container/tensor.h"
+#include "ffi/function.h"
+#include "ffi/memory.h"
+#include "ffi/reflection/registry.h"
+#include "ffi/thread_pool.h"
+
+#include "cpu_util.h"
+#include "dtype_convert.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define TVM_FFI_DTYPE_CONVERT_AVX2 1
+#else
+#define TVM_FFI_DTYPE_CONVERT_AVX2 0
+#endif
+
+namespace litetvm {
+namespace ffi {
+namespace details {
+
+namespace {
+
+template<typename D, typename S, D (*kConvert)(S)>
+void ScalarRow(char* dst, const char* src, int64_t begin, int64_t n) {
+    for (int64_t i = begin; i < n; ++i) {
+        S value;
+        std::memcpy(&value, src + i * sizeof(S), sizeof(S));
+        D result = kConvert(value);
+        std::memcpy(dst + i * sizeof(D), &result, sizeof(D));
+    }
+}
+
+#if TVM_FFI_DTYPE_CONVERT_AVX2
+bool HasAVX2F16C() {
+    static const bool has = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c");
+    return has;
+}
+
+// each returns the number of elements converted, a multiple of 8
+__attribute__((target("avx2,f16c"))) int64_t FloatToHalfAVX2(char* dst, const char* src, int64_t n) {
+    const __m256i sign_mask = _mm256_set1_epi32(0x8000);
+    const __m128i quiet_nan = _mm_set1_epi16(0x7e00);
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(reinterpret_cast<const float*>(src + i * 4));
+        __m128i h = _mm256_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT);
+        // NaNs become the quiet NaN of their sign, as in FloatToHalf
+        __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+        __m256i sign = _mm256_and_si256(_mm256_srli_epi32(_mm256_castps_si256(x), 16), sign_mask);
+        __m128i nan16 = _mm_packs_epi32(_mm256_castsi256_si128(nan), _mm256_extracti128_si256(nan, 1));
+        __m128i sign16 = _mm_packus_epi32(_mm256_castsi256_si128(sign), _mm256_extracti128_si256(sign, 1));
+        h = _mm_blendv_epi8(h, _mm_or_si128(sign16, quiet_nan), nan16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), h);
+    }
+    return i;
+}
+
+__attribute__((target("avx2,f16c"))) int64_t HalfToFloatAVX2(char* dst, const char* src, int64_t n) {
+    const __m256i exp_mask = _mm256_set1_epi32(0x7c00);
+    const __m256i mant_mask = _mm256_set1_epi32(0x3ff);
+    const __m256i sign_mask = _mm256_set1_epi32(0x8000);
+    const __m256i inf = _mm256_set1_epi32(0x7f800000);
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+        __m256 x = _mm256_cvtph_ps(h);
+        // NaNs keep their payload as in HalfToFloat, where the hardware sets the quiet bit
+        __m256i h32 = _mm256_cvtepu16_epi32(h);
+        __m256i mant = _mm256_and_si256(h32, mant_mask);
+        __m256i nan = _mm256_andnot_si256(_mm256_cmpeq_epi32(mant, _mm256_setzero_si256()),
+                                          _mm256_cmpeq_epi32(_mm256_and_si256(h32, exp_mask), exp_mask));
+        __m256i nan_bits = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(h32, sign_mask), 16),
+                                           _mm256_or_si256(inf, _mm256_slli_epi32(mant, 13)));
+        x = _mm256_blendv_ps(x, _mm256_castsi256_ps(nan_bits), _mm256_castsi256_ps(nan));
+        _mm256_storeu_ps(reinterpret_cast<float*>(dst + i * 4), x);
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) int64_t FloatToBFloat16AVX2(char* dst, const char* src, int64_t n) {
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i half_ulp = _mm256_set1_epi32(0x7fff);
+    const __m256i abs_mask = _mm256_set1_epi32(0x7fffffff);
+    const __m256i inf = _mm256_set1_epi32(0x7f800000);
+    const __m256i quiet = _mm256_set1_epi32(0x40);
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(x, 16), one);
+        __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(x, _mm256_add_epi32(half_ulp, lsb)), 16);
+        __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(x, abs_mask), inf);
+        __m256i nan_bits = _mm256_or_si256(_mm256_srli_epi32(x, 16), quiet);
+        __m256i result = _mm256_blendv_epi8(rounded, nan_bits, nan);
+        // the 16 bit halves of the 8 lanes, packing works within 128 bit lanes
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(result, result), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm256_castsi256_si128(packed));
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) int64_t BFloat16ToFloatAVX2(char* dst, const char* src, int64_t n) {
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+        __m256i x = _mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), x);
+    }
+    return i;
+}
+#endif
+
+}// namespace
+
+void FloatToHalfRow(void* dst, const void* src, int64_t n) {
+    int64_t begin = 0;
+#if TVM_FFI_DTYPE_CONVERT_AVX2
+    if (HasAVX2F16C()) {
+        begin = FloatToHalfAVX2(static_cast<char*>(dst), static_cast<const char*>(src), n);
+    }
+#endif
+    ScalarRow<uint16_t, float, FloatToHalf>(static_cast<char*>(dst), static_cast<const char*>(src), begin, n);
+}
+
+void HalfToFloatRow(void* dst, const void* src, int64_t n) {
+    int64_t begin = 0;
+#if TVM_FFI_DTYPE_CONVERT_AVX2
+    if (HasAVX2F16C()) {
+        begin = HalfToFloatAVX2(static_cast<char*>(dst), static_cast<const char*>(src), n);
+    }
+#endif
+    ScalarRow<float, uint16_t, HalfToFloat>(static_cast<char*>(dst), static_cast<const char*>(src), begin, n);
+}
+
+void FloatToBFloat16Row(void* dst, const void* src, int64_t n) {
+    int64_t begin = 0;
+#if TVM_FFI_DTYPE_CONVERT_AVX2
+    if (HasAVX2F16C()) {
+        begin = FloatToBFloat16AVX2(static_cast<char*>(dst), static_cast<const char*>(src), n);
+    }
+#endif
+    ScalarRow<uint16_t, float, FloatToBFloat16>(static_cast<char*>(dst), static_cast<const char*>(src), begin, n);
+}
+
+void BFloat16ToFloatRow(void* dst, const void* src, int64_t n) {
+    int64_t begin = 0;
+#if TVM_FFI_DTYPE_CONVERT_AVX2
+    if (HasAVX2F16C()) {
+        begin = BFloat16ToFloatAVX2(static_cast<char*>(dst), static_cast<const char*>(src), n);
+    }
+#endif
+    ScalarRow<float, uint16_t, BFloat16ToFloat>(static_cast<char*>(dst), static_cast<const char*>(src), begin, n);
+}
+
+}// namespace details
+
+namespace {
+
+/*! \brief Elements quantized or dequantized together, even so packed bytes are not split. */
+constexpr int64_t kBlock = 4096;
+/*! \brief Tensors of at least this many elements are quantized in parallel. */
+constexpr int64_t kParallelMinElems = static_cast<int64_t>(1) << 18;
+/*! \brief Smallest share of a parallel quantization given to one thread, in blocks. */
+constexpr int64_t kMinChunkBlocks = 16;
+
+constexpr DLDataType kFloat32{kDLFloat, 32, 1};
+
+/*! \brief Device of converted tensors, plain host memory also for pinned sources. */
+constexpr DLDevice kCPUDevice{kDLCPU, 0};
+
+/*! \return Whether the dtype holds two elements per byte. */
+bool IsPacked(DLDataType dtype) {
+    return dtype.lanes == 1 && dtype.bits == 4 &&
+           (dtype.code == kDLInt || dtype.code == kDLUInt || dtype.code == kDLFloat4_e2m1fn);
+}
+
+/*! \return Whether the dtype is a dtype of Quantize. */
+bool IsQuantized(DLDataType dtype) {
+    if (dtype.lanes != 1) {
+        return false;
+    }
+    switch (dtype.code) {
+        case kDLInt:
+        case kDLUInt:
+            return dtype.bits == 4 || dtype.bits == 8;
+        case kDLFloat8_e3m4:
+        case kDLFloat8_e4m3:
+        case kDLFloat8_e4m3b11fnuz:
+        case kDLFloat8_e4m3fn:
+        case kDLFloat8_e4m3fnuz:
+        case kDLFloat8_e5m2:
+        case kDLFloat8_e5m2fnuz:
+        case kDLFloat8_e8m0fnu:
+            return dtype.bits == 8;
+        case kDLFloat4_e2m1fn:
+            return dtype.bits == 4;
+        default:
+            return false;
+    }
+}
+
+/*! \brief Scales of the elements, channel c is inner elements every channels * inner. */
+struct Scales {
+    // keeps the float32 scales alive
+    Tensor tensor;
+    const float* data;
+    int64_t channels;
+    int64_t inner;
+};
+
+Scales GetScales(const char* op, const Tensor& tensor, const Tensor& scale, int64_t axis) {
+    if (!details::IsCPUAccessible(scale->device)) {
+        TVM_FFI_THROW(ValueError) << op << ": the scale must be on the CPU, got device type "
+                                  << scale->device.device_type;
+    }
+    Scales scales;
+    scales.tensor = scale.AsType(kFloat32);
+    scales.data = static_cast<const float*>(scales.tensor->data) + scales.tensor->byte_offset / sizeof(float);
+    scales.channels = 1;
+    scales.inner = std::max<int64_t>(tensor.numel(), 1);
+    if (scale.numel() == 1) {
+        return scales;
+    }
+    int32_t ndim = tensor.ndim();
+    if (axis < -ndim || axis >= ndim) {
+        TVM_FFI_THROW(IndexError) << op << ": axis " << axis << " is out of range for " << ndim << " dims";
+    }
+    if (axis < 0) {
+        axis += ndim;
+    }
+    scales.channels = tensor.shape()[axis];
+    if (scale.numel() != scales.channels) {
+        TVM_FFI_THROW(ValueError) << op << ": " << scale.numel() << " scales for " << scales.channels
+                                  << " channels of axis " << axis;
+    }
+    scales.inner = 1;
+    for (int32_t i = static_cast<int32_t>(axis) + 1; i < ndim; ++i) {
+        scales.inner *= tensor.shape()[i];
+    }
+    return scales;
+}
+
+Scales UnitScales(const Tensor& tensor) {
+    static const float kOne = 1.0f;
+    return Scales{Tensor(nullptr), &kOne, 1, std::max<int64_t>(tensor.numel(), 1)};
+}
+
+// Encode rounds a float32 to a code, kept in the low bits of the byte
+template<int kMin, int kMax>
+struct IntEncoder {
+    static uint8_t Encode(float value) {
+        // NaN to 0 and saturate, then adding 1.5 * 2^23 rounds to nearest even, without branches
+        value = value == value ? value : 0.0f;
+        value = std::min(std::max(value, static_cast<float>(kMin)), static_cast<float>(kMax));
+        value = (value + 0x1.8p23f) - 0x1.8p23f;
+        return static_cast<uint8_t>(static_cast<int32_t>(value));
+    }
+};
+
+template<uint8_t kCode>
+struct SmallFloatEncoder {
+    static uint8_t Encode(float value) {
+        return details::FloatToSmallFloat<kCode>(value);
+    }
+};
+
+/*!
+ * \brief Quantize the elements of a range of blocks.
+ * \param dst The codes, packed or one per byte.
+ * \param src The contiguous float32 elements.
+ */
+using QuantizeKernel = void (*)(uint8_t* dst, const float* src, bool packed, const Scales& scales, int64_t numel,
+                                int64_t block_begin, int64_t block_end);
+
+template<typename Encoder>
+void QuantizeBlocks(uint8_t* dst, const float* src, bool packed, const Scales& scales, int64_t numel,
+                    int64_t block_begin, int64_t block_end) {
+    uint8_t codes[kBlock];
+    for (int64_t block = block_begin; block < block_end; ++block) {
+        int64_t begin = block * kBlock;
+        int64_t end = std::min(numel, begin + kBlock);
+        // runs of the elements of one channel
+        for (int64_t i = begin; i < end;) {
+            int64_t run = std::min(end - i, scales.inner - i % scales.inner);
+            float scale = scales.data[i / scales.inner % scales.channels];
+            for (int64_t k = 0; k < run; ++k) {
+                codes[i - begin + k] = Encoder::Encode(src[i + k] / scale);
+            }
+            i += run;
+        }
+        if (!packed) {
+            std::memcpy(dst + begin, codes, end - begin);
+            continue;
+        }
+        for (int64_t k = 0; k < end - begin; k += 2) {
+            uint8_t high = k + 1 < end - begin ? codes[k + 1] : 0;
+            dst[(begin + k) / 2] = static_cast<uint8_t>((codes[k] & 0xfu) | (high << 4));
+        }
+    }
+}
+
+QuantizeKernel GetQuantizeKernel(DLDataType dtype) {
+    switch (dtype.code) {
+        case kDLInt:
+            return dtype.bits == 4 ? QuantizeBlocks<IntEncoder<-8, 7>> : QuantizeBlocks<IntEncoder<-128, 127>>;
+        case kDLUInt:
+            return dtype.bits == 4 ? QuantizeBlocks<IntEncoder<0, 15>> : QuantizeBlocks<IntEncoder<0, 255>>;
+        case kDLFloat8_e3m4:
+            return QuantizeBlocks<SmallFloatEncoder<kDLFloat8_e3m4>>;
+        case kDLFloat8_e4m3:
+            return QuantizeBlocks<SmallFloatEncoder<kDLFloat8_e4m3>>;
+        case kDLFloat8_e4m3b11fnuz:
+            return QuantizeBlocks<SmallFloatEncoder<kDLFloat8_e4m3b11fnuz>>;
+        case kDLFloat8_e4m3fn:
+            return QuantizeBlocks<SmallFloatEncoder<kDLFloat8_e4m3fn>>;
+        case kDLFloat8_e4m3fnuz:
+            return QuantizeBlocks<SmallFloatEncoder<kDLFloat8_e4m3fnuz>>;
+        case kDLFloat8_e5m2:
+            return QuantizeBlocks<SmallFloatEncoder<kDLFloat8_e5m2>>;
+        case kDLFloat8_e5m2fnuz:
+            return QuantizeBlocks<SmallFloatEncoder<kDLFloat8_e5m2fnuz>>;
+        case kDLFloat8_e8m0fnu:
+            return QuantizeBlocks<SmallFloatEncoder<kDLFloat8_e8m0fnu>>;
+        default:
+            return QuantizeBlocks<SmallFloatEncoder<kDLFloat4_e2m1fn>>;
+    }
+}
+
+/*! \return The values of the codes of a dtype of Quantize. */
+std::array<float, 256> CodeValues(DLDataType dtype) {
+    switch (dtype.code) {
+        case kDLInt:
+        case kDLUInt: {
+            std::array<float, 256> values{};
+            for (int code = 0; code < 256; ++code) {
+                int value = dtype.bits == 4 ? code & 0xf : code;
+                // sign extend
+                if (dtype.code == kDLInt && value >= (1 << (dtype.bits - 1))) {
+                    value -= 1 << dtype.bits;
+                }
+                values[code] = static_cast<float>(value);
+            }
+            return values;
+        }
+        case kDLFloat8_e3m4:
+            return details::kSmallFloatTable<kDLFloat8_e3m4>;
+        case kDLFloat8_e4m3:
+            return details::kSmallFloatTable<kDLFloat8_e4m3>;
+        case kDLFloat8_e4m3b11fnuz:
+            return details::kSmallFloatTable<kDLFloat8_e4m3b11fnuz>;
+        case kDLFloat8_e4m3fn:
+            return details::kSmallFloatTable<kDLFloat8_e4m3fn>;
+        case kDLFloat8_e4m3fnuz:
+            return details::kSmallFloatTable<kDLFloat8_e4m3fnuz>;
+        case kDLFloat8_e5m2:
+            return details::kSmallFloatTable<kDLFloat8_e5m2>;
+        case kDLFloat8_e5m2fnuz:
+            return details::kSmallFloatTable<kDLFloat8_e5m2fnuz>;
+        case kDLFloat8_e8m0fnu:
+            return details::kSmallFloatTable<kDLFloat8_e8m0fnu>;
+        default:
+            return details::kSmallFloatTable<kDLFloat4_e2m1fn>;
+    }
+}
+
+void DequantizeBlocks(float* dst, const uint8_t* src, bool packed, const std::array<float, 256>& values,
+                      const Scales& scales, int64_t numel, int64_t block_begin, int64_t block_end) {
+    float block_values[kBlock];
+    for (int64_t block = block_begin; block < block_end; ++block) {
+        int64_t begin = block * kBlock;
+        int64_t end = std::min(numel, begin + kBlock);
+        if (packed) {
+            for (int64_t k = 0; k < end - begin; k += 2) {
+                uint8_t byte = src[(begin + k) / 2];
+                block_values[k] = values[byte & 0xfu];
+                // the high nibble of the last byte of an odd number of elements is padding
+                block_values[k + 1] = values[byte >> 4];
+            }
+        } else {
+            for (int64_t i = begin; i < end; ++i) {
+                block_values[i - begin] = values[src[i]];
+            }
+        }
+        for (int64_t i = begin; i < end;) {
+            int64_t run = std::min(end - i, scales.inner - i % scales.inner);
+            float scale = scales.data[i / scales.inner % scales.channels];
+            for (int64_t k = 0; k < run; ++k) {
+                dst[i + k] = block_values[i - begin + k] * scale;
+            }
+            i += run;
+        }
+    }
+}
+
+// runs fn over the blocks of numel elements, in parallel for large tensors
+template<typename F>
+void ForEachBlocks(int64_t numel, F fn) {
+    int64_t num_blocks = (numel + kBlock - 1) / kBlock;
+    if (numel < kParallelMinElems) {
+        fn(0, num_blocks);
+        return;
+    }
+    ThreadPool::Global()->ParallelFor(0, num_blocks, kMinChunkBlocks, fn);
+}
+
+const char* DataOf(const Tensor& tensor) {
+    return static_cast<const char*>(tensor->data) + tensor->byte_offset;
+}
+
+// quantize a tensor of any dtype of AsType, with checked scales
+Tensor QuantizeTensor(const Tensor& tensor, DLDataType dtype, const Scales& scales) {
+    Tensor src = tensor.AsType(kFloat32);
+    Tensor result = Tensor::FromNDAlloc(details::AlignedCPUAlloc(), tensor.shape(), dtype, kCPUDevice);
+    QuantizeKernel kernel = GetQuantizeKernel(dtype);
+    auto* dst = static_cast<uint8_t*>(result->data);
+    const auto* src_data = reinterpret_cast<const float*>(DataOf(src));
+    bool packed = IsPacked(dtype);
+    int64_t numel = tensor.numel();
+    ForEachBlocks(numel, [&](int64_t block_begin, int64_t block_end) {
+        kernel(dst, src_data, packed, scales, numel, block_begin, block_end);
+    });
+    return result;
+}
+
+// dequantize a contiguous tensor of a dtype of Quantize to float32
+Tensor DequantizeTensor(const Tensor& tensor, const Scales& scales) {
+    Tensor src = tensor.Contiguous();
+    Tensor result = Tensor::FromNDAlloc(details::AlignedCPUAlloc(), tensor.shape(), kFloat32, kCPUDevice);
+    std::array<float, 256> values = CodeValues(tensor.dtype());
+    auto* dst = static_cast<float*>(result->data);
+    const auto* src_data = reinterpret_cast<const uint8_t*>(DataOf(src));
+    bool packed = IsPacked(tensor.dtype());
+    int64_t numel = tensor.numel();
+    ForEachBlocks(numel, [&](int64_t block_begin, int64_t block_end) {
+        DequantizeBlocks(dst, src_data, packed, values, scales, numel, block_begin, block_end);
+    });
+    return result;
+}
+
+void CheckCPU(const char* op, const Tensor& tensor) {
+    if (!details::IsCPUAccessible(tensor->device)) {
+        TVM_FFI_THROW(ValueError) << op << ": only CPU tensors are supported, got device type "
+                                  << tensor->device.device_type;
+    }
+}
+
+}// namespace
+
+Tensor Tensor::AsType(DLDataType dtype) const {
+    const TensorObj* self = get();
+    if (self->dtype == dtype) {
+        return Contiguous();
+    }
+    CheckCPU("AsType", *this);
+    if (IsPacked(dtype)) {
+        return QuantizeTensor(*this, dtype, UnitScales(*this));
+    }
+    if (IsPacked(self->dtype)) {
+        Tensor result = DequantizeTensor(*this, UnitScales(*this));
+        return dtype == kFloat32 ? result : result.AsType(dtype);
+    }
+    Tensor result = FromNDAlloc(details::AlignedCPUAlloc(), shape(), dtype, kCPUDevice);
+    CopyTo(result);
+    return result;
+}
+
+Tensor Tensor::Quantize(DLDataType dtype, const Tensor& scale, int64_t axis) const {
+    CheckCPU("Quantize", *this);
+    if (!IsQuantized(dtype)) {
+        TVM_FFI_THROW(ValueError) << "Quantize: cannot quantize to " << dtype;
+    }
+    return QuantizeTensor(*this, dtype, GetScales("Quantize", *this, scale, axis));
+}
+
+Tensor Tensor::Dequantize(DLDataType dtype, const Tensor& scale, int64_t axis) const {
+    CheckCPU("Dequantize", *this);
+    if (!IsQuantized(get()->dtype)) {
+        TVM_FFI_THROW(ValueError) << "Dequantize: cannot dequantize " << get()->dtype;
+    }
+    Tensor result = DequantizeTensor(*this, GetScales("Dequantize", *this, scale, axis));
+    return dtype == kFloat32 ? result : result.AsType(dtype);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+    namespace refl = litetvm::ffi::reflection;
+    refl::GlobalDef()
+            .def("ffi.TensorAsType", [](Tensor tensor, DLDataType dtype) { return tensor.AsType(dtype); })
+            .def("ffi.TensorQuantize",
+                 [](Tensor tensor, DLDataType dtype, Tensor scale, int64_t axis) {
+                     return tensor.Quantize(dtype, scale, axis);
+                 })
+            .def("ffi.TensorDequantize", [](Tensor tensor, DLDataType dtype, Tensor scale, int64_t axis) {
+                return tensor.Dequantize(dtype, scale, axis);
+            });
+}
+
+}// namespace ffi
+}// namespace litetvm
@@ -0,0 +1,312 @@
+//
+// Created by richard on 10/19/26.
+//
+// Scalar codecs of the floating point dtypes narrower than float32, shared by the tensor
+// copy kernels and the quantization kernels.
+//
+// Narrowing conversions round to nearest even. Float8 formats follow the conventions of
+// their names: e5m2, e4m3 and e3m4 are IEEE-like with infinities, overflow rounds to
+// infinity. The fn formats have no infinity and a single NaN magnitude, the fnuz formats
+// have no negative zero and NaN is 0x80, overflow and infinity convert to NaN in both.
+// e8m0fnu is an unsigned power of two, float4_e2m1fn has no NaN and saturates.
+#ifndef LITETVM_FFI_DTYPE_CONVERT_H
+#define LITETVM_FFI_DTYPE_CONVERT_H
+
+#include "ffi/c_api.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace litetvm {
+namespace ffi {
+namespace details {
+
+inline float HalfToFloat(uint16_t h) {
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+    uint32_t exp = (h >> 10) & 0x1fu;
+    uint32_t mant = h & 0x3ffu;
+    if (exp == 0) {
+        // zero and subnormals, mant * 2^-24
+        float value = static_cast<float>(mant) * 0x1p-24f;
+        return sign != 0 ? -value : value;
+    }
+    uint32_t bits = exp == 0x1fu ? sign | 0x7f800000u | (mant << 13) : sign | ((exp + 112) << 23) | (mant << 13);
+    return std::bit_cast<float>(bits);
+}
+
+inline uint16_t FloatToHalf(float value) {
+    uint32_t x = std::bit_cast<uint32_t>(value);
+    uint16_t sign = static_cast<uint16_t>((x >> 16) & 0x8000u);
+    uint32_t ax = x & 0x7fffffffu;
+    if (ax > 0x7f800000u) {
+        return sign | 0x7e00u;
+    }
+    // 65520 and above round to infinity
+    if (ax >= 0x477ff000u) {
+        return sign | 0x7c00u;
+    }
+    if (ax >= 0x38800000u) {
+        // rebias the exponent and round the dropped 13 bits to nearest even
+        ax += 0xc8000fffu + ((ax >> 13) & 1u);
+        return sign | static_cast<uint16_t>(ax >> 13);
+    }
+    // subnormals, adding 0.5 leaves the rounded value in the low mantissa bits
+    float shifted = std::bit_cast<float>(ax) + 0.5f;
+    return sign | static_cast<uint16_t>(std::bit_cast<uint32_t>(shifted) - 0x3f000000u);
+}
+
+inline float BFloat16ToFloat(uint16_t h) {
+    return std::bit_cast<float>(static_cast<uint32_t>(h) << 16);
+}
+
+inline uint16_t FloatToBFloat16(float value) {
+    uint32_t x = std::bit_cast<uint32_t>(value);
+    if ((x & 0x7fffffffu) > 0x7f800000u) {
+        return static_cast<uint16_t>((x >> 16) | 0x40u);
+    }
+    x += 0x7fffu + ((x >> 16) & 1u);
+    return static_cast<uint16_t>(x >> 16);
+}
+
+/*!
+ * \brief Round a double to float, rounding to odd.
+ *
+ * The result rounds to any format of at most 22 mantissa bits like the double itself, where
+ * a plain cast would round twice.
+ */
+inline float RoundToOddFloat(double value) {
+    float result = static_cast<float>(value);
+    if (static_cast<double>(result) != value && result == result) {
+        uint32_t bits = std::bit_cast<uint32_t>(result);
+        // truncate towards zero, then mark the value as inexact
+        if (static_cast<double>(result) > value ? value > 0 : value < 0) {
+            bits -= 1;
+        }
+        result = std::bit_cast<float>(bits | 1u);
+    }
+    return result;
+}
+
+/*! \brief How a float format encodes NaN and infinity. */
+enum class FloatKind {
+    /*! \brief Infinity and NaN at the largest exponent. */
+    kIEEE,
+    /*! \brief NaN is all ones but the sign, no infinity. */
+    kFiniteNaN,
+    /*! \brief NaN is the negative zero, no infinity. */
+    kFiniteUnsignedZero,
+    /*! \brief No NaN or infinity, overflow saturates. */
+    kSaturate,
+};
+
+/*! \brief Layout of a float format of at most 8 bits with a sign bit. */
+struct SmallFloatFormat {
+    int exp_bits;
+    int mant_bits;
+    int bias;
+    FloatKind kind;
+
+    NODISCARD constexpr int bits() const {
+        return 1 + exp_bits + mant_bits;
+    }
+};
+
+/*! \return The layout of a small float dtype code, e8m0fnu excluded. */
+constexpr SmallFloatFormat SmallFloatFormatOf(uint8_t code) {
+    switch (code) {
+        case kDLFloat8_e3m4:
+            return {3, 4, 3, FloatKind::kIEEE};
+        case kDLFloat8_e4m3:
+            return {4, 3, 7, FloatKind::kIEEE};
+        case kDLFloat8_e4m3b11fnuz:
+            return {4, 3, 11, FloatKind::kFiniteUnsignedZero};
+        case kDLFloat8_e4m3fn:
+            return {4, 3, 7, FloatKind::kFiniteNaN};
+        case kDLFloat8_e4m3fnuz:
+            return {4, 3, 8, FloatKind::kFiniteUnsignedZero};
+        case kDLFloat8_e5m2:
+            return {5, 2, 15, FloatKind::kIEEE};
+        case kDLFloat8_e5m2fnuz:
+            return {5, 2, 16, FloatKind::kFiniteUnsignedZero};
+        case kDLFloat4_e2m1fn:
+        default:
+            return {2, 1, 1, FloatKind::kSaturate};
+    }
+}
+
+/*! \return The float32 bits of a small float, all values are normal float32. */
+constexpr uint32_t SmallFloatToFloatBits(SmallFloatFormat format, uint32_t code) {
+    uint32_t sign_bit = 1u << (format.bits() - 1);
+    uint32_t sign = (code & sign_bit) != 0 ? 0x80000000u : 0u;
+    uint32_t exp_mask = (1u << format.exp_bits) - 1;
+    uint32_t mant_mask = (1u << format.mant_bits) - 1;
+    uint32_t exp = (code >> format.mant_bits) & exp_mask;
+    uint32_t mant = code & mant_mask;
+    switch (format.kind) {
+        case FloatKind::kIEEE:
+            if (exp == exp_mask) {
+                return sign | (mant == 0 ? 0x7f800000u : 0x7fc00000u | (mant << (23 - format.mant_bits)));
+            }
+            break;
+        case FloatKind::kFiniteNaN:
+            if (exp == exp_mask && mant == mant_mask) {
+                return sign | 0x7fc00000u;
+            }
+            break;
+        case FloatKind::kFiniteUnsignedZero:
+            if (code == sign_bit) {
+                return 0x7fc00000u;
+            }
+            break;
+        case FloatKind::kSaturate:
+            break;
+    }
+    int unbiased = static_cast<int>(exp) - format.bias;
+    if (exp == 0) {
+        if (mant == 0) {
+            return sign;
+        }
+        // normalize the subnormal
+        unbiased = 1 - format.bias;
+        while ((mant & (1u << format.mant_bits)) == 0) {
+            mant <<= 1;
+            --unbiased;
+        }
+        mant &= mant_mask;
+    }
+    return sign | static_cast<uint32_t>(unbiased + 127) << 23 | mant << (23 - format.mant_bits);
+}
+
+/*! \return The float32 bits of a float8_e8m0fnu, 2^(code - 127). */
+constexpr uint32_t Float8E8M0ToFloatBits(uint32_t code) {
+    if (code == 0xffu) {
+        return 0x7fc00000u;
+    }
+    // 2^-127 is a float32 subnormal
+    return code == 0 ? 0x00400000u : code << 23;
+}
+
+template<uint8_t kCode>
+constexpr std::array<float, 256> MakeSmallFloatTable() {
+    std::array<float, 256> table{};
+    for (uint32_t code = 0; code < 256; ++code) {
+        uint32_t bits = kCode == kDLFloat8_e8m0fnu ? Float8E8M0ToFloatBits(code)
+                                                   : SmallFloatToFloatBits(SmallFloatFormatOf(kCode), code);
+        table[code] = std::bit_cast<float>(bits);
+    }
+    return table;
+}
+
+/*! \brief Values of the codes of a small float dtype, indexed by code. */
+template<uint8_t kCode>
+inline constexpr std::array<float, 256> kSmallFloatTable = MakeSmallFloatTable<kCode>();
+
+/*!
+ * \brief Round a float to a small float format.
+ * \param format The format.
+ * \param value The value.
+ * \return The code.
+ */
+inline uint8_t FloatToSmallFloat(SmallFloatFormat format, float value) {
+    uint32_t x = std::bit_cast<uint32_t>(value);
+    uint32_t sign_bit = 1u << (format.bits() - 1);
+    uint32_t sign = (x & 0x80000000u) != 0 ? sign_bit : 0u;
+    uint32_t ax = x & 0x7fffffffu;
+    uint32_t exp_mask = (1u << format.exp_bits) - 1;
+    // the code past the largest finite value, and what overflow and NaN convert to
+    uint32_t overflow_code, overflow, nan;
+    switch (format.kind) {
+        case FloatKind::kIEEE:
+            overflow_code = exp_mask << format.mant_bits;
+            overflow = sign | overflow_code;
+            nan = sign | overflow_code | (1u << (format.mant_bits - 1));
+            break;
+        case FloatKind::kFiniteNaN:
+            overflow_code = sign_bit - 1;
+            overflow = nan = sign | overflow_code;
+            break;
+        case FloatKind::kFiniteUnsignedZero:
+            overflow_code = sign_bit;
+            overflow = nan = sign_bit;
+            break;
+        default:
+            overflow_code = sign_bit;
+            overflow = nan = sign | (sign_bit - 1);
+            break;
+    }
+    if (ax > 0x7f800000u) {
+        return static_cast<uint8_t>(nan);
+    }
+    uint32_t code;
+    int min_exp = 1 - format.bias;
+    if (ax >= static_cast<uint32_t>(min_exp + 127) << 23) {
+        // rebias the exponent and round the dropped bits to nearest even
+        int shift = 23 - format.mant_bits;
+        uint32_t rebiased = ax - (static_cast<uint32_t>(127 - format.bias) << 23);
+        // infinity lands past overflow_code as well
+        code = (rebiased + (1u << (shift - 1)) - 1 + ((rebiased >> shift) & 1u)) >> shift;
+    } else {
+        // subnormals, scaled to units of the smallest subnormal, adding 2^23 rounds to an integer
+        float units = std::bit_cast<float>(ax) *
+                      std::bit_cast<float>(static_cast<uint32_t>(format.mant_bits - min_exp + 127) << 23);
+        code = std::bit_cast<uint32_t>(units + 0x1p23f) - 0x4b000000u;
+    }
+    if (code >= overflow_code) {
+        return static_cast<uint8_t>(overflow);
+    }
+    if (code == 0 && format.kind == FloatKind::kFiniteUnsignedZero) {
+        return 0;
+    }
+    return static_cast<uint8_t>(sign | code);
+}
+
+/*!
+ * \brief Round a float to float8_e8m0fnu.
+ * \note NaN, infinity, negative values and overflow convert to NaN, zero and values below
+ *  2^-127 to 2^-127.
+ */
+inline uint8_t FloatToFloat8E8M0(float value) {
+    uint32_t x = std::bit_cast<uint32_t>(value);
+    if (x == 0x80000000u) {
+        return 0;
+    }
+    if (x >= 0x7f800000u) {
+        return 0xff;
+    }
+    if (x < 0x00800000u) {
+        // float32 subnormals, 2^-127 is 0x00400000 and the midpoint to 2^-126 is 0x00600000
+        return x > 0x00600000u ? 1 : 0;
+    }
+    uint32_t code = (x + 0x3fffffu + ((x >> 23) & 1u)) >> 23;
+    return static_cast<uint8_t>(code);
+}
+
+/*! \brief Round a float to the small float dtype code kCode. */
+template<uint8_t kCode>
+TVM_FFI_INLINE uint8_t FloatToSmallFloat(float value) {
+    if constexpr (kCode == kDLFloat8_e8m0fnu) {
+        return FloatToFloat8E8M0(value);
+    } else {
+        constexpr SmallFloatFormat kFormat = SmallFloatFormatOf(kCode);
+        return FloatToSmallFloat(kFormat, value);
+    }
+}
+
+/*!
+ * \brief Convert contiguous rows between float32 and the 16 bit floats.
+ *
+ * The rows take AVX2 and F16C when the CPU has them, with the results of the scalar codecs
+ * above, NaNs included. Neither row needs to be aligned.
+ */
+void FloatToHalfRow(void* dst, const void* src, int64_t n);
+void HalfToFloatRow(void* dst, const void* src, int64_t n);
+void FloatToBFloat16Row(void* dst, const void* src, int64_t n);
+void BFloat16ToFloatRow(void* dst, const void* src, int64_t n);
+
+}// namespace details
+}// namespace ffi
+}// namespace litetvm
+
+#endif//LITETVM_FFI_DTYPE_CONVERT_H
@@ -5,6 +5,8 @@
 #include "ffi/c_api.h"
 
 #include <cstring>
+#include <new>
+#include <string_view>
 
 namespace litetvm {
 namespace ffi {
@@ -44,6 +46,8 @@ public:
         result[0] = details::ObjectUnsafe::MoveObjectPtrToTVMFFIObjectPtr(std::move(last_error_));
     }
 
+    void SetRaisedOutOfMemory();
+
     static SafeCallContext* ThreadLocal() {
         static thread_local SafeCallContext ctx;
         return &ctx;
@@ -53,19 +57,57 @@ private:
     ObjectPtr<ErrorObj> last_error_;
 };
 
+/*!
+ * \brief The error reported when memory runs out.
+ *
+ * The error is created when the library loads and lives forever, so reporting it never allocates.
+ * It is shared by all threads, updates to its backtrace are ignored.
+ */
+ErrorObj* OutOfMemoryError() {
+    static ErrorObj* inst = [] {
+        Error error("MemoryError", "Out of memory", "");
+        ErrorObj* obj = details::ObjectUnsafe::RawObjectPtrFromUnowned<ErrorObj>(
+                details::ObjectUnsafe::MoveObjectRefToTVMFFIObjectPtr(std::move(error)));
+        obj->update_backtrace = [](TVMFFIObjectHandle, const TVMFFIByteArray*, int32_t) {};
+        return obj;
+    }();
+    return inst;
+}
+
+void SafeCallContext::SetRaisedOutOfMemory() {
+    last_error_ = details::ObjectUnsafe::ObjectPtrFromUnowned<ErrorObj>(static_cast<Object*>(OutOfMemoryError()));
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+    // allocate the error while memory is still available
+    OutOfMemoryError();
+}
+
 }// namespace ffi
 }// namespace litetvm
 
 void TVMFFIErrorSetRaisedFromCStr(const char* kind, const char* message) {
-    // NOTE: run traceback here to simplify the depth of tracekback
-    litetvm::ffi::SafeCallContext::ThreadLocal()->SetRaisedByCstr(kind, message, TVM_FFI_TRACEBACK_HERE);
+    try {
+        // NOTE: run traceback here to simplify the depth of tracekback
+        litetvm::ffi::SafeCallContext::ThreadLocal()->SetRaisedByCstr(kind, message, TVM_FFI_TRACEBACK_HERE);
+    } catch (const std::bad_alloc&) {
+        litetvm::ffi::SafeCallContext::ThreadLocal()->SetRaisedOutOfMemory();
+    }
 }
 
 void TVMFFIErrorSetRaisedFromCStrParts(const char* kind, const char** message_parts,
                                        int32_t num_parts) {
-    // NOTE: run backtrace here to simplify the depth of tracekback
-    litetvm::ffi::SafeCallContext::ThreadLocal()->SetRaisedByCstrParts(
-        kind, message_parts, num_parts, TVMFFITraceback(nullptr, 0, nullptr));
+    try {
+        // NOTE: run backtrace here to simplify the depth of tracekback
+        litetvm::ffi::SafeCallContext::ThreadLocal()->SetRaisedByCstrParts(
+            kind, message_parts, num_parts, TVMFFITraceback(nullptr, 0, nullptr));
+    } catch (const std::bad_alloc&) {
+        litetvm::ffi::SafeCallContext::ThreadLocal()->SetRaisedOutOfMemory();
+    }
+}
+
+void TVMFFIErrorSetRaisedOutOfMemory() {
+    litetvm::ffi::SafeCallContext::ThreadLocal()->SetRaisedOutOfMemory();
 }
 
 void TVMFFIErrorSetRaised(TVMFFIObjectHandle error) {
@@ -81,12 +123,16 @@ int TVMFFIErrorCreate(const TVMFFIByteArray* kind, const TVMFFIByteArray* messag
     // log other errors to the logger
     TVM_FFI_LOG_EXCEPTION_CALL_BEGIN();
     try {
-        litetvm::ffi::Error error(std::string(kind->data, kind->size),
-                                  std::string(message->data, message->size),
-                                  std::string(backtrace->data, backtrace->size));
-        *out = litetvm::ffi::details::ObjectUnsafe::MoveObjectRefToTVMFFIObjectPtr(std::move(error));
+        auto error = litetvm::ffi::details::ErrorObjFromStd::Create(
+                std::string_view(kind->data, kind->size), std::string_view(message->data, message->size),
+                std::string_view(backtrace->data, backtrace->size));
+        *out = litetvm::ffi::details::ObjectUnsafe::MoveObjectPtrToTVMFFIObjectPtr(std::move(error));
         return 0;
-    } catch (const std::bad_alloc& e) {
+    } catch (const std::bad_alloc&) {
+        // hand out the preallocated error so the caller still has something to raise
+        litetvm::ffi::ErrorObj* oom = litetvm::ffi::OutOfMemoryError();
+        litetvm::ffi::details::ObjectUnsafe::IncRefObjectHandle(oom);
+        *out = oom;
         return -1;
     }
     TVM_FFI_LOG_EXCEPTION_CALL_END(TVMFFIErrorCreate);
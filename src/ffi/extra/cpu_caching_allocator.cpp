@@ -0,0 +1,413 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/extra/cpu_caching_allocator.h"
+#include "ffi/container/map.h"
+#include "ffi/container/shape_ops.h"
+#include "ffi/function.h"
+#include "ffi/memory.h"
+#include "ffi/reflection/registry.h"
+
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace litetvm {
+namespace ffi {
+namespace {
+
+// size classes: 64 bytes, then four classes per power of two, (4, 5, 6, 7, 8) * 2^(k - 2)
+constexpr size_t kMinClassSize = 64;
+constexpr int kMinClassLog2 = 6;
+constexpr size_t kClassesPerDoubling = 4;
+
+constexpr size_t SizeClassIndex(size_t nbytes) {
+    if (nbytes <= kMinClassSize) {
+        return 0;
+    }
+    int lg = 63 - std::countl_zero(static_cast<uint64_t>(nbytes - 1));
+    size_t sub = (nbytes - 1) >> (lg - 2);
+    return static_cast<size_t>(lg - kMinClassLog2) * kClassesPerDoubling + (sub - kClassesPerDoubling) + 1;
+}
+
+constexpr size_t SizeClassBytes(size_t index) {
+    if (index == 0) {
+        return kMinClassSize;
+    }
+    int lg = static_cast<int>((index - 1) / kClassesPerDoubling) + kMinClassLog2;
+    size_t sub = (index - 1) % kClassesPerDoubling + kClassesPerDoubling;
+    return (sub + 1) << (lg - 2);
+}
+
+static_assert(SizeClassBytes(SizeClassIndex(65)) == 80);
+static_assert(SizeClassBytes(SizeClassIndex(129)) == 160);
+static_assert(SizeClassBytes(SizeClassIndex(CPUCachingAllocator::kMaxCachedSize)) ==
+              CPUCachingAllocator::kMaxCachedSize);
+
+// alignment classes: 64, 128 and 4096 bytes
+constexpr size_t kNumAlignClasses = 3;
+constexpr size_t kNumSizeClasses = SizeClassIndex(CPUCachingAllocator::kMaxCachedSize) + 1;
+constexpr size_t kNumThreadSizeClasses = SizeClassIndex(CPUCachingAllocator::kMaxThreadCachedSize) + 1;
+// bounds of each thread cache
+constexpr uint32_t kThreadBlocksPerBucket = 8;
+constexpr size_t kThreadCacheLimit = static_cast<size_t>(4) << 20;
+// threads publish their statistics after this many bytes or allocations
+constexpr int64_t kStatsFlushBytes = static_cast<int64_t>(1) << 20;
+constexpr uint64_t kStatsFlushAllocs = 1024;
+
+size_t AlignClass(size_t alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > CPUCachingAllocator::kPageAlignment) {
+        TVM_FFI_THROW(ValueError) << "CPUCachingAllocator: alignment must be a power of 2 no larger than "
+                                  << CPUCachingAllocator::kPageAlignment << ", got " << alignment;
+    }
+    return alignment <= 64 ? 0 : (alignment <= 128 ? 1 : 2);
+}
+
+void* SystemAlloc(size_t nbytes, size_t align_class) {
+    switch (align_class) {
+        case 0: return details::AlignedAlloc<64>(nbytes);
+        case 1: return details::AlignedAlloc<128>(nbytes);
+        default: return details::AlignedAlloc<CPUCachingAllocator::kPageAlignment>(nbytes);
+    }
+}
+
+/*! \brief Statistics and the cache shared by all threads. */
+struct SharedState {
+    std::mutex mutex;
+    std::vector<void*> buckets[kNumSizeClasses * kNumAlignClasses];
+    std::atomic<size_t> cache_limit{CPUCachingAllocator::kDefaultCacheLimit};
+    std::atomic<size_t> bytes_in_use{0};
+    std::atomic<size_t> bytes_cached{0};
+    std::atomic<size_t> peak_bytes_in_use{0};
+    std::atomic<uint64_t> num_allocs{0};
+    std::atomic<uint64_t> num_cache_hits{0};
+
+    static SharedState* Global() {
+        // never destroyed, threads flush their caches into it at exit
+        static SharedState* inst = new SharedState();
+        return inst;
+    }
+
+    void AddInUse(size_t nbytes) {
+        size_t now = bytes_in_use.fetch_add(nbytes, std::memory_order_relaxed) + nbytes;
+        size_t peak = peak_bytes_in_use.load(std::memory_order_relaxed);
+        while (now > peak && !peak_bytes_in_use.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+        }
+    }
+
+    void* Pop(size_t bucket) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (buckets[bucket].empty()) {
+            return nullptr;
+        }
+        void* block = buckets[bucket].back();
+        buckets[bucket].pop_back();
+        return block;
+    }
+
+    // keep a free block if the cache limit allows, block_bytes is not counted as cached yet
+    void Push(size_t bucket, void* block, size_t block_bytes) {
+        size_t cached = bytes_cached.fetch_add(block_bytes, std::memory_order_relaxed) + block_bytes;
+        if (cached > cache_limit.load(std::memory_order_relaxed)) {
+            bytes_cached.fetch_sub(block_bytes, std::memory_order_relaxed);
+            details::AlignedFree(block);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        buckets[bucket].push_back(block);
+    }
+
+    // release cached blocks, largest first, until at most limit bytes are cached
+    void TrimTo(size_t limit) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t bucket = kNumSizeClasses * kNumAlignClasses; bucket != 0; --bucket) {
+            std::vector<void*>& blocks = buckets[bucket - 1];
+            size_t block_bytes = SizeClassBytes((bucket - 1) / kNumAlignClasses);
+            while (!blocks.empty() && bytes_cached.load(std::memory_order_relaxed) > limit) {
+                details::AlignedFree(blocks.back());
+                blocks.pop_back();
+                bytes_cached.fetch_sub(block_bytes, std::memory_order_relaxed);
+            }
+            if (blocks.empty()) {
+                blocks.shrink_to_fit();
+            }
+        }
+    }
+};
+
+/*!
+ * \brief Free blocks and unpublished statistics of one thread, trivially destructible so frees
+ *  during thread exit can check it.
+ */
+struct ThreadCache {
+    struct Bucket {
+        void* blocks[kThreadBlocksPerBucket];
+        uint32_t size;
+    };
+    Bucket buckets[kNumThreadSizeClasses * kNumAlignClasses];
+    size_t bytes;
+    bool closed;
+    // statistics not yet added to the shared state, so the fast path has no atomic operations
+    int64_t in_use_delta;
+    int64_t cached_delta;
+    uint64_t num_allocs;
+    uint64_t num_cache_hits;
+
+    void FlushStats() {
+        SharedState* shared = SharedState::Global();
+        // negative deltas wrap around, which the unsigned addition undoes
+        shared->bytes_cached.fetch_add(static_cast<size_t>(cached_delta), std::memory_order_relaxed);
+        if (in_use_delta > 0) {
+            shared->AddInUse(static_cast<size_t>(in_use_delta));
+        } else {
+            shared->bytes_in_use.fetch_sub(static_cast<size_t>(-in_use_delta), std::memory_order_relaxed);
+        }
+        shared->num_allocs.fetch_add(num_allocs, std::memory_order_relaxed);
+        shared->num_cache_hits.fetch_add(num_cache_hits, std::memory_order_relaxed);
+        in_use_delta = 0;
+        cached_delta = 0;
+        num_allocs = 0;
+        num_cache_hits = 0;
+    }
+
+    void MaybeFlushStats() {
+        if (closed || in_use_delta >= kStatsFlushBytes || -in_use_delta >= kStatsFlushBytes ||
+            cached_delta >= kStatsFlushBytes || -cached_delta >= kStatsFlushBytes || num_allocs >= kStatsFlushAllocs) {
+            FlushStats();
+        }
+    }
+
+    // move the blocks to the shared cache, or release them if to_system is set
+    void Flush(bool to_system) {
+        SharedState* shared = SharedState::Global();
+        for (size_t bucket = 0; bucket < kNumThreadSizeClasses * kNumAlignClasses; ++bucket) {
+            size_t block_bytes = SizeClassBytes(bucket / kNumAlignClasses);
+            for (uint32_t i = 0; i < buckets[bucket].size; ++i) {
+                shared->bytes_cached.fetch_sub(block_bytes, std::memory_order_relaxed);
+                if (to_system) {
+                    details::AlignedFree(buckets[bucket].blocks[i]);
+                } else {
+                    shared->Push(bucket, buckets[bucket].blocks[i], block_bytes);
+                }
+            }
+            buckets[bucket].size = 0;
+        }
+        bytes = 0;
+    }
+};
+
+// hands the blocks of a thread to the shared cache on thread exit
+struct ThreadCacheCloser {
+    ThreadCache* cache;
+    ~ThreadCacheCloser() {
+        cache->FlushStats();
+        cache->Flush(/*to_system=*/false);
+        cache->closed = true;
+    }
+};
+
+ThreadCache* GetThreadCache() {
+    static thread_local ThreadCache cache;
+    static thread_local ThreadCacheCloser closer{&cache};
+    return &cache;
+}
+
+/*! \brief DLPack tensor with the shape stored after it. */
+struct CPUManagedTensor {
+    DLManagedTensorVersioned tensor;
+    size_t nbytes;
+    size_t alignment;
+
+    static void Deleter(DLManagedTensorVersioned* self) {
+        CPUManagedTensor* ctx = static_cast<CPUManagedTensor*>(self->manager_ctx);
+        CPUCachingAllocator::Global()->Free(self->dl_tensor.data, ctx->nbytes, ctx->alignment);
+        details::AlignedFree(ctx);
+    }
+};
+
+}// namespace
+
+CPUCachingAllocator* CPUCachingAllocator::Global() {
+    static CPUCachingAllocator* inst = new CPUCachingAllocator();
+    return inst;
+}
+
+void* CPUCachingAllocator::Alloc(size_t nbytes, size_t alignment) {
+    SharedState* shared = SharedState::Global();
+    size_t align_class = AlignClass(alignment);
+    if (nbytes > kMaxCachedSize) {
+        shared->num_allocs.fetch_add(1, std::memory_order_relaxed);
+        void* ptr;
+        try {
+            ptr = SystemAlloc(nbytes, align_class);
+        } catch (const std::bad_alloc&) {
+            Trim();
+            ptr = SystemAlloc(nbytes, align_class);
+        }
+        shared->AddInUse(nbytes);
+        return ptr;
+    }
+    size_t size_class = SizeClassIndex(nbytes);
+    size_t block_bytes = SizeClassBytes(size_class);
+    size_t bucket = size_class * kNumAlignClasses + align_class;
+    if (size_class < kNumThreadSizeClasses) {
+        ThreadCache* cache = GetThreadCache();
+        ThreadCache::Bucket& entry = cache->buckets[bucket];
+        if (entry.size != 0) {
+            void* block = entry.blocks[--entry.size];
+            cache->bytes -= block_bytes;
+            cache->cached_delta -= static_cast<int64_t>(block_bytes);
+            cache->in_use_delta += static_cast<int64_t>(block_bytes);
+            ++cache->num_allocs;
+            ++cache->num_cache_hits;
+            cache->MaybeFlushStats();
+            return block;
+        }
+    }
+    shared->num_allocs.fetch_add(1, std::memory_order_relaxed);
+    void* block = shared->Pop(bucket);
+    if (block != nullptr) {
+        shared->num_cache_hits.fetch_add(1, std::memory_order_relaxed);
+        shared->bytes_cached.fetch_sub(block_bytes, std::memory_order_relaxed);
+    } else {
+        try {
+            block = SystemAlloc(block_bytes, align_class);
+        } catch (const std::bad_alloc&) {
+            // memory pressure, return the cached blocks to the system and retry once
+            Trim();
+            block = SystemAlloc(block_bytes, align_class);
+        }
+    }
+    shared->AddInUse(block_bytes);
+    return block;
+}
+
+void CPUCachingAllocator::Free(void* ptr, size_t nbytes, size_t alignment) {
+    if (ptr == nullptr) {
+        return;
+    }
+    SharedState* shared = SharedState::Global();
+    size_t align_class = AlignClass(alignment);
+    if (nbytes > kMaxCachedSize) {
+        shared->bytes_in_use.fetch_sub(nbytes, std::memory_order_relaxed);
+        details::AlignedFree(ptr);
+        return;
+    }
+    size_t size_class = SizeClassIndex(nbytes);
+    size_t block_bytes = SizeClassBytes(size_class);
+    size_t bucket = size_class * kNumAlignClasses + align_class;
+    if (size_class < kNumThreadSizeClasses) {
+        ThreadCache* cache = GetThreadCache();
+        ThreadCache::Bucket& entry = cache->buckets[bucket];
+        if (!cache->closed && entry.size < kThreadBlocksPerBucket &&
+            cache->bytes + block_bytes <= kThreadCacheLimit) {
+            entry.blocks[entry.size++] = ptr;
+            cache->bytes += block_bytes;
+            cache->cached_delta += static_cast<int64_t>(block_bytes);
+            cache->in_use_delta -= static_cast<int64_t>(block_bytes);
+            cache->MaybeFlushStats();
+            return;
+        }
+    }
+    shared->bytes_in_use.fetch_sub(block_bytes, std::memory_order_relaxed);
+    shared->Push(bucket, ptr, block_bytes);
+}
+
+void CPUCachingAllocator::Trim() {
+    ThreadCache* cache = GetThreadCache();
+    if (!cache->closed) {
+        cache->FlushStats();
+        cache->Flush(/*to_system=*/true);
+    }
+    SharedState::Global()->TrimTo(0);
+}
+
+void CPUCachingAllocator::SetCacheLimit(size_t bytes) {
+    SharedState* shared = SharedState::Global();
+    shared->cache_limit.store(bytes, std::memory_order_relaxed);
+    shared->TrimTo(bytes);
+}
+
+CPUCachingAllocator::Stats CPUCachingAllocator::GetStats() const {
+    // other threads publish their statistics in batches, the calling thread's are exact
+    GetThreadCache()->FlushStats();
+    SharedState* shared = SharedState::Global();
+    Stats stats;
+    stats.bytes_in_use = shared->bytes_in_use.load(std::memory_order_relaxed);
+    stats.bytes_cached = shared->bytes_cached.load(std::memory_order_relaxed);
+    stats.peak_bytes_in_use = shared->peak_bytes_in_use.load(std::memory_order_relaxed);
+    stats.num_allocs = shared->num_allocs.load(std::memory_order_relaxed);
+    stats.num_cache_hits = shared->num_cache_hits.load(std::memory_order_relaxed);
+    return stats;
+}
+
+int CPUCachingAllocator::DLPackAlloc(DLTensor* prototype, DLManagedTensorVersioned** out, void* error_ctx,
+                                     void (*SetError)(void* error_ctx, const char* kind, const char* message)) {
+    try {
+        if (prototype->device.device_type != kDLCPU) {
+            TVM_FFI_THROW(ValueError) << "CPUCachingAllocator only allocates CPU tensors, got device type "
+                                      << prototype->device.device_type;
+        }
+        size_t nbytes = ShapeOps::CheckedDataSize(prototype->shape, prototype->ndim, prototype->dtype);
+        size_t alignment = nbytes >= kPageAlignedSize ? kPageAlignment : kDefaultAlignment;
+        void* data = Global()->Alloc(nbytes, alignment);
+        CPUManagedTensor* ctx;
+        try {
+            ctx = new (details::AlignedAlloc<alignof(CPUManagedTensor)>(
+                    sizeof(CPUManagedTensor) + sizeof(int64_t) * prototype->ndim)) CPUManagedTensor();
+        } catch (...) {
+            Global()->Free(data, nbytes, alignment);
+            throw;
+        }
+        int64_t* shape = reinterpret_cast<int64_t*>(ctx + 1);
+        std::copy(prototype->shape, prototype->shape + prototype->ndim, shape);
+        ctx->nbytes = nbytes;
+        ctx->alignment = alignment;
+        DLManagedTensorVersioned* tensor = &ctx->tensor;
+        tensor->version.major = DLPACK_MAJOR_VERSION;
+        tensor->version.minor = DLPACK_MINOR_VERSION;
+        tensor->manager_ctx = ctx;
+        tensor->deleter = CPUManagedTensor::Deleter;
+        tensor->flags = 0;
+        tensor->dl_tensor = *prototype;
+        tensor->dl_tensor.data = data;
+        tensor->dl_tensor.shape = shape;
+        tensor->dl_tensor.strides = nullptr;
+        tensor->dl_tensor.byte_offset = 0;
+        *out = tensor;
+        return 0;
+    } catch (const Error& err) {
+        SetError(error_ctx, err.kind().c_str(), err.message().c_str());
+    } catch (const std::bad_alloc&) {
+        SetError(error_ctx, "MemoryError", "CPUCachingAllocator: out of memory");
+    }
+    return -1;
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+    namespace refl = litetvm::ffi::reflection;
+    refl::GlobalDef()
+            .def("ffi.CPUCachingAllocatorGetStats",
+                 []() {
+                     CPUCachingAllocator::Stats stats = CPUCachingAllocator::Global()->GetStats();
+                     return Map<String, int64_t>{
+                             {"bytes_in_use", static_cast<int64_t>(stats.bytes_in_use)},
+                             {"bytes_cached", static_cast<int64_t>(stats.bytes_cached)},
+                             {"peak_bytes_in_use", static_cast<int64_t>(stats.peak_bytes_in_use)},
+                             {"num_allocs", static_cast<int64_t>(stats.num_allocs)},
+                             {"num_cache_hits", static_cast<int64_t>(stats.num_cache_hits)}};
+                 })
+            .def("ffi.CPUCachingAllocatorTrim", []() { CPUCachingAllocator::Global()->Trim(); })
+            .def("ffi.CPUCachingAllocatorSetCacheLimit",
+                 [](int64_t bytes) {
+                     if (bytes < 0) {
+                         TVM_FFI_THROW(ValueError) << "The cache limit must be non-negative, got " << bytes;
+                     }
+                     CPUCachingAllocator::Global()->SetCacheLimit(static_cast<size_t>(bytes));
+                 });
+}
+
+}// namespace ffi
+}// namespace litetvm
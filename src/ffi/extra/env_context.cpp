@@ -2,15 +2,37 @@
 // Created by 赵丹 on 2025/8/28.
 //
 #include "ffi/extra/c_env_api.h"
+#include "ffi/extra/cpu_caching_allocator.h"
 #include "ffi/function.h"
 
+#include <array>
+#include <atomic>
 #include <vector>
 
 namespace litetvm {
 namespace ffi {
 
+/*!
+ * \brief Thread-local streams and tensor allocators of the environment.
+ *
+ * Allocators are looked up from the most specific setting: the thread-local allocator of
+ * the device type, the thread-local default, the global allocator of the device type, then
+ * the global default. Global settings are atomics bumping a global epoch after each write,
+ * each thread caches the resolved allocators with the epoch they were resolved at, so a
+ * lookup is one atomic load and a compare until a setting changes.
+ */
 class EnvContext {
 public:
+    /*! \brief Device types with their own allocators, covers the DLPack device types. */
+    static constexpr int32_t kMaxDeviceTypes = 32;
+    /*! \brief Device type of the allocator used for all device types. */
+    static constexpr int32_t kAnyDevice = -1;
+
+    /*! \return Whether the device type has its own allocator slot. */
+    static bool IsDeviceSlot(int32_t device_type) {
+        return device_type >= 0 && device_type < kMaxDeviceTypes;
+    }
+
     void SetStream(int32_t device_type, int32_t device_id, TVMFFIStreamHandle stream,
                    TVMFFIStreamHandle* out_original_stream) {
         if (static_cast<size_t>(device_type) >= stream_table_.size()) {
@@ -33,23 +55,33 @@ public:
         return nullptr;
     }
 
-    DLPackTensorAllocator GetDLPackTensorAllocator() {
-        if (dlpack_allocator_ != nullptr) {
-            return dlpack_allocator_;
+    DLPackTensorAllocator GetDLPackTensorAllocator(int32_t device_type = kAnyDevice) {
+        size_t slot = IsDeviceSlot(device_type) ? static_cast<size_t>(device_type) : kMaxDeviceTypes;
+        uint64_t epoch = GlobalEpoch().load(std::memory_order_acquire);
+        if (resolved_epochs_[slot] != epoch) {
+            // a concurrent global write bumps the epoch again, refreshing on the next lookup
+            resolved_[slot] = Resolve(slot);
+            resolved_epochs_[slot] = epoch;
         }
-        return GlobalTensorAllocator();
+        return resolved_[slot];
     }
 
-    void SetDLPackTensorAllocator(DLPackTensorAllocator allocator, int write_to_global_context,
+    void SetDLPackTensorAllocator(int32_t device_type, DLPackTensorAllocator allocator, int write_to_global_context,
                                   DLPackTensorAllocator* opt_out_original_allocator) {
-        dlpack_allocator_ = allocator;
-        if (write_to_global_context != 0) {
-            GlobalTensorAllocator() = allocator;
-        }
+        TVM_FFI_ICHECK(device_type == kAnyDevice || IsDeviceSlot(device_type));
+        DLPackTensorAllocator& local = device_type == kAnyDevice ? default_allocator_ : device_allocators_[device_type];
         if (opt_out_original_allocator != nullptr) {
-            *opt_out_original_allocator = dlpack_allocator_;
+            *opt_out_original_allocator = local;
+        }
+        local = allocator;
+        if (write_to_global_context != 0) {
+            std::atomic<DLPackTensorAllocator>& global =
+                    device_type == kAnyDevice ? GlobalDefaultAllocator() : GlobalDeviceAllocators()[device_type];
+            global.store(allocator, std::memory_order_relaxed);
+            // publishes the store to the threads seeing the new epoch
+            GlobalEpoch().fetch_add(1, std::memory_order_release);
         }
-        dlpack_allocator_ = allocator;
+        resolved_epochs_.fill(0);
     }
 
     static EnvContext* ThreadLocal() {
@@ -58,13 +90,44 @@ public:
     }
 
 private:
-    // use static function to avoid static initialization order issue
-    static DLPackTensorAllocator& GlobalTensorAllocator() {// NOLINT(*)
-        static DLPackTensorAllocator allocator = nullptr;
+    DLPackTensorAllocator Resolve(size_t slot) const {
+        DLPackTensorAllocator allocator = slot < kMaxDeviceTypes ? device_allocators_[slot] : nullptr;
+        if (allocator == nullptr) {
+            allocator = default_allocator_;
+        }
+        if (allocator == nullptr && slot < kMaxDeviceTypes) {
+            allocator = GlobalDeviceAllocators()[slot].load(std::memory_order_relaxed);
+        }
+        if (allocator == nullptr) {
+            allocator = GlobalDefaultAllocator().load(std::memory_order_relaxed);
+        }
         return allocator;
     }
+
+    // use static functions to avoid static initialization order issue
+    static std::atomic<DLPackTensorAllocator>& GlobalDefaultAllocator() {
+        // CPU tensors can be allocated out of the box, frameworks install their own allocator
+        static std::atomic<DLPackTensorAllocator> allocator{CPUCachingAllocator::DLPackAlloc};
+        return allocator;
+    }
+
+    static std::array<std::atomic<DLPackTensorAllocator>, kMaxDeviceTypes>& GlobalDeviceAllocators() {
+        static std::array<std::atomic<DLPackTensorAllocator>, kMaxDeviceTypes> allocators{};
+        return allocators;
+    }
+
+    // starts at 1 so the thread caches start stale
+    static std::atomic<uint64_t>& GlobalEpoch() {
+        static std::atomic<uint64_t> epoch{1};
+        return epoch;
+    }
+
     std::vector<std::vector<TVMFFIStreamHandle>> stream_table_;
-    DLPackTensorAllocator dlpack_allocator_ = nullptr;
+    DLPackTensorAllocator default_allocator_ = nullptr;
+    std::array<DLPackTensorAllocator, kMaxDeviceTypes> device_allocators_{};
+    // allocators per device type and the default last, valid while their epoch is the global one
+    std::array<DLPackTensorAllocator, kMaxDeviceTypes + 1> resolved_{};
+    std::array<uint64_t, kMaxDeviceTypes + 1> resolved_epochs_{};
 };
 
 }// namespace ffi
@@ -87,8 +150,8 @@ TVMFFIStreamHandle TVMFFIEnvGetStream(int32_t device_type, int32_t device_id) {
 int TVMFFIEnvSetTensorAllocator(DLPackTensorAllocator allocator, int write_to_global_context,
                                 DLPackTensorAllocator* opt_out_original_allocator) {
     TVM_FFI_SAFE_CALL_BEGIN();
-    litetvm::ffi::EnvContext::ThreadLocal()->SetDLPackTensorAllocator(allocator, write_to_global_context,
-                                                                      opt_out_original_allocator);
+    litetvm::ffi::EnvContext::ThreadLocal()->SetDLPackTensorAllocator(
+            litetvm::ffi::EnvContext::kAnyDevice, allocator, write_to_global_context, opt_out_original_allocator);
     TVM_FFI_SAFE_CALL_END();
 }
 
@@ -96,4 +159,25 @@ DLPackTensorAllocator TVMFFIEnvGetTensorAllocator() {
     TVM_FFI_LOG_EXCEPTION_CALL_BEGIN();
     return litetvm::ffi::EnvContext::ThreadLocal()->GetDLPackTensorAllocator();
     TVM_FFI_LOG_EXCEPTION_CALL_END(TVMFFIEnvGetTensorAllocator);
-}
\ No newline at end of file
+}
+
+int TVMFFIEnvSetDeviceTensorAllocator(int32_t device_type, DLPackTensorAllocator allocator,
+                                      int write_to_global_context,
+                                      DLPackTensorAllocator* opt_out_original_allocator) {
+    TVM_FFI_SAFE_CALL_BEGIN();
+    // kAnyDevice is internal, the default allocator is set with TVMFFIEnvSetTensorAllocator
+    if (!litetvm::ffi::EnvContext::IsDeviceSlot(device_type)) {
+        TVM_FFI_THROW(ValueError) << "Cannot set the tensor allocator of device type " << device_type
+                                  << ", expected a device type in [0, " << litetvm::ffi::EnvContext::kMaxDeviceTypes
+                                  << ")";
+    }
+    litetvm::ffi::EnvContext::ThreadLocal()->SetDLPackTensorAllocator(device_type, allocator, write_to_global_context,
+                                                                      opt_out_original_allocator);
+    TVM_FFI_SAFE_CALL_END();
+}
+
+DLPackTensorAllocator TVMFFIEnvGetDeviceTensorAllocator(int32_t device_type) {
+    TVM_FFI_LOG_EXCEPTION_CALL_BEGIN();
+    return litetvm::ffi::EnvContext::ThreadLocal()->GetDLPackTensorAllocator(device_type);
+    TVM_FFI_LOG_EXCEPTION_CALL_END(TVMFFIEnvGetDeviceTensorAllocator);
+}
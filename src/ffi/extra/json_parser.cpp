@@ -7,7 +7,9 @@
 #include "ffi/string.h"
 
 #include <cinttypes>
+#include <functional>
 #include <limits>
+#include <string_view>
 #include <utility>
 
 namespace litetvm {
@@ -104,7 +106,7 @@ public:
         // the loop focuses on simple string without escape characters
         for (; cur_ != end_; ++cur_) {
             if (*cur_ == '\"') {
-                *out = String(start_pos + 1, cur_ - start_pos - 1);
+                *out = this->MakeString(start_pos + 1, static_cast<size_t>(cur_ - start_pos - 1));
                 ++cur_;
                 return true;
             }
@@ -481,6 +483,33 @@ private:
         return true;
     }
 
+    /*!
+   * \brief Create a string for an unescaped token.
+   *
+   * Strings too long for the small-string cell of String but at most
+   * kMaxCachedStrLen bytes (object keys such as "device_type" and enum-like
+   * values) tend to repeat across records, so they are served from a
+   * direct-mapped cache and share one allocation.
+   */
+    String MakeString(const char* data, size_t size) {
+        if (size <= kMaxSmallStrLen || size > kMaxCachedStrLen) {
+            return String(data, size);
+        }
+        std::string_view key(data, size);
+        String& entry = short_string_cache_[std::hash<std::string_view>()(key) % kShortStringCacheSize];
+        if (std::string_view(entry.data(), entry.size()) != key) {
+            entry = String(data, size);
+        }
+        return entry;
+    }
+
+    /*! \brief Strings up to this length are stored inline in String. */
+    static constexpr size_t kMaxSmallStrLen = sizeof(int64_t) - 1;
+    /*! \brief Strings up to this length are served from the short string cache. */
+    static constexpr size_t kMaxCachedStrLen = 23;
+    /*! \brief Number of entries in the short string cache. */
+    static constexpr size_t kShortStringCacheSize = 64;
+
     /*! \brief The beginning of the string */
     const char* begin_;
     /*! \brief The current pointer */
@@ -493,6 +522,8 @@ private:
     std::string error_msg_;
     /*! \brief The line counter */
     int64_t line_counter_{1};
+    /*! \brief Recently created short strings */
+    String short_string_cache_[kShortStringCacheSize];
 };
 
 class JSONParser {
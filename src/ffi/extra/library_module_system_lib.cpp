@@ -7,7 +7,10 @@
 #include "ffi/reflection/registry.h"
 #include "ffi/string.h"
 
+#include <initializer_list>
 #include <mutex>
+#include <string>
+#include <string_view>
 
 #include "module_internal.h"
 
@@ -25,7 +28,7 @@ public:
         symbol_table_.Set(name, ptr);
     }
 
-    void* GetSymbol(const String& name) {
+    void* GetSymbol(std::string_view name) {
         auto it = symbol_table_.find(name);
         if (it != symbol_table_.end()) {
             return (*it).second;
@@ -52,29 +55,42 @@ public:
     void* GetSymbol(const String& name) {
         // The `name` might or might not already contain the symbol prefix.
         // Therefore, we check both with and without the prefix.
-        String name_with_prefix = symbol_prefix_ + name;
-        void* symbol = reg_->GetSymbol(name_with_prefix);
+        std::string_view name_view(name.data(), name.size());
+        void* symbol = reg_->GetSymbol(JoinName({symbol_prefix_, name_view}));
         if (symbol != nullptr) {
             return symbol;
         }
-        return reg_->GetSymbol(name_with_prefix);
+        return reg_->GetSymbol(name_view);
     }
 
     void* GetSymbolWithSymbolPrefix(const String& name) {
         // The `name` might or might not already contain the symbol prefix.
         // Therefore, we check both with and without the prefix.
-        String name_with_prefix = symbol::tvm_ffi_symbol_prefix + symbol_prefix_ + name;
-        void* symbol = reg_->GetSymbol(name_with_prefix);
+        std::string_view name_view(name.data(), name.size());
+        void* symbol = reg_->GetSymbol(JoinName({symbol::tvm_ffi_symbol_prefix, symbol_prefix_, name_view}));
         if (symbol != nullptr) {
             return symbol;
         }
-        name_with_prefix = symbol::tvm_ffi_symbol_prefix + name;
-        return reg_->GetSymbol(name_with_prefix);
+        return reg_->GetSymbol(JoinName({symbol::tvm_ffi_symbol_prefix, name_view}));
     }
 
 private:
+    /*!
+   * \brief Concatenate the parts of a symbol name into a per-thread buffer
+   * \return View of the buffer, valid until the next call on the same thread
+   * \note Symbol lookups are frequent, reusing the buffer avoids allocating a String each time.
+   */
+    static std::string_view JoinName(std::initializer_list<std::string_view> parts) {
+        thread_local std::string buffer;
+        buffer.clear();
+        for (std::string_view part: parts) {
+            buffer.append(part);
+        }
+        return buffer;
+    }
+
     SystemLibSymbolRegistry* reg_ = SystemLibSymbolRegistry::Global();
-    String symbol_prefix_;
+    std::string symbol_prefix_;
 };
 
 class SystemLibModuleRegistry {
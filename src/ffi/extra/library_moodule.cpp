@@ -4,6 +4,7 @@
 #include "ffi/cast.h"
 #include "ffi/extra/c_env_api.h"
 #include "ffi/extra/module.h"
+#include "ffi/profiler.h"
 
 #include "buffer_stream.h"
 #include "module_internal.h"
@@ -26,11 +27,13 @@ public:
         // ensure the function keeps the Library Module alive
         Module self_strong_ref = GetRef<Module>(this);
         if (faddr != nullptr) {
-            return Function::FromPacked([faddr, self_strong_ref](PackedArgs args,Any* rv) {
+            Function func = Function::FromPacked([faddr, self_strong_ref](PackedArgs args,Any* rv) {
                 TVM_FFI_ICHECK_LT(rv->type_index(), ffi::TypeIndex::kTVMFFIStaticObjectBegin);
                 TVM_FFI_CHECK_SAFE_CALL((*faddr)(nullptr, reinterpret_cast<const TVMFFIAny*>(args.data()),
                                                  args.size(), reinterpret_cast<TVMFFIAny*>(rv)));
             });
+            Profiler::Track(name, func);
+            return func;
         }
         return std::nullopt;
     }
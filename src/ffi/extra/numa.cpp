@@ -0,0 +1,271 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/extra/numa.h"
+#include "ffi/container/array.h"
+#include "ffi/container/shape_ops.h"
+#include "ffi/function.h"
+#include "ffi/memory.h"
+#include "ffi/reflection/registry.h"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace litetvm {
+namespace ffi {
+namespace {
+
+// memory policies of mbind and set_mempolicy, see linux/mempolicy.h
+constexpr int kMPolPreferred = 1;
+constexpr int kMPolBind = 2;
+
+constexpr size_t kPageSize = 4096;
+
+// parses lists such as "0-3,8,10-11"
+std::vector<int> ParseIdList(const std::string& text) {
+    std::vector<int> ids;
+    std::stringstream stream(text);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int id = first; id <= last; ++id) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+bool ReadIdList(const std::string& path, std::vector<int>* ids) {
+    std::ifstream in(path);
+    std::string text;
+    if (!in || !std::getline(in, text)) {
+        return false;
+    }
+    try {
+        *ids = ParseIdList(text);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+/*! \brief CPUs per node, read once. */
+const std::vector<std::vector<int>>& NodeCpus() {
+    static const std::vector<std::vector<int>> node_cpus = []() {
+        std::vector<std::vector<int>> node_cpus;
+        std::vector<int> nodes;
+        if (ReadIdList("/sys/devices/system/node/online", &nodes) && !nodes.empty()) {
+            node_cpus.resize(*std::max_element(nodes.begin(), nodes.end()) + 1);
+            for (int node: nodes) {
+                ReadIdList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", &node_cpus[node]);
+            }
+        } else {
+            node_cpus.resize(1);
+            for (int cpu = 0; cpu < static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u)); ++cpu) {
+                node_cpus[0].push_back(cpu);
+            }
+        }
+        return node_cpus;
+    }();
+    return node_cpus;
+}
+
+void CheckNode(int node) {
+    if (node < 0 || node >= NUMANumNodes()) {
+        TVM_FFI_THROW(ValueError) << "NUMA node " << node << " does not exist, the machine has " << NUMANumNodes()
+                                  << " nodes";
+    }
+}
+
+size_t MappedSize(size_t nbytes) {
+    return std::max<size_t>((nbytes + kPageSize - 1) / kPageSize, 1) * kPageSize;
+}
+
+#if defined(__linux__)
+// node mask of the mbind and set_mempolicy system calls
+struct NodeMask {
+    std::vector<unsigned long> bits;
+
+    explicit NodeMask(int node) : bits(node / 64 + 1, 0) {
+        bits[node / 64] = 1UL << (node % 64);
+    }
+
+    // the kernel reads max_node - 1 bits
+    NODISCARD unsigned long max_node() const {
+        return bits.size() * 64 + 1;
+    }
+};
+#endif
+
+/*! \brief DLPack tensor with the shape stored after it. */
+struct NUMAManagedTensor {
+    DLManagedTensorVersioned tensor;
+    size_t nbytes;
+
+    static void Deleter(DLManagedTensorVersioned* self) {
+        NUMAManagedTensor* ctx = static_cast<NUMAManagedTensor*>(self->manager_ctx);
+        NUMAAllocator::Free(self->dl_tensor.data, ctx->nbytes);
+        details::AlignedFree(ctx);
+    }
+};
+
+}// namespace
+
+int NUMANumNodes() {
+    return static_cast<int>(NodeCpus().size());
+}
+
+std::vector<int> NUMANodeCpus(int node) {
+    CheckNode(node);
+    return NodeCpus()[node];
+}
+
+bool NUMABindMemory(void* ptr, size_t nbytes, int node) {
+    CheckNode(node);
+#if defined(__linux__)
+    NodeMask mask(node);
+    return syscall(SYS_mbind, ptr, nbytes, kMPolBind, mask.bits.data(), mask.max_node(), 0) == 0;
+#else
+    return false;
+#endif
+}
+
+bool NUMAPinThread(int node) {
+    CheckNode(node);
+#if defined(__linux__)
+    const std::vector<int>& cpus = NodeCpus()[node];
+    if (cpus.empty()) {
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu: cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+        return false;
+    }
+    // preferred rather than bound, allocations spill to other nodes when the node is full
+    NodeMask mask(node);
+    syscall(SYS_set_mempolicy, kMPolPreferred, mask.bits.data(), mask.max_node());
+    return true;
+#else
+    return false;
+#endif
+}
+
+ThreadPool* NUMANodeThreadPool(int node) {
+    CheckNode(node);
+    // leaked so loops can run during static destruction
+    static std::mutex mutex;
+    static std::vector<ThreadPool*>* pools = new std::vector<ThreadPool*>(NUMANumNodes(), nullptr);
+    std::lock_guard<std::mutex> lock(mutex);
+    ThreadPool*& pool = (*pools)[node];
+    if (pool == nullptr) {
+        // the calling thread runs a share of each loop, as with ThreadPool::Global
+        int num_workers = std::max(static_cast<int>(NodeCpus()[node].size()) - 1, 1);
+        pool = new ThreadPool(num_workers, [node](int) { NUMAPinThread(node); });
+    }
+    return pool;
+}
+
+void* NUMAAllocator::Alloc(size_t nbytes, int node) {
+    CheckNode(node);
+    size_t mapped_size = MappedSize(nbytes);
+#if defined(__linux__)
+    void* ptr = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    // left to first touch where binding is not supported
+    NUMABindMemory(ptr, mapped_size, node);
+    return ptr;
+#else
+    return details::AlignedAlloc<kPageSize>(mapped_size);
+#endif
+}
+
+void NUMAAllocator::Free(void* ptr, size_t nbytes) {
+#if defined(__linux__)
+    munmap(ptr, MappedSize(nbytes));
+#else
+    (void) nbytes;
+    details::AlignedFree(ptr);
+#endif
+}
+
+int NUMAAllocator::DLPackAlloc(DLTensor* prototype, DLManagedTensorVersioned** out, void* error_ctx,
+                               void (*SetError)(void* error_ctx, const char* kind, const char* message)) {
+    try {
+        if (prototype->device.device_type != kDLCPU) {
+            TVM_FFI_THROW(ValueError) << "NUMAAllocator only allocates CPU tensors, got device type "
+                                      << prototype->device.device_type;
+        }
+        size_t nbytes = ShapeOps::CheckedDataSize(prototype->shape, prototype->ndim, prototype->dtype);
+        void* data = Alloc(nbytes, prototype->device.device_id);
+        NUMAManagedTensor* ctx;
+        try {
+            ctx = new (details::AlignedAlloc<alignof(NUMAManagedTensor)>(
+                    sizeof(NUMAManagedTensor) + sizeof(int64_t) * prototype->ndim)) NUMAManagedTensor();
+        } catch (...) {
+            Free(data, nbytes);
+            throw;
+        }
+        int64_t* shape = reinterpret_cast<int64_t*>(ctx + 1);
+        std::copy(prototype->shape, prototype->shape + prototype->ndim, shape);
+        ctx->nbytes = nbytes;
+        DLManagedTensorVersioned* tensor = &ctx->tensor;
+        tensor->version.major = DLPACK_MAJOR_VERSION;
+        tensor->version.minor = DLPACK_MINOR_VERSION;
+        tensor->manager_ctx = ctx;
+        tensor->deleter = NUMAManagedTensor::Deleter;
+        tensor->flags = 0;
+        tensor->dl_tensor = *prototype;
+        tensor->dl_tensor.data = data;
+        tensor->dl_tensor.shape = shape;
+        tensor->dl_tensor.strides = nullptr;
+        tensor->dl_tensor.byte_offset = 0;
+        *out = tensor;
+        return 0;
+    } catch (const Error& err) {
+        SetError(error_ctx, err.kind().c_str(), err.message().c_str());
+    } catch (const std::bad_alloc&) {
+        SetError(error_ctx, "MemoryError", "NUMAAllocator: out of memory");
+    }
+    return -1;
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+    namespace refl = litetvm::ffi::reflection;
+    refl::GlobalDef()
+            .def("ffi.NUMANumNodes", []() { return NUMANumNodes(); })
+            .def("ffi.NUMANodeCpus", [](int node) {
+                Array<int64_t> cpus;
+                for (int cpu: NUMANodeCpus(node)) {
+                    cpus.push_back(cpu);
+                }
+                return cpus;
+            });
+}
+
+}// namespace ffi
+}// namespace litetvm
@@ -13,6 +13,8 @@
 #include "ffi/reflection/registry.h"
 #include "ffi/string.h"
 
+#include <optional>
+
 namespace litetvm {
 namespace ffi {
 
@@ -346,10 +348,10 @@ private:
 
         json::Object data_object = data.cast<json::Object>();
         reflection::ForEachFieldInfo(type_info, [&](const TVMFFIFieldInfo* field_info) {
-            String field_name(field_info->name);
             void* field_addr = reinterpret_cast<char*>(ptr.get()) + field_info->offset;
-            if (data_object.count(field_name) != 0) {
-                Any field_value = decode_field_value(field_info, data_object[field_name]);
+            // look up by the name bytes directly, no String is allocated per field
+            if (std::optional<Any> field_data = data_object.Get(field_info->name)) {
+                Any field_value = decode_field_value(field_info, *field_data);
                 field_info->setter(field_addr, reinterpret_cast<const TVMFFIAny*>(&field_value));
             } else if (field_info->flags & kTVMFFIFieldFlagBitMaskHasDefault) {
                 field_info->setter(field_addr, &(field_info->default_value));
@@ -323,6 +323,9 @@ public:
     }
 
     static bool CompareShape(const Shape& lhs, const Shape& rhs) {
+        if (lhs.same_as(rhs)) {
+            return true;
+        }
         if (lhs.size() != rhs.size()) {
             return false;
         }
@@ -405,7 +408,42 @@ public:
     std::unordered_map<ObjectRef, ObjectRef, ObjectPtrHash, ObjectPtrEqual> equal_map_rhs_;
 };
 
+namespace {
+/*!
+ * \brief Whether an object of the type is equal to itself without comparing its content.
+ *
+ * Only holds for types whose comparison cannot fail, types without structural
+ * equality support must still raise a TypeError when compared with themselves.
+ */
+bool SelfEqualWithoutCompare(int32_t type_index) {
+    switch (type_index) {
+        case kTVMFFIStr:
+        case kTVMFFIBytes:
+        case kTVMFFIShape:
+            return true;
+        case kTVMFFIArray:
+        case kTVMFFIMap:
+        case kTVMFFITensor:
+            // elements may not support structural equality
+            return false;
+        default: {
+            const TVMFFITypeInfo* type_info = TVMFFIGetTypeInfo(type_index);
+            if (type_info->metadata == nullptr) return false;
+            auto kind = type_info->metadata->structural_eq_hash_kind;
+            return kind == kTVMFFISEqHashKindUniqueInstance || kind == kTVMFFISEqHashKindConstTreeNode;
+        }
+    }
+}
+}// namespace
+
 bool StructuralEqual::Equal(const Any& lhs, const Any& rhs, bool map_free_vars, bool skip_ndarray_content) {
+    // skip the handler setup for shared (e.g. interned) objects that are trivially equal to themselves
+    const TVMFFIAny* lhs_data = details::AnyUnsafe::TVMFFIAnyPtrFromAny(lhs);
+    const TVMFFIAny* rhs_data = details::AnyUnsafe::TVMFFIAnyPtrFromAny(rhs);
+    if (lhs_data->type_index >= kTVMFFIStaticObjectBegin && lhs_data->type_index == rhs_data->type_index &&
+        lhs_data->v_obj == rhs_data->v_obj && SelfEqualWithoutCompare(lhs_data->type_index)) {
+        return true;
+    }
     StructEqualHandler handler;
     handler.map_free_vars_ = map_free_vars;
     handler.skip_ndarray_content_ = skip_ndarray_content;
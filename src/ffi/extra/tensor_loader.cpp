@@ -0,0 +1,166 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/extra/tensor_loader.h"
+#include "ffi/extra/c_env_api.h"
+#include "ffi/reflection/registry.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unordered_map>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace litetvm {
+namespace ffi {
+
+struct TensorLoader::FileHandle {
+    int fd;
+    String path;
+
+    ~FileHandle() {
+#if !defined(_WIN32)
+        close(fd);
+#endif
+    }
+
+    static std::shared_ptr<FileHandle> Open(const String& path) {
+#if defined(_WIN32)
+        TVM_FFI_THROW(RuntimeError) << "TensorLoader: reading files is not supported on Windows";
+#else
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            TVM_FFI_THROW(RuntimeError) << "TensorLoader: cannot open " << path << ": " << std::strerror(errno);
+        }
+        return std::shared_ptr<FileHandle>(new FileHandle{fd, path});
+#endif
+    }
+
+    /*! \return The error message, empty if all bytes were read. */
+    std::string Read(char* data, int64_t nbytes, int64_t offset) const {
+#if !defined(_WIN32)
+        for (int64_t done = 0; done < nbytes;) {
+            ssize_t n = pread(fd, data + done, static_cast<size_t>(nbytes - done), static_cast<off_t>(offset + done));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0) {
+                return "cannot read " + std::string(path) + ": " + std::strerror(errno);
+            }
+            if (n == 0) {
+                return "unexpected end of " + std::string(path) + " at offset " + std::to_string(offset + done);
+            }
+            done += n;
+        }
+#endif
+        return "";
+    }
+};
+
+bool TensorFutureObj::IsReady() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ready_;
+}
+
+Tensor TensorFutureObj::Wait() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return ready_; });
+    if (!error_.empty()) {
+        TVM_FFI_THROW(RuntimeError) << "TensorLoader: " << error_;
+    }
+    return tensor_;
+}
+
+TensorLoader::TensorLoader(int io_depth, int64_t chunk_bytes)
+    : chunk_bytes_(std::max<int64_t>(chunk_bytes, 1)), pool_(io_depth) {}
+
+TensorLoader::~TensorLoader() = default;
+
+TensorFuture TensorLoader::Submit(const TensorLoadRequest& request, Optional<Function> callback) {
+    return Submit(request, FileHandle::Open(request.path), std::move(callback));
+}
+
+std::vector<TensorFuture> TensorLoader::Submit(const std::vector<TensorLoadRequest>& requests) {
+    std::unordered_map<std::string, std::shared_ptr<FileHandle>> files;
+    std::vector<TensorFuture> futures;
+    futures.reserve(requests.size());
+    for (const TensorLoadRequest& request: requests) {
+        std::shared_ptr<FileHandle>& file = files[std::string(request.path)];
+        if (file == nullptr) {
+            file = FileHandle::Open(request.path);
+        }
+        futures.push_back(Submit(request, file, std::nullopt));
+    }
+    return futures;
+}
+
+TensorFuture TensorLoader::Submit(const TensorLoadRequest& request, std::shared_ptr<FileHandle> file,
+                                  Optional<Function> callback) {
+    if (request.offset < 0) {
+        TVM_FFI_THROW(ValueError) << "TensorLoader: negative offset " << request.offset << " in " << request.path;
+    }
+    ObjectPtr<TensorFutureObj> future = make_object<TensorFutureObj>();
+    future->tensor_ = Tensor::FromDLPackAlloc(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU), request.shape,
+                                              request.dtype, DLDevice{kDLCPU, 0});
+    future->callback_ = std::move(callback);
+    int64_t nbytes = static_cast<int64_t>(GetDataSize(*future->tensor_.get()));
+    int64_t num_chunks = std::max<int64_t>((nbytes + chunk_bytes_ - 1) / chunk_bytes_, 1);
+    future->pending_chunks_.store(num_chunks, std::memory_order_relaxed);
+    char* data = static_cast<char*>(future->tensor_->data) + future->tensor_->byte_offset;
+
+    for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+        int64_t begin = chunk * chunk_bytes_;
+        int64_t size = std::min(chunk_bytes_, nbytes - begin);
+        pool_.Submit([future, file, data, begin, size, offset = request.offset]() {
+            std::string error = file->Read(data + begin, size, offset + begin);
+            if (!error.empty()) {
+                std::lock_guard<std::mutex> lock(future->mutex_);
+                if (future->error_.empty()) {
+                    future->error_ = std::move(error);
+                }
+            }
+            if (future->pending_chunks_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+            Any result;
+            {
+                std::lock_guard<std::mutex> lock(future->mutex_);
+                if (!future->error_.empty()) {
+                    future->tensor_ = Tensor(nullptr);
+                    result = Error("RuntimeError", "TensorLoader: " + future->error_, "");
+                } else {
+                    result = future->tensor_;
+                }
+                future->ready_ = true;
+            }
+            future->cv_.notify_all();
+            if (future->callback_.has_value()) {
+                try {
+                    (*future->callback_)(result);
+                } catch (...) {
+                }
+            }
+        });
+    }
+    return TensorFuture(future);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+    namespace refl = litetvm::ffi::reflection;
+    refl::ObjectDef<TensorFutureObj>()
+            .def("is_ready", &TensorFutureObj::IsReady)
+            .def("wait", &TensorFutureObj::Wait);
+    refl::GlobalDef().def("ffi.TensorLoaderLoad", [](String path, int64_t offset, Shape shape, DLDataType dtype,
+                                                     Optional<Function> callback) {
+        // leaked so loads can finish during static destruction
+        static TensorLoader* loader = new TensorLoader();
+        return loader->Submit(TensorLoadRequest{path, offset, shape, dtype}, std::move(callback));
+    });
+}
+
+}// namespace ffi
+}// namespace litetvm
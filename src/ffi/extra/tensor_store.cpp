@@ -0,0 +1,350 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/extra/tensor_store.h"
+#include "ffi/container/map.h"
+#include "ffi/function.h"
+#include "ffi/reflection/registry.h"
+#include "ffi/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace litetvm {
+namespace ffi {
+namespace {
+
+constexpr int64_t kChunkBytes = static_cast<int64_t>(1) << 20;
+constexpr size_t kStripeBytes = 64;
+// stripes between two scrambles of the lanes
+constexpr size_t kStripesPerBlock = 16;
+constexpr size_t kBackingAlignment = 4096;
+
+constexpr uint64_t kSecret[8] = {0xbe4ba423396cfeb8ULL, 0x1cad21f72c81017cULL, 0xdb979083e96dd4deULL,
+                                 0x1f67b3b7a4a44072ULL, 0x78e5c0cc4ee679cbULL, 0x2172ffcc7dd05a82ULL,
+                                 0x8e2443f7744608b8ULL, 0x4c263a81e69035e0ULL};
+constexpr uint64_t kPrime32 = 0x9e3779b1ULL;
+constexpr uint64_t kPrime64 = 0x9e3779b185ebca87ULL;
+
+// secret of each stripe of a block, so swapping stripes changes the hash
+struct StripeSecrets {
+    alignas(16) uint64_t value[kStripesPerBlock][8];
+
+    constexpr StripeSecrets() : value() {
+        for (size_t s = 0; s < kStripesPerBlock; ++s) {
+            for (size_t i = 0; i < 8; ++i) {
+                value[s][i] = kSecret[(i + s) % 8] ^ (s * kPrime64);
+            }
+        }
+    }
+};
+constexpr StripeSecrets kStripeSecrets;
+
+uint64_t Mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+uint64_t Combine(uint64_t hash, uint64_t value) {
+    return Mix64(hash ^ (value + kPrime64 + (hash << 6) + (hash >> 2)));
+}
+
+// lanes of a chunk, each stripe adds its words and the product of the halves of the words
+// mixed with the secret, as XXH3 does
+struct Lanes {
+    alignas(16) uint64_t acc[8] = {kPrime32, kPrime64, kSecret[0], kSecret[1],
+                                   kSecret[2], kSecret[3], kSecret[4], kPrime32};
+
+#if defined(__SSE2__) || defined(_M_X64)
+    void Accumulate(const char* stripes, size_t num_stripes) {
+        __m128i* acc_vec = reinterpret_cast<__m128i*>(acc);
+        for (size_t s = 0; s < num_stripes; ++s) {
+            const char* stripe = stripes + s * kStripeBytes;
+            const __m128i* secret = reinterpret_cast<const __m128i*>(kStripeSecrets.value[s]);
+            for (int i = 0; i < 4; ++i) {
+                __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stripe) + i);
+                __m128i key = _mm_xor_si128(data, _mm_load_si128(secret + i));
+                __m128i product = _mm_mul_epu32(key, _mm_srli_epi64(key, 32));
+                __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                acc_vec[i] = _mm_add_epi64(acc_vec[i], _mm_add_epi64(product, swapped));
+            }
+        }
+    }
+
+    void Scramble() {
+        __m128i* acc_vec = reinterpret_cast<__m128i*>(acc);
+        __m128i prime = _mm_set1_epi32(static_cast<int>(kPrime32));
+        for (int i = 0; i < 4; ++i) {
+            __m128i value = _mm_xor_si128(acc_vec[i], _mm_srli_epi64(acc_vec[i], 47));
+            value = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(kSecret) + i));
+            // 64 bit multiply by a 32 bit prime from two 32 x 32 bit products
+            __m128i low = _mm_mul_epu32(value, prime);
+            __m128i high = _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(value, 32), prime), 32);
+            acc_vec[i] = _mm_add_epi64(low, high);
+        }
+    }
+#else
+    static uint64_t Load64(const char* data) {
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        if constexpr (!TVM_FFI_IO_NO_ENDIAN_SWAP) {
+            value = __builtin_bswap64(value);
+        }
+        return value;
+    }
+
+    void Accumulate(const char* stripes, size_t num_stripes) {
+        for (size_t s = 0; s < num_stripes; ++s) {
+            const char* stripe = stripes + s * kStripeBytes;
+            for (int i = 0; i < 8; ++i) {
+                uint64_t data = Load64(stripe + 8 * i);
+                uint64_t key = data ^ kStripeSecrets.value[s][i];
+                acc[i ^ 1] += data;
+                acc[i] += (key & 0xffffffffULL) * (key >> 32);
+            }
+        }
+    }
+
+    void Scramble() {
+        for (int i = 0; i < 8; ++i) {
+            acc[i] = (acc[i] ^ (acc[i] >> 47) ^ kSecret[i]) * kPrime32;
+        }
+    }
+#endif
+};
+
+uint64_t HashChunk(const char* data, size_t nbytes) {
+    Lanes lanes;
+    size_t num_stripes = nbytes / kStripeBytes;
+    for (size_t s = 0; s < num_stripes; s += kStripesPerBlock) {
+        lanes.Accumulate(data + s * kStripeBytes, std::min(kStripesPerBlock, num_stripes - s));
+        lanes.Scramble();
+    }
+    if (size_t tail = nbytes % kStripeBytes; tail != 0) {
+        char last[kStripeBytes] = {};
+        std::memcpy(last, data + num_stripes * kStripeBytes, tail);
+        lanes.Accumulate(last, 1);
+    }
+    uint64_t hash = Mix64(nbytes * kPrime64);
+    for (uint64_t lane: lanes.acc) {
+        hash = Combine(hash, lane);
+    }
+    return hash;
+}
+
+const char* Data(const Tensor& tensor) {
+    return static_cast<const char*>(tensor->data) + tensor->byte_offset;
+}
+
+Tensor MakeContiguous(const Tensor& tensor) {
+    if (tensor->device.device_type != kDLCPU) {
+        TVM_FFI_THROW(ValueError) << "TensorStore only stores CPU tensors, got device type "
+                                  << tensor->device.device_type;
+    }
+    return tensor.IsContiguous() ? tensor : tensor.Contiguous();
+}
+
+uint64_t FingerprintContiguous(const Tensor& tensor) {
+    uint64_t hash = Combine(kPrime64, static_cast<uint64_t>(tensor->ndim));
+    for (int i = 0; i < tensor->ndim; ++i) {
+        hash = Combine(hash, static_cast<uint64_t>(tensor->shape[i]));
+    }
+    hash = Combine(hash, (static_cast<uint64_t>(tensor->dtype.code) << 24) |
+                                 (static_cast<uint64_t>(tensor->dtype.bits) << 16) | tensor->dtype.lanes);
+    int64_t nbytes = static_cast<int64_t>(GetDataSize(*tensor.get()));
+    int64_t num_chunks = (nbytes + kChunkBytes - 1) / kChunkBytes;
+    std::vector<uint64_t> chunk_hashes(num_chunks);
+    const char* data = Data(tensor);
+    ThreadPool::Global()->ParallelFor(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t chunk = begin; chunk < end; ++chunk) {
+            int64_t offset = chunk * kChunkBytes;
+            size_t size = static_cast<size_t>(std::min(kChunkBytes, nbytes - offset));
+            chunk_hashes[chunk] = HashChunk(data + offset, size);
+        }
+    });
+    for (uint64_t chunk_hash: chunk_hashes) {
+        hash = Combine(hash, chunk_hash);
+    }
+    return hash;
+}
+
+bool SameContent(const Tensor& lhs, const Tensor& rhs) {
+    if (lhs->ndim != rhs->ndim || lhs->dtype != rhs->dtype ||
+        !std::equal(lhs->shape, lhs->shape + lhs->ndim, rhs->shape)) {
+        return false;
+    }
+    int64_t nbytes = static_cast<int64_t>(GetDataSize(*lhs.get()));
+    std::atomic<bool> same{true};
+    ThreadPool::Global()->ParallelFor(0, nbytes, kChunkBytes, [&](int64_t begin, int64_t end) {
+        if (std::memcmp(Data(lhs) + begin, Data(rhs) + begin, static_cast<size_t>(end - begin)) != 0) {
+            same.store(false, std::memory_order_relaxed);
+        }
+    });
+    return same.load(std::memory_order_relaxed);
+}
+
+}// namespace
+
+TensorStoreObj::TensorStoreObj(Optional<String> backing_file, int backing_fd)
+    : backing_file_(std::move(backing_file)), backing_fd_(backing_fd) {}
+
+TensorStoreObj::~TensorStoreObj() {
+#if !defined(_WIN32)
+    if (backing_fd_ >= 0) {
+        close(backing_fd_);
+    }
+#endif
+}
+
+Tensor TensorStoreObj::WriteBackingFile(const Tensor& tensor, int64_t offset) {
+    int64_t nbytes = static_cast<int64_t>(GetDataSize(*tensor.get()));
+#if !defined(_WIN32)
+    for (int64_t done = 0; done < nbytes;) {
+        ssize_t n = pwrite(backing_fd_, Data(tensor) + done, static_cast<size_t>(nbytes - done),
+                           static_cast<off_t>(offset + done));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            TVM_FFI_THROW(RuntimeError) << "TensorStore: cannot write " << *backing_file_ << ": "
+                                        << std::strerror(errno);
+        }
+        done += n;
+    }
+#endif
+    return Tensor::LoadMapped(*backing_file_, offset, tensor.shape(), tensor->dtype);
+}
+
+Tensor TensorStoreObj::Intern(const Tensor& tensor) {
+    Tensor contiguous = MakeContiguous(tensor);
+    uint64_t fingerprint = FingerprintContiguous(contiguous);
+    int64_t nbytes = static_cast<int64_t>(GetDataSize(*contiguous.get()));
+
+    // with the lock held
+    auto count = [&](bool deduplicated) {
+        stats_.num_interned += 1;
+        stats_.bytes_interned += nbytes;
+        if (deduplicated) {
+            stats_.num_deduplicated += 1;
+            stats_.bytes_deduplicated += nbytes;
+        }
+    };
+
+    // The bytes are compared and written without the lock, they may be large. Each round
+    // collects the live entries not compared yet, and the tensor is only published when a
+    // round under the lock finds none.
+    std::vector<Tensor> checked;
+    std::optional<Tensor> written;
+    while (true) {
+        std::vector<Tensor> candidates;
+        int64_t offset = -1;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(fingerprint);
+            if (it != entries_.end()) {
+                std::vector<WeakObjectPtr<TensorObj>>& bucket = it->second;
+                for (size_t i = 0; i < bucket.size();) {
+                    if (ObjectPtr<TensorObj> entry = bucket[i].lock()) {
+                        Tensor candidate(std::move(entry));
+                        if (std::none_of(checked.begin(), checked.end(),
+                                         [&](const Tensor& other) { return other.same_as(candidate); })) {
+                            candidates.push_back(std::move(candidate));
+                        }
+                        ++i;
+                    } else {
+                        bucket[i] = std::move(bucket.back());
+                        bucket.pop_back();
+                    }
+                }
+                if (bucket.empty()) {
+                    entries_.erase(it);
+                }
+            }
+            if (candidates.empty()) {
+                if (written.has_value() || backing_fd_ < 0 || nbytes == 0) {
+                    Tensor canonical = written.has_value() ? *written : contiguous;
+                    entries_[fingerprint].emplace_back(
+                            details::ObjectUnsafe::ObjectPtrFromObjectRef<TensorObj>(canonical));
+                    count(false);
+                    return canonical;
+                }
+                // reserve the range, the file only grows
+                offset = (backing_size_ + kBackingAlignment - 1) / kBackingAlignment * kBackingAlignment;
+                backing_size_ = offset + nbytes;
+            }
+        }
+        for (Tensor& candidate: candidates) {
+            if (SameContent(candidate, contiguous)) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                count(true);
+                return candidate;
+            }
+            checked.push_back(std::move(candidate));
+        }
+        if (offset >= 0) {
+            written = WriteBackingFile(contiguous, offset);
+        }
+    }
+}
+
+TensorStoreObj::Stats TensorStoreObj::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+TensorStore TensorStore::Create(Optional<String> backing_file) {
+    int backing_fd = -1;
+    if (backing_file.has_value()) {
+#if defined(_WIN32)
+        TVM_FFI_THROW(RuntimeError) << "TensorStore: backing files are not supported on Windows";
+#else
+        backing_fd = open(backing_file.value().c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (backing_fd < 0) {
+            TVM_FFI_THROW(RuntimeError) << "TensorStore: cannot create " << backing_file.value() << ": "
+                                        << std::strerror(errno);
+        }
+#endif
+    }
+    return TensorStore(make_object<TensorStoreObj>(std::move(backing_file), backing_fd));
+}
+
+uint64_t TensorStore::Fingerprint(const Tensor& tensor) {
+    return FingerprintContiguous(MakeContiguous(tensor));
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+    namespace refl = litetvm::ffi::reflection;
+    refl::ObjectDef<TensorStoreObj>().def("intern", &TensorStoreObj::Intern);
+    refl::GlobalDef()
+            .def("ffi.TensorStore", [](Optional<String> backing_file) { return TensorStore::Create(backing_file); })
+            .def("ffi.TensorStoreGetStats",
+                 [](TensorStore store) {
+                     TensorStoreObj::Stats stats = store->GetStats();
+                     return Map<String, Any>{{"num_interned", stats.num_interned},
+                                             {"num_deduplicated", stats.num_deduplicated},
+                                             {"bytes_interned", stats.bytes_interned},
+                                             {"bytes_deduplicated", stats.bytes_deduplicated},
+                                             {"dedup_ratio", stats.DedupRatio()}};
+                 })
+            .def("ffi.TensorFingerprint",
+                 [](Tensor tensor) { return static_cast<int64_t>(TensorStore::Fingerprint(tensor)); });
+}
+
+}// namespace ffi
+}// namespace litetvm
@@ -11,8 +11,10 @@
 #include "ffi/container/map.h"
 #include "ffi/error.h"
 #include "ffi/memory.h"
+#include "ffi/profiler.h"
 #include "ffi/reflection/registry.h"
 #include "ffi/string.h"
+#include <string_view>
 #include <utility>
 
 namespace litetvm {
@@ -71,6 +73,7 @@ public:
                 TVM_FFI_THROW(RuntimeError) << "Global Function `" << name << "` is already registered";
             }
         }
+        Profiler::Track(name, func);
         table_.Set(name, ObjectRef(make_object<Entry>(name, func)));
     }
 
@@ -84,7 +87,9 @@ public:
                         << "Please remove the duplicate registration.";
             }
         }
-        table_.Set(name, ObjectRef(make_object<Entry>(method_info)));
+        ObjectPtr<Entry> entry = make_object<Entry>(method_info);
+        Profiler::Track(name, entry->func_data);
+        table_.Set(name, ObjectRef(std::move(entry)));
     }
 
     bool Remove(const String& name) {
@@ -94,7 +99,7 @@ public:
         return true;
     }
 
-    const Entry* Get(const String& name) {
+    const Entry* Get(std::string_view name) {
         auto it = table_.find(name);
         if (it == table_.end()) return nullptr;
         const auto* obj = (*it).second.cast<const Object*>();
@@ -164,8 +169,7 @@ int TVMFFIFunctionSetGlobalFromMethodInfo(const TVMFFIMethodInfo* method_info, i
 int TVMFFIFunctionGetGlobal(const TVMFFIByteArray* name, TVMFFIObjectHandle* out) {
     using namespace litetvm::ffi;
     TVM_FFI_SAFE_CALL_BEGIN();
-    String name_str(name->data, name->size);
-    const GlobalFunctionTable::Entry* fp = GlobalFunctionTable::Global()->Get(name_str);
+    const GlobalFunctionTable::Entry* fp = GlobalFunctionTable::Global()->Get(ToStringView(*name));
     if (fp != nullptr) {
         Function func(fp->func_data);
         *out = details::ObjectUnsafe::MoveObjectRefToTVMFFIObjectPtr(std::move(func));
@@ -208,7 +212,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
             .def("ffi.String", [](litetvm::ffi::String val) -> litetvm::ffi::String { return val; })
             .def("ffi.Bytes", [](litetvm::ffi::Bytes val) -> litetvm::ffi::Bytes { return val; })
             .def("ffi.GetGlobalFuncMetadata", [](const litetvm::ffi::String& name) -> litetvm::ffi::String {
-                const auto* f = litetvm::ffi::GlobalFunctionTable::Global()->Get(name);
+                const auto* f = litetvm::ffi::GlobalFunctionTable::Global()->Get(std::string_view(name.data(), name.size()));
                 if (f == nullptr) {
                     TVM_FFI_THROW(RuntimeError) << "Global Function is not found: " << name;
                 }
@@ -0,0 +1,344 @@
+//
+// Created by richard on 10/19/26.
+//
+// Memory-mapped tensors and the tensor file format.
+//
+// Tensor file layout, integers little endian:
+//   char[8]  magic "LTVMTENS"
+//   uint32   version
+//   uint32   number of tensors
+//   uint64   offset of the first tensor data
+//   per tensor:
+//     uint32 name length, name bytes
+//     uint8 dtype code, uint8 dtype bits, uint16 dtype lanes
+//     int32 ndim, int64 shape[ndim]
+//     uint64 data offset, uint64 data size
+//   tensor data, each starting on a kTensorFileAlignment boundary
+#include "ffi/container/mapped_file.h"
+#include "ffi/function.h"
+#include "ffi/reflection/registry.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace litetvm {
+namespace ffi {
+
+namespace {
+
+constexpr char kTensorFileMagic[8] = {'L', 'T', 'V', 'M', 'T', 'E', 'N', 'S'};
+constexpr uint32_t kTensorFileVersion = 1;
+/*! \brief Alignment of the tensor data in a tensor file, a page on common systems. */
+constexpr uint64_t kTensorFileAlignment = 4096;
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+class HeaderWriter {
+public:
+    template<typename T>
+    void Put(T value) {
+        uint64_t bits = static_cast<uint64_t>(value);
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            buffer_.push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+        }
+    }
+
+    void PutBytes(const char* data, size_t size) {
+        buffer_.append(data, size);
+    }
+
+    NODISCARD const std::string& buffer() const {
+        return buffer_;
+    }
+
+private:
+    std::string buffer_;
+};
+
+class HeaderReader {
+public:
+    HeaderReader(const char* data, size_t size, const String& path) : data_(data), size_(size), path_(path) {}
+
+    template<typename T>
+    T Get() {
+        uint64_t bits = 0;
+        const char* bytes = Take(sizeof(T));
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            bits |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[i])) << (8 * i);
+        }
+        return static_cast<T>(bits);
+    }
+
+    const char* Take(size_t size) {
+        if (size > size_ - pos_) {
+            TVM_FFI_THROW(ValueError) << "LoadTensorFile: " << path_ << " has a truncated header";
+        }
+        const char* data = data_ + pos_;
+        pos_ += size;
+        return data;
+    }
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t pos_{0};
+    const String& path_;
+};
+
+/*! \brief NDAlloc of tensors on mapped memory, the mapping outlives the tensor. */
+struct MappedNDAlloc {
+    ObjectPtr<MappedFileObj> file;
+    char* data;
+
+    void AllocData(DLTensor* tensor) {
+        tensor->data = data;
+    }
+
+    void FreeData(DLTensor*) {}
+};
+
+#if !defined(_WIN32)
+// read-faults [begin, end) of a mapping; read faults share the page cache
+// pages, where write faults on the private mapping would copy them
+void Prefault(char* base, size_t begin, size_t end) {
+#ifdef MADV_POPULATE_READ
+    if (madvise(base + begin, end - begin, MADV_POPULATE_READ) == 0) {
+        return;
+    }
+#endif
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t i = begin; i < end; i += page) {
+        static_cast<void>(*static_cast<volatile char*>(base + i));
+    }
+}
+
+// faults in the pages of a mapping in order, until done or stopped
+void ReadAhead(char* base, size_t size, const std::atomic<bool>* stop) {
+    constexpr size_t kChunk = static_cast<size_t>(1) << 21;
+    for (size_t begin = 0; begin < size && !stop->load(std::memory_order_relaxed); begin += kChunk) {
+        Prefault(base, begin, std::min(size, begin + kChunk));
+    }
+}
+#endif
+
+}// namespace
+
+MappedFileObj::~MappedFileObj() {
+    stop_read_ahead_.store(true, std::memory_order_relaxed);
+    if (read_ahead_.joinable()) {
+        read_ahead_.join();
+    }
+#if !defined(_WIN32)
+    if (base_ != nullptr) {
+        munmap(base_, mapped_size_);
+    }
+#endif
+}
+
+MappedFile MappedFile::Open(const String& path, const MapOptions& options, int64_t offset, int64_t length) {
+#if defined(_WIN32)
+    TVM_FFI_THROW(RuntimeError) << "MappedFile: mapping files is not supported on Windows";
+#else
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        TVM_FFI_THROW(RuntimeError) << "MappedFile: cannot open " << path << ": " << std::strerror(errno);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int err = errno;
+        close(fd);
+        TVM_FFI_THROW(RuntimeError) << "MappedFile: cannot stat " << path << ": " << std::strerror(err);
+    }
+    int64_t file_size = static_cast<int64_t>(st.st_size);
+    if (length < 0) {
+        length = file_size - offset;
+    }
+    if (offset < 0 || offset > file_size || length < 0 || length > file_size - offset) {
+        close(fd);
+        TVM_FFI_THROW(ValueError) << "MappedFile: range [" << offset << ", " << offset << " + " << length
+                                  << ") is not in " << path << " of " << file_size << " bytes";
+    }
+    int64_t page = static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+    int64_t map_offset = offset / page * page;
+    size_t map_size = static_cast<size_t>(offset - map_offset + length);
+    char* base = nullptr;
+    if (map_size != 0) {
+        // no MAP_POPULATE: on a writable private mapping it write-faults every
+        // page and copies the file into anonymous memory
+        void* ptr = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(map_offset));
+        if (ptr == MAP_FAILED) {
+            int err = errno;
+            close(fd);
+            TVM_FFI_THROW(RuntimeError) << "MappedFile: cannot map " << path << ": " << std::strerror(err);
+        }
+        base = static_cast<char*>(ptr);
+    }
+    close(fd);
+
+    ObjectPtr<MappedFileObj> obj = make_object<MappedFileObj>(base, map_size, static_cast<size_t>(offset - map_offset),
+                                                              static_cast<size_t>(length));
+    if (base != nullptr) {
+        static constexpr int kAdvice[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED};
+        int advice = kAdvice[static_cast<int>(options.advice)];
+        if (advice != MADV_NORMAL) {
+            // advice is a hint, failures are ignored
+            madvise(base, map_size, advice);
+        }
+        if (options.populate) {
+            Prefault(base, 0, map_size);
+        }
+        if (options.read_ahead) {
+            obj->read_ahead_ = std::thread(ReadAhead, base, map_size, &obj->stop_read_ahead_);
+        }
+    }
+    return MappedFile(obj);
+#endif
+}
+
+Tensor MappedFile::ToTensor(int64_t offset, ShapeView shape, DLDataType dtype) const {
+    const MappedFileObj* self = get();
+    size_t nbytes = ShapeOps::CheckedDataSize(shape.data(), static_cast<int32_t>(shape.size()), dtype);
+    if (offset < 0 || static_cast<size_t>(offset) > self->size() || nbytes > self->size() - offset) {
+        TVM_FFI_THROW(ValueError) << "MappedFile: " << nbytes << " bytes at offset " << offset
+                                  << " are not in the mapped " << self->size() << " bytes";
+    }
+    MappedNDAlloc alloc{details::ObjectUnsafe::ObjectPtrFromObjectRef<MappedFileObj>(*this), self->data() + offset};
+    return Tensor::FromNDAlloc(std::move(alloc), shape, dtype, DLDevice{kDLCPU, 0});
+}
+
+Tensor Tensor::LoadMapped(const String& path, int64_t offset, ShapeView shape, DLDataType dtype) {
+    return LoadMapped(path, offset, shape, dtype, MapOptions());
+}
+
+Tensor Tensor::LoadMapped(const String& path, int64_t offset, ShapeView shape, DLDataType dtype,
+                          const MapOptions& options) {
+    size_t nbytes = ShapeOps::CheckedDataSize(shape.data(), static_cast<int32_t>(shape.size()), dtype);
+    return MappedFile::Open(path, options, offset, static_cast<int64_t>(nbytes)).ToTensor(0, shape, dtype);
+}
+
+void SaveTensorFile(const String& path, const Map<String, Tensor>& tensors) {
+    std::vector<Tensor> contiguous;
+    contiguous.reserve(tensors.size());
+    HeaderWriter entries;
+    // header size first, the data offsets depend on it
+    size_t header_size = sizeof(kTensorFileMagic) + 16;
+    for (const auto& [name, tensor]: tensors) {
+        header_size += 4 + name.size() + 4 + 4 + 8 * tensor.ndim() + 16;
+    }
+    uint64_t data_begin = AlignUp(header_size, kTensorFileAlignment);
+    uint64_t offset = data_begin;
+    for (const auto& [name, tensor]: tensors) {
+        DLDevice device = tensor->device;
+        if (device.device_type != kDLCPU && device.device_type != kDLCUDAHost && device.device_type != kDLROCMHost) {
+            TVM_FFI_THROW(ValueError) << "SaveTensorFile: tensor " << name << " is not on the CPU";
+        }
+        contiguous.push_back(tensor.Contiguous());
+        DLDataType dtype = tensor.dtype();
+        entries.Put<uint32_t>(static_cast<uint32_t>(name.size()));
+        entries.PutBytes(name.data(), name.size());
+        entries.Put<uint8_t>(dtype.code);
+        entries.Put<uint8_t>(dtype.bits);
+        entries.Put<uint16_t>(dtype.lanes);
+        entries.Put<int32_t>(tensor.ndim());
+        for (int64_t dim: tensor.shape()) {
+            entries.Put<int64_t>(dim);
+        }
+        uint64_t nbytes = GetDataSize(*tensor.get());
+        entries.Put<uint64_t>(offset);
+        entries.Put<uint64_t>(nbytes);
+        offset = AlignUp(offset + nbytes, kTensorFileAlignment);
+    }
+
+    HeaderWriter header;
+    header.PutBytes(kTensorFileMagic, sizeof(kTensorFileMagic));
+    header.Put<uint32_t>(kTensorFileVersion);
+    header.Put<uint32_t>(static_cast<uint32_t>(tensors.size()));
+    header.Put<uint64_t>(data_begin);
+    header.PutBytes(entries.buffer().data(), entries.buffer().size());
+    TVM_FFI_ICHECK_EQ(header.buffer().size(), header_size);
+
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out) {
+        TVM_FFI_THROW(RuntimeError) << "SaveTensorFile: cannot open " << path;
+    }
+    const std::string padding(kTensorFileAlignment, '\0');
+    out.write(header.buffer().data(), static_cast<std::streamsize>(header_size));
+    uint64_t written = header_size;
+    for (const Tensor& tensor: contiguous) {
+        uint64_t aligned = AlignUp(written, kTensorFileAlignment);
+        out.write(padding.data(), static_cast<std::streamsize>(aligned - written));
+        uint64_t nbytes = GetDataSize(*tensor.get());
+        out.write(static_cast<const char*>(tensor->data) + tensor->byte_offset, static_cast<std::streamsize>(nbytes));
+        written = aligned + nbytes;
+    }
+    if (!out.flush()) {
+        TVM_FFI_THROW(RuntimeError) << "SaveTensorFile: cannot write " << path;
+    }
+}
+
+Map<String, Tensor> LoadTensorFile(const String& path, const MapOptions& options) {
+    MappedFile file = MappedFile::Open(path, options);
+    HeaderReader reader(file->data(), file->size(), path);
+    if (std::memcmp(reader.Take(sizeof(kTensorFileMagic)), kTensorFileMagic, sizeof(kTensorFileMagic)) != 0) {
+        TVM_FFI_THROW(ValueError) << "LoadTensorFile: " << path << " is not a tensor file";
+    }
+    uint32_t version = reader.Get<uint32_t>();
+    if (version != kTensorFileVersion) {
+        TVM_FFI_THROW(ValueError) << "LoadTensorFile: " << path << " has unsupported version " << version;
+    }
+    uint32_t num_tensors = reader.Get<uint32_t>();
+    reader.Get<uint64_t>();
+    Map<String, Tensor> tensors;
+    std::vector<int64_t> shape;
+    for (uint32_t i = 0; i < num_tensors; ++i) {
+        uint32_t name_size = reader.Get<uint32_t>();
+        String name(reader.Take(name_size), name_size);
+        DLDataType dtype;
+        dtype.code = reader.Get<uint8_t>();
+        dtype.bits = reader.Get<uint8_t>();
+        dtype.lanes = reader.Get<uint16_t>();
+        int32_t ndim = reader.Get<int32_t>();
+        if (ndim < 0 || static_cast<uint64_t>(ndim) > file->size() / 8) {
+            TVM_FFI_THROW(ValueError) << "LoadTensorFile: tensor " << name << " in " << path << " has rank " << ndim;
+        }
+        shape.resize(ndim);
+        for (int64_t& dim: shape) {
+            dim = reader.Get<int64_t>();
+        }
+        uint64_t offset = reader.Get<uint64_t>();
+        uint64_t nbytes = reader.Get<uint64_t>();
+        if (nbytes != ShapeOps::CheckedDataSize(shape.data(), ndim, dtype) || offset > file->size()) {
+            TVM_FFI_THROW(ValueError) << "LoadTensorFile: tensor " << name << " in " << path
+                                      << " does not match its data";
+        }
+        tensors.Set(name, file.ToTensor(static_cast<int64_t>(offset), ShapeView(shape.data(), ndim), dtype));
+    }
+    return tensors;
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+    namespace refl = litetvm::ffi::reflection;
+    refl::GlobalDef()
+            .def("ffi.TensorLoadMapped",
+                 [](String path, int64_t offset, Shape shape, DLDataType dtype) {
+                     return Tensor::LoadMapped(path, offset, shape, dtype);
+                 })
+            .def("ffi.SaveTensorFile",
+                 [](String path, Map<String, Tensor> tensors) { SaveTensorFile(path, tensors); })
+            .def("ffi.LoadTensorFile", [](String path) { return LoadTensorFile(path); });
+}
+
+}// namespace ffi
+}// namespace litetvm
@@ -163,9 +163,8 @@ public:
     }
 
     int32_t TypeKeyToIndex(const TVMFFIByteArray* type_key) {
-        String type_key_str(type_key->data, type_key->size);
-        auto it = type_key2index_.find(type_key_str);
-        TVM_FFI_ICHECK(it != type_key2index_.end()) << "Cannot find type `" << type_key_str << "`";
+        auto it = type_key2index_.find(*type_key);
+        TVM_FFI_ICHECK(it != type_key2index_.end()) << "Cannot find type `" << ToStringView(*type_key) << "`";
         return static_cast<int32_t>((*it).second);
     }
 
@@ -251,8 +250,7 @@ public:
     }
 
     const TVMFFITypeAttrColumn* GetTypeAttrColumn(const TVMFFIByteArray* name) const {
-        String name_str(*name);
-        auto it = type_attr_name_to_column_index_.find(name_str);
+        auto it = type_attr_name_to_column_index_.find(*name);
         if (it == type_attr_name_to_column_index_.end()) return nullptr;
         return type_attr_columns_[(*it).second].get();
     }
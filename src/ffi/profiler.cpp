@@ -0,0 +1,458 @@
+//
+// Created by richard on 10/18/26.
+//
+#include "ffi/profiler.h"
+
+#include "ffi/any.h"
+#include "ffi/c_api.h"
+#include "ffi/cast.h"
+#include "ffi/container/array.h"
+#include "ffi/container/map.h"
+#include "ffi/error.h"
+#include "ffi/function.h"
+#include "ffi/reflection/registry.h"
+#include "ffi/string.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace litetvm {
+namespace ffi {
+namespace {
+
+// constant initialized so it is usable during static initialization
+std::atomic<bool> profiler_enabled{false};
+
+TVM_FFI_INLINE uint64_t NowNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+}
+
+// Counters are only written by the owner thread, relaxed load + store is enough
+// and avoids a locked read-modify-write on the hot path.
+TVM_FFI_INLINE void Bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+/*!
+ * \brief Log-linear latency histogram in the spirit of HdrHistogram.
+ *
+ * Values below kNumLinear get an exact bucket. Larger values are bucketed by
+ * their highest set bit and the next kSubBits bits, which bounds the relative
+ * error of a bucket to 1 / 2^kSubBits.
+ */
+struct LatencyHistogram {
+    static constexpr int kSubBits = 3;
+    static constexpr int kNumSub = 1 << kSubBits;
+    static constexpr int kNumLinear = 2 * kNumSub;
+    static constexpr int kLinearExp = kSubBits + 1;
+    static constexpr int kNumBuckets = kNumLinear + (64 - kLinearExp) * kNumSub;
+
+    static int BucketIndex(uint64_t value) {
+        if (value < static_cast<uint64_t>(kNumLinear)) {
+            return static_cast<int>(value);
+        }
+        int exp = 63 - std::countl_zero(value);
+        int sub = static_cast<int>((value >> (exp - kSubBits)) & (kNumSub - 1));
+        return kNumLinear + (exp - kLinearExp) * kNumSub + sub;
+    }
+
+    static uint64_t BucketUpperBound(int index) {
+        if (index < kNumLinear) {
+            return static_cast<uint64_t>(index);
+        }
+        int exp = (index - kNumLinear) / kNumSub + kLinearExp;
+        uint64_t sub = static_cast<uint64_t>((index - kNumLinear) % kNumSub);
+        uint64_t width = static_cast<uint64_t>(1) << (exp - kSubBits);
+        uint64_t lower = (static_cast<uint64_t>(kNumSub) + sub) * width;
+        return lower + (width - 1);
+    }
+};
+
+/*! \brief Counters of one call site, owned by a single thread. */
+struct SiteCounters {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> arg_ns{0};
+    std::atomic<uint64_t> body_ns{0};
+    std::atomic<uint64_t> min_ns{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> max_ns{0};
+    std::atomic<uint64_t> buckets[LatencyHistogram::kNumBuckets] = {};
+
+    void Record(uint64_t total, uint64_t arg) {
+        Bump(count, 1);
+        Bump(total_ns, total);
+        Bump(arg_ns, arg);
+        Bump(body_ns, total - arg);
+        if (total < min_ns.load(std::memory_order_relaxed)) {
+            min_ns.store(total, std::memory_order_relaxed);
+        }
+        if (total > max_ns.load(std::memory_order_relaxed)) {
+            max_ns.store(total, std::memory_order_relaxed);
+        }
+        Bump(buckets[LatencyHistogram::BucketIndex(total)], 1);
+    }
+
+    void Clear() {
+        count.store(0, std::memory_order_relaxed);
+        total_ns.store(0, std::memory_order_relaxed);
+        arg_ns.store(0, std::memory_order_relaxed);
+        body_ns.store(0, std::memory_order_relaxed);
+        min_ns.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+        for (auto& bucket: buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+/*! \brief Plain accumulator used when merging counters on read. */
+struct SiteSummary {
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t arg_ns = 0;
+    uint64_t body_ns = 0;
+    uint64_t min_ns = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ns = 0;
+    std::vector<uint64_t> buckets = std::vector<uint64_t>(LatencyHistogram::kNumBuckets, 0);
+
+    void Merge(const SiteCounters& other) {
+        count += other.count.load(std::memory_order_relaxed);
+        total_ns += other.total_ns.load(std::memory_order_relaxed);
+        arg_ns += other.arg_ns.load(std::memory_order_relaxed);
+        body_ns += other.body_ns.load(std::memory_order_relaxed);
+        min_ns = std::min(min_ns, other.min_ns.load(std::memory_order_relaxed));
+        max_ns = std::max(max_ns, other.max_ns.load(std::memory_order_relaxed));
+        for (int i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+            buckets[i] += other.buckets[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    void Merge(const SiteSummary& other) {
+        count += other.count;
+        total_ns += other.total_ns;
+        arg_ns += other.arg_ns;
+        body_ns += other.body_ns;
+        min_ns = std::min(min_ns, other.min_ns);
+        max_ns = std::max(max_ns, other.max_ns);
+        for (int i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+            buckets[i] += other.buckets[i];
+        }
+    }
+
+    NODISCARD uint64_t Percentile(double q) const {
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count));
+        uint64_t seen = 0;
+        for (int i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+            seen += buckets[i];
+            if (seen > rank) {
+                return std::min(LatencyHistogram::BucketUpperBound(i), max_ns);
+            }
+        }
+        return max_ns;
+    }
+};
+
+/*! \brief In-flight profiled call, used to split argument conversion from body time. */
+struct CallFrame {
+    CallFrame* parent;
+    uint64_t start_ns;
+    uint64_t args_done_ns;
+};
+
+thread_local CallFrame* current_frame = nullptr;
+
+}// namespace
+
+/*!
+ * \brief Global state of the function profiler.
+ *
+ * Each thread owns a ThreadStats block that holds counters of the call sites it touched.
+ * The blocks are registered here so that Report can merge them, the counters of exited
+ * threads are folded into retired_.
+ */
+class FunctionProfiler {
+public:
+    struct ThreadStats {
+        uint64_t epoch = 0;
+        std::vector<std::unique_ptr<SiteCounters>> sites;
+
+        ThreadStats() {
+            FunctionProfiler::Global()->AddThread(this);
+        }
+
+        ~ThreadStats() {
+            FunctionProfiler::Global()->RemoveThread(this);
+        }
+    };
+
+    int32_t GetOrAllocSite(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = site_index_.find(name);
+        if (it != site_index_.end()) {
+            return it->second;
+        }
+        int32_t site = static_cast<int32_t>(site_names_.size());
+        site_names_.push_back(name);
+        site_index_.emplace(name, site);
+        return site;
+    }
+
+    /*! \brief Record the calls of func under the given name, from now on. */
+    void Track(const std::string& name, FunctionObj* func) {
+        func->profile_site_.store(GetOrAllocSite(name), std::memory_order_relaxed);
+    }
+
+    static int32_t SiteOf(const FunctionObj* func) {
+        return func->profile_site_.load(std::memory_order_relaxed);
+    }
+
+    void Record(int32_t site, uint64_t total_ns, uint64_t arg_ns) {
+        thread_local ThreadStats stats;
+        uint64_t epoch = epoch_.load(std::memory_order_acquire);
+        if (stats.epoch != epoch || static_cast<size_t>(site) >= stats.sites.size() ||
+            stats.sites[site] == nullptr) {
+            // slow path: the layout of the block changes, so synchronize with readers
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stats.epoch != epoch) {
+                for (auto& counters: stats.sites) {
+                    if (counters != nullptr) counters->Clear();
+                }
+                stats.epoch = epoch;
+            }
+            if (static_cast<size_t>(site) >= stats.sites.size()) {
+                stats.sites.resize(site + 1);
+            }
+            if (stats.sites[site] == nullptr) {
+                stats.sites[site] = std::make_unique<SiteCounters>();
+            }
+        }
+        stats.sites[site]->Record(total_ns, arg_ns);
+    }
+
+    void Start() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired_.clear();
+        epoch_.fetch_add(1, std::memory_order_acq_rel);
+        profiler_enabled.store(true, std::memory_order_release);
+    }
+
+    void Stop() {
+        profiler_enabled.store(false, std::memory_order_release);
+    }
+
+    Map<String, Any> Report() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t epoch = epoch_.load(std::memory_order_acquire);
+        std::vector<SiteSummary> summary(site_names_.size());
+        for (const auto& [site, retired]: retired_) {
+            summary[site].Merge(retired);
+        }
+        for (const ThreadStats* stats: threads_) {
+            if (stats->epoch != epoch) continue;
+            for (size_t site = 0; site < stats->sites.size(); ++site) {
+                if (stats->sites[site] != nullptr) {
+                    summary[site].Merge(*stats->sites[site]);
+                }
+            }
+        }
+
+        Map<String, Any> result;
+        for (size_t site = 0; site < summary.size(); ++site) {
+            const SiteSummary& s = summary[site];
+            if (s.count == 0) continue;
+            Array<Any> histogram;
+            for (int i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+                if (s.buckets[i] == 0) continue;
+                histogram.push_back(Array<int64_t>{static_cast<int64_t>(LatencyHistogram::BucketUpperBound(i)),
+                                                   static_cast<int64_t>(s.buckets[i])});
+            }
+            Map<String, Any> entry;
+            entry.Set("count", static_cast<int64_t>(s.count));
+            entry.Set("total_ns", static_cast<int64_t>(s.total_ns));
+            entry.Set("arg_conversion_ns", static_cast<int64_t>(s.arg_ns));
+            entry.Set("body_ns", static_cast<int64_t>(s.body_ns));
+            entry.Set("min_ns", static_cast<int64_t>(s.min_ns));
+            entry.Set("max_ns", static_cast<int64_t>(s.max_ns));
+            entry.Set("mean_ns", static_cast<double>(s.total_ns) / static_cast<double>(s.count));
+            entry.Set("p50_ns", static_cast<int64_t>(s.Percentile(0.5)));
+            entry.Set("p90_ns", static_cast<int64_t>(s.Percentile(0.9)));
+            entry.Set("p99_ns", static_cast<int64_t>(s.Percentile(0.99)));
+            entry.Set("histogram", histogram);
+            result.Set(String(site_names_[site]), entry);
+        }
+        return result;
+    }
+
+    static FunctionProfiler* Global() {
+        // deliberately leaked, thread local stats may be released after static destruction
+        static FunctionProfiler* inst = new FunctionProfiler();
+        return inst;
+    }
+
+private:
+    void AddThread(ThreadStats* stats) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        threads_.push_back(stats);
+    }
+
+    void RemoveThread(ThreadStats* stats) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        threads_.erase(std::remove(threads_.begin(), threads_.end(), stats), threads_.end());
+        if (stats->epoch != epoch_.load(std::memory_order_acquire)) return;
+        for (size_t site = 0; site < stats->sites.size(); ++site) {
+            if (stats->sites[site] != nullptr) {
+                retired_[static_cast<int32_t>(site)].Merge(*stats->sites[site]);
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    std::atomic<uint64_t> epoch_{0};
+    std::vector<std::string> site_names_;
+    std::unordered_map<std::string, int32_t> site_index_;
+    std::vector<ThreadStats*> threads_;
+    std::unordered_map<int32_t, SiteSummary> retired_;
+};
+
+namespace {
+
+/*! \brief Records one profiled call when it goes out of scope, including on exception. */
+class ProfiledCallScope {
+public:
+    explicit ProfiledCallScope(int32_t site) : site_(site) {
+        frame_.parent = current_frame;
+        frame_.args_done_ns = 0;
+        current_frame = &frame_;
+        frame_.start_ns = NowNanos();
+    }
+
+    ~ProfiledCallScope() {
+        uint64_t end_ns = NowNanos();
+        current_frame = frame_.parent;
+        uint64_t arg_ns = frame_.args_done_ns != 0 ? frame_.args_done_ns - frame_.start_ns : 0;
+        FunctionProfiler::Global()->Record(site_, end_ns - frame_.start_ns, arg_ns);
+    }
+
+private:
+    int32_t site_;
+    CallFrame frame_{};
+};
+
+/*!
+ * \brief Function that records the calls of the wrapped function.
+ *
+ * Both calling conventions are forwarded as is, so a function only reachable
+ * through safe_call (e.g. one returning Expected) keeps reporting errors
+ * through the return code instead of throwing.
+ */
+class ProfiledFunctionObj : public FunctionObj {
+public:
+    ProfiledFunctionObj(Function func, int32_t site) : func_(std::move(func)), site_(site) {
+        this->safe_call = SafeCall;
+        this->cpp_call = Inner()->cpp_call != nullptr ? reinterpret_cast<void*>(CppCall) : nullptr;
+    }
+
+private:
+    const FunctionObj* Inner() const {
+        return static_cast<const FunctionObj*>(func_.get());
+    }
+
+    static void CppCall(const FunctionObj* func, const AnyView* args, int32_t num_args, Any* rv) {
+        const auto* self = static_cast<const ProfiledFunctionObj*>(func);
+        auto inner_call = reinterpret_cast<FCall>(self->Inner()->cpp_call);
+        if (!details::ProfilerEnabled()) {
+            inner_call(self->Inner(), args, num_args, rv);
+            return;
+        }
+        ProfiledCallScope scope(self->site_);
+        inner_call(self->Inner(), args, num_args, rv);
+    }
+
+    static int SafeCall(void* func, const TVMFFIAny* args, int32_t num_args, TVMFFIAny* rv) {
+        const auto* self = static_cast<const ProfiledFunctionObj*>(static_cast<FunctionObj*>(func));
+        FunctionObj* inner = const_cast<FunctionObj*>(self->Inner());
+        if (!details::ProfilerEnabled()) {
+            return inner->safe_call(inner, args, num_args, rv);
+        }
+        ProfiledCallScope scope(self->site_);
+        return inner->safe_call(inner, args, num_args, rv);
+    }
+
+    Function func_;
+    int32_t site_;
+};
+
+Function WrapFunction(const std::string& name, Function func) {
+    int32_t site = FunctionProfiler::Global()->GetOrAllocSite(name);
+    return details::ObjectUnsafe::ObjectRefFromObjectPtr<Function>(
+            make_object<ProfiledFunctionObj>(std::move(func), site));
+}
+
+}// namespace
+
+namespace details {
+
+bool ProfilerEnabled() {
+    return profiler_enabled.load(std::memory_order_relaxed);
+}
+
+void ProfiledCppCall(FunctionObj::FCall call, const FunctionObj* func, const AnyView* args, int32_t num_args,
+                     Any* result) {
+    ProfiledCallScope scope(FunctionProfiler::SiteOf(func));
+    call(func, args, num_args, result);
+}
+
+int ProfiledSafeCall(TVMFFISafeCallType call, void* func, const TVMFFIAny* args, int32_t num_args,
+                     TVMFFIAny* result) {
+    ProfiledCallScope scope(FunctionProfiler::SiteOf(static_cast<const FunctionObj*>(func)));
+    return call(func, args, num_args, result);
+}
+
+}// namespace details
+}// namespace ffi
+}// namespace litetvm
+
+void TVMFFIProfilerMarkArgsConverted() {
+    using namespace litetvm::ffi;
+    // only the first mark counts, nested typed calls in the body must not move it
+    if (current_frame != nullptr && current_frame->args_done_ns == 0) {
+        current_frame->args_done_ns = NowNanos();
+    }
+}
+
+int TVMFFIProfilerWrapFunction(const TVMFFIByteArray* name, TVMFFIObjectHandle func,
+                               TVMFFIObjectHandle* out) {
+    using namespace litetvm::ffi;
+    TVM_FFI_SAFE_CALL_BEGIN();
+    Function f = GetRef<Function>(static_cast<FunctionObj*>(func));
+    Function wrapped = WrapFunction(std::string(name->data, name->size), std::move(f));
+    *out = details::ObjectUnsafe::MoveObjectRefToTVMFFIObjectPtr(std::move(wrapped));
+    TVM_FFI_SAFE_CALL_END();
+}
+
+int TVMFFIProfilerTrackFunction(const TVMFFIByteArray* name, TVMFFIObjectHandle func) {
+    using namespace litetvm::ffi;
+    TVM_FFI_SAFE_CALL_BEGIN();
+    FunctionProfiler::Global()->Track(std::string(name->data, name->size), static_cast<FunctionObj*>(func));
+    TVM_FFI_SAFE_CALL_END();
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+    namespace refl = litetvm::ffi::reflection;
+    using litetvm::ffi::FunctionProfiler;
+    refl::GlobalDef()
+            .def("ffi.Profiler.Start", []() { FunctionProfiler::Global()->Start(); })
+            .def("ffi.Profiler.Stop", []() { FunctionProfiler::Global()->Stop(); })
+            .def("ffi.Profiler.Report", []() { return FunctionProfiler::Global()->Report(); });
+}
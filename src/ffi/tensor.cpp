@@ -10,12 +10,32 @@
 namespace litetvm {
 namespace ffi {
 
+namespace details {
+ObjectPtr<ShapeObj> ShapeInternCache::Intern(ShapeView shape) {
+    static thread_local ObjectPtr<ShapeObj> slots[kNumSlots];
+    uint64_t hash = shape.size();
+    for (int64_t dim: shape) {
+        hash = (hash ^ static_cast<uint64_t>(dim)) * 0x9e3779b97f4a7c15ULL;
+    }
+    ObjectPtr<ShapeObj>& slot = slots[hash >> (64 - kSlotBits)];
+    if (slot == nullptr || slot->size != shape.size() || !std::equal(shape.begin(), shape.end(), slot->data)) {
+        slot = MakeInplaceShape(shape.begin(), shape.end());
+    }
+    return slot;
+}
+}// namespace details
+
 // Shape
 TVM_FFI_STATIC_INIT_BLOCK() {
     namespace refl = litetvm::ffi::reflection;
     refl::GlobalDef().def_packed("ffi.Shape", [](ffi::PackedArgs args, Any* ret) {
-        int64_t* mutable_data;
-        ObjectPtr<ShapeObj> shape = details::MakeEmptyShape(args.size(), &mutable_data);
+        constexpr int kMaxInternRank = static_cast<int>(details::SmallShapeObjAllocator::kMaxPooledRank);
+        int64_t small_data[kMaxInternRank];
+        int64_t* mutable_data = small_data;
+        ObjectPtr<ShapeObj> shape;
+        if (args.size() > kMaxInternRank) {
+            shape = details::MakeEmptyShape(args.size(), &mutable_data);
+        }
         for (int i = 0; i < args.size(); ++i) {
             if (auto opt_int = args[i].try_cast<int64_t>()) {
                 mutable_data[i] = *opt_int;
@@ -23,9 +43,33 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                 TVM_FFI_THROW(ValueError) << "Expect shape to take list of int arguments";
             }
         }
+        // small shapes repeat a lot, share them through the interning cache
+        if (shape == nullptr) {
+            *ret = Shape::Intern(ShapeView(small_data, args.size()));
+            return;
+        }
         *ret = details::ObjectUnsafe::ObjectRefFromObjectPtr<Shape>(shape);
     });
 }
+
+// Tensor views
+TVM_FFI_STATIC_INIT_BLOCK() {
+    namespace refl = litetvm::ffi::reflection;
+    refl::GlobalDef()
+            .def("ffi.TensorCreateView",
+                 [](Tensor tensor, Shape shape, DLDataType dtype, int64_t relative_byte_offset) {
+                     return tensor.CreateView(shape, dtype, relative_byte_offset);
+                 })
+            .def("ffi.TensorSlice",
+                 [](Tensor tensor, int64_t dim, int64_t begin, int64_t end, int64_t step) {
+                     return tensor.Slice(dim, begin, end, step);
+                 })
+            .def("ffi.TensorReshape", [](Tensor tensor, Shape shape) { return tensor.Reshape(shape); })
+            .def("ffi.TensorPermute", [](Tensor tensor, Shape dims) { return tensor.Permute(dims); })
+            .def("ffi.TensorAsStrided", [](Tensor tensor, Shape shape, Shape strides, int64_t storage_offset) {
+                return tensor.AsStrided(shape, strides, storage_offset);
+            });
+}
 }// namespace ffi
 }// namespace litetvm
 
@@ -0,0 +1,486 @@
+//
+// Created by richard on 10/19/26.
+//
+// Copy of CPU tensors between strided layouts, with dtype conversion.
+//
+// The loops of a copy are the dims of the destination ordered by decreasing stride, with
+// extent-1 dims dropped and neighbours that are contiguous in both tensors merged. The
+// innermost loop runs a row kernel picked by dtype, which turns contiguous rows into
+// memcpy and broadcast rows into fills. When the innermost loop is strided in the source
+// but the next one is contiguous, a transpose, rows are copied in square tiles so both
+// sides stay in cache. Copies of at least kParallelMinBytes split the outer loops over
+// ThreadPool::Global.
+#include "ffi/container/tensor.h"
+#include "ffi/function.h"
+#include "ffi/memory.h"
+#include "ffi/reflection/registry.h"
+#include "ffi/thread_pool.h"
+
+#include "cpu_util.h"
+#include "dtype_convert.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace litetvm {
+namespace ffi {
+
+namespace {
+
+/*! \brief Copies of at least this many bytes run in parallel. */
+constexpr int64_t kParallelMinBytes = static_cast<int64_t>(1) << 20;
+/*! \brief Smallest share of a parallel copy given to one thread. */
+constexpr int64_t kMinChunkBytes = static_cast<int64_t>(1) << 18;
+/*! \brief Edge of the tiles of transposed copies, in elements. */
+constexpr int64_t kTile = 32;
+
+// storage types of the dtypes without a C++ counterpart
+struct Bool {
+    uint8_t value;
+};
+struct Half {
+    uint16_t bits;
+};
+struct BFloat16 {
+    uint16_t bits;
+};
+struct Bytes16 {
+    uint64_t words[2];
+};
+template<uint8_t kCode>
+struct Float8 {
+    uint8_t bits;
+};
+
+// Load converts a stored element to an arithmetic value, Store converts back
+template<typename T>
+struct Elem {
+    static T Load(T value) { return value; }
+    template<typename V>
+    static T Store(V value) {
+        if constexpr (std::is_integral_v<T> && std::is_floating_point_v<V>) {
+            // casting NaN or an out of range float to an integer is undefined, saturate instead
+            // the upper limit is a power of two so it is exact in V, unlike max()
+            constexpr V kUpper = static_cast<V>(std::numeric_limits<T>::max() / 2 + 1) * 2;
+            if (std::isnan(value)) return 0;
+            if (value >= kUpper) return std::numeric_limits<T>::max();
+            if (value <= static_cast<V>(std::numeric_limits<T>::min())) return std::numeric_limits<T>::min();
+        }
+        return static_cast<T>(value);
+    }
+};
+
+template<>
+struct Elem<Bool> {
+    static bool Load(Bool value) { return value.value != 0; }
+    template<typename V>
+    static Bool Store(V value) { return Bool{static_cast<uint8_t>(value != 0)}; }
+};
+
+template<>
+struct Elem<Half> {
+    static float Load(Half value) { return details::HalfToFloat(value.bits); }
+    template<typename V>
+    static Half Store(V value) { return Half{details::FloatToHalf(static_cast<float>(value))}; }
+};
+
+template<>
+struct Elem<BFloat16> {
+    static float Load(BFloat16 value) { return details::BFloat16ToFloat(value.bits); }
+    template<typename V>
+    static BFloat16 Store(V value) { return BFloat16{details::FloatToBFloat16(static_cast<float>(value))}; }
+};
+
+// values that are not float are rounded to odd on the way, so they round once
+template<uint8_t kCode>
+struct Elem<Float8<kCode>> {
+    static float Load(Float8<kCode> value) { return details::kSmallFloatTable<kCode>[value.bits]; }
+    template<typename V>
+    static Float8<kCode> Store(V value) {
+        if constexpr (std::is_same_v<V, float>) {
+            return Float8<kCode>{details::FloatToSmallFloat<kCode>(value)};
+        } else {
+            return Float8<kCode>{details::FloatToSmallFloat<kCode>(details::RoundToOddFloat(static_cast<double>(value)))};
+        }
+    }
+};
+
+/*!
+ * \brief Copy a row of n elements.
+ * \param dst The first destination element.
+ * \param src The first source element.
+ * \param n The number of elements.
+ * \param dst_stride The destination stride in bytes.
+ * \param src_stride The source stride in bytes, 0 broadcasts the first element.
+ * \param elem_bytes The element size, used by the kernels that are not typed.
+ */
+using RowKernel = void (*)(char* dst, const char* src, int64_t n, int64_t dst_stride, int64_t src_stride,
+                           int64_t elem_bytes);
+
+// elements are moved with memcpy, the tensors need not be aligned to the element type
+template<typename T>
+void CopyRow(char* dst, const char* src, int64_t n, int64_t dst_stride, int64_t src_stride, int64_t) {
+    constexpr int64_t kBytes = sizeof(T);
+    if (dst_stride == kBytes && src_stride == kBytes) {
+        std::memcpy(dst, src, n * kBytes);
+    } else if (src_stride == 0) {
+        T value;
+        std::memcpy(&value, src, kBytes);
+        if (dst_stride == kBytes) {
+            for (int64_t i = 0; i < n; ++i) {
+                std::memcpy(dst + i * kBytes, &value, kBytes);
+            }
+        } else {
+            for (int64_t i = 0; i < n; ++i) {
+                std::memcpy(dst + i * dst_stride, &value, kBytes);
+            }
+        }
+    } else if (dst_stride == kBytes) {
+        for (int64_t i = 0; i < n; ++i) {
+            std::memcpy(dst + i * kBytes, src + i * src_stride, kBytes);
+        }
+    } else {
+        for (int64_t i = 0; i < n; ++i) {
+            std::memcpy(dst + i * dst_stride, src + i * src_stride, kBytes);
+        }
+    }
+}
+
+void CopyRowBytes(char* dst, const char* src, int64_t n, int64_t dst_stride, int64_t src_stride,
+                  int64_t elem_bytes) {
+    if (dst_stride == elem_bytes && src_stride == elem_bytes) {
+        std::memcpy(dst, src, n * elem_bytes);
+        return;
+    }
+    for (int64_t i = 0; i < n; ++i) {
+        std::memcpy(dst + i * dst_stride, src + i * src_stride, elem_bytes);
+    }
+}
+
+template<typename D, typename S>
+TVM_FFI_INLINE void ConvertElem(char* dst, const char* src) {
+    S value;
+    std::memcpy(&value, src, sizeof(S));
+    D result = Elem<D>::Store(Elem<S>::Load(value));
+    std::memcpy(dst, &result, sizeof(D));
+}
+
+/*! \brief Kernel of contiguous rows converting S to D, if vectorized. */
+using VectorRow = void (*)(void* dst, const void* src, int64_t n);
+
+template<typename D, typename S>
+constexpr VectorRow kVectorRow = nullptr;
+template<>
+constexpr VectorRow kVectorRow<Half, float> = details::FloatToHalfRow;
+template<>
+constexpr VectorRow kVectorRow<float, Half> = details::HalfToFloatRow;
+template<>
+constexpr VectorRow kVectorRow<BFloat16, float> = details::FloatToBFloat16Row;
+template<>
+constexpr VectorRow kVectorRow<float, BFloat16> = details::BFloat16ToFloatRow;
+
+template<typename D, typename S>
+void ConvertRow(char* dst, const char* src, int64_t n, int64_t dst_stride, int64_t src_stride, int64_t) {
+    if (src_stride == 0) {
+        char value[sizeof(D)];
+        ConvertElem<D, S>(value, src);
+        CopyRow<D>(dst, value, n, dst_stride, 0, sizeof(D));
+    } else if (dst_stride == sizeof(D) && src_stride == sizeof(S)) {
+        if constexpr (kVectorRow<D, S> != nullptr) {
+            kVectorRow<D, S>(dst, src, n);
+        } else {
+            for (int64_t i = 0; i < n; ++i) {
+                ConvertElem<D, S>(dst + i * sizeof(D), src + i * sizeof(S));
+            }
+        }
+    } else {
+        for (int64_t i = 0; i < n; ++i) {
+            ConvertElem<D, S>(dst + i * dst_stride, src + i * src_stride);
+        }
+    }
+}
+
+using ConvertTypes =
+        std::tuple<Bool, int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t, Half, float, double,
+                   BFloat16, Float8<kDLFloat8_e3m4>, Float8<kDLFloat8_e4m3>, Float8<kDLFloat8_e4m3b11fnuz>,
+                   Float8<kDLFloat8_e4m3fn>, Float8<kDLFloat8_e4m3fnuz>, Float8<kDLFloat8_e5m2>,
+                   Float8<kDLFloat8_e5m2fnuz>, Float8<kDLFloat8_e8m0fnu>>;
+constexpr size_t kNumConvertTypes = std::tuple_size_v<ConvertTypes>;
+
+/*! \return The index of the dtype in ConvertTypes, -1 if it cannot be converted. */
+int ConvertTypeIndex(DLDataType dtype) {
+    auto log2_bytes = [](int bits) {
+        switch (bits) {
+            case 8:
+                return 0;
+            case 16:
+                return 1;
+            case 32:
+                return 2;
+            case 64:
+                return 3;
+            default:
+                return -1;
+        }
+    };
+    int index = log2_bytes(dtype.bits);
+    switch (dtype.code) {
+        case kDLBool:
+            return dtype.bits == 8 ? 0 : -1;
+        case kDLInt:
+            return index < 0 ? -1 : 1 + index;
+        case kDLUInt:
+            return index < 0 ? -1 : 5 + index;
+        case kDLFloat:
+            return index < 1 ? -1 : 8 + index;
+        case kDLBfloat:
+            return dtype.bits == 16 ? 12 : -1;
+        case kDLFloat8_e3m4:
+        case kDLFloat8_e4m3:
+        case kDLFloat8_e4m3b11fnuz:
+        case kDLFloat8_e4m3fn:
+        case kDLFloat8_e4m3fnuz:
+        case kDLFloat8_e5m2:
+        case kDLFloat8_e5m2fnuz:
+        case kDLFloat8_e8m0fnu:
+            return dtype.bits == 8 ? 13 + (dtype.code - kDLFloat8_e3m4) : -1;
+        default:
+            return -1;
+    }
+}
+
+template<size_t... Is>
+constexpr std::array<RowKernel, sizeof...(Is)> MakeConvertKernels(std::index_sequence<Is...>) {
+    return {&ConvertRow<std::tuple_element_t<Is / kNumConvertTypes, ConvertTypes>,
+                        std::tuple_element_t<Is % kNumConvertTypes, ConvertTypes>>...};
+}
+
+// indexed by dst type * kNumConvertTypes + src type
+constexpr std::array<RowKernel, kNumConvertTypes * kNumConvertTypes> kConvertKernels =
+        MakeConvertKernels(std::make_index_sequence<kNumConvertTypes * kNumConvertTypes>());
+
+RowKernel SameTypeKernel(int64_t elem_bytes) {
+    switch (elem_bytes) {
+        case 1:
+            return CopyRow<uint8_t>;
+        case 2:
+            return CopyRow<uint16_t>;
+        case 4:
+            return CopyRow<uint32_t>;
+        case 8:
+            return CopyRow<uint64_t>;
+        case 16:
+            return CopyRow<Bytes16>;
+        default:
+            return CopyRowBytes;
+    }
+}
+
+/*! \brief A loop of a copy, strides in bytes. */
+struct CopyDim {
+    int64_t size;
+    int64_t dst_stride;
+    int64_t src_stride;
+};
+
+std::vector<int64_t> StridesOf(const DLTensor& tensor) {
+    if (tensor.strides != nullptr) {
+        return std::vector<int64_t>(tensor.strides, tensor.strides + tensor.ndim);
+    }
+    std::vector<int64_t> strides(tensor.ndim);
+    ShapeOps::FillContiguousStrides(tensor.shape, tensor.ndim, strides.data());
+    return strides;
+}
+
+void CopyTensor(const DLTensor& src, const DLTensor& dst) {
+    if (!details::IsCPUAccessible(src.device) || !details::IsCPUAccessible(dst.device)) {
+        TVM_FFI_THROW(ValueError) << "CopyTo: only CPU tensors are supported, got device types "
+                                  << src.device.device_type << " and " << dst.device.device_type;
+    }
+    ShapeView src_shape(src.shape, src.ndim);
+    ShapeView dst_shape(dst.shape, dst.ndim);
+    bool same_shape = src.ndim == dst.ndim && std::equal(src_shape.begin(), src_shape.end(), dst_shape.begin());
+    if (!same_shape) {
+        bool broadcast = src.ndim <= dst.ndim;
+        for (int32_t i = 0; broadcast && i < src.ndim; ++i) {
+            int64_t extent = src.shape[src.ndim - 1 - i];
+            broadcast = extent == 1 || extent == dst.shape[dst.ndim - 1 - i];
+        }
+        if (!broadcast) {
+            TVM_FFI_THROW(ValueError) << "CopyTo: shape " << src_shape << " cannot be broadcast to " << dst_shape;
+        }
+    }
+    if (ShapeOps::CheckedNumel(dst.shape, dst.ndim) == 0) {
+        return;
+    }
+    char* dst_data = static_cast<char*>(dst.data) + dst.byte_offset;
+    const char* src_data = static_cast<const char*>(src.data) + src.byte_offset;
+
+    // element sizes and the row kernel, vectors are split into lanes when converted
+    int64_t dst_elem, src_elem, lanes = 1;
+    RowKernel kernel;
+    if (src.dtype == dst.dtype) {
+        int64_t bits = static_cast<int64_t>(src.dtype.bits) * src.dtype.lanes;
+        if (bits % 8 != 0) {
+            if (same_shape && ffi::IsContiguous(src) && ffi::IsContiguous(dst)) {
+                std::memcpy(dst_data, src_data, GetDataSize(dst));
+                return;
+            }
+            TVM_FFI_THROW(ValueError) << "CopyTo: sub-byte dtype " << src.dtype
+                                      << " can only be copied between contiguous tensors of the same shape";
+        }
+        dst_elem = src_elem = bits / 8;
+        kernel = SameTypeKernel(dst_elem);
+    } else {
+        int dst_index = ConvertTypeIndex(dst.dtype);
+        int src_index = ConvertTypeIndex(src.dtype);
+        if (dst_index < 0 || src_index < 0 || src.dtype.lanes != dst.dtype.lanes) {
+            TVM_FFI_THROW(ValueError) << "CopyTo: cannot convert " << src.dtype << " to " << dst.dtype;
+        }
+        dst_elem = dst.dtype.bits / 8;
+        src_elem = src.dtype.bits / 8;
+        lanes = src.dtype.lanes;
+        kernel = kConvertKernels[dst_index * kNumConvertTypes + src_index];
+    }
+
+    std::vector<int64_t> dst_strides = StridesOf(dst);
+    std::vector<int64_t> src_strides = StridesOf(src);
+    std::vector<CopyDim> dims;
+    dims.reserve(dst.ndim + 1);
+    for (int32_t i = 0; i < dst.ndim; ++i) {
+        if (dst.shape[i] == 1) {
+            continue;
+        }
+        int32_t j = i - (dst.ndim - src.ndim);
+        bool broadcast = j < 0 || src.shape[j] == 1;
+        dims.push_back(CopyDim{dst.shape[i], dst_strides[i] * dst_elem * lanes,
+                               broadcast ? 0 : src_strides[j] * src_elem * lanes});
+    }
+    // loop order of the destination layout, then merge loops contiguous in both tensors
+    std::stable_sort(dims.begin(), dims.end(), [](const CopyDim& a, const CopyDim& b) {
+        return std::abs(a.dst_stride) > std::abs(b.dst_stride);
+    });
+    if (lanes != 1) {
+        dims.push_back(CopyDim{lanes, dst_elem, src_elem});
+    }
+    size_t ndim = 0;
+    for (size_t i = 0; i < dims.size(); ++i) {
+        if (ndim != 0) {
+            CopyDim& outer = dims[ndim - 1];
+            if (outer.dst_stride == dims[i].dst_stride * dims[i].size &&
+                outer.src_stride == dims[i].src_stride * dims[i].size) {
+                outer.size *= dims[i].size;
+                outer.dst_stride = dims[i].dst_stride;
+                outer.src_stride = dims[i].src_stride;
+                continue;
+            }
+        }
+        dims[ndim++] = dims[i];
+    }
+    dims.resize(ndim);
+    if (dims.empty()) {
+        kernel(dst_data, src_data, 1, dst_elem, src_elem, dst_elem);
+        return;
+    }
+
+    const CopyDim inner = dims.back();
+    bool transpose = dims.size() >= 2 && inner.dst_stride == dst_elem && inner.src_stride != src_elem &&
+                     inner.src_stride != 0 && dims[dims.size() - 2].src_stride == src_elem;
+    // the loops run by the units of work, one row or one tile row of a transpose
+    const CopyDim rows = transpose ? dims[dims.size() - 2] : CopyDim{1, 0, 0};
+    size_t num_outer = dims.size() - (transpose ? 2 : 1);
+    int64_t row_blocks = transpose ? (rows.size + kTile - 1) / kTile : 1;
+    int64_t num_units = row_blocks;
+    for (size_t d = 0; d < num_outer; ++d) {
+        num_units *= dims[d].size;
+    }
+    int64_t unit_bytes = inner.size * dst_elem * (transpose ? kTile : 1);
+
+    auto run_units = [&](int64_t unit_begin, int64_t unit_end) {
+        // odometer over the outer loops
+        std::vector<int64_t> index(num_outer);
+        int64_t dst_offset = 0, src_offset = 0;
+        int64_t outer = unit_begin / row_blocks;
+        int64_t block = unit_begin % row_blocks;
+        for (size_t d = num_outer; d-- > 0;) {
+            index[d] = outer % dims[d].size;
+            outer /= dims[d].size;
+            dst_offset += index[d] * dims[d].dst_stride;
+            src_offset += index[d] * dims[d].src_stride;
+        }
+        for (int64_t unit = unit_begin; unit < unit_end; ++unit) {
+            if (!transpose) {
+                kernel(dst_data + dst_offset, src_data + src_offset, inner.size, inner.dst_stride, inner.src_stride,
+                       dst_elem);
+            } else {
+                int64_t row_end = std::min(rows.size, (block + 1) * kTile);
+                for (int64_t col = 0; col < inner.size; col += kTile) {
+                    int64_t num_cols = std::min(kTile, inner.size - col);
+                    for (int64_t row = block * kTile; row < row_end; ++row) {
+                        kernel(dst_data + dst_offset + row * rows.dst_stride + col * inner.dst_stride,
+                               src_data + src_offset + row * rows.src_stride + col * inner.src_stride, num_cols,
+                               inner.dst_stride, inner.src_stride, dst_elem);
+                    }
+                }
+                if (++block != row_blocks) {
+                    continue;
+                }
+                block = 0;
+            }
+            for (size_t d = num_outer; d-- > 0;) {
+                dst_offset += dims[d].dst_stride;
+                src_offset += dims[d].src_stride;
+                if (++index[d] != dims[d].size) {
+                    break;
+                }
+                dst_offset -= dims[d].dst_stride * dims[d].size;
+                src_offset -= dims[d].src_stride * dims[d].size;
+                index[d] = 0;
+            }
+        }
+    };
+    if (num_units * unit_bytes < kParallelMinBytes) {
+        run_units(0, num_units);
+        return;
+    }
+    ThreadPool::Global()->ParallelFor(0, num_units, std::max<int64_t>(1, kMinChunkBytes / unit_bytes), run_units);
+}
+
+}// namespace
+
+void Tensor::CopyTo(const Tensor& dst) const {
+    CopyTensor(*get(), *dst.get());
+}
+
+Tensor Tensor::Contiguous() const {
+    if (IsContiguous()) {
+        return *this;
+    }
+    const TensorObj* self = get();
+    if (!details::IsCPUAccessible(self->device)) {
+        TVM_FFI_THROW(ValueError) << "Contiguous: only CPU tensors are supported, got device type "
+                                  << self->device.device_type;
+    }
+    // the copy lives in plain host memory even if the source is pinned
+    Tensor result = FromNDAlloc(details::AlignedCPUAlloc(), shape(), self->dtype, DLDevice{kDLCPU, 0});
+    CopyTo(result);
+    return result;
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+    namespace refl = litetvm::ffi::reflection;
+    refl::GlobalDef()
+            .def("ffi.TensorCopyTo", [](Tensor src, Tensor dst) { src.CopyTo(dst); })
+            .def("ffi.TensorContiguous", [](Tensor tensor) { return tensor.Contiguous(); });
+}
+
+}// namespace ffi
+}// namespace litetvm
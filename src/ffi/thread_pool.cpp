@@ -0,0 +1,145 @@
+//
+// Created by richard on 10/19/26.
+//
+
+#include "ffi/thread_pool.h"
+#include "ffi/error.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+
+namespace litetvm {
+namespace ffi {
+
+namespace {
+// set on worker threads, loops started there run inline
+thread_local bool is_worker_thread = false;
+}// namespace
+
+ThreadPool::ThreadPool(int num_workers) : ThreadPool(num_workers, nullptr) {}
+
+ThreadPool::ThreadPool(int num_workers, std::function<void(int)> init_worker) {
+    TVM_FFI_ICHECK_GE(num_workers, 0);
+    workers_.reserve(num_workers);
+    for (int i = 0; i < num_workers; ++i) {
+        workers_.emplace_back([this, init_worker, i]() {
+            if (init_worker != nullptr) {
+                init_worker(i);
+            }
+            WorkerLoop();
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (std::thread& worker: workers_) {
+        worker.join();
+    }
+}
+
+ThreadPool* ThreadPool::Global() {
+    static ThreadPool* pool = []() {
+        int num_threads = static_cast<int>(std::thread::hardware_concurrency());
+        if (const char* env = std::getenv("TVM_FFI_NUM_THREADS")) {
+            num_threads = std::atoi(env);
+        }
+        // leaked so loops can run during static destruction
+        return new ThreadPool(std::max(num_threads, 1) - 1);
+    }();
+    return pool;
+}
+
+void ThreadPool::WorkerLoop() {
+    is_worker_thread = true;
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    if (workers_.empty()) {
+        task();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void ThreadPool::ParallelFor(int64_t begin, int64_t end, int64_t min_chunk,
+                             const std::function<void(int64_t, int64_t)>& fn) {
+    if (begin >= end) {
+        return;
+    }
+    int64_t num_chunks = std::min<int64_t>(NumThreads(), (end - begin) / std::max<int64_t>(min_chunk, 1));
+    if (num_chunks <= 1 || is_worker_thread) {
+        fn(begin, end);
+        return;
+    }
+
+    struct Join {
+        std::mutex mutex;
+        std::condition_variable cv;
+        int64_t pending;
+        std::exception_ptr error;
+
+        void Run(const std::function<void(int64_t, int64_t)>& fn, int64_t chunk_begin, int64_t chunk_end) {
+            std::exception_ptr chunk_error;
+            try {
+                fn(chunk_begin, chunk_end);
+            } catch (...) {
+                chunk_error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (chunk_error != nullptr && error == nullptr) {
+                error = chunk_error;
+            }
+            if (--pending == 0) {
+                cv.notify_one();
+            }
+        }
+    };
+    Join join;
+    join.pending = num_chunks;
+
+    int64_t chunk = (end - begin) / num_chunks;
+    int64_t rem = (end - begin) % num_chunks;
+    auto chunk_begin = [&](int64_t i) { return begin + i * chunk + std::min(i, rem); };
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int64_t i = 1; i < num_chunks; ++i) {
+            int64_t b = chunk_begin(i);
+            int64_t e = chunk_begin(i + 1);
+            tasks_.emplace_back([&join, &fn, b, e]() { join.Run(fn, b, e); });
+        }
+    }
+    cv_.notify_all();
+    join.Run(fn, begin, chunk_begin(1));
+
+    std::unique_lock<std::mutex> lock(join.mutex);
+    join.cv.wait(lock, [&join]() { return join.pending == 0; });
+    if (join.error != nullptr) {
+        std::rethrow_exception(join.error);
+    }
+}
+
+}// namespace ffi
+}// namespace litetvm
@@ -11,11 +11,16 @@
 
 #include <backtrace.h>
 #include <cxxabi.h>
+#include <unwind.h>
 
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 #if TVM_FFI_BACKTRACE_ON_SEGFAULT
 #include <csignal>
@@ -64,9 +69,19 @@ void BacktraceSyminfoCallback(void* data, uintptr_t pc, const char* symname, uin
     }
 }
 
-int BacktraceFullCallback(void* data, uintptr_t pc, const char* filename, int lineno,
-                          const char* symbol) {
-    auto stack_trace = reinterpret_cast<TracebackStorage*>(data);
+/*!
+ * \brief A symbolized frame, one program counter can map to several frames when inlined.
+ */
+struct SymbolizedFrame {
+    std::string filename;
+    std::string symbol;
+    int lineno;
+    bool has_filename;
+};
+
+int BacktracePcInfoCallback(void* data, uintptr_t pc, const char* filename, int lineno,
+                            const char* symbol) {
+    auto frames = reinterpret_cast<std::vector<SymbolizedFrame>*>(data);
     std::string symbol_str = "<unknown>";
     if (symbol) {
         symbol_str = DemangleName(symbol);
@@ -74,36 +89,138 @@ int BacktraceFullCallback(void* data, uintptr_t pc, const char* filename, int li
         // see if syminfo gives anything
         backtrace_syminfo(_bt_state, pc, BacktraceSyminfoCallback, BacktraceErrorCallback, &symbol_str);
     }
-    symbol = symbol_str.data();
+    frames->push_back(SymbolizedFrame{filename ? filename : "", std::move(symbol_str), lineno, filename != nullptr});
+    return 0;
+}
+
+/*!
+ * \brief Cache from program counter to symbolized frames.
+ *
+ * Errors thrown from the same site share their program counters, so
+ * libbacktrace only needs to resolve each of them once. The cache is
+ * cleared when it reaches kMaxEntries program counters.
+ */
+class SymbolCache {
+public:
+    static constexpr size_t kMaxEntries = 4096;
 
-    if (stack_trace->ExceedTracebackLimit()) {
-        return 1;
+    template<typename FVisit>
+    void Visit(const TVMFFIRawTraceback* raw, FVisit fvisit) {
+        for (int32_t i = 0; i < raw->num_frames; ++i) {
+            std::shared_ptr<const std::vector<SymbolizedFrame>> frames = Lookup(raw->pcs[i]);
+            for (const SymbolizedFrame& frame: *frames) {
+                if (!fvisit(frame)) return;
+            }
+        }
     }
-    if (ShouldStopTraceback(filename, symbol)) {
-        return 1;
+
+    static SymbolCache* Global() {
+        static SymbolCache* inst = new SymbolCache();
+        return inst;
     }
-    if (ShouldExcludeFrame(filename, symbol)) {
-        return 0;
+
+private:
+    // entries are shared, so a found entry stays valid when the cache is cleared
+    std::shared_ptr<const std::vector<SymbolizedFrame>> Lookup(uintptr_t pc) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = cache_.find(pc);
+            if (it != cache_.end()) {
+                return it->second;
+            }
+        }
+        // libbacktrace eats memory if run on multiple threads at the same time, so misses are serialized
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = cache_.find(pc);
+        if (it != cache_.end()) {
+            return it->second;
+        }
+        auto frames = std::make_shared<std::vector<SymbolizedFrame>>();
+        backtrace_pcinfo(_bt_state, pc, BacktracePcInfoCallback, BacktraceErrorCallback, frames.get());
+        if (cache_.size() >= kMaxEntries) {
+            cache_.clear();
+        }
+        cache_.emplace(pc, frames);
+        return frames;
     }
-    stack_trace->Append(filename, symbol, lineno);
-    return 0;
+
+    std::shared_mutex mutex_;
+    std::unordered_map<uintptr_t, std::shared_ptr<const std::vector<SymbolizedFrame>>> cache_;
+};
+
+struct UnwindState {
+    TVMFFIRawTraceback* out;
+    // return address into the first frame to keep, the frames of the capture itself come before it
+    uintptr_t start_pc;
+    bool started;
+};
+
+_Unwind_Reason_Code UnwindCallback(_Unwind_Context* context, void* data) {
+    auto state = static_cast<UnwindState*>(data);
+    int ip_before_insn = 0;
+    uintptr_t pc = _Unwind_GetIPInfo(context, &ip_before_insn);
+    if (pc == 0) {
+        return _URC_END_OF_STACK;
+    }
+    if (!state->started && pc == state->start_pc) {
+        // drop the frames recorded so far, if the start frame is never found all frames are kept
+        state->started = true;
+        state->out->num_frames = 0;
+    }
+    // point into the call instruction rather than the return address
+    if (!ip_before_insn) {
+        --pc;
+    }
+    state->out->pcs[state->out->num_frames++] = pc;
+    return state->out->num_frames < TVM_FFI_RAW_TRACEBACK_MAX_FRAMES ? _URC_NO_REASON : _URC_END_OF_STACK;
+}
+
+/*!
+ * \brief Capture the program counters of the current stack.
+ * \param start_pc The return address into the frame the traceback starts at.
+ *
+ * The start frame is found by address rather than by a number of frames to skip,
+ * which would depend on how the frames in between were inlined or tail called.
+ */
+void CaptureRaw(const char* filename, int lineno, const char* func, uintptr_t start_pc, TVMFFIRawTraceback* out) {
+    out->filename = filename;
+    out->func = func;
+    out->lineno = lineno;
+    out->num_frames = 0;
+    UnwindState state{out, start_pc, false};
+    _Unwind_Backtrace(UnwindCallback, &state);
 }
 
-std::string Traceback() {
+std::string Symbolize(const TVMFFIRawTraceback* raw) {
     TracebackStorage traceback;
 
     if (_bt_state == nullptr) {
         return "";
     }
-    // libbacktrace eats memory if run on multiple threads at the same time, so we guard against it
-    {
-        static std::mutex m;
-        std::lock_guard<std::mutex> lock(m);
-        backtrace_full(_bt_state, 0, BacktraceFullCallback, BacktraceErrorCallback, &traceback);
-    }
+    SymbolCache::Global()->Visit(raw, [&traceback](const SymbolizedFrame& frame) {
+        const char* filename = frame.has_filename ? frame.filename.c_str() : nullptr;
+        const char* symbol = frame.symbol.c_str();
+        if (traceback.ExceedTracebackLimit()) {
+            return false;
+        }
+        if (ShouldStopTraceback(filename, symbol)) {
+            return false;
+        }
+        if (!ShouldExcludeFrame(filename, symbol)) {
+            traceback.Append(filename, symbol, frame.lineno);
+        }
+        return true;
+    });
     return traceback.GetTraceback();
 }
 
+TVM_FFI_NO_INLINE std::string Traceback() {
+    TVMFFIRawTraceback raw;
+    // start at the caller of Traceback
+    CaptureRaw(nullptr, 0, nullptr, reinterpret_cast<uintptr_t>(__builtin_return_address(0)), &raw);
+    return Symbolize(&raw);
+}
+
 #if TVM_FFI_BACKTRACE_ON_SEGFAULT
 void backtrace_handler(int sig) {
     // Technically we shouldn't do any allocation in a signal handler, but
@@ -138,6 +255,21 @@ const TVMFFIByteArray* TVMFFITraceback(const char*, int, const char*) {
     traceback_array.size = traceback_str.size();
     return &traceback_array;
 }
+
+TVM_FFI_NO_INLINE void TVMFFITracebackCaptureRaw(const char* filename, int lineno, const char* func,
+                                                  TVMFFIRawTraceback* out) {
+    // start at the caller, found by the return address of this frame
+    ::litetvm::ffi::CaptureRaw(filename, lineno, func, reinterpret_cast<uintptr_t>(__builtin_return_address(0)), out);
+}
+
+const TVMFFIByteArray* TVMFFITracebackSymbolize(const TVMFFIRawTraceback* raw) {
+    thread_local std::string traceback_str;
+    thread_local TVMFFIByteArray traceback_array;
+    traceback_str = ::litetvm::ffi::Symbolize(raw);
+    traceback_array.data = traceback_str.data();
+    traceback_array.size = traceback_str.size();
+    return &traceback_array;
+}
 #else
 // fallback implementation simply print out the last trace
 const TVMFFIByteArray* TVMFFITraceback(const char* filename, int lineno, const char* func) {
@@ -151,6 +283,18 @@ const TVMFFIByteArray* TVMFFITraceback(const char* filename, int lineno, const c
     traceback_array.size = traceback_str.size();
     return &traceback_array;
 }
+
+// without a symbolizer only the throw site is recorded
+void TVMFFITracebackCaptureRaw(const char* filename, int lineno, const char* func, TVMFFIRawTraceback* out) {
+    out->filename = filename;
+    out->func = func;
+    out->lineno = lineno;
+    out->num_frames = 0;
+}
+
+const TVMFFIByteArray* TVMFFITracebackSymbolize(const TVMFFIRawTraceback* raw) {
+    return TVMFFITraceback(raw->filename, raw->lineno, raw->func);
+}
 #endif// TVM_FFI_USE_LIBBACKTRACE
 
 #endif
\ No newline at end of file
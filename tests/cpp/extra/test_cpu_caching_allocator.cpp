@@ -0,0 +1,117 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/container/map.h"
+#include "ffi/container/tensor.h"
+#include "ffi/extra/c_env_api.h"
+#include "ffi/extra/cpu_caching_allocator.h"
+#include "ffi/function.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace {
+
+using namespace litetvm::ffi;
+
+bool IsAlignedTo(const void* ptr, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+TEST(CPUCachingAllocator, AllocFree) {
+    CPUCachingAllocator* alloc = CPUCachingAllocator::Global();
+    alloc->Trim();
+    CPUCachingAllocator::Stats before = alloc->GetStats();
+
+    // 100 and 110 bytes share the 112 byte class
+    void* a = alloc->Alloc(100);
+    EXPECT_TRUE(IsAlignedTo(a, 64));
+    CPUCachingAllocator::Stats stats = alloc->GetStats();
+    EXPECT_EQ(stats.bytes_in_use - before.bytes_in_use, 112);
+    EXPECT_GE(stats.peak_bytes_in_use, stats.bytes_in_use);
+    alloc->Free(a, 100);
+    EXPECT_EQ(alloc->GetStats().bytes_cached, 112);
+    void* b = alloc->Alloc(110);
+    EXPECT_EQ(b, a);
+    stats = alloc->GetStats();
+    EXPECT_EQ(stats.num_allocs - before.num_allocs, 2);
+    EXPECT_EQ(stats.num_cache_hits - before.num_cache_hits, 1);
+    EXPECT_EQ(stats.bytes_cached, 0);
+    alloc->Free(b, 110);
+
+    // blocks of another alignment are not shared
+    void* c = alloc->Alloc(100, 128);
+    EXPECT_TRUE(IsAlignedTo(c, 128));
+    void* d = alloc->Alloc(5000, CPUCachingAllocator::kPageAlignment);
+    EXPECT_TRUE(IsAlignedTo(d, CPUCachingAllocator::kPageAlignment));
+    void* e = alloc->Alloc(0);
+    EXPECT_NE(e, nullptr);
+    alloc->Free(c, 100, 128);
+    alloc->Free(d, 5000, CPUCachingAllocator::kPageAlignment);
+    alloc->Free(e, 0);
+    alloc->Free(nullptr, 100);
+
+    EXPECT_THROW(alloc->Alloc(64, 48), Error);
+    EXPECT_THROW(alloc->Alloc(64, 8192), Error);
+
+    alloc->Trim();
+    stats = alloc->GetStats();
+    EXPECT_EQ(stats.bytes_cached, 0);
+    EXPECT_EQ(stats.bytes_in_use, before.bytes_in_use);
+}
+
+TEST(CPUCachingAllocator, SharedCache) {
+    CPUCachingAllocator* alloc = CPUCachingAllocator::Global();
+    alloc->Trim();
+    // blocks freed by an exiting thread are handed to other threads
+    void* small = nullptr;
+    std::thread worker([&]() {
+        small = alloc->Alloc(1000);
+        alloc->Free(small, 1000);
+    });
+    worker.join();
+    EXPECT_EQ(alloc->GetStats().bytes_cached, 1024);
+    EXPECT_EQ(alloc->Alloc(1000), small);
+    alloc->Free(small, 1000);
+
+    // large blocks go to the shared cache, which respects the cache limit
+    size_t large = CPUCachingAllocator::kMaxThreadCachedSize * 4;
+    void* a = alloc->Alloc(large);
+    alloc->Free(a, large);
+    EXPECT_EQ(alloc->Alloc(large), a);
+    alloc->SetCacheLimit(0);
+    alloc->Free(a, large);
+    EXPECT_LT(alloc->GetStats().bytes_cached, large);
+    alloc->SetCacheLimit(CPUCachingAllocator::kDefaultCacheLimit);
+    alloc->Trim();
+    EXPECT_EQ(alloc->GetStats().bytes_cached, 0);
+}
+
+TEST(CPUCachingAllocator, DefaultDLPackAllocator) {
+    DLPackTensorAllocator env_alloc = TVMFFIEnvGetTensorAllocator();
+    EXPECT_EQ(env_alloc, CPUCachingAllocator::DLPackAlloc);
+    Tensor small = Tensor::FromDLPackAlloc(env_alloc, {2, 3}, DLDataType({kDLFloat, 32, 1}), DLDevice({kDLCPU, 0}));
+    EXPECT_EQ(small.shape()[1], 3);
+    EXPECT_TRUE(small.IsContiguous());
+    EXPECT_TRUE(IsAlignedTo(small->data, CPUCachingAllocator::kDefaultAlignment));
+    static_cast<float*>(small->data)[5] = 1.0f;
+
+    Tensor large = Tensor::FromDLPackAlloc(env_alloc, {512, 1024}, DLDataType({kDLFloat, 32, 1}),
+                                           DLDevice({kDLCPU, 0}));
+    EXPECT_TRUE(IsAlignedTo(large->data, CPUCachingAllocator::kPageAlignment));
+    size_t in_use = CPUCachingAllocator::Global()->GetStats().bytes_in_use;
+    large = Tensor(nullptr);
+    EXPECT_EQ(in_use - CPUCachingAllocator::Global()->GetStats().bytes_in_use, 512 * 1024 * 4);
+
+    EXPECT_THROW(Tensor::FromDLPackAlloc(env_alloc, {2, 3}, DLDataType({kDLFloat, 32, 1}), DLDevice({kDLCUDA, 0})),
+                 Error);
+
+    Function get_stats = Function::GetGlobalRequired("ffi.CPUCachingAllocatorGetStats");
+    Map<String, int64_t> stats = get_stats().cast<Map<String, int64_t>>();
+    EXPECT_EQ(stats.at("bytes_in_use"), static_cast<int64_t>(CPUCachingAllocator::Global()->GetStats().bytes_in_use));
+    Function set_cache_limit = Function::GetGlobalRequired("ffi.CPUCachingAllocatorSetCacheLimit");
+    EXPECT_THROW(set_cache_limit(-1), Error);
+}
+
+}// namespace
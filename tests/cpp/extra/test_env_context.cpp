@@ -0,0 +1,128 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/container/tensor.h"
+#include "ffi/extra/cpu_caching_allocator.h"
+#include "ffi/extra/env_context.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+namespace {
+
+using namespace litetvm::ffi;
+
+// CPU allocators counting their allocations
+template<int kTag>
+struct CountingAllocator {
+    static std::atomic<int>& Count() {
+        static std::atomic<int> count{0};
+        return count;
+    }
+
+    static int DLPackAlloc(DLTensor* prototype, DLManagedTensorVersioned** out, void* error_ctx,
+                           void (*SetError)(void* error_ctx, const char* kind, const char* message)) {
+        ++Count();
+        return CPUCachingAllocator::DLPackAlloc(prototype, out, error_ctx, SetError);
+    }
+};
+
+using AllocatorA = CountingAllocator<0>;
+using AllocatorB = CountingAllocator<1>;
+
+TEST(EnvContext, SetTensorAllocatorReturnsOriginal) {
+    DLPackTensorAllocator original = nullptr;
+    ASSERT_EQ(TVMFFIEnvSetTensorAllocator(AllocatorA::DLPackAlloc, 0, &original), 0);
+    EXPECT_EQ(original, nullptr);
+    EXPECT_EQ(TVMFFIEnvGetTensorAllocator(), AllocatorA::DLPackAlloc);
+    ASSERT_EQ(TVMFFIEnvSetTensorAllocator(AllocatorB::DLPackAlloc, 0, &original), 0);
+    EXPECT_EQ(original, AllocatorA::DLPackAlloc);
+    ASSERT_EQ(TVMFFIEnvSetTensorAllocator(nullptr, 0, &original), 0);
+    EXPECT_EQ(original, AllocatorB::DLPackAlloc);
+    EXPECT_EQ(TVMFFIEnvGetTensorAllocator(), CPUCachingAllocator::DLPackAlloc);
+}
+
+TEST(EnvContext, WithAllocator) {
+    int count_a = AllocatorA::Count();
+    int count_b = AllocatorB::Count();
+    {
+        WithAllocator outer(AllocatorA::DLPackAlloc);
+        EXPECT_EQ(TVMFFIEnvGetTensorAllocator(), AllocatorA::DLPackAlloc);
+        EXPECT_EQ(TVMFFIEnvGetDeviceTensorAllocator(kDLCUDA), AllocatorA::DLPackAlloc);
+        {
+            WithAllocator inner(kDLCPU, AllocatorB::DLPackAlloc);
+            EXPECT_EQ(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU), AllocatorB::DLPackAlloc);
+            EXPECT_EQ(TVMFFIEnvGetTensorAllocator(), AllocatorA::DLPackAlloc);
+            Tensor tensor = Tensor::FromDLPackAlloc(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU), {4},
+                                                    DLDataType({kDLFloat, 32, 1}), DLDevice({kDLCPU, 0}));
+            EXPECT_EQ(AllocatorB::Count() - count_b, 1);
+            {
+                WithAllocator innermost(kDLCPU, AllocatorA::DLPackAlloc);
+                EXPECT_EQ(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU), AllocatorA::DLPackAlloc);
+            }
+            EXPECT_EQ(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU), AllocatorB::DLPackAlloc);
+        }
+        EXPECT_EQ(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU), AllocatorA::DLPackAlloc);
+        Tensor tensor = Tensor::FromDLPackAlloc(TVMFFIEnvGetTensorAllocator(), {4}, DLDataType({kDLFloat, 32, 1}),
+                                                DLDevice({kDLCPU, 0}));
+        EXPECT_EQ(AllocatorA::Count() - count_a, 1);
+    }
+    EXPECT_EQ(TVMFFIEnvGetTensorAllocator(), CPUCachingAllocator::DLPackAlloc);
+    EXPECT_EQ(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU), CPUCachingAllocator::DLPackAlloc);
+    // device types without a slot use the default allocator
+    EXPECT_EQ(TVMFFIEnvGetDeviceTensorAllocator(1000), CPUCachingAllocator::DLPackAlloc);
+    EXPECT_THROW(WithAllocator(1000, AllocatorA::DLPackAlloc), Error);
+    // -1 is not a way to set the default allocator through the device type entry point
+    EXPECT_THROW(WithAllocator(-1, AllocatorA::DLPackAlloc), Error);
+    EXPECT_EQ(TVMFFIEnvGetTensorAllocator(), CPUCachingAllocator::DLPackAlloc);
+}
+
+TEST(EnvContext, GlobalAllocator) {
+    // the global allocator of a device type is published to the other threads
+    DLPackTensorAllocator original = nullptr;
+    ASSERT_EQ(TVMFFIEnvSetDeviceTensorAllocator(kDLCPU, AllocatorA::DLPackAlloc, 1, &original), 0);
+    EXPECT_EQ(original, nullptr);
+    ASSERT_EQ(TVMFFIEnvSetDeviceTensorAllocator(kDLCPU, nullptr, 0, nullptr), 0);
+    std::thread([]() {
+        EXPECT_EQ(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU), AllocatorA::DLPackAlloc);
+        EXPECT_EQ(TVMFFIEnvGetDeviceTensorAllocator(kDLCUDA), CPUCachingAllocator::DLPackAlloc);
+        EXPECT_EQ(TVMFFIEnvGetTensorAllocator(), CPUCachingAllocator::DLPackAlloc);
+        // the thread-local default overrides the global allocator of the device type
+        WithAllocator scope(AllocatorB::DLPackAlloc);
+        EXPECT_EQ(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU), AllocatorB::DLPackAlloc);
+    }).join();
+    EXPECT_EQ(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU), AllocatorA::DLPackAlloc);
+    // a cached thread sees the global change
+    ASSERT_EQ(TVMFFIEnvSetDeviceTensorAllocator(kDLCPU, nullptr, 1, nullptr), 0);
+    EXPECT_EQ(TVMFFIEnvGetDeviceTensorAllocator(kDLCPU), CPUCachingAllocator::DLPackAlloc);
+
+    ASSERT_EQ(TVMFFIEnvSetTensorAllocator(AllocatorB::DLPackAlloc, 1, nullptr), 0);
+    ASSERT_EQ(TVMFFIEnvSetTensorAllocator(nullptr, 0, nullptr), 0);
+    std::thread([]() { EXPECT_EQ(TVMFFIEnvGetTensorAllocator(), AllocatorB::DLPackAlloc); }).join();
+    ASSERT_EQ(TVMFFIEnvSetTensorAllocator(CPUCachingAllocator::DLPackAlloc, 1, nullptr), 0);
+    ASSERT_EQ(TVMFFIEnvSetTensorAllocator(nullptr, 0, nullptr), 0);
+    EXPECT_EQ(TVMFFIEnvGetTensorAllocator(), CPUCachingAllocator::DLPackAlloc);
+}
+
+TEST(EnvContext, WithStream) {
+    int stream_a = 0;
+    int stream_b = 0;
+    DLDevice device{kDLCUDA, 1};
+    EXPECT_EQ(TVMFFIEnvGetStream(kDLCUDA, 1), nullptr);
+    {
+        WithStream outer(device, &stream_a);
+        EXPECT_EQ(TVMFFIEnvGetStream(kDLCUDA, 1), &stream_a);
+        EXPECT_EQ(TVMFFIEnvGetStream(kDLCUDA, 0), nullptr);
+        {
+            WithStream inner(device, &stream_b);
+            EXPECT_EQ(TVMFFIEnvGetStream(kDLCUDA, 1), &stream_b);
+        }
+        EXPECT_EQ(TVMFFIEnvGetStream(kDLCUDA, 1), &stream_a);
+        std::thread([]() { EXPECT_EQ(TVMFFIEnvGetStream(kDLCUDA, 1), nullptr); }).join();
+    }
+    EXPECT_EQ(TVMFFIEnvGetStream(kDLCUDA, 1), nullptr);
+}
+
+}// namespace
@@ -198,6 +198,25 @@ TEST(JSONParser, ObjectOrderPreserving) {
     EXPECT_TRUE(StructuralEqual()(keys, json::Array{"c", "a", "b"}));
 }
 
+TEST(JSONParser, RepeatedShortStrings) {
+    // medium sized strings are shared between records, make sure the
+    // shared entries never mix up different contents
+    std::string json_str = "[";
+    json::Array expected;
+    for (int i = 0; i < 200; ++i) {
+        std::string name = "device_type_" + std::to_string(i % 97);
+        if (i != 0) json_str += ",";
+        json_str += "{\"" + name + "\": \"requires_grad\"}";
+        expected.push_back(json::Object{{String(name), "requires_grad"}});
+    }
+    json_str += "]";
+    auto arr = json::Parse(json_str).cast<json::Array>();
+    EXPECT_TRUE(StructuralEqual()(arr, expected));
+    auto value0 = (*arr[0].cast<json::Object>().begin()).second.cast<String>();
+    auto value1 = (*arr[1].cast<json::Object>().begin()).second.cast<String>();
+    EXPECT_EQ(value0.data(), value1.data());
+}
+
 TEST(JSONParser, WrongObject) {
     String error_msg;
     EXPECT_EQ(json::Parse("{\"a\":", &error_msg), nullptr);
@@ -0,0 +1,89 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/container/tensor.h"
+#include "ffi/extra/env_context.h"
+#include "ffi/extra/numa.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include <sched.h>
+
+namespace {
+
+using namespace litetvm::ffi;
+
+bool IsAlignedTo(const void* ptr, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+TEST(NUMA, Topology) {
+    int num_nodes = NUMANumNodes();
+    EXPECT_GE(num_nodes, 1);
+    size_t num_cpus = 0;
+    for (int node = 0; node < num_nodes; ++node) {
+        num_cpus += NUMANodeCpus(node).size();
+    }
+    EXPECT_GE(num_cpus, 1);
+    EXPECT_THROW(NUMANodeCpus(-1), Error);
+    EXPECT_THROW(NUMANodeCpus(num_nodes), Error);
+    EXPECT_EQ(Function::GetGlobalRequired("ffi.NUMANumNodes")().cast<int>(), num_nodes);
+}
+
+TEST(NUMA, Alloc) {
+    for (int node = 0; node < NUMANumNodes(); ++node) {
+        for (size_t nbytes: {size_t{0}, size_t{1}, size_t{5000}, size_t{1} << 20}) {
+            void* ptr = NUMAAllocator::Alloc(nbytes, node);
+            EXPECT_TRUE(IsAlignedTo(ptr, 4096));
+            std::memset(ptr, 1, nbytes);
+            NUMAAllocator::Free(ptr, nbytes);
+        }
+    }
+    EXPECT_THROW(NUMAAllocator::Alloc(16, NUMANumNodes()), Error);
+}
+
+TEST(NUMA, DLPackAlloc) {
+    WithAllocator scope(kDLCPU, NUMAAllocator::DLPackAlloc);
+    DLPackTensorAllocator allocator = TVMFFIEnvGetDeviceTensorAllocator(kDLCPU);
+    int node = NUMANumNodes() - 1;
+    Tensor tensor = Tensor::FromDLPackAlloc(allocator, {3, 100}, DLDataType({kDLFloat, 32, 1}),
+                                            DLDevice({kDLCPU, node}));
+    EXPECT_EQ(tensor->device.device_id, node);
+    EXPECT_EQ(tensor.shape()[1], 100);
+    EXPECT_TRUE(IsAlignedTo(tensor->data, 4096));
+    std::fill_n(static_cast<float*>(tensor->data), 300, 1.0f);
+    EXPECT_THROW(Tensor::FromDLPackAlloc(allocator, {4}, DLDataType({kDLFloat, 32, 1}),
+                                         DLDevice({kDLCPU, NUMANumNodes()})),
+                 Error);
+    EXPECT_THROW(Tensor::FromDLPackAlloc(allocator, {4}, DLDataType({kDLFloat, 32, 1}), DLDevice({kDLCUDA, 0})),
+                 Error);
+}
+
+TEST(NUMA, NodeThreadPool) {
+    for (int node = 0; node < NUMANumNodes(); ++node) {
+        std::vector<int> cpus = NUMANodeCpus(node);
+        if (cpus.empty()) {
+            continue;
+        }
+        ThreadPool* pool = NUMANodeThreadPool(node);
+        EXPECT_EQ(pool, NUMANodeThreadPool(node));
+        EXPECT_EQ(pool->NumThreads(), std::max(static_cast<int>(cpus.size()) - 1, 1) + 1);
+        std::atomic<int> cpu{-1};
+        std::atomic<bool> done{false};
+        pool->Submit([&]() {
+            cpu = sched_getcpu();
+            done = true;
+        });
+        while (!done) {
+            std::this_thread::yield();
+        }
+        EXPECT_NE(std::find(cpus.begin(), cpus.end(), cpu.load()), cpus.end());
+    }
+}
+
+}// namespace
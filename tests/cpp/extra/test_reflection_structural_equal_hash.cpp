@@ -4,8 +4,10 @@
 #include "../testing_object.h"
 #include "ffi/container/array.h"
 #include "ffi/container/map.h"
+#include "ffi/container/shape.h"
 #include "ffi/extra/structural_equal.h"
 #include "ffi/extra/structural_hash.h"
+#include "ffi/function.h"
 #include "ffi/object.h"
 #include "ffi/reflection/registry.h"
 #include "ffi/string.h"
@@ -159,4 +161,17 @@ TEST(StructuralEqualHash, CustomTreeNode) {
     EXPECT_TRUE(diff_fa_fc.has_value());
     EXPECT_TRUE(StructuralEqual()(diff_fa_fc, expected_diff_fa_fc));
 }
+
+TEST(StructuralEqualHash, SameObject) {
+    Shape shape = {2, 3};
+    EXPECT_TRUE(StructuralEqual()(shape, shape));
+    TVar x = TVar("x");
+    EXPECT_TRUE(StructuralEqual()(x, x));
+
+    // an object is not equal to itself when its type does not support the comparison
+    Function f = Function::FromTyped([](int64_t a) { return a; });
+    EXPECT_THROW(StructuralEqual()(f, f), Error);
+    Array<Any> arr = {f};
+    EXPECT_THROW(StructuralEqual()(arr, arr), Error);
+}
 }// namespace
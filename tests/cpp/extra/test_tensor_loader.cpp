@@ -0,0 +1,134 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/extra/cpu_caching_allocator.h"
+#include "ffi/extra/tensor_loader.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+using namespace litetvm::ffi;
+
+constexpr DLDataType kFloat32{kDLFloat, 32, 1};
+
+// raw file of floats 0, 1, 2, ... after a prefix of 100 bytes, removed at the end of the test
+class TempFile {
+public:
+    TempFile(const std::string& name, int64_t num_floats)
+        : path_((std::filesystem::temp_directory_path() / (name + "_" + std::to_string(getpid()))).string()) {
+        std::ofstream out(path_, std::ios::binary);
+        std::string prefix(100, 'x');
+        out.write(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+        for (int64_t i = 0; i < num_floats; ++i) {
+            float value = static_cast<float>(i);
+            out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
+
+    ~TempFile() {
+        std::filesystem::remove(path_);
+    }
+
+    NODISCARD const std::string& path() const {
+        return path_;
+    }
+
+private:
+    std::string path_;
+};
+
+const float* Data(const Tensor& tensor) {
+    return reinterpret_cast<const float*>(static_cast<const char*>(tensor->data) + tensor->byte_offset);
+}
+
+bool IsIota(const Tensor& tensor, int64_t first) {
+    for (int64_t i = 0; i < tensor.numel(); ++i) {
+        if (Data(tensor)[i] != static_cast<float>(first + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(TensorLoader, Load) {
+    TempFile file("tensor_loader_load", 10000);
+    CPUCachingAllocator::Stats before = CPUCachingAllocator::Global()->GetStats();
+    // small chunks so one tensor is read by all the I/O threads
+    for (int io_depth: {0, 1, 3}) {
+        TensorLoader loader(io_depth, 4096);
+        EXPECT_EQ(loader.io_depth(), io_depth);
+        TensorFuture a = loader.Submit({file.path(), 100, {100, 100}, kFloat32});
+        TensorFuture b = loader.Submit({file.path(), 100 + 17 * sizeof(float), {3, 7}, kFloat32});
+        TensorFuture empty = loader.Submit({file.path(), 100, {0}, kFloat32});
+        Tensor tensor = a.Wait();
+        EXPECT_TRUE(a.IsReady());
+        EXPECT_EQ(tensor.shape()[1], 100);
+        EXPECT_TRUE(IsIota(tensor, 0));
+        EXPECT_TRUE(IsIota(b.Wait(), 17));
+        EXPECT_EQ(empty.Wait().numel(), 0);
+    }
+    // the tensors come from the environment allocator
+    EXPECT_GE(CPUCachingAllocator::Global()->GetStats().num_allocs - before.num_allocs, 9);
+}
+
+TEST(TensorLoader, Batch) {
+    TempFile file("tensor_loader_batch", 4096);
+    TensorLoader loader(2, 1000);
+    std::vector<TensorLoadRequest> requests;
+    for (int64_t i = 0; i < 16; ++i) {
+        requests.push_back({file.path(), 100 + i * 256 * static_cast<int64_t>(sizeof(float)), {256}, kFloat32});
+    }
+    std::vector<TensorFuture> futures = loader.Submit(requests);
+    ASSERT_EQ(futures.size(), 16);
+    for (int64_t i = 0; i < 16; ++i) {
+        EXPECT_TRUE(IsIota(futures[i].Wait(), i * 256));
+    }
+}
+
+TEST(TensorLoader, Callback) {
+    TempFile file("tensor_loader_callback", 1000);
+    std::atomic<int> num_loaded{0};
+    std::atomic<int> num_failed{0};
+    Function callback = Function::FromTyped([&](Any result) {
+        if (auto tensor = result.as<Tensor>()) {
+            num_loaded += IsIota(*tensor, 10) ? 1 : 0;
+        } else if (result.as<Error>()) {
+            ++num_failed;
+        }
+    });
+    {
+        TensorLoader loader(2, 512);
+        loader.Submit({file.path(), 100 + 10 * sizeof(float), {990}, kFloat32}, callback);
+        // past the end of the file
+        loader.Submit({file.path(), 100 + 10 * sizeof(float), {991}, kFloat32}, callback);
+    }
+    EXPECT_EQ(num_loaded.load(), 1);
+    EXPECT_EQ(num_failed.load(), 1);
+
+    Function load = Function::GetGlobalRequired("ffi.TensorLoaderLoad");
+    TensorFuture future = load(String(file.path()), 100 + 10 * sizeof(float), Shape({990}), kFloat32, callback)
+                                  .cast<TensorFuture>();
+    EXPECT_TRUE(IsIota(future.Wait(), 10));
+}
+
+TEST(TensorLoader, Errors) {
+    TempFile file("tensor_loader_errors", 100);
+    TensorLoader loader(2, 128);
+    TensorFuture truncated = loader.Submit({file.path(), 100, {101}, kFloat32});
+    EXPECT_THROW(truncated.Wait(), Error);
+    EXPECT_TRUE(truncated.IsReady());
+    EXPECT_THROW(loader.Submit({file.path(), -1, {1}, kFloat32}), Error);
+    EXPECT_THROW(loader.Submit({file.path() + ".missing", 0, {1}, kFloat32}), Error);
+    EXPECT_TRUE(IsIota(loader.Submit({file.path(), 100 + 99 * sizeof(float), {1}, kFloat32}).Wait(), 99));
+}
+
+}// namespace
@@ -0,0 +1,166 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/container/map.h"
+#include "ffi/extra/tensor_store.h"
+#include "ffi/function.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+namespace {
+
+using namespace litetvm::ffi;
+
+struct CPUNDAlloc {
+    void AllocData(DLTensor* tensor) {
+        tensor->data = malloc(GetDataSize(*tensor));
+    }
+
+    void FreeData(DLTensor* tensor) {
+        free(tensor->data);
+    }
+};
+
+Tensor Iota(Shape shape, float start = 0, DLDevice device = DLDevice({kDLCPU, 0})) {
+    Tensor tensor = Tensor::FromNDAlloc(CPUNDAlloc(), std::move(shape), DLDataType({kDLFloat, 32, 1}), device);
+    float* data = static_cast<float*>(tensor->data);
+    for (int64_t i = 0; i < tensor.numel(); ++i) {
+        data[i] = start + static_cast<float>(i);
+    }
+    return tensor;
+}
+
+float* Data(const Tensor& tensor) {
+    return reinterpret_cast<float*>(static_cast<char*>(tensor->data) + tensor->byte_offset);
+}
+
+TEST(TensorStore, Fingerprint) {
+    // several chunks and a partial stripe
+    Tensor a = Iota({3, 100001});
+    uint64_t fingerprint = TensorStore::Fingerprint(a);
+    EXPECT_EQ(TensorStore::Fingerprint(Iota({3, 100001})), fingerprint);
+    EXPECT_NE(TensorStore::Fingerprint(Iota({100001, 3})), fingerprint);
+    EXPECT_NE(TensorStore::Fingerprint(Iota({3, 100001}, 1)), fingerprint);
+
+    Tensor b = Iota({3, 100001});
+    Data(b)[250000] = -1.0f;
+    EXPECT_NE(TensorStore::Fingerprint(b), fingerprint);
+    // swapped 64 byte stripes
+    Tensor c = Iota({64});
+    Tensor d = Iota({64});
+    std::swap_ranges(Data(d), Data(d) + 16, Data(d) + 16);
+    EXPECT_NE(TensorStore::Fingerprint(c), TensorStore::Fingerprint(d));
+
+    Tensor matrix = Iota({40, 30});
+    EXPECT_EQ(TensorStore::Fingerprint(matrix.Permute({1, 0})),
+              TensorStore::Fingerprint(matrix.Permute({1, 0}).Contiguous()));
+    EXPECT_EQ(TensorStore::Fingerprint(Iota({0, 5})), TensorStore::Fingerprint(Iota({0, 5})));
+    EXPECT_NE(TensorStore::Fingerprint(Iota({0, 5})), TensorStore::Fingerprint(Iota({5, 0})));
+    EXPECT_THROW(TensorStore::Fingerprint(Iota({4}, 0, DLDevice({kDLCUDA, 0}))), Error);
+
+    Function fingerprint_func = Function::GetGlobalRequired("ffi.TensorFingerprint");
+    EXPECT_EQ(fingerprint_func(a).cast<int64_t>(), static_cast<int64_t>(fingerprint));
+}
+
+TEST(TensorStore, Intern) {
+    TensorStore store = TensorStore::Create();
+    Tensor a = store.Intern(Iota({256, 256}));
+    Tensor b = store.Intern(Iota({256, 256}));
+    EXPECT_TRUE(a.same_as(b));
+    EXPECT_FALSE(store.Intern(Iota({256, 256}, 1)).same_as(a));
+    EXPECT_FALSE(store.Intern(Iota({65536})).same_as(a));
+
+    Tensor matrix = Iota({20, 10});
+    Tensor transposed = store.Intern(matrix.Permute({1, 0}));
+    EXPECT_TRUE(transposed.IsContiguous());
+    EXPECT_EQ(Data(transposed)[1], 10.0f);
+    EXPECT_TRUE(store.Intern(matrix.Permute({1, 0}).Contiguous()).same_as(transposed));
+
+    TensorStoreObj::Stats stats = store->GetStats();
+    EXPECT_EQ(stats.num_interned, 6);
+    EXPECT_EQ(stats.num_deduplicated, 2);
+    EXPECT_EQ(stats.bytes_interned, 4 * 65536 * 4 + 2 * 200 * 4);
+    EXPECT_EQ(stats.bytes_deduplicated, 65536 * 4 + 200 * 4);
+    EXPECT_DOUBLE_EQ(stats.DedupRatio(), static_cast<double>(stats.bytes_interned) / (3 * 65536 * 4 + 200 * 4));
+
+    // released tensors leave the store
+    a = Tensor(nullptr);
+    b = Tensor(nullptr);
+    Tensor c = Iota({256, 256});
+    EXPECT_TRUE(store.Intern(c).same_as(c));
+    EXPECT_EQ(store->GetStats().num_deduplicated, 2);
+
+    EXPECT_THROW(store.Intern(Iota({4}, 0, DLDevice({kDLCUDA, 0}))), Error);
+}
+
+TEST(TensorStore, Concurrent) {
+    TensorStore store = TensorStore::Create();
+    std::vector<Tensor> results(8);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&, i]() { results[i] = store.Intern(Iota({1000}, static_cast<float>(i % 2))); });
+    }
+    for (std::thread& thread: threads) {
+        thread.join();
+    }
+    for (int i = 2; i < 8; ++i) {
+        EXPECT_TRUE(results[i].same_as(results[i % 2]));
+    }
+    EXPECT_EQ(store->GetStats().num_deduplicated, 6);
+}
+
+TEST(TensorStore, BackingFile) {
+    std::string path = (std::filesystem::temp_directory_path() / ("tensor_store_" + std::to_string(getpid()))).string();
+    {
+        Function create = Function::GetGlobalRequired("ffi.TensorStore");
+        TensorStore store = create(String(path)).cast<TensorStore>();
+        Tensor input = Iota({1000});
+        Tensor a = store.Intern(input);
+        EXPECT_NE(a->data, input->data);
+        EXPECT_EQ(Data(a)[999], 999.0f);
+        EXPECT_TRUE(a.IsAligned(4096));
+        Tensor b = store.Intern(Iota({3, 7}, 5));
+        EXPECT_EQ(Data(b)[20], 25.0f);
+        EXPECT_TRUE(store.Intern(Iota({1000})).same_as(a));
+        EXPECT_EQ(store.Intern(Iota({0})).numel(), 0);
+        EXPECT_EQ(std::filesystem::file_size(path), 4096 + 21 * 4);
+
+        Function get_stats = Function::GetGlobalRequired("ffi.TensorStoreGetStats");
+        Map<String, Any> stats = get_stats(store).cast<Map<String, Any>>();
+        EXPECT_EQ(stats.at("num_deduplicated").cast<int64_t>(), 1);
+        EXPECT_GT(stats.at("dedup_ratio").cast<double>(), 1.0);
+    }
+    std::filesystem::remove(path);
+    EXPECT_THROW(TensorStore::Create(String(path + "/missing/store")), Error);
+}
+
+TEST(TensorStore, ConcurrentBackingFile) {
+    std::string path =
+            (std::filesystem::temp_directory_path() / ("tensor_store_concurrent_" + std::to_string(getpid()))).string();
+    {
+        TensorStore store = TensorStore::Create(String(path));
+        std::vector<Tensor> results(8);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 8; ++i) {
+            threads.emplace_back([&, i]() { results[i] = store.Intern(Iota({4096}, static_cast<float>(i % 2))); });
+        }
+        for (std::thread& thread: threads) {
+            thread.join();
+        }
+        for (int i = 2; i < 8; ++i) {
+            EXPECT_TRUE(results[i].same_as(results[i % 2]));
+        }
+        EXPECT_EQ(Data(results[1])[4095], 4096.0f);
+        EXPECT_EQ(store->GetStats().num_deduplicated, 6);
+    }
+    std::filesystem::remove(path);
+}
+
+}// namespace
@@ -6,6 +6,8 @@
 
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+
 namespace {
 using namespace litetvm::ffi;
 using namespace litetvm::ffi::testing;
@@ -276,4 +278,110 @@ TEST(Array, Upcast) {
     static_assert(details::type_contains_v<Any, Array<float>>);
 }
 
+TEST(Array, Extend) {
+    Array<int> a = {1, 2};
+    std::vector<int> values = {3, 4, 5};
+    a.Extend(values);
+    EXPECT_EQ(a.size(), 5);
+    EXPECT_EQ(a.capacity(), 5);
+    EXPECT_EQ(a[4], 5);
+
+    // extending a shared array copies it once
+    Array<int> b = a;
+    b.Extend(values.begin(), values.begin() + 1);
+    EXPECT_EQ(a.size(), 5);
+    EXPECT_EQ(b.size(), 6);
+    EXPECT_EQ(b[5], 3);
+
+    // extending with itself
+    b.Extend(b);
+    EXPECT_EQ(b.size(), 12);
+    EXPECT_EQ(b[11], 3);
+
+    Array<Any> c;
+    c.Extend(a);
+    EXPECT_EQ(c.size(), 5);
+    EXPECT_EQ(c[2].cast<int>(), 3);
+
+    Array<int> d = Concat(a, Array<int>{6});
+    EXPECT_EQ(d.size(), 6);
+    EXPECT_EQ(d[5], 6);
+}
+
+TEST(Array, Filter) {
+    Array<int> a = {1, 2, 3, 4, 5};
+    Array<int> even = a.Filter([](int x) { return x % 2 == 0; });
+    EXPECT_EQ(even.size(), 2);
+    EXPECT_EQ(even[0], 2);
+    EXPECT_EQ(even[1], 4);
+    EXPECT_EQ(a.size(), 5);
+
+    // nothing removed, storage is shared
+    Array<int> all = a.Filter([](int x) { return x > 0; });
+    EXPECT_TRUE(all.same_as(a));
+    EXPECT_TRUE(a.Filter([](int x) { return x > 5; }).empty());
+    // the result is allocated at its final size
+    EXPECT_EQ(even.capacity(), 2);
+}
+
+TEST(Array, EraseIf) {
+    Array<int> a = {1, 2, 3, 4, 5};
+    const ArrayObj* arr = a.GetArrayObj();
+    EXPECT_EQ(a.EraseIf([](int x) { return x % 2 == 0; }), 2);
+    // uniquely owned arrays are compacted in place
+    EXPECT_EQ(a.GetArrayObj(), arr);
+    EXPECT_EQ(a.size(), 3);
+    EXPECT_EQ(a[0], 1);
+    EXPECT_EQ(a[1], 3);
+    EXPECT_EQ(a[2], 5);
+
+    Array<int> b = a;
+    EXPECT_EQ(b.EraseIf([](int x) { return x == 3; }), 1);
+    EXPECT_EQ(a.size(), 3);
+    EXPECT_EQ(b.size(), 2);
+    EXPECT_EQ(b[1], 5);
+    EXPECT_EQ(b.EraseIf([](int x) { return x > 10; }), 0);
+
+    // a throwing predicate leaves the array unchanged
+    auto throw_at_five = [](int x) {
+        if (x == 5) {
+            throw std::runtime_error("five");
+        }
+        return x == 1;
+    };
+    EXPECT_THROW(a.EraseIf(throw_at_five), std::runtime_error);
+    EXPECT_EQ(a.size(), 3);
+    EXPECT_EQ(a[0], 1);
+    EXPECT_EQ(a[1], 3);
+    EXPECT_EQ(a[2], 5);
+}
+
+TEST(Array, Builder) {
+    ArrayBuilder<int64_t> builder(2);
+    for (int64_t i = 0; i < 10; ++i) {
+        builder.push_back(i * i);
+    }
+    builder.emplace_back(100);
+    EXPECT_EQ(builder.size(), 11);
+    Array<int64_t> squares = std::move(builder).Build();
+    EXPECT_EQ(squares.size(), 11);
+    EXPECT_EQ(squares[3], 9);
+    EXPECT_EQ(squares[10], 100);
+
+    // the builder can be reused after building
+    EXPECT_TRUE(builder.empty());// NOLINT(*)
+    builder.push_back(1);
+    EXPECT_EQ(std::move(builder).Build().size(), 1);
+
+    ArrayBuilder<String> names;
+    names.reserve(3);
+    EXPECT_EQ(names.capacity(), 4);
+    names.push_back("a");
+    names.emplace_back("b");
+    Any any = std::move(names).Build();
+    auto arr = any.cast<Array<String>>();
+    EXPECT_EQ(arr[1], "b");
+    static_assert(!std::is_copy_constructible_v<ArrayBuilder<int>>);
+}
+
 }// namespace
\ No newline at end of file
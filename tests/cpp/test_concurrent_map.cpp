@@ -0,0 +1,109 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/container/concurrent_map.h"
+#include "ffi/function.h"
+#include "ffi/string.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace litetvm::ffi;
+
+TEST(ConcurrentMap, Basic) {
+    ConcurrentMap<String, int> m;
+    EXPECT_TRUE(m.empty());
+    m.Set("a", 1);
+    m.Set("b", 2);
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m.Get("a").value(), 1);
+    EXPECT_FALSE(m.Get("c").has_value());
+
+    m.Set("a", 10);
+    EXPECT_EQ(m.Get("a").value(), 10);
+    EXPECT_EQ(m.GetOrInsert("a", [](const String&) { return 100; }), 10);
+    EXPECT_EQ(m.GetOrInsert("c", [](const String& key) { return static_cast<int>(key.size()) + 2; }), 3);
+    EXPECT_EQ(m.size(), 3);
+
+    // handles share the content
+    ConcurrentMap<String, int> alias = m;
+    EXPECT_TRUE(alias.erase("a"));
+    EXPECT_FALSE(alias.erase("a"));
+    EXPECT_FALSE(m.Get("a").has_value());
+    m.clear();
+    EXPECT_TRUE(alias.empty());
+}
+
+TEST(ConcurrentMap, FactoryError) {
+    ConcurrentMap<int, int> m;
+    EXPECT_THROW(m.GetOrInsert(1, [](int) -> int { TVM_FFI_THROW(ValueError) << "failed"; }), Error);
+    EXPECT_FALSE(m.Get(1).has_value());
+    // the next caller retries the factory
+    EXPECT_EQ(m.GetOrInsert(1, [](int x) { return x + 1; }), 2);
+    EXPECT_EQ(m.Get(1).value(), 2);
+}
+
+TEST(ConcurrentMap, ReentrantGetOrInsert) {
+    ConcurrentMap<int, int> m;
+    // a factory asking for its own key would wait for itself
+    EXPECT_THROW(m.GetOrInsert(1, [&m](int x) { return m.GetOrInsert(x, [](int y) { return y; }); }), Error);
+    // other keys are fine
+    EXPECT_EQ(m.GetOrInsert(1, [&m](int x) { return m.GetOrInsert(x + 1, [](int y) { return y * 10; }) + 1; }), 21);
+}
+
+TEST(ConcurrentMap, ParallelGetOrInsert) {
+    constexpr int kNumThreads = 8;
+    constexpr int kNumKeys = 1000;
+    ConcurrentMap<int64_t, int64_t> m;
+    std::atomic<int> num_calls{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kNumThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kNumKeys; ++i) {
+                int64_t key = (i * 7 + t) % kNumKeys;
+                int64_t value = m.GetOrInsert(key, [&num_calls](int64_t k) {
+                    num_calls.fetch_add(1);
+                    return k * k;
+                });
+                EXPECT_EQ(value, key * key);
+                if (i % 10 == 0) {
+                    m.Set(kNumKeys + key, key);
+                }
+            }
+        });
+    }
+    for (auto& t: threads) {
+        t.join();
+    }
+    // every factory ran exactly once per key
+    EXPECT_EQ(num_calls.load(), kNumKeys);
+    EXPECT_EQ(m.Get(999).value(), 999 * 999);
+}
+
+TEST(ConcurrentMap, AnyConvert) {
+    ConcurrentMap<String, int64_t> m;
+    Any any = m;
+    EXPECT_EQ(any.type_index(), TypeIndex::kTVMFFIConcurrentMap);
+    EXPECT_TRUE((any.cast<ConcurrentMap<String, int64_t>>().same_as(m)));
+    EXPECT_THROW((Any(1).cast<ConcurrentMap<String, int64_t>>()), Error);
+
+    Function fget_or_insert = Function::GetGlobalRequired("ffi.ConcurrentMapGetOrInsert");
+    Function factory = Function::FromTyped([](String key) -> int64_t { return static_cast<int64_t>(key.size()); });
+    EXPECT_EQ(fget_or_insert(m, "abc", factory).cast<int64_t>(), 3);
+    EXPECT_EQ(m.GetOrInsert("abcd", factory), 4);
+    EXPECT_EQ(m.Get("abc").value(), 3);
+
+    Function fset = Function::GetGlobalRequired("ffi.ConcurrentMapSet");
+    fset(m, "x", 7);
+    Function fget = Function::GetGlobalRequired("ffi.ConcurrentMapGetItem");
+    EXPECT_EQ(fget(m, "x").cast<int64_t>(), 7);
+    EXPECT_THROW(fget(m, "y"), Error);
+    Function fsize = Function::GetGlobalRequired("ffi.ConcurrentMapSize");
+    EXPECT_EQ(fsize(m).cast<int64_t>(), 3);
+}
+
+}// namespace
@@ -0,0 +1,396 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/container/tensor.h"
+#include "ffi/function.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace litetvm::ffi;
+
+struct CPUNDAlloc {
+    void AllocData(DLTensor* tensor) {
+        tensor->data = malloc(GetDataSize(*tensor));
+    }
+
+    void FreeData(DLTensor* tensor) {
+        free(tensor->data);
+    }
+};
+
+Tensor Empty(Shape shape, DLDataType dtype) {
+    return Tensor::FromNDAlloc(CPUNDAlloc(), std::move(shape), dtype, DLDevice({kDLCPU, 0}));
+}
+
+// the elements of dtype in the bytes of values
+template<typename T>
+Tensor FromVector(const std::vector<T>& values, DLDataType dtype) {
+    Tensor tensor = Empty({static_cast<int64_t>(values.size() * sizeof(T) * 8 / dtype.bits)}, dtype);
+    std::memcpy(tensor->data, values.data(), values.size() * sizeof(T));
+    return tensor;
+}
+
+template<typename T>
+std::vector<T> ToVector(const Tensor& tensor) {
+    std::vector<T> values(GetDataSize(*tensor.get()) / sizeof(T));
+    std::memcpy(values.data(), static_cast<const char*>(tensor->data) + tensor->byte_offset,
+                values.size() * sizeof(T));
+    return values;
+}
+
+constexpr DLDataType kFloat32{kDLFloat, 32, 1};
+constexpr DLDataType kFloat64{kDLFloat, 64, 1};
+
+// reference float8 formats, decoded and rounded by brute force
+enum class Kind { kIEEE, kFN, kFNUZ, kE8M0 };
+
+struct Format {
+    uint8_t code;
+    const char* name;
+    int exp_bits;
+    int mant_bits;
+    int bias;
+    Kind kind;
+
+    DLDataType dtype() const {
+        return DLDataType{code, 8, 1};
+    }
+};
+
+const Format kFormats[] = {
+        {kDLFloat8_e3m4, "e3m4", 3, 4, 3, Kind::kIEEE},
+        {kDLFloat8_e4m3, "e4m3", 4, 3, 7, Kind::kIEEE},
+        {kDLFloat8_e4m3b11fnuz, "e4m3b11fnuz", 4, 3, 11, Kind::kFNUZ},
+        {kDLFloat8_e4m3fn, "e4m3fn", 4, 3, 7, Kind::kFN},
+        {kDLFloat8_e4m3fnuz, "e4m3fnuz", 4, 3, 8, Kind::kFNUZ},
+        {kDLFloat8_e5m2, "e5m2", 5, 2, 15, Kind::kIEEE},
+        {kDLFloat8_e5m2fnuz, "e5m2fnuz", 5, 2, 16, Kind::kFNUZ},
+        {kDLFloat8_e8m0fnu, "e8m0fnu", 8, 0, 127, Kind::kE8M0},
+};
+
+double RefDecode(const Format& format, int code) {
+    constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+    if (format.kind == Kind::kE8M0) {
+        return code == 255 ? kNaN : std::ldexp(1.0, code - 127);
+    }
+    int max_exp = (1 << format.exp_bits) - 1;
+    int max_mant = (1 << format.mant_bits) - 1;
+    int exp = (code >> format.mant_bits) & max_exp;
+    int mant = code & max_mant;
+    double sign = (code & 0x80) != 0 ? -1.0 : 1.0;
+    if (format.kind == Kind::kIEEE && exp == max_exp) {
+        return mant != 0 ? kNaN : sign * std::numeric_limits<double>::infinity();
+    }
+    if ((format.kind == Kind::kFN && exp == max_exp && mant == max_mant) ||
+        (format.kind == Kind::kFNUZ && code == 0x80)) {
+        return kNaN;
+    }
+    double value = exp == 0 ? std::ldexp(mant, 1 - format.bias - format.mant_bits)
+                            : std::ldexp((1 << format.mant_bits) + mant, exp - format.bias - format.mant_bits);
+    return sign * value;
+}
+
+int RefEncode(const Format& format, double x) {
+    if (std::isnan(x)) {
+        switch (format.kind) {
+            case Kind::kIEEE:
+                return (std::signbit(x) ? 0x80 : 0) | (((1 << format.exp_bits) - 1) << format.mant_bits) |
+                       (1 << (format.mant_bits - 1));
+            case Kind::kFN:
+                return std::signbit(x) ? 0xff : 0x7f;
+            default:
+                return format.kind == Kind::kFNUZ ? 0x80 : 0xff;
+        }
+    }
+    if (format.kind == Kind::kE8M0 && x != 0 && std::signbit(x)) {
+        return 0xff;
+    }
+    // the positive finite codes in increasing order, then the code past the largest value
+    std::vector<int> codes;
+    for (int code = 0; code < 128 || (format.kind == Kind::kE8M0 && code < 255); ++code) {
+        if (std::isfinite(RefDecode(format, code))) {
+            codes.push_back(code);
+        }
+    }
+    double max = RefDecode(format, codes.back());
+    double before_max = RefDecode(format, codes[codes.size() - 2]);
+    double past_max = format.mant_bits == 0 ? 2 * max : 2 * max - before_max;
+    int past_code = codes.back() + 1;
+
+    long double ax = std::fabs(static_cast<long double>(x));
+    int best = past_code;
+    if (ax < past_max) {
+        long double best_distance = std::fabs(ax - past_max);
+        for (int code: codes) {
+            long double distance = std::fabs(ax - static_cast<long double>(RefDecode(format, code)));
+            if (distance < best_distance || (distance == best_distance && code % 2 == 0)) {
+                best = code;
+                best_distance = distance;
+            }
+        }
+    }
+    if (format.kind == Kind::kE8M0 || (format.kind == Kind::kFNUZ && (best == 0 || best == past_code))) {
+        return best;
+    }
+    return best | (std::signbit(x) ? 0x80 : 0);
+}
+
+// values around every rounding boundary of a format
+std::vector<double> BoundaryInputs(const Format& format) {
+    std::vector<double> finite;
+    for (int code = 0; code < 256; ++code) {
+        double value = RefDecode(format, code);
+        if (std::isfinite(value) && !std::signbit(value)) {
+            finite.push_back(value);
+        }
+    }
+    std::sort(finite.begin(), finite.end());
+    double max = finite.back();
+    finite.push_back(format.mant_bits == 0 ? 2 * max : 2 * max - finite[finite.size() - 2]);
+
+    std::vector<double> inputs = {0.0, std::numeric_limits<double>::infinity(),
+                                  std::numeric_limits<double>::quiet_NaN(), 1e-30, 1e30, 3.0e38};
+    for (size_t i = 0; i < finite.size(); ++i) {
+        inputs.push_back(finite[i]);
+        if (i + 1 == finite.size()) {
+            break;
+        }
+        double mid = (finite[i] + finite[i + 1]) / 2;
+        float mid_float = static_cast<float>(mid);
+        inputs.push_back(mid);
+        inputs.push_back(std::nextafter(mid_float, 0.0f));
+        inputs.push_back(std::nextafter(mid_float, std::numeric_limits<float>::infinity()));
+        // not float, a float cast would round them to the tie
+        inputs.push_back(mid * (1 - 0x1p-40));
+        inputs.push_back(mid * (1 + 0x1p-40));
+    }
+    size_t num_positive = inputs.size();
+    for (size_t i = 0; i < num_positive; ++i) {
+        inputs.push_back(-inputs[i]);
+    }
+    return inputs;
+}
+
+TEST(DtypeConvert, Float8Decode) {
+    // every code of every format, bit exact
+    std::vector<uint8_t> codes(256);
+    for (int code = 0; code < 256; ++code) {
+        codes[code] = static_cast<uint8_t>(code);
+    }
+    for (const Format& format: kFormats) {
+        Tensor fp8 = FromVector(codes, format.dtype());
+        std::vector<float> values = ToVector<float>(fp8.AsType(kFloat32));
+        std::vector<double> wide = ToVector<double>(fp8.AsType(kFloat64));
+        for (int code = 0; code < 256; ++code) {
+            double expected = RefDecode(format, code);
+            if (std::isnan(expected)) {
+                ASSERT_TRUE(std::isnan(values[code])) << format.name << " code " << code;
+                ASSERT_TRUE(std::isnan(wide[code])) << format.name << " code " << code;
+            } else {
+                ASSERT_EQ(std::bit_cast<uint32_t>(values[code]), std::bit_cast<uint32_t>(static_cast<float>(expected)))
+                        << format.name << " code " << code;
+                ASSERT_EQ(std::bit_cast<uint64_t>(wide[code]), std::bit_cast<uint64_t>(expected))
+                        << format.name << " code " << code;
+            }
+        }
+    }
+}
+
+TEST(DtypeConvert, Float8Encode) {
+    for (const Format& format: kFormats) {
+        std::vector<double> inputs = BoundaryInputs(format);
+        std::vector<float> float_inputs;
+        for (double x: inputs) {
+            if (std::isnan(x) || static_cast<double>(static_cast<float>(x)) == x) {
+                float_inputs.push_back(static_cast<float>(x));
+            }
+        }
+        std::vector<uint8_t> from_double = ToVector<uint8_t>(FromVector(inputs, kFloat64).AsType(format.dtype()));
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            ASSERT_EQ(from_double[i], RefEncode(format, inputs[i])) << format.name << " input " << inputs[i];
+        }
+        std::vector<uint8_t> from_float = ToVector<uint8_t>(FromVector(float_inputs, kFloat32).AsType(format.dtype()));
+        for (size_t i = 0; i < float_inputs.size(); ++i) {
+            ASSERT_EQ(from_float[i], RefEncode(format, float_inputs[i])) << format.name << " input " << float_inputs[i];
+        }
+    }
+}
+
+TEST(DtypeConvert, Float8ToFloat8) {
+    // every code of every format to every format, and through bfloat16 and back
+    std::vector<uint8_t> codes(256);
+    for (int code = 0; code < 256; ++code) {
+        codes[code] = static_cast<uint8_t>(code);
+    }
+    for (const Format& src: kFormats) {
+        Tensor fp8 = FromVector(codes, src.dtype());
+        for (const Format& dst: kFormats) {
+            std::vector<uint8_t> result = ToVector<uint8_t>(fp8.AsType(dst.dtype()));
+            for (int code = 0; code < 256; ++code) {
+                double value = RefDecode(src, code);
+                if (std::isnan(value)) {
+                    ASSERT_TRUE(std::isnan(RefDecode(dst, result[code]))) << src.name << " to " << dst.name;
+                } else {
+                    ASSERT_EQ(result[code], RefEncode(dst, value)) << src.name << " to " << dst.name << " code " << code;
+                }
+            }
+        }
+        std::vector<uint8_t> back = ToVector<uint8_t>(fp8.AsType(DLDataType({kDLBfloat, 16, 1})).AsType(src.dtype()));
+        for (int code = 0; code < 256; ++code) {
+            if (!std::isnan(RefDecode(src, code))) {
+                ASSERT_EQ(back[code], code) << src.name;
+            }
+        }
+    }
+}
+
+TEST(DtypeConvert, Packed) {
+    DLDataType int4{kDLInt, 4, 1};
+    DLDataType uint4{kDLUInt, 4, 1};
+    DLDataType fp4{kDLFloat4_e2m1fn, 4, 1};
+
+    // rounding to nearest even, saturation and NaN, an odd number of elements
+    Tensor src = FromVector<float>({2.5f, 3.5f, -2.5f, 100.0f, -100.0f, std::nanf(""), 0.49f}, kFloat32);
+    Tensor packed = src.AsType(int4);
+    ASSERT_EQ(GetDataSize(*packed.get()), 4);
+    EXPECT_EQ(ToVector<uint8_t>(packed), std::vector<uint8_t>({0x42, 0x7e, 0x08, 0x00}));
+    EXPECT_EQ(ToVector<float>(packed.AsType(kFloat32)), std::vector<float>({2, 4, -2, 7, -8, 0, 0}));
+    EXPECT_EQ(ToVector<uint8_t>(src.AsType(uint4)), std::vector<uint8_t>({0x42, 0xf0, 0x00, 0x00}));
+    EXPECT_EQ(ToVector<int32_t>(packed.AsType(DLDataType({kDLInt, 32, 1}))),
+              std::vector<int32_t>({2, 4, -2, 7, -8, 0, 0}));
+
+    // every code of int4, uint4 and float4_e2m1fn
+    std::vector<uint8_t> codes;
+    for (int code = 0; code < 16; code += 2) {
+        codes.push_back(static_cast<uint8_t>(code | (code + 1) << 4));
+    }
+    std::vector<float> ints = ToVector<float>(FromVector(codes, int4).AsType(kFloat32));
+    std::vector<float> uints = ToVector<float>(FromVector(codes, uint4).AsType(kFloat32));
+    std::vector<float> fp4s = ToVector<float>(FromVector(codes, fp4).AsType(kFloat32));
+    const float kFp4Values[8] = {0.0f, 0.5f, 1.0f, 1.5f, 2.0f, 3.0f, 4.0f, 6.0f};
+    for (int code = 0; code < 16; ++code) {
+        EXPECT_EQ(ints[code], code < 8 ? code : code - 16);
+        EXPECT_EQ(uints[code], code);
+        EXPECT_EQ(std::bit_cast<uint32_t>(fp4s[code]),
+                  std::bit_cast<uint32_t>(code < 8 ? kFp4Values[code] : -kFp4Values[code - 8]));
+    }
+    for (DLDataType dtype: {int4, uint4, fp4}) {
+        Tensor tensor = FromVector(codes, dtype);
+        EXPECT_EQ(ToVector<uint8_t>(tensor.AsType(kFloat32).AsType(dtype)), codes);
+        EXPECT_EQ(ToVector<uint8_t>(tensor.AsType(DLDataType({kDLFloat, 16, 1})).AsType(dtype)), codes);
+    }
+    // float4_e2m1fn rounds to nearest even and saturates
+    Tensor fp4_src = FromVector<float>({0.25f, 0.75f, 2.5f, 5.0f, 1e9f, -7.0f, -0.0f, 1.25f}, kFloat32);
+    EXPECT_EQ(ToVector<float>(fp4_src.AsType(fp4).AsType(kFloat32)),
+              std::vector<float>({0.0f, 1.0f, 2.0f, 4.0f, 6.0f, -6.0f, -0.0f, 1.0f}));
+
+    EXPECT_THROW(FromVector<float>({1.0f}, kFloat32).AsType(DLDataType({kDLFloat6_e2m3fn, 6, 1})), Error);
+    EXPECT_THROW(Empty({4, 8}, int4).Permute({1, 0}).AsType(kFloat32), Error);
+    EXPECT_THROW(Tensor::FromNDAlloc(CPUNDAlloc(), {4}, kFloat32, DLDevice({kDLCUDA, 0})).AsType(int4), Error);
+}
+
+TEST(DtypeConvert, Quantize) {
+    // 3 channels of 4 elements
+    std::vector<float> values = {1, 2, 3, 4, 10, -20, 30, -40, 0.5f, 0.25f, -1.75f, 1};
+    Tensor tensor = Empty({3, 4}, kFloat32);
+    std::memcpy(tensor->data, values.data(), values.size() * sizeof(float));
+    Tensor per_channel = FromVector<float>({1.0f, 10.0f, 0.25f}, kFloat32);
+    Tensor q = tensor.Quantize(DLDataType({kDLInt, 4, 1}), per_channel);
+    EXPECT_TRUE(std::equal(q.shape().begin(), q.shape().end(), tensor.shape().begin()));
+    EXPECT_EQ(ToVector<float>(q.AsType(kFloat32)), std::vector<float>({1, 2, 3, 4, 1, -2, 3, -4, 2, 1, -7, 4}));
+    EXPECT_EQ(ToVector<float>(q.Dequantize(kFloat32, per_channel)),
+              std::vector<float>({1, 2, 3, 4, 10, -20, 30, -40, 0.5f, 0.25f, -1.75f, 1}));
+
+    // channels on the last axis, float8 and a per-tensor scale
+    Tensor per_column = FromVector<float>({1.0f, 2.0f, 4.0f, 8.0f}, kFloat32);
+    Tensor q8 = tensor.Quantize(DLDataType({kDLInt, 8, 1}), per_column, -1);
+    EXPECT_EQ(ToVector<int8_t>(q8), std::vector<int8_t>({1, 1, 1, 0, 10, -10, 8, -5, 0, 0, 0, 0}));
+    Tensor fp8 = tensor.Quantize(DLDataType({kDLFloat8_e4m3fn, 8, 1}), FromVector<float>({0.5f}, kFloat32));
+    EXPECT_EQ(ToVector<float>(fp8.Dequantize(kFloat32, FromVector<float>({0.5f}, kFloat32))), values);
+    Tensor bf16 = q.Dequantize(DLDataType({kDLBfloat, 16, 1}), per_channel, -2);
+    EXPECT_EQ(ToVector<float>(bf16.AsType(kFloat32)), ToVector<float>(q.Dequantize(kFloat32, per_channel)));
+
+    EXPECT_THROW(tensor.Quantize(DLDataType({kDLInt, 4, 1}), per_column), Error);
+    EXPECT_THROW(tensor.Quantize(DLDataType({kDLInt, 4, 1}), per_channel, 2), Error);
+    EXPECT_THROW(tensor.Quantize(DLDataType({kDLFloat, 16, 1}), per_channel), Error);
+    EXPECT_THROW(tensor.Dequantize(kFloat32, per_channel), Error);
+}
+
+TEST(DtypeConvert, QuantizeLarge) {
+    // large enough to run on the thread pool, with channels not aligned to the blocks
+    Tensor tensor = Empty({1001, 333}, kFloat32);
+    float* data = static_cast<float*>(tensor->data);
+    for (int64_t i = 0; i < tensor.numel(); ++i) {
+        data[i] = static_cast<float>(i % 15 - 7) * static_cast<float>(i / 333 % 5 + 1);
+    }
+    std::vector<float> scales;
+    for (int64_t c = 0; c < 1001; ++c) {
+        scales.push_back(static_cast<float>(c % 5 + 1));
+    }
+    Tensor scale = FromVector(scales, kFloat32);
+    Function quantize = Function::GetGlobalRequired("ffi.TensorQuantize");
+    Function dequantize = Function::GetGlobalRequired("ffi.TensorDequantize");
+    Tensor q = quantize(tensor, DLDataType({kDLInt, 4, 1}), scale, 0).cast<Tensor>();
+    Tensor back = dequantize(q, kFloat32, scale, 0).cast<Tensor>();
+    EXPECT_EQ(std::memcmp(back->data, tensor->data, tensor.numel() * sizeof(float)), 0);
+
+    Function as_type = Function::GetGlobalRequired("ffi.TensorAsType");
+    Tensor half = as_type(tensor, DLDataType({kDLFloat, 16, 1})).cast<Tensor>();
+    Tensor fp32 = as_type(half, kFloat32).cast<Tensor>();
+    EXPECT_EQ(std::memcmp(fp32->data, tensor->data, tensor.numel() * sizeof(float)), 0);
+    EXPECT_TRUE(as_type(tensor, kFloat32).cast<Tensor>().same_as(tensor));
+}
+
+TEST(DtypeConvert, VectorRows) {
+    // the vectorized contiguous rows match the scalar strided rows, NaNs included
+    std::mt19937 rng(42);
+    std::vector<uint32_t> bits(4099);
+    for (uint32_t& b: bits) {
+        b = rng();
+    }
+    bits[0] = 0x7f800001u;
+    bits[1] = 0xffc12345u;
+    bits[2] = 0x477ff000u;
+    bits[3] = 0x33000001u;
+    bits[4] = 0x80000000u;
+    bits[5] = 0x3f808000u;
+    int64_t n = static_cast<int64_t>(bits.size());
+    Tensor fp32 = FromVector(bits, kFloat32);
+    for (DLDataType dtype: {DLDataType({kDLFloat, 16, 1}), DLDataType({kDLBfloat, 16, 1})}) {
+        // every other element of a wide tensor is a strided row
+        Tensor contiguous = Empty({n}, dtype);
+        fp32.CopyTo(contiguous);
+        Tensor wide = Empty({n, 2}, dtype);
+        fp32.CreateView({n, 1}, kFloat32).CopyTo(wide.Slice(1, 0, 1));
+        std::vector<uint16_t> narrow = ToVector<uint16_t>(contiguous);
+        std::vector<uint16_t> scalar = ToVector<uint16_t>(wide);
+        for (int64_t i = 0; i < n; ++i) {
+            ASSERT_EQ(narrow[i], scalar[2 * i]) << "input " << std::hex << bits[i];
+        }
+
+        // all 65536 codes to float32, from a row not aligned to the vectors
+        std::vector<uint16_t> codes(65537);
+        for (uint32_t i = 0; i < 65536; ++i) {
+            codes[i + 1] = static_cast<uint16_t>(i);
+        }
+        Tensor src = FromVector(codes, dtype).CreateView({65536}, dtype, 2);
+        std::vector<uint32_t> decoded = ToVector<uint32_t>(src.AsType(kFloat32));
+        Tensor src_column = Empty({65536, 2}, dtype);
+        src.CreateView({65536, 1}, dtype).CopyTo(src_column.Slice(1, 0, 1));
+        Tensor column_decoded = Empty({65536, 1}, kFloat32);
+        src_column.Slice(1, 0, 1).CopyTo(column_decoded);
+        EXPECT_EQ(decoded, ToVector<uint32_t>(column_decoded));
+    }
+}
+
+}// namespace
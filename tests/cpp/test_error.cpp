@@ -3,10 +3,14 @@
 //
 #include "ffi/any.h"
 #include "ffi/error.h"
+#include "ffi/function.h"
 #include "ffi/optional.h"
 
 #include <gtest/gtest.h>
 
+#include <new>
+#include <string>
+
 namespace {
 using namespace litetvm::ffi;
 
@@ -99,6 +103,134 @@ TEST(CheckError, PassingCondition) {
 }
 
 
+TEST(Error, LazyTraceback) {
+    try {
+        ThrowRuntimeError();
+    } catch (const Error& error) {
+        // the raw traceback is symbolized on first access
+        const ErrorObj* obj = error.get();
+        EXPECT_EQ(obj->backtrace.size, 0);
+        std::string backtrace = error.backtrace();
+        EXPECT_NE(backtrace.find("ThrowRuntimeError"), std::string::npos);
+        EXPECT_EQ(error.backtrace(), backtrace);
+
+        Error copy = error;
+        TVMFFIByteArray extra{"extra\n", 6};
+        copy.UpdateBacktrace(&extra, kTVMFFIBacktraceUpdateModeAppend);
+        EXPECT_EQ(error.backtrace(), backtrace + "extra\n");
+        copy.UpdateBacktrace(&extra, kTVMFFIBacktraceUpdateModeReplace);
+        EXPECT_EQ(error.backtrace(), "extra\n");
+    }
+
+    // replacing before the first access discards the raw traceback
+    try {
+        ThrowRuntimeError();
+    } catch (Error& error) {
+        TVMFFIByteArray replaced{"replaced\n", 9};
+        error.UpdateBacktrace(&replaced, kTVMFFIBacktraceUpdateModeReplace);
+        EXPECT_EQ(error.backtrace(), "replaced\n");
+    }
+}
+
+TVM_FFI_NO_INLINE void CaptureHere(TVMFFIRawTraceback* raw) {
+    TVMFFITracebackCaptureRaw(__FILE__, __LINE__, TVM_FFI_FUNC_SIG, raw);
+    // the volatile read keeps the call from being a tail call, so this frame is still on the stack
+    static_cast<void>(*static_cast<volatile int32_t*>(&raw->num_frames));
+}
+
+TEST(Error, RawTracebackStart) {
+    TVMFFIRawTraceback raw;
+    CaptureHere(&raw);
+    if (raw.num_frames == 0) {
+        GTEST_SKIP() << "raw tracebacks are not supported";
+    }
+    // the most recent frame is the caller of the capture, not the capture itself
+    const TVMFFIByteArray* symbolized = TVMFFITracebackSymbolize(&raw);
+    std::string traceback(symbolized->data, symbolized->size);
+    std::string last_frame = traceback.substr(traceback.rfind("  File"));
+    EXPECT_NE(last_frame.find("CaptureHere"), std::string::npos) << traceback;
+    EXPECT_EQ(traceback.find("CaptureRaw"), std::string::npos) << traceback;
+}
+
+TEST(Error, RawTracebackOwnedByError) {
+    // errors thrown while the message of another one is formatted keep their own tracebacks
+    auto format_message = [] {
+        std::string message;
+        for (int i = 0; i < 8; ++i) {
+            try {
+                TVM_FFI_THROW(ValueError) << "inner";
+            } catch (Error& inner) {
+                message = inner.message();
+            }
+        }
+        return message;
+    };
+    try {
+        TVM_FFI_THROW(RuntimeError) << format_message();
+    } catch (Error& error) {
+        EXPECT_EQ(error.message(), "inner");
+        std::string backtrace = error.backtrace();
+        EXPECT_NE(backtrace.find("RawTracebackOwnedByError"), std::string::npos) << backtrace;
+        EXPECT_EQ(backtrace.find("lambda"), std::string::npos) << backtrace;
+    }
+}
+
+TEST(Error, CompactLayout) {
+    Error error("ValueError", "bad value", "backtrace\n");
+    const ErrorObj* obj = error.get();
+    // strings are stored right after each other in the object allocation
+    EXPECT_EQ(obj->message.data, obj->kind.data + obj->kind.size + 1);
+    EXPECT_EQ(obj->backtrace.data, obj->message.data + obj->message.size + 1);
+    EXPECT_EQ(error.kind(), "ValueError");
+    EXPECT_EQ(error.message(), "bad value");
+
+    TVMFFIByteArray extra{"extra\n", 6};
+    error.UpdateBacktrace(&extra, kTVMFFIBacktraceUpdateModeAppend);
+    EXPECT_EQ(error.backtrace(), "backtrace\nextra\n");
+    EXPECT_EQ(error.message(), "bad value");
+
+    // errors larger than a pooled block are allocated directly
+    std::string long_message(details::ErrorObjAllocator::kBlockSize * 2, 'x');
+    Error large("ValueError", long_message, "");
+    EXPECT_EQ(large.message(), long_message);
+}
+
+TEST(Error, PoolReuse) {
+    const void* first = Error("ValueError", "first", "").get();
+    const void* second = Error("ValueError", "second", "").get();
+    EXPECT_EQ(first, second);
+
+    // errors of different size classes do not share blocks
+    std::string medium(details::ErrorObjAllocator::kMinBlockSize * 2, 'x');
+    const void* small = Error("ValueError", "small", "").get();
+    const void* larger = Error("ValueError", medium, "").get();
+    EXPECT_EQ(small, first);
+    EXPECT_NE(larger, first);
+}
+
+TEST(Error, OutOfMemory) {
+    TVMFFIErrorSetRaisedOutOfMemory();
+    TVMFFIObjectHandle handle;
+    TVMFFIErrorMoveFromRaised(&handle);
+    Error error = details::ObjectUnsafe::ObjectRefFromObjectPtr<Error>(
+            details::ObjectUnsafe::ObjectPtrFromOwned<ErrorObj>(static_cast<TVMFFIObject*>(handle)));
+    EXPECT_EQ(error.kind(), "MemoryError");
+
+    // the error is shared, updates do not leak into other raises
+    TVMFFIByteArray extra{"extra\n", 6};
+    error.UpdateBacktrace(&extra, kTVMFFIBacktraceUpdateModeAppend);
+    EXPECT_EQ(error.backtrace(), "");
+
+    // bad_alloc thrown inside a safe call is reported as MemoryError
+    Function fthrow = Function::FromPacked([](const AnyView*, int32_t, Any*) { throw std::bad_alloc(); });
+    TVMFFIAny result;
+    result.type_index = kTVMFFINone;
+    EXPECT_EQ(TVMFFIFunctionCall(const_cast<FunctionObj*>(fthrow.get()), nullptr, 0, &result), -1);
+    TVMFFIErrorMoveFromRaised(&handle);
+    EXPECT_EQ(handle, error.get());
+    details::ObjectUnsafe::DecRefObjectHandle(handle);
+}
+
 TEST(Error, AnyConvert) {
     Any any = Error("TypeError", "here", "test0");
     Optional<Error> opt_err = any.as<Error>();
@@ -0,0 +1,98 @@
+//
+// Created by richard on 10/18/26.
+//
+#include "ffi/any.h"
+#include "ffi/error.h"
+#include "ffi/expected.h"
+#include "ffi/function.h"
+#include "ffi/reflection/registry.h"
+#include "ffi/string.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+using namespace litetvm::ffi;
+
+Expected<int64_t> CheckPositive(int64_t x) {
+    if (x <= 0) {
+        return Error("ValueError", "expect a positive value", "");
+    }
+    return x;
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+    namespace refl = litetvm::ffi::reflection;
+    refl::GlobalDef().def("testing.expected_check_positive", CheckPositive);
+}
+
+TEST(Expected, Basic) {
+    Expected<int64_t> ok = 1;
+    EXPECT_TRUE(ok.is_ok());
+    EXPECT_TRUE(static_cast<bool>(ok));
+    EXPECT_EQ(ok.value(), 1);
+    EXPECT_EQ(ok.value_or(2), 1);
+    EXPECT_THROW(ok.error(), Error);
+
+    Expected<String> err = Error("ValueError", "bad", "");
+    EXPECT_TRUE(err.is_err());
+    EXPECT_EQ(err.error().kind(), "ValueError");
+    EXPECT_EQ(err.value_or("fallback"), "fallback");
+    EXPECT_THROW(std::move(err).value(), Error);
+}
+
+TEST(Expected, TypedFunction) {
+    TypedFunction<Expected<int64_t>(int64_t)> fcheck = CheckPositive;
+    EXPECT_EQ(fcheck(2).value(), 2);
+
+    Expected<int64_t> res = fcheck(-1);
+    EXPECT_TRUE(res.is_err());
+    EXPECT_EQ(res.error().kind(), "ValueError");
+    EXPECT_EQ(res.error().message(), "expect a positive value");
+
+    // argument conversion errors are reported the same way
+    TypedFunction<Expected<int64_t>(String)> fmismatch = fcheck.packed();
+    Expected<int64_t> converted = fmismatch("x");
+    EXPECT_TRUE(converted.is_err());
+    EXPECT_EQ(converted.error().kind(), "TypeError");
+}
+
+TEST(Expected, GenericCallThrows) {
+    // callers that do not ask for Expected still see an exception
+    Function fcheck = Function::FromTyped(CheckPositive);
+    EXPECT_EQ(fcheck(3).cast<int64_t>(), 3);
+    EXPECT_THROW(
+            {
+                try {
+                    fcheck(0);
+                } catch (const Error& error) {
+                    EXPECT_EQ(error.kind(), "ValueError");
+                    throw;
+                }
+            },
+            Error);
+}
+
+TEST(Expected, FromThrowingFunction) {
+    // errors of regular functions are returned instead of thrown to the caller
+    TypedFunction<Expected<int64_t>(int64_t)> fthrow = Function::FromTyped([](int64_t x) -> int64_t {
+        if (x < 0) {
+            TVM_FFI_THROW(IndexError) << "negative index " << x;
+        }
+        return x;
+    });
+    EXPECT_EQ(fthrow(1).value(), 1);
+    Expected<int64_t> res = fthrow(-1);
+    EXPECT_TRUE(res.is_err());
+    EXPECT_EQ(res.error().kind(), "IndexError");
+}
+
+TEST(Expected, GlobalFunction) {
+    TypedFunction<Expected<int64_t>(int64_t)> fcheck =
+            Function::GetGlobalRequired("testing.expected_check_positive");
+    EXPECT_EQ(fcheck(5).value(), 5);
+    Expected<int64_t> res = fcheck(-5);
+    EXPECT_TRUE(res.is_err());
+    EXPECT_EQ(res.error().kind(), "ValueError");
+}
+
+}// namespace
@@ -4,6 +4,7 @@
 
 // #include "testing_object.h"
 #include "ffi/container/array.h"
+#include "ffi/dtype.h"
 #include "ffi/function.h"
 #include "ffi/object.h"
 #include "testing_object.h"
@@ -172,6 +173,42 @@ TEST(Func, TypedFunction) {
     fcheck_int(1);
 }
 
+TEST(Func, TypedFunctionPOD) {
+    TypedFunction<int64_t(int64_t, double, DLDataType, DLDevice, void*)> fpod =
+            [](int64_t a, double b, DLDataType dtype, DLDevice device, void* ptr) -> int64_t {
+        return a + static_cast<int64_t>(b) + dtype.bits + device.device_id + (ptr != nullptr);
+    };
+    int x = 0;
+    EXPECT_EQ(fpod(1, 2.0, DLDataType{kDLFloat, 32, 1}, DLDevice{kDLCPU, 3}, &x), 39);
+
+    TypedFunction<int64_t()> fzero = []() -> int64_t { return 7; };
+    EXPECT_EQ(fzero(), 7);
+
+    // implicit conversion of the return value goes through the slow path
+    TypedFunction<double(int64_t)> fconvert = Function::FromTyped([](int64_t a) -> int64_t { return a * 2; });
+    EXPECT_EQ(fconvert(2), 4.0);
+
+    // mismatched return values still raise a type error
+    TypedFunction<int64_t(int64_t)> fmismatch = Function::FromTyped([](int64_t) -> String { return "x"; });
+    EXPECT_THROW(
+            {
+                try {
+                    fmismatch(1);
+                } catch (const Error& error) {
+                    EXPECT_EQ(error.kind(), "TypeError");
+                    throw;
+                }
+            },
+            Error);
+
+    // object results are released when the signature returns void
+    TInt value(1);
+    TypedFunction<void(int64_t)> fvoid = Function::FromTyped([value](int64_t) -> TInt { return value; });
+    EXPECT_EQ(value.use_count(), 2);
+    fvoid(1);
+    EXPECT_EQ(value.use_count(), 2);
+}
+
 TEST(Func, Global) {
     Function::SetGlobal("testing.add1",
                         Function::FromTyped([](const int32_t& a) -> int { return a + 1; }));
@@ -352,4 +352,113 @@ TEST(Map, DuplicatedKeysInit) {
     EXPECT_EQ(map["a"], 3);
 }
 
+TEST(Map, SwissLayout) {
+    Map<String, int> m(MapObj::Layout::kSwiss, 0);
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.begin(), m.end());
+    std::vector<int> order;
+    for (int i = 0; i < 1000; ++i) {
+        int key = (i * 7919) % 1000;
+        m.Set("key" + std::to_string(key), key);
+        order.push_back(key);
+    }
+    EXPECT_EQ(m.size(), 1000);
+    EXPECT_EQ(m.count("key1000"), 0);
+    EXPECT_THROW(m.at("key1000"), Error);
+    // iteration keeps insertion order, also after erase and copy
+    for (int i = 0; i < 1000; i += 3) {
+        m.erase("key" + std::to_string(order[i]));
+    }
+    std::vector<int> expected;
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 3 != 0) expected.push_back(order[i]);
+    }
+    Map<String, int> copy = m;
+    for (const Map<String, int>& map: {m, copy}) {
+        size_t index = 0;
+        for (auto [k, v]: map) {
+            ASSERT_LT(index, expected.size());
+            EXPECT_EQ(k, "key" + std::to_string(expected[index]));
+            EXPECT_EQ(v, expected[index]);
+            ++index;
+        }
+        EXPECT_EQ(index, expected.size());
+    }
+    // a write to the copy appends to it and leaves the original alone
+    copy.Set("key0", -1);
+    EXPECT_EQ(copy.size(), expected.size() + 1);
+    EXPECT_EQ(copy["key0"], -1);
+    EXPECT_EQ((*--copy.end()).first, "key0");
+    EXPECT_EQ(m.count("key0"), 0);
+    // reverse iteration
+    auto it = m.end();
+    --it;
+    EXPECT_EQ((*it).second, expected.back());
+}
+
+TEST(Map, SwissLayoutChurn) {
+    // a sliding window of live keys, the erased entries are dropped on rehash
+    Map<int64_t, int64_t> m(MapObj::Layout::kSwiss, 64);
+    std::unordered_map<int64_t, int64_t> ref;
+    for (int64_t i = 0; i < 20000; ++i) {
+        m.Set(i, i);
+        ref[i] = i;
+        if (i >= 40) {
+            m.erase(i - 40);
+            ref.erase(i - 40);
+        }
+    }
+    EXPECT_EQ(m.size(), ref.size());
+    for (auto [k, v]: m) {
+        EXPECT_EQ(ref.at(k), v);
+    }
+    for (int64_t i = 0; i < 20000; ++i) {
+        EXPECT_EQ(m.count(i), ref.count(i));
+    }
+}
+
+TEST(Map, StringViewLookup) {
+    std::string short_str = "abc";
+    std::string long_str = "a key longer than the small string";
+    std::string_view short_key = short_str;
+    std::string_view long_key = long_str;
+    EXPECT_EQ(AnyHash()(short_key), AnyHash()(String(short_str)));
+    EXPECT_EQ(AnyHash()(long_key), AnyHash()(String(long_str)));
+    EXPECT_TRUE(AnyEqual()(Any(String(long_str)), long_key));
+    EXPECT_TRUE(AnyEqual()(short_key, Any(String(short_str))));
+    EXPECT_FALSE(AnyEqual()(Any(1), short_key));
+    EXPECT_FALSE(AnyEqual()(Any(Bytes("abc")), short_key));
+
+    // small, dense and swiss layouts
+    for (int n: {4, 100}) {
+        for (MapObj::Layout layout: {MapObj::Layout::kDense, MapObj::Layout::kSwiss}) {
+            Map<String, int> m(layout, 0);
+            for (int i = 0; i < n; ++i) {
+                m.Set(std::string(i % 2 == 0 ? "k" : "a long key number ") + std::to_string(i), i);
+            }
+            for (int i = 0; i < n; ++i) {
+                std::string key = std::string(i % 2 == 0 ? "k" : "a long key number ") + std::to_string(i);
+                std::string_view view = key;
+                TVMFFIByteArray bytes{key.data(), key.size()};
+                EXPECT_EQ(m.count(view), 1);
+                EXPECT_EQ(m.at(view), i);
+                EXPECT_EQ(m[bytes], i);
+                EXPECT_EQ((*m.find(bytes)).second, i);
+                EXPECT_EQ(m.Get(view).value(), i);
+            }
+            EXPECT_EQ(m.count(std::string_view("missing")), 0);
+            EXPECT_EQ(m.find(std::string_view("missing")), m.end());
+            EXPECT_FALSE(m.Get(std::string_view("missing")).has_value());
+            EXPECT_THROW(m.at(std::string_view("missing")), Error);
+        }
+    }
+
+    // keys of other types never match
+    Map<Any, int> mixed{{1, 1}, {String("x"), 2}, {Bytes("y"), 3}};
+    EXPECT_EQ(mixed.at(std::string_view("x")), 2);
+    EXPECT_EQ(mixed.count(std::string_view("y")), 0);
+    Map<String, int> empty;
+    EXPECT_EQ(empty.count(std::string_view("x")), 0);
+}
+
 }// namespace
\ No newline at end of file
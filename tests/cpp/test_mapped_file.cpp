@@ -0,0 +1,159 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/container/mapped_file.h"
+#include "ffi/function.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+namespace {
+
+using namespace litetvm::ffi;
+
+struct CPUNDAlloc {
+    void AllocData(DLTensor* tensor) {
+        tensor->data = malloc(GetDataSize(*tensor));
+    }
+
+    void FreeData(DLTensor* tensor) {
+        free(tensor->data);
+    }
+};
+
+Tensor Iota(Shape shape) {
+    Tensor tensor = Tensor::FromNDAlloc(CPUNDAlloc(), std::move(shape), DLDataType({kDLFloat, 32, 1}),
+                                        DLDevice({kDLCPU, 0}));
+    float* data = static_cast<float*>(tensor->data);
+    for (int64_t i = 0; i < tensor.numel(); ++i) {
+        data[i] = static_cast<float>(i);
+    }
+    return tensor;
+}
+
+const float* Data(const Tensor& tensor) {
+    return reinterpret_cast<const float*>(static_cast<const char*>(tensor->data) + tensor->byte_offset);
+}
+
+// file in the temp directory, removed at the end of the test
+class TempFile {
+public:
+    explicit TempFile(const std::string& name)
+        : path_((std::filesystem::temp_directory_path() / (name + "_" + std::to_string(getpid()))).string()) {}
+
+    ~TempFile() {
+        std::filesystem::remove(path_);
+    }
+
+    NODISCARD const std::string& path() const {
+        return path_;
+    }
+
+private:
+    std::string path_;
+};
+
+TEST(MappedFile, SaveLoad) {
+    TempFile file("tensor_file_save_load");
+    Tensor matrix = Iota({3, 5});
+    Map<String, Tensor> tensors;
+    tensors.Set("matrix", matrix);
+    tensors.Set("transposed", matrix.Permute({1, 0}));
+    tensors.Set("scalar", Iota({}));
+    tensors.Set("empty", Iota({0, 4}));
+    SaveTensorFile(file.path(), tensors);
+
+    Tensor loaded;
+    {
+        Map<String, Tensor> result = LoadTensorFile(file.path());
+        EXPECT_EQ(result.size(), 4);
+        loaded = result.at("transposed");
+        EXPECT_EQ(result.at("matrix").shape()[1], 5);
+        EXPECT_TRUE(result.at("matrix").IsAligned(4096));
+        EXPECT_EQ(std::memcmp(Data(result.at("matrix")), Data(matrix), 15 * sizeof(float)), 0);
+        EXPECT_EQ(Data(result.at("scalar"))[0], 0.0f);
+        EXPECT_EQ(result.at("empty").numel(), 0);
+    }
+    // the tensors keep the mapping alive
+    EXPECT_TRUE(loaded.IsContiguous());
+    EXPECT_EQ(loaded.shape()[0], 5);
+    EXPECT_EQ(Data(loaded)[1], 5.0f);
+    EXPECT_EQ(Data(loaded)[14], 14.0f);
+
+    // writes are private to the mapping
+    const_cast<float*>(Data(loaded))[1] = -1.0f;
+    EXPECT_EQ(Data(LoadTensorFile(file.path()).at("transposed"))[1], 5.0f);
+
+    Function save = Function::GetGlobalRequired("ffi.SaveTensorFile");
+    Function load = Function::GetGlobalRequired("ffi.LoadTensorFile");
+    Map<String, Tensor> single;
+    single.Set("x", Iota({7}));
+    save(String(file.path()), single);
+    Map<String, Tensor> result = load(String(file.path())).cast<Map<String, Tensor>>();
+    EXPECT_EQ(Data(result.at("x"))[6], 6.0f);
+}
+
+TEST(MappedFile, Options) {
+    TempFile file("tensor_file_options");
+    Map<String, Tensor> tensors;
+    tensors.Set("a", Iota({1 << 16}));
+    tensors.Set("b", Iota({33, 17}));
+    SaveTensorFile(file.path(), tensors);
+
+    MapOptions populate;
+    populate.populate = true;
+    MapOptions read_ahead;
+    read_ahead.read_ahead = true;
+    read_ahead.advice = MapOptions::Advice::kSequential;
+    MapOptions random;
+    random.advice = MapOptions::Advice::kRandom;
+    for (const MapOptions& options: {populate, read_ahead, random}) {
+        Map<String, Tensor> result = LoadTensorFile(file.path(), options);
+        EXPECT_EQ(Data(result.at("a"))[(1 << 16) - 1], static_cast<float>((1 << 16) - 1));
+        EXPECT_EQ(Data(result.at("b"))[33 * 17 - 1], static_cast<float>(33 * 17 - 1));
+    }
+    // the read-ahead thread stops when the mapping is released early
+    LoadTensorFile(file.path(), read_ahead);
+}
+
+TEST(MappedFile, LoadMapped) {
+    TempFile file("tensor_file_raw");
+    Tensor values = Iota({8});
+    {
+        std::ofstream out(file.path(), std::ios::binary);
+        std::string prefix(100, 'x');
+        out.write(prefix.data(), prefix.size());
+        out.write(static_cast<const char*>(values->data), 8 * sizeof(float));
+    }
+    Tensor tensor = Tensor::LoadMapped(file.path(), 100, {2, 4}, DLDataType({kDLFloat, 32, 1}));
+    EXPECT_EQ(Data(tensor)[0], 0.0f);
+    EXPECT_EQ(Data(tensor)[7], 7.0f);
+    MapOptions options;
+    options.populate = true;
+    tensor = Tensor::LoadMapped(file.path(), 100 + 4 * sizeof(float), {4}, DLDataType({kDLFloat, 32, 1}), options);
+    EXPECT_EQ(Data(tensor)[0], 4.0f);
+
+    MappedFile mapped = MappedFile::Open(file.path(), MapOptions(), 100);
+    EXPECT_EQ(mapped->size(), 8 * sizeof(float));
+    EXPECT_EQ(Data(mapped.ToTensor(4, {1}, DLDataType({kDLFloat, 32, 1})))[0], 1.0f);
+    EXPECT_THROW(mapped.ToTensor(4, {8}, DLDataType({kDLFloat, 32, 1})), Error);
+
+    EXPECT_THROW(Tensor::LoadMapped(file.path(), 100, {9}, DLDataType({kDLFloat, 32, 1})), Error);
+    EXPECT_THROW(Tensor::LoadMapped(file.path(), -1, {1}, DLDataType({kDLFloat, 32, 1})), Error);
+    EXPECT_THROW(Tensor::LoadMapped(file.path() + ".missing", 0, {1}, DLDataType({kDLFloat, 32, 1})), Error);
+    // not a tensor file, and a truncated one
+    EXPECT_THROW(LoadTensorFile(file.path()), Error);
+    {
+        std::ofstream out(file.path(), std::ios::binary | std::ios::trunc);
+        out.write("LTVMTENS\1\0\0\0\5\0", 14);
+    }
+    EXPECT_THROW(LoadTensorFile(file.path()), Error);
+}
+
+}// namespace
@@ -0,0 +1,111 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/container/persistent_array.h"
+#include "ffi/function.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+using namespace litetvm::ffi;
+
+TEST(PersistentArray, Basic) {
+    PersistentArray<int> a = {1, 2, 3};
+    EXPECT_EQ(a.size(), 3);
+    EXPECT_EQ(a[0], 1);
+    EXPECT_EQ(a.back(), 3);
+    EXPECT_THROW(a[3], Error);
+
+    PersistentArray<int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+TEST(PersistentArray, PushPopAcrossLevels) {
+    // cover the tail, a leaf root and two inner levels
+    constexpr int kNum = 40000;
+    PersistentArray<int> a;
+    for (int i = 0; i < kNum; ++i) {
+        a.push_back(i);
+    }
+    EXPECT_EQ(a.size(), kNum);
+    for (int i = 0; i < kNum; i += 7) {
+        EXPECT_EQ(a[i], i);
+    }
+    int expected = 0;
+    for (int x: a) {
+        EXPECT_EQ(x, expected++);
+    }
+    EXPECT_EQ(expected, kNum);
+
+    for (int i = kNum - 1; i >= 0; --i) {
+        EXPECT_EQ(a.back(), i);
+        a.pop_back();
+    }
+    EXPECT_TRUE(a.empty());
+    EXPECT_THROW(a.pop_back(), Error);
+}
+
+TEST(PersistentArray, Versions) {
+    PersistentArray<int> v0;
+    for (int i = 0; i < 2000; ++i) {
+        v0.push_back(i);
+    }
+    std::vector<PersistentArray<int>> versions = {v0};
+    for (int i = 0; i < 100; ++i) {
+        PersistentArray<int> next = versions.back();
+        next.Set(i * 17, -i);
+        if (i % 10 == 0) {
+            next.pop_back();
+        } else {
+            next.push_back(i);
+        }
+        versions.push_back(next);
+    }
+    // older versions are not affected by updates of newer ones
+    EXPECT_EQ(versions[0].size(), 2000);
+    for (int i = 0; i < 2000; ++i) {
+        EXPECT_EQ(versions[0][i], i);
+    }
+    EXPECT_EQ(versions[1][0], 0);
+    EXPECT_EQ(versions[1].size(), 1999);
+    EXPECT_EQ(versions[2][17], -1);
+    EXPECT_EQ(versions[1][17], 17);
+    EXPECT_EQ(versions[100][99 * 17], -99);
+
+    // uniquely owned arrays are updated in place
+    PersistentArray<int> unique = versions[0];
+    versions.clear();
+    v0 = PersistentArray<int>();
+    const PersistentArrayObj* obj = unique.get();
+    unique.Set(5, 100);
+    EXPECT_EQ(unique.get(), obj);
+    EXPECT_EQ(unique[5], 100);
+}
+
+TEST(PersistentArray, AnyConvert) {
+    PersistentArray<int> a = {1, 2, 3};
+    Any any = a;
+    EXPECT_EQ(any.type_index(), TypeIndex::kTVMFFIPersistentArray);
+    auto b = any.cast<PersistentArray<int>>();
+    EXPECT_TRUE(b.same_as(a));
+    auto c = any.cast<PersistentArray<double>>();
+    EXPECT_DOUBLE_EQ(c[1], 2.0);
+    EXPECT_THROW(any.cast<PersistentArray<String>>(), Error);
+
+    Array<int> arr = a.ToArray();
+    EXPECT_EQ(arr.size(), 3);
+    EXPECT_EQ(arr[2], 3);
+    EXPECT_EQ(PersistentArray<int>(arr)[2], 3);
+
+    Function fsize = Function::GetGlobalRequired("ffi.PersistentArraySize");
+    EXPECT_EQ(fsize(a).cast<int64_t>(), 3);
+    Function fset = Function::GetGlobalRequired("ffi.PersistentArraySetItem");
+    auto d = fset(a, 0, 10).cast<PersistentArray<int>>();
+    EXPECT_EQ(d[0], 10);
+    EXPECT_EQ(a[0], 1);
+}
+
+}// namespace
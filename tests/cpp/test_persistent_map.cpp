@@ -0,0 +1,113 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/container/persistent_map.h"
+#include "ffi/function.h"
+#include "ffi/string.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+using namespace litetvm::ffi;
+
+TEST(PersistentMap, Basic) {
+    PersistentMap<String, int> m = {{"a", 1}, {"b", 2}};
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m["a"], 1);
+    EXPECT_EQ(m.count("b"), 1);
+    EXPECT_EQ(m.count("c"), 0);
+    EXPECT_FALSE(m.Get("c").has_value());
+    EXPECT_THROW(m.at("c"), Error);
+
+    m.Set("a", 10);
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m["a"], 10);
+    m.erase("a");
+    m.erase("not-there");
+    EXPECT_EQ(m.size(), 1);
+    EXPECT_EQ(m.count("a"), 0);
+}
+
+TEST(PersistentMap, ManyEntries) {
+    constexpr int kNum = 20000;
+    PersistentMap<int64_t, int64_t> m;
+    std::unordered_map<int64_t, int64_t> ref;
+    for (int64_t i = 0; i < kNum; ++i) {
+        m.Set(i * 7919, i);
+        ref[i * 7919] = i;
+    }
+    EXPECT_EQ(m.size(), kNum);
+    int64_t visited = 0;
+    for (auto [k, v]: m) {
+        EXPECT_EQ(ref.at(k), v);
+        ++visited;
+    }
+    EXPECT_EQ(visited, kNum);
+
+    for (int64_t i = 0; i < kNum; i += 2) {
+        m.erase(i * 7919);
+    }
+    EXPECT_EQ(m.size(), kNum / 2);
+    for (int64_t i = 0; i < kNum; ++i) {
+        EXPECT_EQ(m.count(i * 7919), i % 2);
+    }
+    for (int64_t i = 1; i < kNum; i += 2) {
+        m.erase(i * 7919);
+    }
+    EXPECT_TRUE(m.empty());
+    EXPECT_TRUE(m.begin() == m.end());
+}
+
+TEST(PersistentMap, Versions) {
+    PersistentMap<String, int64_t> v0;
+    for (int64_t i = 0; i < 1000; ++i) {
+        v0.Set("sym" + std::to_string(i), i);
+    }
+    std::vector<PersistentMap<String, int64_t>> versions = {v0};
+    for (int64_t i = 0; i < 200; ++i) {
+        PersistentMap<String, int64_t> next = versions.back();
+        next.Set("sym" + std::to_string(i), -i);
+        next.erase("sym" + std::to_string(999 - i));
+        next.Set("new" + std::to_string(i), i);
+        versions.push_back(next);
+    }
+    EXPECT_EQ(versions[0].size(), 1000);
+    for (int64_t i = 0; i < 1000; ++i) {
+        EXPECT_EQ(versions[0]["sym" + std::to_string(i)], i);
+    }
+    EXPECT_EQ(versions[1]["sym0"], 0);
+    EXPECT_EQ(versions[2]["sym1"], -1);
+    EXPECT_EQ(versions[1]["sym1"], 1);
+    EXPECT_EQ(versions[200].size(), 1000);
+    EXPECT_EQ(versions[200].count("sym800"), 0);
+    EXPECT_EQ(versions[199].count("sym800"), 1);
+    EXPECT_EQ(versions[200]["new199"], 199);
+}
+
+TEST(PersistentMap, AnyConvert) {
+    PersistentMap<String, int> m = {{"x", 1}, {"y", 2}};
+    Any any = m;
+    EXPECT_EQ(any.type_index(), TypeIndex::kTVMFFIPersistentMap);
+    EXPECT_TRUE((any.cast<PersistentMap<String, int>>().same_as(m)));
+    auto converted = any.cast<PersistentMap<String, double>>();
+    EXPECT_DOUBLE_EQ(converted["y"], 2.0);
+    EXPECT_THROW((any.cast<PersistentMap<int, int>>()), Error);
+
+    Map<String, int> regular = m.ToMap();
+    EXPECT_EQ(regular.size(), 2);
+    EXPECT_EQ(regular["x"], 1);
+    EXPECT_EQ((PersistentMap<String, int>(regular)["y"]), 2);
+
+    Function fset = Function::GetGlobalRequired("ffi.PersistentMapSet");
+    auto m2 = fset(m, "z", 3).cast<PersistentMap<String, int>>();
+    EXPECT_EQ(m2.size(), 3);
+    EXPECT_EQ(m.size(), 2);
+    Function fget = Function::GetGlobalRequired("ffi.PersistentMapGetItem");
+    EXPECT_EQ(fget(m2, "z").cast<int>(), 3);
+}
+
+}// namespace
@@ -0,0 +1,130 @@
+//
+// Created by richard on 10/18/26.
+//
+#include "ffi/container/pod_array.h"
+#include "ffi/dtype.h"
+#include "ffi/function.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+namespace {
+using namespace litetvm::ffi;
+
+TEST(PODArray, Basic) {
+    PODArray<int64_t> arr = {1, 2, 3};
+    EXPECT_EQ(arr.size(), 3);
+    EXPECT_EQ(arr[1], 2);
+    EXPECT_EQ(arr.at(2), 3);
+    EXPECT_THROW(arr.at(3), Error);
+    std::span<const int64_t> view = arr.span();
+    EXPECT_EQ(std::accumulate(view.begin(), view.end(), int64_t{0}), 6);
+
+    // elements are stored right after the object
+    EXPECT_EQ(static_cast<const void*>(arr.data()), static_cast<const void*>(arr.get() + 1));
+    EXPECT_EQ(arr.get()->type_index(), TypeIndex::kTVMFFIPODArray);
+
+    PODArray<double> filled(4, 0.5);
+    EXPECT_EQ(filled.size(), 4);
+    EXPECT_EQ(filled[3], 0.5);
+
+    std::vector<bool> bits = {true, false, true};
+    PODArray<bool> flags(bits.begin(), bits.end());
+    EXPECT_EQ(flags.size(), 3);
+    EXPECT_TRUE(flags[0]);
+    EXPECT_FALSE(flags[1]);
+
+    EXPECT_TRUE(PODArray<int64_t>().empty());
+}
+
+TEST(PODArray, COW) {
+    PODArray<int64_t> arr = {1, 2, 3};
+    PODArray<int64_t> arr2 = arr;
+    arr.Set(0, 10);
+    EXPECT_EQ(arr[0], 10);
+    EXPECT_EQ(arr2[0], 1);
+    EXPECT_EQ(arr.use_count(), 1);
+    // unique arrays are updated in place
+    const int64_t* data = arr.data();
+    arr.MutableSpan()[1] = 20;
+    EXPECT_EQ(arr.data(), data);
+    EXPECT_EQ(arr[1], 20);
+}
+
+TEST(PODArray, ArrayConversion) {
+    PODArray<double> arr = {1.5, 2.5};
+    Array<Any> boxed = arr.ToArray();
+    EXPECT_EQ(boxed.size(), 2);
+    EXPECT_EQ(boxed[1].cast<double>(), 2.5);
+
+    PODArray<double> unboxed = PODArray<double>::FromArray(boxed);
+    EXPECT_EQ(unboxed.size(), 2);
+    EXPECT_EQ(unboxed[0], 1.5);
+
+    // ints are converted to double
+    EXPECT_EQ(PODArray<double>::FromArray(Array<Any>{1, 2})[1], 2.0);
+    EXPECT_FALSE(PODArray<int64_t>::TryFromArray(Array<Any>{1, "x"}).has_value());
+    EXPECT_THROW(PODArray<int64_t>::FromArray(Array<Any>{1, "x"}), Error);
+}
+
+TEST(PODArray, AnyConvert) {
+    PODArray<int64_t> arr = {1, 2, 3};
+    Any any = arr;
+    EXPECT_EQ(any.type_index(), TypeIndex::kTVMFFIPODArray);
+
+    // zero-copy when the element type matches
+    PODArray<int64_t> back = any.cast<PODArray<int64_t>>();
+    EXPECT_TRUE(back.same_as(arr));
+
+    // boxed and unboxed arrays convert into each other
+    Array<int64_t> boxed = any.cast<Array<int64_t>>();
+    EXPECT_EQ(boxed.size(), 3);
+    EXPECT_EQ(boxed[2], 3);
+    Array<double> as_double = any.cast<Array<double>>();
+    EXPECT_EQ(as_double[0], 1.0);
+    EXPECT_FALSE(any.try_cast<Array<String>>().has_value());
+
+    Any boxed_any = Array<Any>{4, 5};
+    EXPECT_EQ(boxed_any.cast<PODArray<int64_t>>()[1], 5);
+    EXPECT_EQ(boxed_any.cast<PODArray<double>>()[0], 4.0);
+    EXPECT_EQ(any.cast<PODArray<double>>()[2], 3.0);
+}
+
+TEST(PODArray, TypedFunction) {
+    Function fsum = Function::FromTyped([](PODArray<int64_t> arr) {
+        std::span<const int64_t> view = arr.span();
+        return std::accumulate(view.begin(), view.end(), int64_t{0});
+    });
+    EXPECT_EQ(fsum(PODArray<int64_t>{1, 2, 3}).cast<int64_t>(), 6);
+    EXPECT_EQ(fsum(Array<int64_t>{4, 5}).cast<int64_t>(), 9);
+
+    // existing signatures taking Array accept unboxed arrays
+    Function fsize = Function::FromTyped([](Array<int64_t> arr) { return static_cast<int64_t>(arr.size()); });
+    EXPECT_EQ(fsize(PODArray<int64_t>{1, 2, 3}).cast<int64_t>(), 3);
+    EXPECT_THROW(fsize(PODArray<double>{0.5}), Error);
+
+    Function fbox = Function::GetGlobalRequired("ffi.PODArrayToArray");
+    Array<Any> boxed = fbox(PODArray<bool>{true, false}).cast<Array<Any>>();
+    EXPECT_EQ(boxed[0].cast<bool>(), true);
+}
+
+TEST(PODArray, FromArrayDType) {
+    Function fpod = Function::GetGlobalRequired("ffi.PODArrayFromArray");
+    Any arr = fpod(Array<Any>{1, 2}, DLDataType({kDLInt, 64, 1}));
+    EXPECT_EQ(arr.cast<PODArray<int64_t>>()[1], 2);
+    EXPECT_EQ(fpod(Array<Any>{true}, DLDataType({kDLBool, 8, 1})).cast<PODArray<bool>>()[0], true);
+
+    // element types other than the stored ones are rejected instead of widened
+    EXPECT_THROW(fpod(Array<Any>{1, 2}, DLDataType({kDLInt, 32, 1})), Error);
+    EXPECT_THROW(fpod(Array<Any>{1.5}, DLDataType({kDLFloat, 32, 1})), Error);
+    EXPECT_THROW(fpod(Array<Any>{1, 2}, DLDataType({kDLInt, 64, 2})), Error);
+
+    // the zero-copy cast requires the exact element type
+    EXPECT_TRUE(details::PODArrayElemTraits<int64_t>::Match(DLDataType({kDLInt, 64, 1})));
+    EXPECT_FALSE(details::PODArrayElemTraits<int64_t>::Match(DLDataType({kDLInt, 32, 1})));
+    EXPECT_FALSE(details::PODArrayElemTraits<double>::Match(DLDataType({kDLFloat, 64, 4})));
+}
+
+}// namespace
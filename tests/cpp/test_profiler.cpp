@@ -0,0 +1,110 @@
+//
+// Created by richard on 10/18/26.
+//
+#include "ffi/container/array.h"
+#include "ffi/container/map.h"
+#include "ffi/function.h"
+#include "ffi/profiler.h"
+#include "ffi/reflection/registry.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace {
+using namespace litetvm::ffi;
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+    namespace refl = litetvm::ffi::reflection;
+    refl::GlobalDef().def("testing.profiler_add", [](int64_t a, int64_t b) { return a + b; });
+}
+
+int64_t GetCount(const Map<String, Any>& report, const String& name) {
+    auto it = report.find(name);
+    if (it == report.end()) return 0;
+    return (*it).second.cast<Map<String, Any>>().at("count").cast<int64_t>();
+}
+
+TEST(Profiler, RecordGlobalFunction) {
+    Profiler::Start();
+    Function fadd = Function::GetGlobalRequired("testing.profiler_add");
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(fadd(i, 1).cast<int64_t>(), i + 1);
+    }
+    Profiler::Stop();
+    // calls after stop are not recorded
+    fadd(1, 2);
+
+    Map<String, Any> report = Profiler::Report();
+    EXPECT_EQ(GetCount(report, "testing.profiler_add"), 10);
+    auto stats = report.at("testing.profiler_add").cast<Map<String, Any>>();
+    int64_t total_ns = stats.at("total_ns").cast<int64_t>();
+    EXPECT_EQ(stats.at("arg_conversion_ns").cast<int64_t>() + stats.at("body_ns").cast<int64_t>(), total_ns);
+    EXPECT_LE(stats.at("min_ns").cast<int64_t>(), stats.at("p50_ns").cast<int64_t>());
+    EXPECT_LE(stats.at("p99_ns").cast<int64_t>(), stats.at("max_ns").cast<int64_t>());
+
+    int64_t histogram_count = 0;
+    for (const Array<int64_t>& bucket: stats.at("histogram").cast<Array<Array<int64_t>>>()) {
+        histogram_count += bucket[1];
+    }
+    EXPECT_EQ(histogram_count, 10);
+}
+
+TEST(Profiler, MergeThreads) {
+    Profiler::Start();
+    Function fadd = Function::GetGlobalRequired("testing.profiler_add");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&fadd]() {
+            for (int i = 0; i < 25; ++i) {
+                fadd(i, i);
+            }
+        });
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    Profiler::Stop();
+    EXPECT_EQ(GetCount(Profiler::Report(), "testing.profiler_add"), 100);
+
+    // restarting clears the previous statistics
+    Profiler::Start();
+    Profiler::Stop();
+    EXPECT_EQ(GetCount(Profiler::Report(), "testing.profiler_add"), 0);
+}
+
+TEST(Profiler, FetchedBeforeStart) {
+    // lookups return the registered function itself, profiling or not
+    Function fadd = Function::GetGlobalRequired("testing.profiler_add");
+    Profiler::Start();
+    EXPECT_TRUE(fadd.same_as(Function::GetGlobalRequired("testing.profiler_add")));
+    // the reference fetched before Start is recorded as well
+    fadd(1, 2);
+    Profiler::Stop();
+    EXPECT_TRUE(fadd.same_as(Function::GetGlobalRequired("testing.profiler_add")));
+    EXPECT_EQ(GetCount(Profiler::Report(), "testing.profiler_add"), 1);
+}
+
+TEST(Profiler, Track) {
+    Function f = Function::FromTyped([](int64_t x) { return x + 1; });
+    Profiler::Track("testing.profiler_tracked", f);
+    Profiler::Start();
+    EXPECT_EQ(f(1).cast<int64_t>(), 2);
+    Profiler::Stop();
+    EXPECT_EQ(f(1).cast<int64_t>(), 2);
+    EXPECT_EQ(GetCount(Profiler::Report(), "testing.profiler_tracked"), 1);
+}
+
+TEST(Profiler, Wrap) {
+    Function f = Function::FromPacked([](PackedArgs args, Any* rv) { *rv = args.size(); });
+    Function wrapped = Profiler::Wrap("testing.profiler_packed", f);
+    Profiler::Start();
+    EXPECT_EQ(wrapped(1, 2, 3).cast<int>(), 3);
+    Profiler::Stop();
+    auto stats = Profiler::Report().at("testing.profiler_packed").cast<Map<String, Any>>();
+    EXPECT_EQ(stats.at("count").cast<int64_t>(), 1);
+    // packed functions do not report a conversion phase
+    EXPECT_EQ(stats.at("arg_conversion_ns").cast<int64_t>(), 0);
+}
+
+}// namespace
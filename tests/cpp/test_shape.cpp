@@ -3,9 +3,13 @@
 //
 
 #include "ffi/container/shape.h"
+#include "ffi/function.h"
 
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
 namespace {
 using namespace litetvm::ffi;
 
@@ -78,4 +82,59 @@ TEST(Shape, ShapeView) {
     EXPECT_EQ(view_from_init.Product(), 7 * 8 * 9);
 }
 
+TEST(Shape, SmallShapePool) {
+    // small shapes reuse the blocks of released ones
+    const ShapeObj* first = nullptr;
+    {
+        Shape shape({1, 2, 3, 4});
+        first = shape.get();
+    }
+    Shape reused({5, 6});
+    EXPECT_EQ(reused.get(), first);
+    EXPECT_EQ(reused.size(), 2);
+    EXPECT_EQ(reused[1], 6);
+
+    std::vector<Shape> shapes;
+    for (int64_t rank = 0; rank <= 6; ++rank) {
+        std::vector<int64_t> dims(rank, rank);
+        shapes.emplace_back(dims);
+        shapes.emplace_back(dims.begin(), dims.end());
+    }
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        int64_t rank = static_cast<int64_t>(i / 2);
+        EXPECT_EQ(shapes[i].size(), rank);
+        for (int64_t dim: shapes[i]) {
+            EXPECT_EQ(dim, rank);
+        }
+    }
+
+    // shapes can be released by another thread than the one that created them
+    std::thread worker([moved = std::move(shapes)]() mutable { moved.clear(); });
+    worker.join();
+    Shape after({7, 8, 9});
+    EXPECT_EQ(after.Product(), 7 * 8 * 9);
+}
+
+TEST(Shape, Intern) {
+    Shape a = Shape::Intern({2, 3, 4});
+    Shape b = Shape::Intern({2, 3, 4});
+    Shape c = Shape::Intern({2, 3, 5});
+    EXPECT_TRUE(a.same_as(b));
+    EXPECT_FALSE(a.same_as(c));
+    EXPECT_EQ(c[2], 5);
+    Shape empty = Shape::Intern({});
+    EXPECT_EQ(empty.size(), 0);
+    EXPECT_TRUE(empty.same_as(Shape::Intern({})));
+    Shape large = Shape::Intern({1, 2, 3, 4, 5, 6});
+    EXPECT_EQ(large.Product(), 720);
+
+    Function fshape = Function::GetGlobalRequired("ffi.Shape");
+    Shape d = fshape(2, 3, 4).cast<Shape>();
+    EXPECT_TRUE(d.same_as(a));
+    Shape e = fshape(1, 2, 3, 4, 5).cast<Shape>();
+    EXPECT_EQ(e.size(), 5);
+    EXPECT_EQ(e[4], 5);
+    EXPECT_THROW(fshape(1, "x"), Error);
+}
+
 }// namespace
\ No newline at end of file
@@ -0,0 +1,168 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/container/shape_ops.h"
+#include "ffi/container/tensor.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+namespace {
+using namespace litetvm::ffi;
+
+TEST(ShapeOps, NumelAndStrides) {
+    // every fixed rank and the dynamic fallback
+    for (int32_t ndim = 0; ndim <= 10; ++ndim) {
+        std::vector<int64_t> shape(ndim);
+        int64_t numel = 1;
+        for (int32_t i = 0; i < ndim; ++i) {
+            shape[i] = i % 3 + 1;
+            numel *= shape[i];
+        }
+        EXPECT_EQ(ShapeOps::Numel(shape.data(), ndim), numel);
+        EXPECT_EQ(ShapeOps::CheckedNumel(shape.data(), ndim), numel);
+        std::vector<int64_t> strides(ndim);
+        EXPECT_EQ(ShapeOps::FillContiguousStrides(shape.data(), ndim, strides.data()), numel);
+        int64_t expected = 1;
+        for (int32_t i = ndim - 1; i >= 0; --i) {
+            EXPECT_EQ(strides[i], expected);
+            expected *= shape[i];
+        }
+        EXPECT_TRUE(ShapeOps::IsContiguous(shape.data(), strides.data(), ndim));
+        if (ndim >= 2) {
+            // dim 1 has extent 2, its stride is checked
+            strides[1] += 1;
+            EXPECT_FALSE(ShapeOps::IsContiguous(shape.data(), strides.data(), ndim));
+        }
+    }
+    // strides of dims of extent 1 are ignored
+    int64_t shape[] = {2, 1, 3};
+    int64_t strides[] = {3, 100, 1};
+    EXPECT_TRUE(ShapeOps::IsContiguous(shape, strides, 3));
+    EXPECT_TRUE(ShapeOps::IsContiguous(shape, nullptr, 3));
+}
+
+TEST(ShapeOps, Checked) {
+    int64_t negative[] = {2, -1};
+    EXPECT_THROW(ShapeOps::CheckedNumel(negative, 2), Error);
+    int64_t huge[] = {1 << 30, 1 << 30, 1 << 30};
+    EXPECT_THROW(ShapeOps::CheckedNumel(huge, 3), Error);
+    int64_t large[] = {int64_t{1} << 61};
+    EXPECT_EQ(ShapeOps::CheckedNumel(large, 1), int64_t{1} << 61);
+    EXPECT_THROW(ShapeOps::CheckedDataSize(large, 1, DLDataType{kDLFloat, 32, 1}), Error);
+    EXPECT_EQ(ShapeOps::CheckedDataSize(large, 1, DLDataType{kDLInt, 4, 1}), size_t{1} << 60);
+
+    int64_t shape[] = {3, 5};
+    EXPECT_EQ(ShapeOps::CheckedDataSize(shape, 2, DLDataType{kDLFloat, 32, 1}), 60);
+    EXPECT_EQ(ShapeOps::CheckedDataSize(shape, 2, DLDataType{kDLFloat, 16, 4}), 120);
+    EXPECT_EQ(ShapeOps::CheckedDataSize(shape, 2, DLDataType{kDLUInt, 1, 1}), 15);
+    EXPECT_EQ(ShapeOps::CheckedDataSize(shape, 2, DLDataType{kDLInt, 4, 1}), 8);
+    EXPECT_EQ(ShapeOps::CheckedDataSize(nullptr, 0, DLDataType{kDLFloat, 64, 1}), 8);
+}
+
+TEST(ShapeOps, Broadcast) {
+    int64_t lhs[] = {8, 1, 6, 1};
+    int64_t rhs[] = {7, 1, 5};
+    int64_t out[4];
+    EXPECT_EQ(ShapeOps::BroadcastShape(lhs, 4, rhs, 3, out), 4);
+    EXPECT_EQ(std::vector<int64_t>(out, out + 4), (std::vector<int64_t>{8, 7, 6, 5}));
+    EXPECT_EQ(ShapeOps::BroadcastShape(rhs, 3, lhs, 4, out), 4);
+    EXPECT_EQ(std::vector<int64_t>(out, out + 4), (std::vector<int64_t>{8, 7, 6, 5}));
+    EXPECT_EQ(ShapeOps::BroadcastShape(lhs, 4, nullptr, 0, out), 4);
+    EXPECT_EQ(std::vector<int64_t>(out, out + 4), (std::vector<int64_t>{8, 1, 6, 1}));
+
+    int64_t zero[] = {0, 3};
+    int64_t one[] = {1};
+    EXPECT_EQ(ShapeOps::BroadcastShape(zero, 2, one, 1, out), 2);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(out[1], 3);
+
+    int64_t bad[] = {2, 4};
+    EXPECT_THROW(ShapeOps::BroadcastShape(lhs, 4, bad, 2, out), Error);
+
+    std::vector<int64_t> big_lhs(10, 1), big_rhs(9, 2), big_out(10);
+    big_lhs[0] = 3;
+    EXPECT_EQ(ShapeOps::BroadcastShape(big_lhs.data(), 10, big_rhs.data(), 9, big_out.data()), 10);
+    EXPECT_EQ(big_out[0], 3);
+    EXPECT_EQ(big_out[9], 2);
+}
+
+TEST(ShapeOps, Reshape) {
+    int64_t target[] = {4, -1, 2};
+    int64_t out[3];
+    ShapeOps::InferReshape(24, target, 3, out);
+    EXPECT_EQ(std::vector<int64_t>(out, out + 3), (std::vector<int64_t>{4, 3, 2}));
+    EXPECT_THROW(ShapeOps::InferReshape(25, target, 3, out), Error);
+    int64_t two_infer[] = {-1, -1};
+    EXPECT_THROW(ShapeOps::InferReshape(4, two_infer, 2, out), Error);
+    int64_t fixed[] = {2, 3};
+    EXPECT_THROW(ShapeOps::InferReshape(7, fixed, 2, out), Error);
+    int64_t zero_infer[] = {0, -1};
+    EXPECT_THROW(ShapeOps::InferReshape(0, zero_infer, 2, out), Error);
+}
+
+TEST(ShapeOps, ViewStrides) {
+    int64_t shape[] = {2, 3, 4};
+    int64_t strides[] = {12, 4, 1};
+    int64_t new_shape[] = {6, 4};
+    int64_t out[5];
+    EXPECT_TRUE(ShapeOps::ComputeViewStrides(shape, strides, 3, new_shape, 2, out));
+    EXPECT_EQ(out[0], 4);
+    EXPECT_EQ(out[1], 1);
+
+    // a transposed tensor can split dims but not merge across the transpose
+    int64_t t_shape[] = {4, 3};
+    int64_t t_strides[] = {1, 4};
+    int64_t merged[] = {12};
+    EXPECT_FALSE(ShapeOps::ComputeViewStrides(t_shape, t_strides, 2, merged, 1, out));
+    int64_t split[] = {2, 2, 3};
+    EXPECT_TRUE(ShapeOps::ComputeViewStrides(t_shape, t_strides, 2, split, 3, out));
+    EXPECT_EQ(out[0], 2);
+    EXPECT_EQ(out[1], 1);
+    EXPECT_EQ(out[2], 4);
+
+    // unit dims can be inserted anywhere
+    int64_t unit[] = {1, 4, 1, 3, 1};
+    EXPECT_TRUE(ShapeOps::ComputeViewStrides(t_shape, t_strides, 2, unit, 5, out));
+    EXPECT_EQ(out[1], 1);
+    EXPECT_EQ(out[3], 4);
+
+    // a sliced row keeps a gap between rows
+    int64_t s_shape[] = {2, 3};
+    int64_t s_strides[] = {4, 1};
+    int64_t flat[] = {6};
+    EXPECT_FALSE(ShapeOps::ComputeViewStrides(s_shape, s_strides, 2, flat, 1, out));
+
+    int64_t empty_shape[] = {0, 3};
+    int64_t empty_view[] = {3, 0};
+    EXPECT_TRUE(ShapeOps::ComputeViewStrides(empty_shape, s_strides, 2, empty_view, 2, out));
+
+    int64_t lo, hi;
+    int64_t n_strides[] = {-4, 1};
+    EXPECT_TRUE(ShapeOps::ElementSpan(s_shape, n_strides, 2, &lo, &hi));
+    EXPECT_EQ(lo, -4);
+    EXPECT_EQ(hi, 2);
+    EXPECT_FALSE(ShapeOps::ElementSpan(empty_shape, s_strides, 2, &lo, &hi));
+    int64_t huge_shape[] = {int64_t{1} << 40, 2};
+    int64_t huge_strides[] = {int64_t{1} << 40, 1};
+    EXPECT_THROW(ShapeOps::ElementSpan(huge_shape, huge_strides, 2, &lo, &hi), Error);
+}
+
+TEST(ShapeOps, TensorCreation) {
+    struct CPUNDAlloc {
+        void AllocData(DLTensor* tensor) { tensor->data = malloc(GetDataSize(*tensor)); }
+        void FreeData(DLTensor* tensor) { free(tensor->data); }
+    };
+    Tensor tensor = Tensor::FromNDAlloc(CPUNDAlloc(), {2, 3, 4}, DLDataType{kDLFloat, 32, 1}, DLDevice{kDLCPU, 0});
+    EXPECT_EQ(tensor.strides()[0], 12);
+    EXPECT_TRUE(tensor.IsContiguous());
+    EXPECT_THROW(Tensor::FromNDAlloc(CPUNDAlloc(), {2, -3}, DLDataType{kDLFloat, 32, 1}, DLDevice{kDLCPU, 0}),
+                 Error);
+    int64_t max = std::numeric_limits<int64_t>::max();
+    EXPECT_THROW(Tensor::FromNDAlloc(CPUNDAlloc(), {max, 2}, DLDataType{kDLFloat, 32, 1}, DLDevice{kDLCPU, 0}),
+                 Error);
+}
+
+}// namespace
@@ -0,0 +1,83 @@
+//
+// Created by richard on 10/18/26.
+//
+#include "ffi/any.h"
+#include "ffi/string_builder.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace {
+using namespace litetvm::ffi;
+
+TEST(StringBuilder, Basic) {
+    StringBuilder builder;
+    builder << "float" << 32 << 'x' << int64_t{4} << std::string("_") << String("end");
+    EXPECT_EQ(builder.size(), 13);
+    String result = builder.Build();
+    EXPECT_EQ(result, "float32x4_end");
+    EXPECT_TRUE(builder.empty());
+
+    // small results are stored inline
+    builder << "abc";
+    Any small = builder.Build();
+    EXPECT_EQ(small.type_index(), TypeIndex::kTVMFFISmallStr);
+    EXPECT_EQ(small.cast<String>(), "abc");
+
+    EXPECT_EQ(StringBuilder().Build(), "");
+    builder.AppendNumber(0.5);
+    EXPECT_EQ(builder.Build(), "0.5");
+}
+
+TEST(StringBuilder, Reserve) {
+    // the content fits the reserved chunk, which becomes the string object
+    StringBuilder builder(32);
+    builder << "0123456789" << "0123456789";
+    Any full = builder.Build();
+    EXPECT_EQ(full.type_index(), TypeIndex::kTVMFFIStr);
+    EXPECT_EQ(full.cast<String>(), "01234567890123456789");
+    EXPECT_EQ(full.cast<String>().c_str()[20], '\0');
+
+    // mostly empty chunks are copied into an exact allocation
+    builder.Reserve(4096);
+    builder << "0123456789";
+    EXPECT_EQ(builder.Build(), "0123456789");
+}
+
+TEST(StringBuilder, ChunkedGrowth) {
+    StringBuilder builder(4);
+    std::string expected;
+    for (int i = 0; i < 1000; ++i) {
+        builder << "item" << i << ',';
+        expected += "item" + std::to_string(i) + ",";
+    }
+    EXPECT_EQ(builder.size(), expected.size());
+    String result = builder.Build();
+    EXPECT_EQ(std::string(result), expected);
+    EXPECT_EQ(result.c_str()[result.size()], '\0');
+
+    // pieces larger than a chunk
+    std::string large(1000, 'y');
+    builder << "x" << large;
+    EXPECT_EQ(std::string(builder.Build()), "x" + large);
+}
+
+TEST(BytesRope, Basic) {
+    Bytes large(std::string(100, 'a'));
+    BytesRope rope = BytesRope(large) + BytesRope(Bytes("bc", 2));
+    rope.Append(Bytes());
+    EXPECT_EQ(rope.size(), 102);
+    EXPECT_EQ(rope.pieces().size(), 2);
+    // pieces are shared, not copied
+    EXPECT_EQ(rope.pieces()[0].data(), large.data());
+    EXPECT_EQ(rope.at(100), 'b');
+    EXPECT_THROW(rope.at(102), Error);
+
+    Bytes flat = rope.Flatten();
+    EXPECT_EQ(std::string(flat), std::string(100, 'a') + "bc");
+    EXPECT_EQ(BytesRope(large).Flatten().data(), large.data());
+    EXPECT_EQ(BytesRope().Flatten().size(), 0);
+}
+
+}// namespace
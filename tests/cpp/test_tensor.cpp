@@ -3,9 +3,12 @@
 //
 
 #include "ffi/container/tensor.h"
+#include "ffi/function.h"
 
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <thread>
 #include <utility>
 
 namespace {
@@ -86,11 +89,44 @@ TEST(Tensor, DLPack) {
     EXPECT_EQ(dlpack->dl_tensor.strides[2], 1);
     EXPECT_EQ(nd.use_count(), 2);
     {
+        // our own export is taken back without wrapping
         Tensor nd2 = Tensor::FromDLPack(dlpack);
+        EXPECT_TRUE(nd2.same_as(nd));
+        EXPECT_EQ(nd.use_count(), 2);
+    }
+    EXPECT_EQ(nd.use_count(), 1);
+
+    // a modified export is wrapped
+    dlpack = nd.ToDLPack();
+    dlpack->dl_tensor.shape = dlpack->dl_tensor.shape + 1;
+    dlpack->dl_tensor.strides = dlpack->dl_tensor.strides + 1;
+    dlpack->dl_tensor.ndim = 2;
+    {
+        Tensor nd2 = Tensor::FromDLPack(dlpack);
+        EXPECT_FALSE(nd2.same_as(nd));
         EXPECT_EQ(nd2.use_count(), 1);
         EXPECT_EQ(nd2->data, nd->data);
+        EXPECT_EQ(nd2.shape()[0], 2);
         EXPECT_EQ(nd.use_count(), 2);
-        EXPECT_EQ(nd2.use_count(), 1);
+    }
+    EXPECT_EQ(nd.use_count(), 1);
+
+    // a retyped or moved export keeps its new dtype and device
+    dlpack = nd.ToDLPack();
+    dlpack->dl_tensor.dtype = DLDataType({kDLUInt, 16, 1});
+    {
+        Tensor nd2 = Tensor::FromDLPack(dlpack);
+        EXPECT_FALSE(nd2.same_as(nd));
+        EXPECT_EQ(nd2.dtype().code, kDLUInt);
+        EXPECT_EQ(nd2->data, nd->data);
+        EXPECT_EQ(nd.dtype().code, kDLInt);
+    }
+    dlpack = nd.ToDLPack();
+    dlpack->dl_tensor.device.device_id = 1;
+    {
+        Tensor nd2 = Tensor::FromDLPack(dlpack);
+        EXPECT_FALSE(nd2.same_as(nd));
+        EXPECT_EQ(nd2->device.device_id, 1);
     }
     EXPECT_EQ(nd.use_count(), 1);
 }
@@ -115,12 +151,59 @@ TEST(Tensor, DLPackVersioned) {
     EXPECT_EQ(nd.use_count(), 2);
     {
         Tensor nd2 = Tensor::FromDLPackVersioned(dlpack);
-        EXPECT_EQ(nd2.use_count(), 1);
-        EXPECT_EQ(nd2->data, nd->data);
+        EXPECT_TRUE(nd2.same_as(nd));
         EXPECT_EQ(nd.use_count(), 2);
+    }
+    EXPECT_EQ(nd.use_count(), 1);
+
+    dlpack = nd.ToDLPackVersioned();
+    dlpack->dl_tensor.byte_offset = 1;
+    {
+        Tensor nd2 = Tensor::FromDLPackVersioned(dlpack);
+        EXPECT_FALSE(nd2.same_as(nd));
         EXPECT_EQ(nd2.use_count(), 1);
+        EXPECT_EQ(nd2->byte_offset, 1);
+        EXPECT_EQ(nd.use_count(), 2);
     }
     EXPECT_EQ(nd.use_count(), 1);
+
+    dlpack = nd.ToDLPackVersioned();
+    dlpack->dl_tensor.dtype = DLDataType({kDLInt, 4, 1});
+    {
+        Tensor nd2 = Tensor::FromDLPackVersioned(dlpack);
+        EXPECT_FALSE(nd2.same_as(nd));
+        EXPECT_EQ(nd2.dtype().bits, 4);
+    }
+    dlpack = nd.ToDLPackVersioned();
+    dlpack->flags = DLPACK_FLAG_BITMASK_READ_ONLY;
+    {
+        Tensor nd2 = Tensor::FromDLPackVersioned(dlpack);
+        EXPECT_FALSE(nd2.same_as(nd));
+    }
+    EXPECT_EQ(nd.use_count(), 1);
+}
+
+TEST(Tensor, DLPackRecycle) {
+    Tensor nd = Empty({4}, DLDataType({kDLFloat, 32, 1}), DLDevice({kDLCPU, 0}));
+    // managed tensors of both versions share the pool
+    DLManagedTensor* legacy = nd.ToDLPack();
+    legacy->deleter(legacy);
+    DLManagedTensorVersioned* versioned = nd.ToDLPackVersioned();
+    EXPECT_EQ(static_cast<void*>(versioned), static_cast<void*>(legacy));
+    EXPECT_EQ(versioned->flags, 0);
+    EXPECT_EQ(nd.use_count(), 2);
+
+    // the deleter may run on another thread
+    std::thread worker([versioned]() { versioned->deleter(versioned); });
+    worker.join();
+    EXPECT_EQ(nd.use_count(), 1);
+
+    // checks still apply to our own exports
+    versioned = nd.ToDLPackVersioned();
+    EXPECT_THROW(Tensor::FromDLPackVersioned(versioned, 1 << 20), Error);
+    Tensor nd2 = Tensor::FromDLPackVersioned(versioned, 4, true);
+    EXPECT_TRUE(nd2.same_as(nd));
+    EXPECT_EQ(nd.use_count(), 2);
 }
 
 TEST(Tensor, DLPackAlloc) {
@@ -174,4 +257,120 @@ TEST(Tensor, TensorView) {
     EXPECT_EQ(tensor_view2.dtype().lanes, 1);
 }
 
+// float32 tensor whose elements hold their flat index
+Tensor Iota(Shape shape) {
+    Tensor tensor = Empty(shape, DLDataType({kDLFloat, 32, 1}), DLDevice({kDLCPU, 0}));
+    float* data = static_cast<float*>(tensor->data);
+    for (int64_t i = 0; i < tensor.numel(); ++i) {
+        data[i] = static_cast<float>(i);
+    }
+    return tensor;
+}
+
+float At(const Tensor& tensor, std::initializer_list<int64_t> index) {
+    const char* data = static_cast<const char*>(tensor->data) + tensor->byte_offset;
+    int64_t offset = 0;
+    int32_t d = 0;
+    for (int64_t i: index) {
+        offset += i * tensor->strides[d++];
+    }
+    return reinterpret_cast<const float*>(data)[offset];
+}
+
+TEST(Tensor, SliceAndPermute) {
+    Tensor tensor = Iota({4, 6});
+    Tensor rows = tensor.Slice(0, 1, 3);
+    EXPECT_EQ(rows.shape()[0], 2);
+    EXPECT_EQ(rows->data, tensor->data);
+    EXPECT_EQ(rows->byte_offset, 6 * 4);
+    EXPECT_EQ(At(rows, {0, 0}), 6);
+    EXPECT_TRUE(rows.IsContiguous());
+
+    // negative indices and steps
+    Tensor cols = tensor.Slice(-1, -5, 6, 2);
+    EXPECT_EQ(cols.shape()[1], 3);
+    EXPECT_EQ(cols.strides()[1], 2);
+    EXPECT_EQ(At(cols, {2, 2}), 2 * 6 + 5);
+    EXPECT_FALSE(cols.IsContiguous());
+    EXPECT_EQ(tensor.Slice(0, 3, 1).shape()[0], 0);
+    EXPECT_EQ(tensor.Slice(0, -100, 100).shape()[0], 4);
+    EXPECT_THROW(tensor.Slice(2, 0, 1), Error);
+    EXPECT_THROW(tensor.Slice(0, 0, 1, 0), Error);
+
+    // the view keeps the data alive
+    Tensor transposed = tensor.Permute({1, 0});
+    tensor = Tensor(nullptr);
+    EXPECT_EQ(transposed.shape()[0], 6);
+    EXPECT_EQ(At(transposed, {5, 3}), 3 * 6 + 5);
+    Tensor back = transposed.Permute({-1, 0});
+    EXPECT_TRUE(back.IsContiguous());
+    EXPECT_THROW(transposed.Permute({0, 0}), Error);
+    EXPECT_THROW(transposed.Permute({0}), Error);
+}
+
+TEST(Tensor, ReshapeAndCreateView) {
+    Tensor tensor = Iota({2, 3, 4});
+    Tensor flat = tensor.Reshape({-1});
+    EXPECT_EQ(flat.shape()[0], 24);
+    EXPECT_EQ(At(flat, {17}), 17);
+    Tensor split = tensor.Permute({2, 0, 1}).Reshape({2, 2, 6});
+    EXPECT_EQ(split.strides()[2], 4);
+    EXPECT_EQ(At(split, {1, 0, 4}), 18);
+    EXPECT_THROW(tensor.Permute({1, 0, 2}).Reshape({6, 4}), Error);
+    EXPECT_THROW(tensor.Reshape({5, -1}), Error);
+
+    Tensor bytes = tensor.CreateView({96}, DLDataType({kDLUInt, 8, 1}));
+    EXPECT_EQ(bytes.dtype().bits, 8);
+    Tensor tail = tensor.CreateView({2, 4}, DLDataType({kDLFloat, 32, 1}), 16 * 4);
+    EXPECT_EQ(At(tail, {1, 3}), 23);
+    EXPECT_THROW(tensor.CreateView({2, 4}, DLDataType({kDLFloat, 32, 1}), 17 * 4), Error);
+    EXPECT_THROW(tensor.Slice(2, 0, 4, 2).CreateView({12}, DLDataType({kDLFloat, 32, 1})), Error);
+
+    Function reshape = Function::GetGlobalRequired("ffi.TensorReshape");
+    Tensor from_global = reshape(tensor, Shape({4, 6})).cast<Tensor>();
+    EXPECT_EQ(At(from_global, {3, 5}), 23);
+}
+
+TEST(Tensor, AsStrided) {
+    Tensor tensor = Iota({4, 4});
+    // the diagonal
+    Tensor diag = tensor.AsStrided({4}, {5});
+    EXPECT_EQ(At(diag, {3}), 15);
+    // overlapping windows of the second row
+    Tensor windows = tensor.AsStrided({3, 2}, {1, 1}, 4);
+    EXPECT_EQ(At(windows, {2, 1}), 7);
+    // reversed rows of the inner block
+    Tensor inner = tensor.Slice(0, 1, 3).Slice(1, 1, 3);
+    Tensor reversed = inner.AsStrided({2}, {-1}, 1);
+    EXPECT_EQ(At(reversed, {0}), 6);
+    EXPECT_EQ(At(reversed, {1}), 5);
+    EXPECT_THROW(inner.AsStrided({2}, {-1}, 0), Error);
+    EXPECT_THROW(tensor.AsStrided({4}, {5}, 1), Error);
+    EXPECT_THROW(tensor.AsStrided({2, 2}, {1}), Error);
+    EXPECT_EQ(tensor.AsStrided({0, 100}, {1000, 1000}, 0).numel(), 0);
+    EXPECT_THROW(tensor.AsStrided({1}, {std::numeric_limits<int64_t>::max()}).Slice(0, 0, 1, 2), Error);
+}
+
+TEST(Tensor, ViewBeforeDataPointer) {
+    // a reversed tensor whose data pointer is its last element in memory
+    float storage[4] = {0, 1, 2, 3};
+    int64_t shape[1] = {4};
+    int64_t strides[1] = {-1};
+    DLManagedTensorVersioned managed{};
+    managed.version = {DLPACK_MAJOR_VERSION, DLPACK_MINOR_VERSION};
+    managed.dl_tensor.data = storage + 3;
+    managed.dl_tensor.device = DLDevice({kDLCPU, 0});
+    managed.dl_tensor.ndim = 1;
+    managed.dl_tensor.dtype = DLDataType({kDLFloat, 32, 1});
+    managed.dl_tensor.shape = shape;
+    managed.dl_tensor.strides = strides;
+    managed.deleter = [](DLManagedTensorVersioned*) {};
+    Tensor reversed = Tensor::FromDLPackVersioned(&managed);
+    EXPECT_EQ(At(reversed, {3}), 0);
+    EXPECT_EQ(At(reversed.Slice(0, 0, 4, 2), {1}), 1);
+    // the views would start before the data pointer, which byte_offset cannot express
+    EXPECT_THROW(reversed.Slice(0, 1, 4), Error);
+    EXPECT_THROW(reversed.AsStrided({2}, {1}, -2), Error);
+}
+
 }// namespace
@@ -0,0 +1,242 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/container/tensor.h"
+#include "ffi/function.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+using namespace litetvm::ffi;
+
+struct CPUNDAlloc {
+    void AllocData(DLTensor* tensor) {
+        tensor->data = malloc(GetDataSize(*tensor));
+    }
+
+    void FreeData(DLTensor* tensor) {
+        free(tensor->data);
+    }
+};
+
+Tensor Empty(Shape shape, DLDataType dtype) {
+    return Tensor::FromNDAlloc(CPUNDAlloc(), std::move(shape), dtype, DLDevice({kDLCPU, 0}));
+}
+
+// float32 tensor holding 0, 1, 2, ...
+Tensor Iota(Shape shape) {
+    Tensor tensor = Empty(shape, DLDataType({kDLFloat, 32, 1}));
+    float* data = static_cast<float*>(tensor->data);
+    for (int64_t i = 0; i < tensor.numel(); ++i) {
+        data[i] = static_cast<float>(i);
+    }
+    return tensor;
+}
+
+template<typename T>
+T At(const Tensor& tensor, std::initializer_list<int64_t> index) {
+    int64_t offset = 0;
+    int32_t dim = 0;
+    for (int64_t i: index) {
+        offset += i * tensor.strides()[dim++];
+    }
+    return static_cast<const T*>(tensor->data)[offset + tensor->byte_offset / sizeof(T)];
+}
+
+TEST(TensorCopy, ContiguousPermuted) {
+    Tensor tensor = Iota({3, 70, 45});
+    EXPECT_TRUE(tensor.Contiguous().same_as(tensor));
+
+    // the last two dims swapped is a transpose, the first and last swapped is a gather
+    for (Shape dims: {Shape({0, 2, 1}), Shape({2, 1, 0}), Shape({1, 0, 2})}) {
+        Tensor permuted = tensor.Permute(dims);
+        Tensor copy = permuted.Contiguous();
+        EXPECT_TRUE(copy.IsContiguous());
+        EXPECT_TRUE(std::equal(copy.shape().begin(), copy.shape().end(), permuted.shape().begin()));
+        for (int64_t i = 0; i < copy.shape()[0]; ++i) {
+            for (int64_t j = 0; j < copy.shape()[1]; ++j) {
+                for (int64_t k = 0; k < copy.shape()[2]; ++k) {
+                    ASSERT_EQ(At<float>(copy, {i, j, k}), At<float>(permuted, {i, j, k}));
+                }
+            }
+        }
+    }
+
+    // strided source and destination
+    Tensor src = tensor.Slice(1, 3, 60, 2);
+    Tensor dst = Empty({3, 70, 90}, DLDataType({kDLFloat, 32, 1})).Slice(2, 0, 90, 2).Slice(1, 0, 29);
+    src.CopyTo(dst);
+    EXPECT_EQ(At<float>(dst, {2, 28, 44}), At<float>(tensor, {2, 59, 44}));
+    EXPECT_EQ(At<float>(dst, {1, 0, 0}), At<float>(tensor, {1, 3, 0}));
+}
+
+TEST(TensorCopy, ContiguousPinned) {
+    // pinned host memory is CPU accessible, the copy is plain host memory
+    Tensor pinned = Tensor::FromNDAlloc(CPUNDAlloc(), Shape({4, 5}), DLDataType({kDLFloat, 32, 1}),
+                                        DLDevice({kDLCUDAHost, 0}));
+    std::fill_n(static_cast<float*>(pinned->data), 20, 1.5f);
+    Tensor copy = pinned.Permute({1, 0}).Contiguous();
+    EXPECT_EQ(copy->device.device_type, kDLCPU);
+    EXPECT_EQ(At<float>(copy, {4, 3}), 1.5f);
+}
+
+TEST(TensorCopy, Broadcast) {
+    Tensor src = Iota({3, 1});
+    Tensor dst = Empty({2, 3, 4}, DLDataType({kDLFloat, 32, 1}));
+    src.CopyTo(dst);
+    for (int64_t i = 0; i < 2; ++i) {
+        for (int64_t j = 0; j < 3; ++j) {
+            for (int64_t k = 0; k < 4; ++k) {
+                EXPECT_EQ(At<float>(dst, {i, j, k}), static_cast<float>(j));
+            }
+        }
+    }
+    Tensor scalar = Iota({});
+    Tensor row = Empty({5}, DLDataType({kDLInt, 64, 1}));
+    scalar.CopyTo(row);
+    EXPECT_EQ(At<int64_t>(row, {4}), 0);
+
+    EXPECT_THROW(Iota({3, 2}).CopyTo(dst), Error);
+    EXPECT_THROW(Iota({2, 3, 4}).CopyTo(src), Error);
+    Empty({0, 4}, DLDataType({kDLFloat, 32, 1})).CopyTo(Empty({0, 4}, DLDataType({kDLFloat, 32, 1})));
+}
+
+TEST(TensorCopy, Convert) {
+    Tensor src = Empty({6}, DLDataType({kDLFloat, 32, 1}));
+    float values[6] = {1.5f, -2.25f, 65504.0f, 1e-7f, std::numeric_limits<float>::infinity(), 3.0f};
+    std::memcpy(src->data, values, sizeof(values));
+
+    Tensor half = Empty({6}, DLDataType({kDLFloat, 16, 1}));
+    Tensor back = Empty({6}, DLDataType({kDLFloat, 32, 1}));
+    src.CopyTo(half);
+    half.CopyTo(back);
+    EXPECT_EQ(At<float>(back, {0}), 1.5f);
+    EXPECT_EQ(At<float>(back, {1}), -2.25f);
+    EXPECT_EQ(At<float>(back, {2}), 65504.0f);
+    // the nearest subnormal half is 2^-24
+    EXPECT_EQ(At<float>(back, {3}), std::ldexp(1.0f, -24) * 2);
+    EXPECT_TRUE(std::isinf(At<float>(back, {4})));
+
+    Tensor bf16 = Empty({6}, DLDataType({kDLBfloat, 16, 1}));
+    src.CopyTo(bf16);
+    bf16.CopyTo(back);
+    EXPECT_EQ(At<float>(back, {0}), 1.5f);
+    EXPECT_EQ(At<float>(back, {2}), 65536.0f);
+
+    Tensor ints = Empty({4}, DLDataType({kDLInt, 32, 1}));
+    src.Slice(0, 0, 4).CopyTo(ints);
+    EXPECT_EQ(At<int32_t>(ints, {1}), -2);
+    EXPECT_EQ(At<int32_t>(ints, {2}), 65504);
+    Tensor flags = Empty({4}, DLDataType({kDLBool, 8, 1}));
+    ints.CopyTo(flags);
+    EXPECT_EQ(At<uint8_t>(flags, {0}), 1);
+    EXPECT_EQ(At<uint8_t>(flags, {3}), 0);
+    Tensor wide = Empty({2, 4}, DLDataType({kDLUInt, 64, 1}));
+    flags.CopyTo(wide);
+    EXPECT_EQ(At<uint64_t>(wide, {1, 1}), 1);
+    EXPECT_EQ(At<uint64_t>(wide, {1, 3}), 0);
+
+    // lanes are converted one by one
+    Tensor vec = Iota({4, 2}).CreateView({2}, DLDataType({kDLFloat, 32, 4}));
+    Tensor vec_half = Empty({2}, DLDataType({kDLFloat, 16, 4}));
+    vec.CopyTo(vec_half);
+    Tensor vec_back = Empty({8}, DLDataType({kDLFloat, 32, 1}));
+    vec_half.CopyTo(vec_back.CreateView({2}, DLDataType({kDLFloat, 32, 4})));
+    EXPECT_EQ(At<float>(vec_back, {7}), 7.0f);
+
+    EXPECT_THROW(src.CopyTo(Empty({6}, DLDataType({kDLFloat6_e2m3fn, 6, 1}))), Error);
+    EXPECT_THROW(vec.CopyTo(Empty({2}, DLDataType({kDLFloat, 16, 2}))), Error);
+    Tensor int4 = Empty({4, 8}, DLDataType({kDLInt, 4, 1}));
+    EXPECT_THROW(int4.Permute({1, 0}).Contiguous(), Error);
+    int4.CopyTo(Empty({4, 8}, DLDataType({kDLInt, 4, 1})));
+}
+
+TEST(TensorCopy, SaturatingConvert) {
+    // float to integer saturates to the target range and maps NaN to 0
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+    Tensor src = Empty({7}, DLDataType({kDLFloat, 32, 1}));
+    float values[7] = {std::numeric_limits<float>::quiet_NaN(), 1e10f, -1e10f, kInf, -kInf, -3.75f, 300.5f};
+    std::memcpy(src->data, values, sizeof(values));
+
+    Tensor i32 = Empty({7}, DLDataType({kDLInt, 32, 1}));
+    src.CopyTo(i32);
+    EXPECT_EQ(At<int32_t>(i32, {0}), 0);
+    EXPECT_EQ(At<int32_t>(i32, {1}), std::numeric_limits<int32_t>::max());
+    EXPECT_EQ(At<int32_t>(i32, {2}), std::numeric_limits<int32_t>::min());
+    EXPECT_EQ(At<int32_t>(i32, {3}), std::numeric_limits<int32_t>::max());
+    EXPECT_EQ(At<int32_t>(i32, {4}), std::numeric_limits<int32_t>::min());
+    EXPECT_EQ(At<int32_t>(i32, {5}), -3);
+    EXPECT_EQ(At<int32_t>(i32, {6}), 300);
+
+    Tensor u8 = Empty({7}, DLDataType({kDLUInt, 8, 1}));
+    src.CopyTo(u8);
+    EXPECT_EQ(At<uint8_t>(u8, {0}), 0);
+    EXPECT_EQ(At<uint8_t>(u8, {1}), 255);
+    EXPECT_EQ(At<uint8_t>(u8, {5}), 0);
+    EXPECT_EQ(At<uint8_t>(u8, {6}), 255);
+
+    // 2^63 rounds from int64 max, it is the first value out of range
+    Tensor f64 = Empty({3}, DLDataType({kDLFloat, 64, 1}));
+    double wide[3] = {0x1p63, -0x1p63, 0x1p62};
+    std::memcpy(f64->data, wide, sizeof(wide));
+    Tensor i64 = Empty({3}, DLDataType({kDLInt, 64, 1}));
+    f64.CopyTo(i64);
+    EXPECT_EQ(At<int64_t>(i64, {0}), std::numeric_limits<int64_t>::max());
+    EXPECT_EQ(At<int64_t>(i64, {1}), std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(At<int64_t>(i64, {2}), static_cast<int64_t>(1) << 62);
+
+    // narrow floats go through float on the way
+    Tensor half = Empty({7}, DLDataType({kDLFloat, 16, 1}));
+    src.CopyTo(half);
+    Tensor i8 = Empty({7}, DLDataType({kDLInt, 8, 1}));
+    half.CopyTo(i8);
+    EXPECT_EQ(At<int8_t>(i8, {0}), 0);
+    EXPECT_EQ(At<int8_t>(i8, {1}), 127);
+    EXPECT_EQ(At<int8_t>(i8, {2}), -128);
+}
+
+TEST(TensorCopy, HalfRoundTrip) {
+    // every half converts to float and back to the same bits, NaNs stay NaNs
+    Tensor half = Empty({65536}, DLDataType({kDLFloat, 16, 1}));
+    uint16_t* bits = static_cast<uint16_t*>(half->data);
+    for (uint32_t i = 0; i < 65536; ++i) {
+        bits[i] = static_cast<uint16_t>(i);
+    }
+    Tensor fp32 = Empty({65536}, DLDataType({kDLFloat, 32, 1}));
+    Tensor back = Empty({65536}, DLDataType({kDLFloat, 16, 1}));
+    half.CopyTo(fp32);
+    fp32.CopyTo(back);
+    const uint16_t* back_bits = static_cast<const uint16_t*>(back->data);
+    for (uint32_t i = 0; i < 65536; ++i) {
+        bool is_nan = (i & 0x7c00u) == 0x7c00u && (i & 0x3ffu) != 0;
+        if (is_nan) {
+            ASSERT_TRUE(std::isnan(At<float>(fp32, {i})));
+            ASSERT_EQ(back_bits[i] & 0x7c00u, 0x7c00u);
+        } else {
+            ASSERT_EQ(back_bits[i], i);
+        }
+    }
+}
+
+TEST(TensorCopy, Large) {
+    // large enough to run on the thread pool
+    Tensor tensor = Iota({512, 1030});
+    Tensor transposed = tensor.Permute({1, 0}).Contiguous();
+    EXPECT_EQ(At<float>(transposed, {1029, 511}), At<float>(tensor, {511, 1029}));
+    EXPECT_EQ(At<float>(transposed, {17, 300}), At<float>(tensor, {300, 17}));
+
+    Function copy_to = Function::GetGlobalRequired("ffi.TensorCopyTo");
+    Tensor dst = Empty({512, 1030}, DLDataType({kDLFloat, 64, 1}));
+    copy_to(tensor, dst);
+    EXPECT_EQ(At<double>(dst, {300, 17}), 300 * 1030 + 17);
+    Function contiguous = Function::GetGlobalRequired("ffi.TensorContiguous");
+    EXPECT_TRUE(contiguous(tensor).cast<Tensor>().same_as(tensor));
+}
+
+}// namespace
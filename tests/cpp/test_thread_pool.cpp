@@ -0,0 +1,104 @@
+//
+// Created by richard on 10/19/26.
+//
+#include "ffi/error.h"
+#include "ffi/thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace litetvm::ffi;
+
+TEST(ThreadPool, ParallelFor) {
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.NumThreads(), 4);
+    std::vector<int> hits(1000, 0);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    pool.ParallelFor(0, 1000, 10, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i) {
+            ++hits[i];
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+    });
+    for (int hit: hits) {
+        EXPECT_EQ(hit, 1);
+    }
+    EXPECT_GE(threads.size(), 1);
+    EXPECT_LE(threads.size(), 4);
+
+    // ranges below the chunk size run inline
+    std::thread::id caller = std::this_thread::get_id();
+    pool.ParallelFor(5, 8, 10, [&](int64_t begin, int64_t end) {
+        EXPECT_EQ(begin, 5);
+        EXPECT_EQ(end, 8);
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+    });
+    pool.ParallelFor(3, 3, 1, [&](int64_t, int64_t) { FAIL(); });
+}
+
+TEST(ThreadPool, NestedAndErrors) {
+    ThreadPool pool(2);
+    std::atomic<int64_t> sum{0};
+    pool.ParallelFor(0, 4, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i) {
+            pool.ParallelFor(0, 100, 1, [&](int64_t b, int64_t e) { sum += e - b; });
+        }
+    });
+    EXPECT_EQ(sum.load(), 400);
+
+    EXPECT_THROW(pool.ParallelFor(0, 100, 1,
+                                  [&](int64_t begin, int64_t) {
+                                      if (begin != 0) {
+                                          TVM_FFI_THROW(ValueError) << "chunk " << begin;
+                                      }
+                                  }),
+                 Error);
+}
+
+TEST(ThreadPool, Submit) {
+    std::atomic<int> done{0};
+    {
+        // the destructor runs the pending tasks
+        ThreadPool pool(2);
+        for (int i = 0; i < 10; ++i) {
+            pool.Submit([&]() { ++done; });
+        }
+    }
+    EXPECT_EQ(done.load(), 10);
+    ThreadPool inline_pool(0);
+    inline_pool.Submit([&]() { ++done; });
+    EXPECT_EQ(done.load(), 11);
+}
+
+TEST(ThreadPool, InitWorker) {
+    std::mutex mutex;
+    std::set<int> indices;
+    std::set<std::thread::id> workers;
+    {
+        ThreadPool pool(3, [&](int index) {
+            std::lock_guard<std::mutex> lock(mutex);
+            indices.insert(index);
+            workers.insert(std::this_thread::get_id());
+        });
+        EXPECT_EQ(pool.NumThreads(), 4);
+    }
+    EXPECT_EQ(indices, std::set<int>({0, 1, 2}));
+    EXPECT_EQ(workers.size(), 3);
+}
+
+TEST(ThreadPool, Global) {
+    ThreadPool* pool = ThreadPool::Global();
+    EXPECT_EQ(pool, ThreadPool::Global());
+    EXPECT_GE(pool->NumThreads(), 1);
+}
+
+}// namespace